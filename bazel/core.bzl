@@ -314,6 +314,8 @@ MLN_CORE_SOURCE = [
     "src/mbgl/renderer/possibly_evaluated_property_value.hpp",
     "src/mbgl/renderer/property_evaluation_parameters.hpp",
     "src/mbgl/renderer/property_evaluator.hpp",
+    "src/mbgl/renderer/query_snapshot.cpp",
+    "src/mbgl/renderer/query_snapshot.hpp",
     "src/mbgl/renderer/render_layer.cpp",
     "src/mbgl/renderer/render_layer.hpp",
     "src/mbgl/renderer/render_light.cpp",
@@ -351,6 +353,8 @@ MLN_CORE_SOURCE = [
     "src/mbgl/renderer/source_state.hpp",
     "src/mbgl/renderer/style_diff.cpp",
     "src/mbgl/renderer/style_diff.hpp",
+    "src/mbgl/renderer/tile_load_order.cpp",
+    "src/mbgl/renderer/tile_load_order.hpp",
     "src/mbgl/renderer/tile_mask.hpp",
     "src/mbgl/renderer/tile_parameters.hpp",
     "src/mbgl/renderer/tile_pyramid.cpp",
@@ -520,6 +524,8 @@ MLN_CORE_SOURCE = [
     "src/mbgl/text/glyph_manager.cpp",
     "src/mbgl/text/glyph_manager.hpp",
     "src/mbgl/text/glyph_manager_observer.hpp",
+    "src/mbgl/text/glyph_pack.cpp",
+    "src/mbgl/text/glyph_pack.hpp",
     "src/mbgl/text/glyph_pbf.cpp",
     "src/mbgl/text/glyph_pbf.hpp",
     "src/mbgl/text/glyph_range.hpp",
@@ -532,6 +538,8 @@ MLN_CORE_SOURCE = [
     "src/mbgl/text/quads.hpp",
     "src/mbgl/text/shaping.cpp",
     "src/mbgl/text/shaping.hpp",
+    "src/mbgl/text/shaping_cache.cpp",
+    "src/mbgl/text/shaping_cache.hpp",
     "src/mbgl/text/tagged_string.cpp",
     "src/mbgl/text/tagged_string.hpp",
     "src/mbgl/tile/custom_geometry_tile.cpp",
@@ -572,6 +580,8 @@ MLN_CORE_SOURCE = [
     "src/mbgl/util/bounding_volumes.cpp",
     "src/mbgl/util/chrono.cpp",
     "src/mbgl/util/client_options.cpp",
+    "src/mbgl/util/cluster_index.cpp",
+    "src/mbgl/util/cluster_index.hpp",
     "src/mbgl/util/color.cpp",
     "src/mbgl/util/constants.cpp",
     "src/mbgl/util/convert.cpp",
@@ -610,6 +620,7 @@ MLN_CORE_SOURCE = [
     "src/mbgl/util/mat4.cpp",
     "src/mbgl/util/mat4.hpp",
     "src/mbgl/util/math.hpp",
+    "src/mbgl/util/parallel.hpp",
     "src/mbgl/util/premultiply.cpp",
     "src/mbgl/util/quaternion.cpp",
     "src/mbgl/util/quaternion.hpp",
@@ -657,6 +668,7 @@ MLN_CORE_HEADERS = [
     "include/mbgl/annotation/annotation.hpp",
     "include/mbgl/gfx/backend_scope.hpp",
     "include/mbgl/gfx/gfx_types.hpp",
+    "include/mbgl/gfx/half_float.hpp",
     "include/mbgl/gfx/renderable.hpp",
     "include/mbgl/gfx/renderer_backend.hpp",
     "include/mbgl/gfx/rendering_stats.hpp",
@@ -818,6 +830,7 @@ MLN_CORE_HEADERS = [
     "include/mbgl/util/immutable.hpp",
     "include/mbgl/util/indexed_tuple.hpp",
     "include/mbgl/util/interpolate.hpp",
+    "include/mbgl/util/latency_histogram.hpp",
     "include/mbgl/util/logging.hpp",
     "include/mbgl/util/monotonic_timer.hpp",
     "include/mbgl/util/noncopyable.hpp",
@@ -862,6 +875,8 @@ MLN_OPENGL_SOURCE = [
     "src/mbgl/gl/enum.hpp",
     "src/mbgl/gl/extension.hpp",
     "src/mbgl/gl/framebuffer.hpp",
+    "src/mbgl/gl/framebuffer_readback.cpp",
+    "src/mbgl/gl/framebuffer_readback.hpp",
     "src/mbgl/gl/index_buffer_resource.cpp",
     "src/mbgl/gl/index_buffer_resource.hpp",
     "src/mbgl/gl/object.cpp",
@@ -869,6 +884,8 @@ MLN_OPENGL_SOURCE = [
     "src/mbgl/gl/offscreen_texture.cpp",
     "src/mbgl/gl/offscreen_texture.hpp",
     "src/mbgl/gl/program.hpp",
+    "src/mbgl/gl/program_binary_cache.cpp",
+    "src/mbgl/gl/program_binary_cache.hpp",
     "src/mbgl/gl/render_pass.cpp",
     "src/mbgl/gl/render_pass.hpp",
     "src/mbgl/gl/renderbuffer_resource.hpp",
@@ -998,9 +1015,13 @@ MLN_DRAWABLES_GL_SOURCE = [
     "src/mbgl/gl/drawable_gl.cpp",
     "src/mbgl/gl/drawable_gl_builder.cpp",
     "src/mbgl/gl/drawable_gl_impl.hpp",
+    "src/mbgl/gl/drawable_submission.cpp",
+    "src/mbgl/gl/drawable_submission.hpp",
     "src/mbgl/gl/layer_group_gl.cpp",
     "src/mbgl/gl/texture2d.cpp",
     "src/mbgl/gl/uniform_block_gl.cpp",
+    "src/mbgl/gl/uniform_buffer_allocator.cpp",
+    "src/mbgl/gl/uniform_buffer_allocator.hpp",
     "src/mbgl/gl/uniform_buffer_gl.cpp",
     "src/mbgl/gl/vertex_attribute_gl.cpp",
     "src/mbgl/shaders/gl/shader_program_gl.cpp",
@@ -4,6 +4,7 @@
 #include <mbgl/map/map_options.hpp>
 #include <mbgl/gfx/headless_frontend.hpp>
 #include <mbgl/renderer/renderer.hpp>
+#include <mbgl/renderer/query.hpp>
 #include <mbgl/style/style.hpp>
 #include <mbgl/style/image.hpp>
 #include <mbgl/storage/network_status.hpp>
@@ -86,8 +87,60 @@ static void API_queryRenderedFeaturesLayerFromHighDensity(::benchmark::State& st
         bench.frontend.getRenderer()->queryRenderedFeatures(bench.box, {{{"road-street"}}, {}});
     }
 }
+static void queryRenderedFeaturesAsync(QueryBenchmark& bench, const RenderedQueryOptions& options) {
+    bool done = false;
+    bench.frontend.getRenderer()->queryRenderedFeaturesAsync(
+        bench.box, options, [&](const std::vector<Feature>&) { done = true; });
+    while (!done) {
+        bench.loop.runOnce();
+    }
+}
+
+static void API_queryRenderedFeaturesAllAsync(::benchmark::State& state) {
+    QueryBenchmark bench;
+
+    while (state.KeepRunning()) {
+        queryRenderedFeaturesAsync(bench, {});
+    }
+}
+
+static void API_queryRenderedFeaturesLayerFromHighDensityAsync(::benchmark::State& state) {
+    QueryBenchmark bench;
+
+    while (state.KeepRunning()) {
+        queryRenderedFeaturesAsync(bench, {{{"road-street"}}, {}});
+    }
+}
+
+// Many small queries spread over every tile of the viewport, as issued by hover / click handlers.
+static void API_queryRenderedFeaturesPointGrid(::benchmark::State& state) {
+    QueryBenchmark bench;
+
+    while (state.KeepRunning()) {
+        for (double x = 50; x < 1000; x += 100) {
+            for (double y = 50; y < 1000; y += 100) {
+                bench.frontend.getRenderer()->queryRenderedFeatures(ScreenCoordinate{x, y}, {});
+            }
+        }
+    }
+}
+
+static void API_querySourceFeatures(::benchmark::State& state) {
+    QueryBenchmark bench;
+    SourceQueryOptions options;
+    options.sourceLayers = {{"building", "transportation", "poi"}};
+
+    while (state.KeepRunning()) {
+        bench.frontend.getRenderer()->querySourceFeatures("openmaptiles", options);
+    }
+}
+
 BENCHMARK(API_queryPixelsForLatLngs);
 BENCHMARK(API_queryLatLngsForPixels);
 BENCHMARK(API_queryRenderedFeaturesAll)->Iterations(50);
 BENCHMARK(API_queryRenderedFeaturesLayerFromLowDensity);
 BENCHMARK(API_queryRenderedFeaturesLayerFromHighDensity);
+BENCHMARK(API_queryRenderedFeaturesAllAsync)->Iterations(50);
+BENCHMARK(API_queryRenderedFeaturesLayerFromHighDensityAsync);
+BENCHMARK(API_queryRenderedFeaturesPointGrid);
+BENCHMARK(API_querySourceFeatures);
@@ -15,6 +15,12 @@
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/run_loop.hpp>
 
+#if MLN_RENDER_BACKEND_OPENGL && MLN_DRAWABLE_RENDERER
+#include <mbgl/gl/renderer_backend.hpp>
+
+#include <filesystem>
+#endif
+
 #include <sstream>
 #include <optional>
 
@@ -154,6 +160,57 @@ static void API_renderStill_multiple_sources(::benchmark::State& state) {
     }
 }
 
+#if MLN_RENDER_BACKEND_OPENGL && MLN_DRAWABLE_RENDERER
+namespace {
+
+const std::string programCacheDir{"benchmark/fixtures/api/program_cache"};
+
+void clearProgramCache() {
+    std::filesystem::remove_all(programCacheDir);
+    std::filesystem::create_directories(programCacheDir);
+}
+
+// Time to the first frame of a new renderer, which includes setting up all shader programs.
+void renderFirstFrame() {
+    HeadlessFrontend frontend{size, pixelRatio};
+    static_cast<gl::RendererBackend*>(frontend.getBackend())->setProgramCacheDir(programCacheDir);
+    Map map{frontend,
+            MapObserver::nullObserver(),
+            MapOptions().withMapMode(MapMode::Static).withSize(size).withPixelRatio(pixelRatio),
+            ResourceOptions().withCachePath(cachePath).withApiKey("foobar")};
+    prepare(map);
+    frontend.render(map);
+}
+
+} // namespace
+
+static void API_renderStill_program_cache_cold(::benchmark::State& state) {
+    RenderBenchmark bench;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        clearProgramCache();
+        state.ResumeTiming();
+        renderFirstFrame();
+    }
+    std::filesystem::remove_all(programCacheDir);
+}
+
+static void API_renderStill_program_cache_warm(::benchmark::State& state) {
+    RenderBenchmark bench;
+    clearProgramCache();
+    renderFirstFrame();
+
+    for (auto _ : state) {
+        renderFirstFrame();
+    }
+    std::filesystem::remove_all(programCacheDir);
+}
+
+BENCHMARK(API_renderStill_program_cache_cold)->Unit(benchmark::kMillisecond)->Iterations(20);
+BENCHMARK(API_renderStill_program_cache_warm)->Unit(benchmark::kMillisecond)->Iterations(20);
+#endif
+
 BENCHMARK(API_renderStill_reuse_map)->Unit(benchmark::kMillisecond)->Iterations(50);
 BENCHMARK(API_renderStill_reuse_map_formatted_labels)->Unit(benchmark::kMillisecond)->Iterations(50);
 BENCHMARK(API_renderStill_reuse_map_switch_styles)->Unit(benchmark::kMillisecond)->Iterations(50);
@@ -0,0 +1,78 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/map/camera.hpp>
+#include <mbgl/map/map_snapshotter_pool.hpp>
+#include <mbgl/storage/network_status.hpp>
+#include <mbgl/storage/resource_options.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+const std::string cachePath{"benchmark/fixtures/api/cache.db"};
+constexpr Size size{512, 512};
+constexpr std::size_t jobsPerIteration = 32;
+
+// Pans around Manhattan, so that jobs share most of their tiles like the
+// requests of a static map service do.
+CameraOptions cameraFor(std::size_t job) {
+    const double offset = static_cast<double>(job % 8) * 0.002;
+    return CameraOptions().withCenter(LatLng{40.726989 + offset, -73.992857 - offset}).withZoom(15.0);
+}
+
+} // namespace
+
+static void API_snapshotterPool(::benchmark::State& state) {
+    NetworkStatus::Set(NetworkStatus::Status::Offline);
+    util::RunLoop loop;
+
+    const auto poolSize = static_cast<std::size_t>(state.range(0));
+    MapSnapshotterPool pool(poolSize, 1.0f, ResourceOptions().withCachePath(cachePath).withApiKey("foobar"));
+    const std::string style = util::read_file("benchmark/fixtures/api/style.json");
+
+    std::size_t errors = 0;
+    auto run = [&] {
+        std::size_t remaining = jobsPerIteration;
+        for (std::size_t i = 0; i < jobsPerIteration; ++i) {
+            MapSnapshotterPool::Job job;
+            job.styleJSON = style;
+            job.size = size;
+            job.camera = cameraFor(i);
+            pool.snapshot(std::move(job),
+                          [&](std::exception_ptr error,
+                              PremultipliedImage image,
+                              MapSnapshotter::Attributions,
+                              MapSnapshotter::PointForFn,
+                              MapSnapshotter::LatLngForFn) {
+                              if (error) errors++;
+                              benchmark::DoNotOptimize(image.data.get());
+                              if (--remaining == 0) {
+                                  loop.stop();
+                              }
+                          });
+        }
+        loop.run();
+    };
+
+    // Warm up the renderers, so that only steady state throughput is measured.
+    run();
+
+    for (auto _ : state) {
+        run();
+    }
+
+    state.counters["snapshots/s"] = benchmark::Counter(
+        static_cast<double>(state.iterations() * jobsPerIteration), benchmark::Counter::kIsRate);
+    state.counters["errors"] = static_cast<double>(errors);
+}
+
+BENCHMARK(API_snapshotterPool)
+    ->ArgName("poolSize")
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -0,0 +1,269 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/layout/symbol_instance.hpp>
+#include <mbgl/util/constants.hpp>
+
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+const std::vector<std::u16string> names = {
+    u"Main Street", u"Pennsylvania Avenue Northwest", u"Broadway", u"Rue de Rivoli", u"Route 66"};
+
+// Symbols placed along lines repeat the feature's text at every anchor.
+constexpr std::size_t anchorsPerFeature = 3;
+
+std::vector<SymbolInstance> makeSymbolInstances(std::size_t count) {
+    const ShapedTextOrientations shaping{};
+    style::SymbolLayoutProperties::Evaluated layout;
+    const ImageMap imageMap;
+    const std::array<float, 2> offset{{0.0f, 0.0f}};
+    const auto placement = style::SymbolPlacementType::Point;
+
+    std::map<std::u16string, std::shared_ptr<const std::u16string>> keys;
+    std::vector<SymbolInstance> instances;
+    instances.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::size_t featureIndex = i / anchorsPerFeature;
+        const auto& name = names[featureIndex % names.size()];
+        auto& key = keys[name];
+        if (!key) {
+            key = std::make_shared<const std::u16string>(name);
+        }
+
+        Anchor anchor(static_cast<float>(i % util::EXTENT), static_cast<float>(i / util::EXTENT), 0, 0);
+        IndexedSubfeature subfeature(featureIndex, "transportation_name", "road-label", i);
+        auto sharedData = std::make_shared<SymbolInstanceSharedData>(GeometryCoordinates(),
+                                                                     shaping,
+                                                                     std::nullopt,
+                                                                     std::nullopt,
+                                                                     layout,
+                                                                     placement,
+                                                                     offset,
+                                                                     imageMap,
+                                                                     0.0f,
+                                                                     SymbolContent::None,
+                                                                     false,
+                                                                     false);
+        instances.emplace_back(anchor,
+                               std::move(sharedData),
+                               shaping,
+                               std::nullopt,
+                               std::nullopt,
+                               1.0f,
+                               0.0f,
+                               placement,
+                               offset,
+                               1.0f,
+                               0.0f,
+                               offset,
+                               subfeature,
+                               featureIndex,
+                               featureIndex,
+                               key,
+                               1.0f,
+                               0.0f,
+                               0.0f,
+                               offset,
+                               false);
+        instances.back().releaseSharedData();
+    }
+    return instances;
+}
+
+template <typename String>
+std::size_t heapBytes(const String& string) {
+    // Short strings are stored inline.
+    const auto* data = reinterpret_cast<const char*>(string.data());
+    const auto* object = reinterpret_cast<const char*>(&string);
+    if (data >= object && data < object + sizeof(String)) {
+        return 0;
+    }
+    return (string.capacity() + 1) * sizeof(typename String::value_type);
+}
+
+std::size_t heapBytes(const CollisionFeature& feature) {
+    return feature.boxes.capacity() * sizeof(CollisionBox);
+}
+
+// Field layout of SymbolInstance before its storage was compacted, kept to compare against. Each
+// collision feature held a copy of the indexed feature and each instance its own copy of the key.
+struct LegacyCollisionFeature {
+    std::vector<CollisionBox> boxes;
+    IndexedSubfeature indexedFeature;
+    bool alongLine;
+};
+
+struct LegacySymbolInstance {
+    std::shared_ptr<SymbolInstanceSharedData> sharedData;
+    Anchor anchor;
+    SymbolContent symbolContent;
+    std::size_t rightJustifiedGlyphQuadsSize;
+    std::size_t centerJustifiedGlyphQuadsSize;
+    std::size_t leftJustifiedGlyphQuadsSize;
+    std::size_t verticalGlyphQuadsSize;
+    std::size_t iconQuadsSize;
+    LegacyCollisionFeature textCollisionFeature;
+    LegacyCollisionFeature iconCollisionFeature;
+    std::optional<LegacyCollisionFeature> verticalTextCollisionFeature;
+    std::optional<LegacyCollisionFeature> verticalIconCollisionFeature;
+    WritingModeType writingModes;
+    std::size_t layoutFeatureIndex;
+    std::size_t dataFeatureIndex;
+    std::array<float, 2> textOffset;
+    std::array<float, 2> iconOffset;
+    std::u16string key;
+    bool isDuplicate;
+    std::optional<std::size_t> placedRightTextIndex;
+    std::optional<std::size_t> placedCenterTextIndex;
+    std::optional<std::size_t> placedLeftTextIndex;
+    std::optional<std::size_t> placedVerticalTextIndex;
+    std::optional<std::size_t> placedIconIndex;
+    std::optional<std::size_t> placedVerticalIconIndex;
+    float textBoxScale;
+    std::array<float, 2> variableTextOffset;
+    bool singleLine;
+    uint32_t crossTileID = 0;
+};
+
+std::vector<LegacySymbolInstance> makeLegacySymbolInstances(const std::vector<SymbolInstance>& instances) {
+    std::vector<LegacySymbolInstance> result;
+    result.reserve(instances.size());
+    for (const auto& instance : instances) {
+        const auto& feature = instance.indexedFeature;
+        const auto collisionFeature = [&](const CollisionFeature& collision) {
+            return LegacyCollisionFeature{collision.boxes, feature, collision.alongLine};
+        };
+        result.push_back({nullptr,
+                          instance.anchor,
+                          instance.symbolContent,
+                          instance.rightJustifiedGlyphQuadsSize,
+                          instance.centerJustifiedGlyphQuadsSize,
+                          instance.leftJustifiedGlyphQuadsSize,
+                          instance.verticalGlyphQuadsSize,
+                          instance.iconQuadsSize,
+                          collisionFeature(instance.textCollisionFeature),
+                          collisionFeature(instance.iconCollisionFeature),
+                          std::nullopt,
+                          std::nullopt,
+                          instance.writingModes,
+                          instance.layoutFeatureIndex,
+                          instance.dataFeatureIndex,
+                          instance.textOffset,
+                          instance.iconOffset,
+                          instance.key(),
+                          instance.isDuplicate,
+                          instance.placedRightTextIndex,
+                          instance.placedCenterTextIndex,
+                          instance.placedLeftTextIndex,
+                          instance.placedVerticalTextIndex,
+                          instance.placedIconIndex,
+                          instance.placedVerticalIconIndex,
+                          instance.textBoxScale,
+                          instance.variableTextOffset,
+                          instance.singleLine,
+                          instance.crossTileID});
+    }
+    return result;
+}
+
+std::size_t heapBytes(const LegacyCollisionFeature& feature) {
+    return feature.boxes.capacity() * sizeof(CollisionBox) + heapBytes(feature.indexedFeature.sourceLayerName) +
+           heapBytes(feature.indexedFeature.bucketLeaderID);
+}
+
+std::size_t bytesPerInstance(const std::vector<SymbolInstance>& instances) {
+    std::set<const std::u16string*> keys;
+    std::size_t bytes = sizeof(SymbolInstance) * instances.size();
+    for (const auto& instance : instances) {
+        bytes += heapBytes(instance.textCollisionFeature) + heapBytes(instance.iconCollisionFeature);
+        if (instance.verticalTextCollisionFeature) bytes += heapBytes(*instance.verticalTextCollisionFeature);
+        if (instance.verticalIconCollisionFeature) bytes += heapBytes(*instance.verticalIconCollisionFeature);
+        bytes += heapBytes(instance.indexedFeature.sourceLayerName);
+        bytes += heapBytes(instance.indexedFeature.bucketLeaderID);
+        if (keys.insert(&instance.key()).second) {
+            bytes += sizeof(std::u16string) + heapBytes(instance.key());
+        }
+    }
+    return bytes / instances.size();
+}
+
+std::size_t bytesPerInstance(const std::vector<LegacySymbolInstance>& instances) {
+    std::size_t bytes = sizeof(LegacySymbolInstance) * instances.size();
+    for (const auto& instance : instances) {
+        bytes += heapBytes(instance.textCollisionFeature) + heapBytes(instance.iconCollisionFeature);
+        if (instance.verticalTextCollisionFeature) bytes += heapBytes(*instance.verticalTextCollisionFeature);
+        if (instance.verticalIconCollisionFeature) bytes += heapBytes(*instance.verticalIconCollisionFeature);
+        bytes += heapBytes(instance.key);
+    }
+    return bytes / instances.size();
+}
+
+// Reads the fields that placement reads for every symbol, so that the time per item reflects how
+// many cache lines a pass over the bucket touches.
+template <typename Instance>
+float placementPass(const std::vector<Instance>& instances) {
+    float sum = 0.0f;
+    for (const auto& instance : instances) {
+        if (instance.crossTileID == 0 || instance.isDuplicate) continue;
+        sum += instance.anchor.point.x + instance.textBoxScale + instance.variableTextOffset[0];
+        sum += static_cast<float>(instance.textCollisionFeature.boxes.size());
+        if (instance.placedRightTextIndex) sum += static_cast<float>(*instance.placedRightTextIndex);
+    }
+    return sum;
+}
+
+} // namespace
+
+static void SymbolInstance_Memory(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    std::size_t bytes = 0;
+    std::size_t bytesBefore = 0;
+
+    for (auto _ : state) {
+        const auto instances = makeSymbolInstances(count);
+
+        state.PauseTiming();
+        bytes = bytesPerInstance(instances);
+        bytesBefore = bytesPerInstance(makeLegacySymbolInstances(instances));
+        state.ResumeTiming();
+    }
+
+    state.counters["sizeof"] = static_cast<double>(sizeof(SymbolInstance));
+    state.counters["sizeofBefore"] = static_cast<double>(sizeof(LegacySymbolInstance));
+    state.counters["bytesPerInstance"] = static_cast<double>(bytes);
+    state.counters["bytesPerInstanceBefore"] = static_cast<double>(bytesBefore);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+static void SymbolInstance_PlacementPass(benchmark::State& state) {
+    auto instances = makeSymbolInstances(static_cast<std::size_t>(state.range(0)));
+    for (auto& instance : instances) instance.crossTileID = 1;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(placementPass(instances));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void SymbolInstance_PlacementPassBefore(benchmark::State& state) {
+    auto instances = makeSymbolInstances(static_cast<std::size_t>(state.range(0)));
+    for (auto& instance : instances) instance.crossTileID = 1;
+    const auto legacyInstances = makeLegacySymbolInstances(instances);
+    instances.clear();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(placementPass(legacyInstances));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(SymbolInstance_Memory)->Arg(1000)->Arg(10000);
+BENCHMARK(SymbolInstance_PlacementPass)->Arg(10000)->Arg(100000);
+BENCHMARK(SymbolInstance_PlacementPassBefore)->Arg(10000)->Arg(100000);
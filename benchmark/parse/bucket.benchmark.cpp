@@ -0,0 +1,259 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/layermanager/layer_manager.hpp>
+#include <mbgl/renderer/bucket_parameters.hpp>
+#include <mbgl/renderer/buckets/fill_bucket.hpp>
+#include <mbgl/renderer/buckets/heatmap_bucket.hpp>
+#include <mbgl/renderer/buckets/line_bucket.hpp>
+#include <mbgl/renderer/property_evaluation_parameters.hpp>
+#include <mbgl/renderer/render_layer.hpp>
+#include <mbgl/renderer/transition_parameters.hpp>
+#include <mbgl/style/conversion/json.hpp>
+#include <mbgl/style/conversion/layer.hpp>
+#include <mbgl/style/layers/fill_layer_impl.hpp>
+#include <mbgl/style/layers/fill_layer_properties.hpp>
+#include <mbgl/style/layers/line_layer_impl.hpp>
+#include <mbgl/style/layers/line_layer_properties.hpp>
+#include <mbgl/tile/vector_tile_data.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <cassert>
+#include <limits>
+#include <random>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+namespace {
+
+constexpr float zoom = 10.0f;
+const CanonicalTileID tileID{10, 163, 395};
+
+// Data-driven colors, opacities, blurs and widths, which are stored as paint attributes per vertex.
+const char* fillLayers[] = {
+    R"JSON({"id": "landcover", "type": "fill", "source": "streets", "source-layer": "landcover", "paint": {
+        "fill-color": ["match", ["get", "class"], "wood", "#6a4", "scrub", "#9b6", "grass", "#ad8", "#cdb"],
+        "fill-outline-color": ["match", ["get", "class"], "wood", "#593", "#bca"],
+        "fill-opacity": ["match", ["get", "class"], "wood", 0.8, 0.6]}})JSON",
+    R"JSON({"id": "landuse", "type": "fill", "source": "streets", "source-layer": "landuse", "paint": {
+        "fill-color": ["interpolate", ["linear"], ["zoom"],
+            8, ["match", ["get", "class"], "park", "#cec", "#eee"],
+            14, ["match", ["get", "class"], "park", "#bdb", "#ddd"]],
+        "fill-opacity": ["interpolate", ["linear"], ["zoom"],
+            8, ["match", ["get", "class"], "park", 0.5, 0.3],
+            14, ["match", ["get", "class"], "park", 1, 0.6]]}})JSON",
+    R"JSON({"id": "water", "type": "fill", "source": "streets", "source-layer": "water", "paint": {
+        "fill-color": "#8be"}})JSON",
+};
+
+const char* lineLayers[] = {
+    R"JSON({"id": "road", "type": "line", "source": "streets", "source-layer": "road", "paint": {
+        "line-color": ["match", ["get", "class"], "motorway", "#fa6", "main", "#fd8", "#fff"],
+        "line-width": ["interpolate", ["exponential", 1.5], ["zoom"],
+            5, ["match", ["get", "class"], "motorway", 1, 0.5],
+            18, ["match", ["get", "class"], "motorway", 30, 12]],
+        "line-opacity": ["interpolate", ["linear"], ["zoom"],
+            5, ["match", ["get", "class"], "motorway", 0.8, 0.4],
+            18, ["match", ["get", "class"], "motorway", 1, 0.9]]}})JSON",
+    R"JSON({"id": "contour", "type": "line", "source": "streets", "source-layer": "contour", "paint": {
+        "line-color": ["match", ["get", "index"], 5, "#a98", "#cba"],
+        "line-blur": ["match", ["get", "index"], 5, 0, 0.5]}})JSON",
+};
+
+Immutable<LayerProperties> evaluate(const char* json) {
+    conversion::Error error;
+    auto layer = conversion::convertJSON<std::unique_ptr<Layer>>(std::string(json), error);
+    assert(layer);
+    auto renderLayer = LayerManager::get()->createRenderLayer((*layer)->baseImpl);
+    renderLayer->transition(TransitionParameters{Clock::now(), TransitionOptions()});
+    renderLayer->evaluate(PropertyEvaluationParameters(zoom));
+    return renderLayer->evaluatedProperties;
+}
+
+struct BucketBytes {
+    std::size_t vertices = 0;
+    std::size_t indices = 0;
+    std::size_t paint = 0;
+    /// Bytes of the paint attributes that MLN_COMPACT_PAINT_ATTRIBUTES stores as 16 bit
+    /// values: as stored in this build, with floats and with 16 bit values
+    std::size_t compactable = 0;
+    std::size_t compactableAsFloats = 0;
+    std::size_t compactableAs16Bit = 0;
+
+    std::size_t paintDefault() const { return paint - compactable + compactableAsFloats; }
+    std::size_t paintCompact() const { return paint - compactable + compactableAs16Bit; }
+};
+
+template <class Bucket, class LayerImpl>
+std::shared_ptr<Bucket> createBucket(const Immutable<LayerProperties>& properties, const VectorTileData& tile) {
+    const auto& impl = static_cast<const LayerImpl&>(*properties->baseImpl);
+    auto bucket = std::make_shared<Bucket>(impl.layout.evaluate(PropertyEvaluationParameters(zoom)),
+                                           std::map<std::string, Immutable<LayerProperties>>{{impl.id, properties}},
+                                           zoom,
+                                           1);
+    if (auto layer = tile.getLayer(impl.sourceLayer)) {
+        for (std::size_t i = 0; i < layer->featureCount(); ++i) {
+            auto feature = layer->getFeature(i);
+            bucket->addFeature(*feature, feature->getGeometries(), {}, PatternLayerMap(), i, tileID);
+        }
+    }
+    return bucket;
+}
+
+template <class Bucket>
+std::size_t paintBytes(const Bucket& bucket) {
+    std::size_t bytes = 0;
+    for (const auto& binders : bucket.paintPropertyBinders) {
+        bytes += binders.second.vertexBytes();
+    }
+    return bytes;
+}
+
+// Size of a paint vertex holding values of the given size, padded to the 4 byte alignment of vertices
+constexpr std::size_t paddedVertexSize(std::size_t values, std::size_t valueSize) {
+    return (values * valueSize + 3) / 4 * 4;
+}
+
+template <class Property, class Binder>
+void addCompactable(BucketBytes& result, const Binder& binder) {
+    const auto& vector = binder.getSharedVertexVector();
+    if (!vector) {
+        return;
+    }
+    const std::size_t values = Property::Attribute::Type::Dimensions * (binder.isInterpolated() ? 2 : 1);
+    result.compactable += vector->getRawSize() * vector->getRawCount();
+    result.compactableAsFloats += paddedVertexSize(values, sizeof(float)) * vector->getRawCount();
+    result.compactableAs16Bit += paddedVertexSize(values, sizeof(uint16_t)) * vector->getRawCount();
+}
+
+template <class... Properties, class Bucket>
+void addCompactable(BucketBytes& result, const Bucket& bucket) {
+    for (const auto& binders : bucket.paintPropertyBinders) {
+        (addCompactable<Properties>(result, *binders.second.template get<Properties>()), ...);
+    }
+}
+
+class PointsFeature : public GeometryTileFeature {
+public:
+    explicit PointsFeature(GeometryCollection geometry_)
+        : geometry(std::move(geometry_)) {}
+
+    FeatureType getType() const override { return FeatureType::Point; }
+    std::optional<Value> getValue(const std::string&) const override { return std::nullopt; }
+    const GeometryCollection& getGeometries() const override { return geometry; }
+
+private:
+    GeometryCollection geometry;
+};
+
+// Clusters of points spread around a few centers, like the dense point sets heatmaps are used for.
+GeometryCollection clusteredPoints(std::size_t count) {
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> center(1024, util::EXTENT - 1024);
+    std::normal_distribution<float> spread(0.0f, 256.0f);
+
+    GeometryCoordinates points;
+    points.reserve(count);
+    Point<int16_t> clusterCenter;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (i % 65536 == 0) {
+            clusterCenter = {static_cast<int16_t>(center(generator)), static_cast<int16_t>(center(generator))};
+        }
+        points.emplace_back(static_cast<int16_t>(clusterCenter.x + spread(generator)),
+                            static_cast<int16_t>(clusterCenter.y + spread(generator)));
+    }
+    return {std::move(points)};
+}
+
+BucketBytes bytes(const FillBucket& bucket) {
+    BucketBytes result;
+    result.vertices = bucket.vertices.bytes();
+    result.indices = bucket.triangles.bytes() + bucket.basicLines.bytes();
+#if MLN_TRIANGULATE_FILL_OUTLINES
+    result.vertices += bucket.lineVertices.bytes();
+    result.indices += bucket.lineIndexes.bytes();
+#endif
+    result.paint = paintBytes(bucket);
+    addCompactable<FillColor, FillOutlineColor, FillOpacity>(result, bucket);
+    return result;
+}
+
+BucketBytes bytes(const LineBucket& bucket) {
+    BucketBytes result;
+    result.vertices = bucket.vertices.bytes();
+    result.indices = bucket.triangles.bytes();
+    result.paint = paintBytes(bucket);
+    addCompactable<LineColor, LineOpacity, LineBlur>(result, bucket);
+    return result;
+}
+
+} // namespace
+
+// Builds the fill and line buckets of a tile, and reports the memory their
+// vertex and index data take up. The paint bytes are reported both with floats
+// and with the 16 bit colors, opacities and blurs of MLN_COMPACT_PAINT_ATTRIBUTES.
+static void Parse_Buckets(benchmark::State& state) {
+    const VectorTileData tile(
+        std::make_shared<std::string>(util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf")));
+
+    std::vector<Immutable<LayerProperties>> fills;
+    for (const auto* json : fillLayers) {
+        fills.push_back(evaluate(json));
+    }
+    std::vector<Immutable<LayerProperties>> lines;
+    for (const auto* json : lineLayers) {
+        lines.push_back(evaluate(json));
+    }
+
+    BucketBytes total;
+    for (auto _ : state) {
+        total = {};
+        auto add = [&](const BucketBytes& bucket) {
+            total.vertices += bucket.vertices;
+            total.indices += bucket.indices;
+            total.paint += bucket.paint;
+            total.compactable += bucket.compactable;
+            total.compactableAsFloats += bucket.compactableAsFloats;
+            total.compactableAs16Bit += bucket.compactableAs16Bit;
+        };
+        for (const auto& properties : fills) {
+            add(bytes(*createBucket<FillBucket, FillLayer::Impl>(properties, tile)));
+        }
+        for (const auto& properties : lines) {
+            add(bytes(*createBucket<LineBucket, LineLayer::Impl>(properties, tile)));
+        }
+    }
+
+    const std::size_t paintDefault = total.paintDefault();
+    const std::size_t paintCompact = total.paintCompact();
+    state.counters["layout_bytes"] = static_cast<double>(total.vertices);
+    state.counters["index_bytes"] = static_cast<double>(total.indices);
+    state.counters["paint_bytes_default"] = static_cast<double>(paintDefault);
+    state.counters["paint_bytes_compact"] = static_cast<double>(paintCompact);
+    state.counters["bytes_per_tile_default"] = static_cast<double>(total.vertices + total.indices + paintDefault);
+    state.counters["bytes_per_tile_compact"] = static_cast<double>(total.vertices + total.indices + paintCompact);
+}
+
+BENCHMARK(Parse_Buckets);
+
+// Builds the heatmap bucket of a tile with a million points, either with a quad
+// per point (0) or with the points merged into the cells of a grid (1).
+static void Parse_HeatmapBucket(benchmark::State& state) {
+    const PointsFeature feature(clusteredPoints(1 << 20));
+    const auto properties = evaluate(R"JSON({"id": "heatmap", "type": "heatmap", "source": "points"})JSON");
+    const BucketParameters parameters{OverscaledTileID(10, 163, 395), MapMode::Continuous, 1.0f, nullptr};
+    const std::size_t threshold = state.range(0) ? HeatmapBucket::defaultBinningThreshold
+                                                 : std::numeric_limits<std::size_t>::max();
+
+    std::size_t vertices = 0;
+    for (auto _ : state) {
+        HeatmapBucket bucket(parameters, {properties}, threshold);
+        bucket.addFeature(feature, feature.getGeometries(), {}, PatternLayerMap(), 0, tileID);
+        bucket.finalize();
+        vertices = bucket.vertices.elements();
+    }
+
+    state.counters["vertices"] = static_cast<double>(vertices);
+}
+
+BENCHMARK(Parse_HeatmapBucket)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
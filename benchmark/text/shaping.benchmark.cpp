@@ -0,0 +1,123 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/text/bidi.hpp>
+#include <mbgl/text/shaping.hpp>
+#include <mbgl/text/shaping_cache.hpp>
+#include <mbgl/tile/vector_tile_data.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/utf.hpp>
+
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+const std::vector<std::string> fontStack{{"Open Sans Regular"}};
+
+// Tiles of different zoom levels and places, which share some of their labels, like the tiles
+// of one map view do.
+const char* const tilePaths[] = {
+    "metrics/integration/tiles/mapbox.mapbox-streets-v7/0-0-0.mvt",
+    "metrics/integration/tiles/mapbox.mapbox-streets-v7/4-4-7.mvt",
+    "metrics/integration/tiles/mapbox.mapbox-streets-v7/4-5-7.mvt",
+    "metrics/integration/tiles/mapbox.mapbox-streets-v7/10-175-409.mvt",
+    "test/fixtures/api/assets/streets/10-163-395.vector.pbf",
+    "metrics/integration/tiles/mapbox.mapbox-streets-v7/11-351-818.mvt",
+    "metrics/integration/tiles/mapbox.mapbox-streets-v7/16-11235-26208.mvt",
+};
+
+std::vector<std::u16string> readLabels(const std::string& path) {
+    VectorTileData tile(std::make_shared<std::string>(util::read_file(path)));
+    std::vector<std::u16string> labels;
+    for (const auto* name : {"place_label", "water_label", "poi_label", "road_label"}) {
+        auto layer = tile.getLayer(name);
+        if (!layer) continue;
+        for (std::size_t i = 0; i < layer->featureCount(); ++i) {
+            const auto value = layer->getFeature(i)->getValue("name");
+            if (value && value->is<std::string>()) {
+                labels.push_back(util::convertUTF8ToUTF16(value->get<std::string>()));
+            }
+        }
+    }
+    return labels;
+}
+
+// Every code point gets the same metrics, only the shaping work matters here.
+GlyphMap makeGlyphs(const std::vector<std::vector<std::u16string>>& tiles) {
+    Glyphs glyphs;
+    for (const auto& labels : tiles) {
+        for (const auto& label : labels) {
+            for (const char16_t codePoint : label) {
+                if (glyphs.count(codePoint)) continue;
+                Glyph glyph;
+                glyph.id = codePoint;
+                glyph.metrics.width = 14;
+                glyph.metrics.height = 18;
+                glyph.metrics.advance = 12;
+                glyphs.emplace(codePoint, Immutable<Glyph>(makeMutable<Glyph>(std::move(glyph))));
+            }
+        }
+    }
+    return {{FontStackHasher()(fontStack), std::move(glyphs)}};
+}
+
+} // namespace
+
+static void Shaping_StreetsTiles(benchmark::State& state) {
+    // The cache starts empty for each pass over the tiles, so that it only helps with the labels
+    // that repeat within and across the tiles, as when a map view is first loaded.
+    std::vector<std::vector<std::u16string>> tiles;
+    for (const auto* path : tilePaths) {
+        tiles.push_back(readLabels(path));
+    }
+    const GlyphMap glyphMap = makeGlyphs(tiles);
+    const GlyphPositions glyphPositions;
+    const ImagePositions imagePositions;
+    const SectionOptions sectionOptions(1.0, fontStack);
+    BiDi bidi;
+    ShapingCache cache(ShapingCache::defaultMaxEntries);
+    ShapingCache* const shapingCache = state.range(0) ? &cache : nullptr;
+
+    std::size_t labelCount = 0;
+    for (const auto& labels : tiles) {
+        labelCount += labels.size();
+    }
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        cache.clear();
+        state.ResumeTiming();
+
+        for (const auto& labels : tiles) {
+            for (const auto& label : labels) {
+                const TaggedString string(label, sectionOptions);
+                auto shaping = getShaping(string,
+                                          10 * util::ONE_EM,
+                                          1.2f * util::ONE_EM,
+                                          style::SymbolAnchorType::Center,
+                                          style::TextJustifyType::Center,
+                                          0.0f,
+                                          {{0.0f, 0.0f}},
+                                          WritingModeType::Horizontal,
+                                          bidi,
+                                          glyphMap,
+                                          glyphPositions,
+                                          imagePositions,
+                                          16.0f,
+                                          16.0f,
+                                          false,
+                                          shapingCache);
+                benchmark::DoNotOptimize(shaping);
+            }
+        }
+    }
+
+    state.counters["tiles"] = static_cast<double>(tiles.size());
+    state.counters["labels"] = static_cast<double>(labelCount);
+    state.counters["hitRate"] = cache.getStats().hitRate();
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(labelCount));
+}
+
+BENCHMARK(Shaping_StreetsTiles)->ArgName("cache")->Arg(0)->Arg(1);
@@ -0,0 +1,509 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/geometry/feature_index.hpp>
+#include <mbgl/layermanager/layer_manager.hpp>
+#include <mbgl/layout/layout.hpp>
+#include <mbgl/layout/symbol_projection.hpp>
+#include <mbgl/map/transform_state.hpp>
+#include <mbgl/renderer/bucket.hpp>
+#include <mbgl/renderer/bucket_parameters.hpp>
+#include <mbgl/renderer/buckets/symbol_bucket.hpp>
+#include <mbgl/renderer/property_evaluation_parameters.hpp>
+#include <mbgl/renderer/render_layer.hpp>
+#include <mbgl/renderer/transition_parameters.hpp>
+#include <mbgl/style/conversion/json.hpp>
+#include <mbgl/style/conversion/layer.hpp>
+#include <mbgl/style/layer_impl.hpp>
+#include <mbgl/text/collision_index.hpp>
+#include <mbgl/text/glyph_atlas.hpp>
+#include <mbgl/text/shaping_cache.hpp>
+#include <mbgl/tile/vector_tile_data.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/mat4.hpp>
+#include <mbgl/util/projection.hpp>
+
+#if MLN_RENDER_BACKEND_OPENGL
+#include <mbgl/gfx/backend_scope.hpp>
+#include <mbgl/gl/context.hpp>
+#include <mbgl/gl/headless_backend.hpp>
+#include <mbgl/renderer/buckets/fill_bucket.hpp>
+#include <mbgl/renderer/buckets/line_bucket.hpp>
+#endif
+
+#include <cassert>
+#include <cmath>
+#include <deque>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+// The stages of the worker's tile pipeline, in the order a tile goes through them, measured on
+// the same corpus of real tiles. The mbgl-benchmark-tile-pipeline target writes them to a JSON
+// report, so that each stage can be tracked over time.
+
+namespace {
+
+struct CorpusTile {
+    const char* path;
+    uint8_t z;
+    uint32_t x;
+    uint32_t y;
+};
+
+// Tiles from low to high zoom levels, from sparse countryside to dense city centers.
+const CorpusTile corpus[] = {
+    {"metrics/integration/tiles/mapbox.mapbox-streets-v7/0-0-0.mvt", 0, 0, 0},
+    {"metrics/integration/tiles/mapbox.mapbox-streets-v7/4-4-7.mvt", 4, 4, 7},
+    {"metrics/integration/tiles/mapbox.mapbox-streets-v7/4-5-7.mvt", 4, 5, 7},
+    {"metrics/integration/tiles/mapbox.mapbox-streets-v7/10-175-409.mvt", 10, 175, 409},
+    {"test/fixtures/api/assets/streets/10-163-395.vector.pbf", 10, 163, 395},
+    {"metrics/integration/tiles/mapbox.mapbox-streets-v7/11-351-818.mvt", 11, 351, 818},
+    {"metrics/integration/tiles/mapbox.mapbox-streets-v7/16-11235-26208.mvt", 16, 11235, 26208},
+};
+
+const char* layers[] = {
+    R"JSON({"id": "landcover", "type": "fill", "source": "streets", "source-layer": "landcover", "paint": {
+        "fill-color": ["match", ["get", "class"], "wood", "#6a4", "scrub", "#9b6", "#ad8"]}})JSON",
+    R"JSON({"id": "landuse", "type": "fill", "source": "streets", "source-layer": "landuse",
+        "filter": ["match", ["get", "class"], ["park", "cemetery", "hospital", "school"], true, false],
+        "paint": {"fill-color": "#cec"}})JSON",
+    R"JSON({"id": "water", "type": "fill", "source": "streets", "source-layer": "water", "paint": {
+        "fill-color": "#8be"}})JSON",
+    R"JSON({"id": "building", "type": "fill", "source": "streets", "source-layer": "building", "paint": {
+        "fill-color": "#ddd", "fill-outline-color": "#ccc"}})JSON",
+    R"JSON({"id": "contour", "type": "line", "source": "streets", "source-layer": "contour",
+        "filter": ["==", ["get", "index"], 5], "paint": {"line-color": "#cba"}})JSON",
+    R"JSON({"id": "road", "type": "line", "source": "streets", "source-layer": "road",
+        "filter": ["match", ["get", "class"], ["path", "track"], false, true],
+        "layout": {"line-join": "round", "line-cap": "round"}, "paint": {
+        "line-color": ["match", ["get", "class"], "motorway", "#fa6", "main", "#fd8", "#fff"],
+        "line-width": ["interpolate", ["exponential", 1.5], ["zoom"], 5, 0.5, 18, 20]}})JSON",
+    R"JSON({"id": "admin", "type": "line", "source": "streets", "source-layer": "admin",
+        "filter": ["all", ["==", ["get", "maritime"], 0], ["<=", ["get", "admin_level"], 4]],
+        "layout": {"line-join": "round"}, "paint": {"line-color": "#98a", "line-dasharray": [2, 1]}})JSON",
+    R"JSON({"id": "road-label", "type": "symbol", "source": "streets", "source-layer": "road_label", "layout": {
+        "symbol-placement": "line", "text-field": ["get", "name"], "text-font": ["Open Sans Regular"],
+        "text-size": 12}})JSON",
+    R"JSON({"id": "poi-label", "type": "symbol", "source": "streets", "source-layer": "poi_label",
+        "filter": ["<=", ["get", "scalerank"], 3], "layout": {
+        "text-field": ["get", "name"], "text-font": ["Open Sans Regular"], "text-size": 12,
+        "text-anchor": "top", "text-offset": [0, 0.5]}})JSON",
+    R"JSON({"id": "place-label", "type": "symbol", "source": "streets", "source-layer": "place_label",
+        "filter": ["match", ["get", "type"], ["city", "town", "village", "suburb"], true, false], "layout": {
+        "text-field": ["get", "name"], "text-font": ["Open Sans Regular"], "text-max-width": 8,
+        "text-size": ["interpolate", ["linear"], ["zoom"], 4, 12, 12, 18]}})JSON",
+    R"JSON({"id": "country-label", "type": "symbol", "source": "streets", "source-layer": "country_label",
+        "layout": {"text-field": ["get", "name_en"], "text-font": ["Open Sans Regular"],
+        "text-transform": "uppercase", "text-size": 14}})JSON",
+};
+
+Immutable<LayerProperties> evaluate(const char* json, float zoom) {
+    conversion::Error error;
+    auto layer = conversion::convertJSON<std::unique_ptr<Layer>>(std::string(json), error);
+    assert(layer);
+    auto renderLayer = LayerManager::get()->createRenderLayer((*layer)->baseImpl);
+    renderLayer->transition(TransitionParameters{Clock::now(), TransitionOptions()});
+    renderLayer->evaluate(PropertyEvaluationParameters(zoom));
+    return renderLayer->evaluatedProperties;
+}
+
+struct PipelineTile {
+    explicit PipelineTile(const CorpusTile& tile)
+        : id(tile.z, tile.x, tile.y),
+          raw(std::make_shared<std::string>(util::read_file(tile.path))),
+          data(raw) {
+        for (const auto* json : layers) {
+            auto properties = evaluate(json, id.overscaledZ);
+            if (properties->baseImpl->getTypeInfo()->layout == LayerTypeInfo::Layout::Required) {
+                symbolLayers.push_back(std::move(properties));
+            } else {
+                geometryLayers.push_back(std::move(properties));
+            }
+        }
+    }
+
+    BucketParameters bucketParameters(const Layer::Impl& impl) const {
+        return {id, MapMode::Continuous, 1.0f, impl.getTypeInfo()};
+    }
+
+    const OverscaledTileID id;
+    const std::shared_ptr<const std::string> raw;
+    const VectorTileData data;
+    std::vector<Immutable<LayerProperties>> geometryLayers;
+    std::vector<Immutable<LayerProperties>> symbolLayers;
+};
+
+// Tiles can't be moved, as their data keeps its parsed layers in place.
+std::deque<PipelineTile> loadCorpus() {
+    std::deque<PipelineTile> tiles;
+    for (const auto& tile : corpus) {
+        tiles.emplace_back(tile);
+    }
+    return tiles;
+}
+
+bool passes(const Filter& filter, const GeometryTileFeature& feature, const OverscaledTileID& id) {
+    return filter(expression::EvaluationContext(static_cast<float>(id.overscaledZ), &feature)
+                      .withCanonicalTileID(&id.canonical));
+}
+
+struct SymbolLayouts {
+    std::vector<std::unique_ptr<Layout>> layouts;
+    GlyphDependencies glyphDependencies;
+};
+
+// Evaluates the text of the symbol features and collects the glyphs they need.
+SymbolLayouts layoutSymbols(const PipelineTile& tile) {
+    SymbolLayouts result;
+    ImageDependencies imageDependencies;
+    std::set<std::string> availableImages;
+    for (const auto& properties : tile.symbolLayers) {
+        const auto parameters = tile.bucketParameters(*properties->baseImpl);
+        if (auto sourceLayer = tile.data.getLayer(properties->baseImpl->sourceLayer)) {
+            result.layouts.push_back(LayerManager::get()->createLayout(
+                {parameters, result.glyphDependencies, imageDependencies, availableImages},
+                std::move(sourceLayer),
+                {properties}));
+        }
+    }
+    return result;
+}
+
+// Every code point gets the same metrics, only the layout work matters here.
+GlyphMap makeGlyphs(const GlyphDependencies& dependencies) {
+    GlyphMap glyphMap;
+    for (const auto& dependency : dependencies) {
+        auto& glyphs = glyphMap[FontStackHasher()(dependency.first)];
+        for (const GlyphID id : dependency.second) {
+            Glyph glyph;
+            glyph.id = id;
+            glyph.metrics.width = 14;
+            glyph.metrics.height = 18;
+            glyph.metrics.advance = 12;
+            glyph.bitmap = AlphaImage(
+                {glyph.metrics.width + 2 * Glyph::borderSize, glyph.metrics.height + 2 * Glyph::borderSize});
+            glyphs.emplace(id, Immutable<Glyph>(makeMutable<Glyph>(std::move(glyph))));
+        }
+    }
+    return glyphMap;
+}
+
+struct ShapedSymbols {
+    SymbolLayouts symbols;
+    GlyphMap glyphMap;
+    GlyphAtlas glyphAtlas;
+};
+
+// Each tile gets a cache of its own, as if it were the first one shaped with its glyphs, so that
+// only the labels repeated within a tile are shaped once.
+ShapedSymbols shapeSymbols(const PipelineTile& tile) {
+    ShapedSymbols result{layoutSymbols(tile), {}, {}};
+    result.glyphMap = makeGlyphs(result.symbols.glyphDependencies);
+    result.glyphAtlas = makeGlyphAtlas(result.glyphMap);
+    ShapingCache shapingCache(ShapingCache::defaultMaxEntries);
+    for (auto& layout : result.symbols.layouts) {
+        layout->prepareSymbols(result.glyphMap, result.glyphAtlas.positions, {}, {}, &shapingCache);
+    }
+    return result;
+}
+
+std::vector<std::unique_ptr<Bucket>> createGeometryBuckets(const PipelineTile& tile) {
+    std::vector<std::unique_ptr<Bucket>> buckets;
+    for (const auto& properties : tile.geometryLayers) {
+        const auto& impl = *properties->baseImpl;
+        auto layer = tile.data.getLayer(impl.sourceLayer);
+        if (!layer) continue;
+
+        auto bucket = LayerManager::get()->createBucket(tile.bucketParameters(impl), {properties});
+        for (std::size_t i = 0; i < layer->featureCount(); ++i) {
+            auto feature = layer->getFeature(i);
+            if (!passes(impl.filter, *feature, tile.id)) continue;
+            bucket->addFeature(*feature, feature->getGeometries(), {}, PatternLayerMap(), i, tile.id.canonical);
+        }
+        bucket->finalize();
+        buckets.push_back(std::move(bucket));
+    }
+    return buckets;
+}
+
+std::vector<std::shared_ptr<Bucket>> createSymbolBuckets(const PipelineTile& tile, ShapedSymbols& shaped) {
+    auto featureIndex = std::make_unique<FeatureIndex>(nullptr);
+    mbgl::unordered_map<std::string, LayerRenderData> renderData;
+    for (auto& layout : shaped.symbols.layouts) {
+        if (layout->hasSymbolInstances()) {
+            layout->createBucket({}, featureIndex, renderData, true, false, tile.id.canonical);
+        }
+    }
+
+    std::vector<std::shared_ptr<Bucket>> buckets;
+    for (auto& entry : renderData) {
+        buckets.push_back(std::move(entry.second.bucket));
+    }
+    return buckets;
+}
+
+// Places the text of every symbol into a collision index, looking straight down on the tile
+// at its own zoom level.
+std::size_t placeSymbols(const PipelineTile& tile, const std::vector<std::shared_ptr<Bucket>>& buckets) {
+    const double scale = std::pow(2.0, tile.id.canonical.z);
+    TransformState state;
+    state.setSize({util::tileSize_I, util::tileSize_I});
+    state.setLatLngZoom(Projection::unproject({(tile.id.canonical.x + 0.5) * util::tileSize_D,
+                                               (tile.id.canonical.y + 0.5) * util::tileSize_D},
+                                              scale),
+                        tile.id.canonical.z);
+
+    mat4 projMatrix;
+    state.getProjMatrix(projMatrix);
+    mat4 posMatrix;
+    state.matrixFor(posMatrix, tile.id.toUnwrapped());
+    matrix::multiply(posMatrix, projMatrix, posMatrix);
+
+    const auto zoom = static_cast<float>(state.getZoom());
+    const float pixelRatio = static_cast<float>(util::tileSize_D / util::EXTENT);
+    CollisionIndex collisionIndex(state, MapMode::Continuous);
+    std::vector<ProjectedCollisionBox> boxes;
+    std::size_t placed = 0;
+    for (const auto& bucket : buckets) {
+        const auto& symbolBucket = static_cast<const SymbolBucket&>(*bucket);
+        const auto& layout = *symbolBucket.layout;
+        const bool pitchWithMap = layout.get<TextPitchAlignment>() == AlignmentType::Map;
+        const bool rotateWithMap = layout.get<TextRotationAlignment>() == AlignmentType::Map;
+        const auto labelPlaneMatrix = getLabelPlaneMatrix(
+            posMatrix, pitchWithMap, rotateWithMap, state, tile.id.toUnwrapped().pixelsToTileUnits(1.0f, zoom));
+        const auto textSize = symbolBucket.textSizeBinder->evaluateForZoom(zoom);
+
+        for (const auto& symbol : symbolBucket.symbolInstances) {
+            const auto& feature = symbol.textCollisionFeature;
+            const auto index = symbol.placedCenterTextIndex ? symbol.placedCenterTextIndex
+                                                            : symbol.placedRightTextIndex;
+            if (feature.boxes.empty() || !index) continue;
+
+            const auto& placedSymbol = symbolBucket.text.placedSymbols[*index];
+            boxes.clear();
+            const auto result = collisionIndex.placeFeature(feature,
+                                                            {},
+                                                            posMatrix,
+                                                            labelPlaneMatrix,
+                                                            pixelRatio,
+                                                            placedSymbol,
+                                                            1.0f,
+                                                            evaluateSizeForFeature(textSize, placedSymbol),
+                                                            false,
+                                                            pitchWithMap,
+                                                            false,
+                                                            std::nullopt,
+                                                            std::nullopt,
+                                                            boxes);
+            if (result.first) {
+                collisionIndex.insertFeature(
+                    feature, symbol.indexedFeature, boxes, false, symbolBucket.bucketInstanceId, 0);
+                placed++;
+            }
+        }
+    }
+    return placed;
+}
+
+} // namespace
+
+// Decodes the protobuf of each tile, with the geometries and properties of all features.
+static void TilePipeline_Decode(benchmark::State& state) {
+    const auto tiles = loadCorpus();
+
+    std::size_t features = 0;
+    for (auto _ : state) {
+        features = 0;
+        for (const auto& tile : tiles) {
+            const VectorTileData data(tile.raw);
+            for (const auto& name : data.layerNames()) {
+                auto layer = data.getLayer(name);
+                for (std::size_t i = 0; layer && i < layer->featureCount(); ++i) {
+                    auto feature = layer->getFeature(i);
+                    benchmark::DoNotOptimize(feature->getGeometries());
+                    benchmark::DoNotOptimize(feature->getProperties());
+                    features++;
+                }
+            }
+        }
+    }
+
+    state.counters["features"] = static_cast<double>(features);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(tiles.size()));
+}
+
+// Evaluates the filter of each layer on the features of its source layer.
+static void TilePipeline_Filter(benchmark::State& state) {
+    const auto tiles = loadCorpus();
+
+    std::size_t passed = 0;
+    for (auto _ : state) {
+        passed = 0;
+        for (const auto& tile : tiles) {
+            for (const auto* group : {&tile.geometryLayers, &tile.symbolLayers}) {
+                for (const auto& properties : *group) {
+                    const auto& impl = *properties->baseImpl;
+                    auto layer = tile.data.getLayer(impl.sourceLayer);
+                    for (std::size_t i = 0; layer && i < layer->featureCount(); ++i) {
+                        passed += passes(impl.filter, *layer->getFeature(i), tile.id);
+                    }
+                }
+            }
+        }
+    }
+
+    state.counters["features"] = static_cast<double>(passed);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(tiles.size()));
+}
+
+// Builds the fill and line buckets: polygons are triangulated and lines are extruded.
+static void TilePipeline_Tessellation(benchmark::State& state) {
+    const auto tiles = loadCorpus();
+
+    for (auto _ : state) {
+        for (const auto& tile : tiles) {
+            benchmark::DoNotOptimize(createGeometryBuckets(tile));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(tiles.size()));
+}
+
+// Lays out the symbol features: their text is evaluated and the glyphs they need are collected.
+static void TilePipeline_Layout(benchmark::State& state) {
+    const auto tiles = loadCorpus();
+
+    for (auto _ : state) {
+        for (const auto& tile : tiles) {
+            benchmark::DoNotOptimize(layoutSymbols(tile));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(tiles.size()));
+}
+
+// Shapes the text of the symbols once their glyphs are available.
+static void TilePipeline_Shaping(benchmark::State& state) {
+    const auto tiles = loadCorpus();
+
+    for (auto _ : state) {
+        for (const auto& tile : tiles) {
+            state.PauseTiming();
+            auto symbols = layoutSymbols(tile);
+            const auto glyphMap = makeGlyphs(symbols.glyphDependencies);
+            const auto glyphAtlas = makeGlyphAtlas(glyphMap);
+            // A cache of its own for each tile, see shapeSymbols().
+            ShapingCache shapingCache(ShapingCache::defaultMaxEntries);
+            state.ResumeTiming();
+
+            for (auto& layout : symbols.layouts) {
+                layout->prepareSymbols(glyphMap, glyphAtlas.positions, {}, {}, &shapingCache);
+            }
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(tiles.size()));
+}
+
+// Creates the symbol buckets from the shaped symbols: anchors, glyph quads and collision features.
+static void TilePipeline_SymbolLayout(benchmark::State& state) {
+    const auto tiles = loadCorpus();
+
+    for (auto _ : state) {
+        for (const auto& tile : tiles) {
+            state.PauseTiming();
+            auto shaped = shapeSymbols(tile);
+            state.ResumeTiming();
+
+            benchmark::DoNotOptimize(createSymbolBuckets(tile, shaped));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(tiles.size()));
+}
+
+// Places the symbols of each tile, checking them for collisions with the ones placed before.
+static void TilePipeline_Placement(benchmark::State& state) {
+    const auto tiles = loadCorpus();
+    std::vector<std::vector<std::shared_ptr<Bucket>>> buckets;
+    for (const auto& tile : tiles) {
+        auto shaped = shapeSymbols(tile);
+        buckets.push_back(createSymbolBuckets(tile, shaped));
+    }
+
+    std::size_t placed = 0;
+    for (auto _ : state) {
+        placed = 0;
+        for (std::size_t i = 0; i < tiles.size(); ++i) {
+            placed += placeSymbols(tiles[i], buckets[i]);
+        }
+    }
+
+    state.counters["placed"] = static_cast<double>(placed);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(tiles.size()));
+}
+
+#if MLN_RENDER_BACKEND_OPENGL
+// Uploads the vertex and index data of the fill and line buckets to a headless OpenGL context.
+// The legacy renderer does this in Bucket::upload(); the drawable renderer uploads the same
+// vectors to buffers of its own when it uploads the drawables built from them.
+static void TilePipeline_Upload(benchmark::State& state) {
+    const auto tiles = loadCorpus();
+    gl::HeadlessBackend backend;
+    gfx::BackendScope scope{backend};
+    gl::Context context{backend};
+
+    std::vector<std::unique_ptr<Bucket>> buckets;
+    std::vector<gfx::VertexBuffer<FillLayoutVertex>> fillVertices;
+    std::vector<gfx::VertexBuffer<LineLayoutVertex>> lineVertices;
+    std::vector<std::unique_ptr<gfx::IndexBufferResource>> indices;
+    for (auto _ : state) {
+        state.PauseTiming();
+        buckets.clear();
+        fillVertices.clear();
+        lineVertices.clear();
+        indices.clear();
+        context.performCleanup();
+        for (const auto& tile : tiles) {
+            for (auto& bucket : createGeometryBuckets(tile)) {
+                buckets.push_back(std::move(bucket));
+            }
+        }
+        auto commandEncoder = context.createCommandEncoder();
+        auto uploadPass = commandEncoder->createUploadPass("upload", backend.getDefaultRenderable());
+        state.ResumeTiming();
+
+        for (auto& bucket : buckets) {
+#if MLN_LEGACY_RENDERER
+            bucket->upload(*uploadPass);
+#else
+            const auto uploadIndices = [&](const auto& triangles) {
+                indices.push_back(uploadPass->createIndexBufferResource(
+                    triangles.data(), triangles.bytes(), gfx::BufferUsageType::StaticDraw));
+            };
+            if (const auto* fill = dynamic_cast<const FillBucket*>(bucket.get())) {
+                fillVertices.push_back(uploadPass->createVertexBuffer(fill->vertices));
+                uploadIndices(fill->triangles);
+            } else if (const auto* line = dynamic_cast<const LineBucket*>(bucket.get())) {
+                lineVertices.push_back(uploadPass->createVertexBuffer(line->vertices));
+                uploadIndices(line->triangles);
+            }
+#endif
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(tiles.size()));
+}
+#endif // MLN_RENDER_BACKEND_OPENGL
+
+BENCHMARK(TilePipeline_Decode)->Unit(benchmark::kMillisecond);
+BENCHMARK(TilePipeline_Filter)->Unit(benchmark::kMillisecond);
+BENCHMARK(TilePipeline_Tessellation)->Unit(benchmark::kMillisecond);
+#if MLN_RENDER_BACKEND_OPENGL
+BENCHMARK(TilePipeline_Upload)->Unit(benchmark::kMillisecond);
+#endif
+BENCHMARK(TilePipeline_Layout)->Unit(benchmark::kMillisecond);
+BENCHMARK(TilePipeline_Shaping)->Unit(benchmark::kMillisecond);
+BENCHMARK(TilePipeline_SymbolLayout)->Unit(benchmark::kMillisecond);
+BENCHMARK(TilePipeline_Placement)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,122 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/util/cluster_index.hpp>
+
+#include <supercluster.hpp>
+
+#include <algorithm>
+#include <random>
+
+using namespace mbgl;
+
+namespace {
+
+ClusterIndex::Features generatePoints(std::size_t count) {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> lng(-180, 180);
+    std::normal_distribution<double> lat(20, 25);
+    ClusterIndex::Features features;
+    features.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const double latitude = std::max(-85.0, std::min(85.0, lat(generator)));
+        features.emplace_back(mapbox::geometry::point<double>{lng(generator), latitude},
+                              PropertyMap{{"value", uint64_t(i % 100)}},
+                              FeatureIdentifier(uint64_t(i)));
+    }
+    return features;
+}
+
+PropertyMap mapValue(const PropertyMap& properties) {
+    return {{"sum", properties.at("value")}};
+}
+
+void reduceValue(PropertyMap& cluster, const PropertyMap& point) {
+    cluster["sum"] = cluster["sum"].get<uint64_t>() + point.at("sum").get<uint64_t>();
+}
+
+std::vector<PropertyMap> mapValues(const std::vector<const PropertyMap*>& points) {
+    std::vector<PropertyMap> result;
+    result.reserve(points.size());
+    for (const auto* properties : points) {
+        result.push_back(mapValue(*properties));
+    }
+    return result;
+}
+
+void reduceValues(std::vector<PropertyMap>& clusters, const std::vector<ClusterIndex::Options::Member>& members) {
+    for (const auto& [cluster, point] : members) {
+        reduceValue(clusters[cluster], *point);
+    }
+}
+
+} // namespace
+
+static void ClusterIndex_Build(benchmark::State& state) {
+    const auto features = generatePoints(state.range(0));
+    ClusterIndex::Options options;
+    options.map = mapValues;
+    options.reduce = reduceValues;
+
+    while (state.KeepRunning()) {
+        ClusterIndex index(features, options);
+        benchmark::DoNotOptimize(index.size());
+    }
+}
+
+// The single-threaded supercluster.hpp build, for comparison.
+static void Supercluster_Build(benchmark::State& state) {
+    const auto features = generatePoints(state.range(0));
+    mapbox::supercluster::Options options;
+    options.map = mapValue;
+    options.reduce = reduceValue;
+
+    while (state.KeepRunning()) {
+        mapbox::supercluster::Supercluster index(features, options);
+        benchmark::DoNotOptimize(index.getTile(0, 0, 0).size());
+    }
+}
+
+static void ClusterIndex_Tiles(benchmark::State& state) {
+    ClusterIndex::Options options;
+    options.map = mapValues;
+    options.reduce = reduceValues;
+    const ClusterIndex index(generatePoints(state.range(0)), options);
+
+    while (state.KeepRunning()) {
+        std::size_t count = 0;
+        for (uint32_t x = 0; x < 8; ++x) {
+            for (uint32_t y = 0; y < 8; ++y) {
+                count += index.getTile(3, x, y).size();
+            }
+        }
+        benchmark::DoNotOptimize(count);
+    }
+}
+
+// Moves a thousand points of a copy of the index, compared to rebuilding it.
+static void ClusterIndex_Update(benchmark::State& state) {
+    ClusterIndex::Options options;
+    options.map = mapValues;
+    options.reduce = reduceValues;
+    ClusterIndex index(generatePoints(state.range(0)), options);
+
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<double> lng(-180, 180);
+    std::uniform_real_distribution<double> lat(-60, 60);
+    std::uniform_int_distribution<uint64_t> id(0, state.range(0) - 1);
+
+    while (state.KeepRunning()) {
+        ClusterIndex::Features moved;
+        for (std::size_t i = 0; i < 1000; ++i) {
+            moved.emplace_back(mapbox::geometry::point<double>{lng(generator), lat(generator)},
+                               PropertyMap{{"value", uint64_t(i % 100)}},
+                               FeatureIdentifier(id(generator)));
+        }
+        benchmark::DoNotOptimize(index.update({}, moved));
+    }
+}
+
+BENCHMARK(ClusterIndex_Build)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(Supercluster_Build)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(ClusterIndex_Tiles)->Arg(1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(ClusterIndex_Update)->Arg(1000000)->Unit(benchmark::kMillisecond);
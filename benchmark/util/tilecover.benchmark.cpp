@@ -32,6 +32,30 @@ static void TileCoverPitchedViewport(benchmark::State& state) {
     (void)length;
 }
 
+// A frame of a style with several sources, each asking for the ideal cover and a
+// lower zoom prefetch cover, with (1) or without (0) a cache shared between them.
+static void TileCoverPitchedViewportSources(benchmark::State& state) {
+    Transform transform;
+    transform.resize({512, 512});
+    transform.jumpTo(CameraOptions().withCenter(LatLng{0.1, -0.1}).withZoom(14.0).withBearing(5.0).withPitch(60.0));
+
+    const std::size_t sources = 4;
+    std::size_t length = 0;
+    while (state.KeepRunning()) {
+        util::TileCoverCache cache;
+        for (std::size_t i = 0; i < sources; ++i) {
+            if (state.range(0)) {
+                length += cache.get(transform.getState(), 14).size();
+                length += cache.get(transform.getState(), 10).size();
+            } else {
+                length += util::tileCover(transform.getState(), 14).size();
+                length += util::tileCover(transform.getState(), 10).size();
+            }
+        }
+    }
+    (void)length;
+}
+
 static void TileCoverBounds(benchmark::State& state) {
     std::size_t length = 0;
     while (state.KeepRunning()) {
@@ -78,5 +102,6 @@ static void TileCountPolygon(benchmark::State& state) {
 BENCHMARK(TileCountBounds);
 BENCHMARK(TileCountPolygon);
 BENCHMARK(TileCoverPitchedViewport);
+BENCHMARK(TileCoverPitchedViewportSources)->Arg(0)->Arg(1);
 BENCHMARK(TileCoverBounds);
 BENCHMARK(TileCoverPolygon);
@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/actor/scheduler.hpp>
+#include <mbgl/util/parallel.hpp>
+#include <mbgl/util/tiny_sdf.hpp>
+
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+// Local glyphs are rasterized at 24px with a 3px buffer on each side.
+constexpr uint32_t glyphSize = 30;
+constexpr uint32_t buffer = 3;
+
+// Stand-in for a rasterized ideograph: horizontal and vertical strokes picked by the
+// bits of the code point, with antialiased edges.
+AlphaImage rasterizeStrokes(char16_t codePoint) {
+    AlphaImage raster({glyphSize, glyphSize});
+    raster.fill(0);
+    auto stroke = [&](uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1) {
+        for (uint32_t y = y0; y <= y1; ++y) {
+            for (uint32_t x = x0; x <= x1; ++x) {
+                const bool edge = x == x0 || x == x1 || y == y0 || y == y1;
+                raster.data[y * glyphSize + x] = edge ? 128 : 255;
+            }
+        }
+    };
+    for (uint32_t i = 0; i < 4; ++i) {
+        const uint32_t offset = buffer + 2 + i * 6;
+        if (codePoint & (1u << i)) {
+            stroke(buffer, offset, glyphSize - buffer - 1, offset + 2);
+        }
+        if (codePoint & (1u << (i + 4))) {
+            stroke(offset, buffer, offset + 2, glyphSize - buffer - 1);
+        }
+    }
+    return raster;
+}
+
+// The first CJK Unified Ideographs range, as requested when a Chinese map loads.
+std::vector<AlphaImage> rasterizeRange() {
+    std::vector<AlphaImage> rasters;
+    for (char16_t codePoint = 0x4E00; codePoint <= 0x4EFF; ++codePoint) {
+        rasters.push_back(rasterizeStrokes(codePoint));
+    }
+    return rasters;
+}
+
+} // namespace
+
+static void TinySDF_CJKRange(benchmark::State& state) {
+    const auto rasters = rasterizeRange();
+    const auto threadPool = Scheduler::GetBackground();
+    std::vector<AlphaImage> sdfs(rasters.size());
+
+    for (auto _ : state) {
+        auto transform = [&](std::size_t i) {
+            sdfs[i] = util::transformRasterToSDF(rasters[i], 8, .25);
+        };
+        if (state.range(0)) {
+            util::parallelFor(*threadPool, rasters.size(), transform);
+        } else {
+            for (std::size_t i = 0; i < rasters.size(); ++i) {
+                transform(i);
+            }
+        }
+        benchmark::DoNotOptimize(sdfs.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(rasters.size()));
+}
+
+BENCHMARK(TinySDF_CJKRange)->ArgName("parallel")->Arg(0)->Arg(1);
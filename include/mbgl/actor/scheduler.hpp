@@ -2,6 +2,7 @@
 
 #include <mapbox/std/weak.hpp>
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 
@@ -33,6 +34,15 @@ class Mailbox;
 */
 class Scheduler {
 public:
+    /// Tasks run in order of priority on schedulers that support it, and in the
+    /// order they were scheduled within one priority.
+    enum class Priority : uint8_t {
+        Low,      // Replies to background work, e.g. parsed tiles and loaded resources.
+        Default,  // Regular messages.
+        High,     // Thread control messages.
+        Critical, // Frame-critical work, such as render and update notifications.
+    };
+
     virtual ~Scheduler() = default;
 
     /// Enqueues a function for execution.
@@ -40,6 +50,10 @@ public:
     /// Makes a weak pointer to this Scheduler.
     virtual mapbox::base::WeakPtr<Scheduler> makeWeakPtr() = 0;
 
+    /// Returns a scheduler that runs the tasks scheduled on it on this one, with
+    /// the given priority. Schedulers without priorities return themselves.
+    virtual Scheduler& withPriority(Priority) { return *this; }
+
     /// Returns a closure wrapping the given one.
     ///
     /// When the returned closure is invoked for the first time, it schedules
@@ -62,6 +76,13 @@ public:
         scheduleAndReplyValue(task, reply, GetCurrent()->makeWeakPtr());
     }
 
+    /// As above, with the reply enqueued with the given priority.
+    template <typename TaskFn, typename ReplyFn>
+    void scheduleAndReplyValue(const TaskFn& task, const ReplyFn& reply, Priority replyPriority) {
+        assert(GetCurrent());
+        scheduleAndReplyValue(task, reply, GetCurrent()->withPriority(replyPriority).makeWeakPtr());
+    }
+
     /// Set/Get the current Scheduler for this thread
     static Scheduler* GetCurrent();
     static void SetCurrent(Scheduler*);
@@ -67,7 +67,13 @@ public:
     const std::string& getName() const { return name; }
 
     /// Set drawable name
-    void setName(std::string value) { name = std::move(value); }
+    void setName(std::string value) {
+        name = std::move(value);
+        debugLabel.clear();
+    }
+
+    /// Label for debug groups, made of the ID, name and tile ID. Built on first use and kept.
+    const std::string& getDebugLabel() const;
 
     /// Which shader to use when rendering this drawable
     const gfx::ShaderProgramBasePtr& getShader() const { return shader; }
@@ -174,7 +180,10 @@ public:
     const std::optional<OverscaledTileID>& getTileID() const { return tileID; }
 
     /// Set the ID of the tile that this drawable represents
-    void setTileID(const OverscaledTileID& value) { tileID = value; }
+    void setTileID(const OverscaledTileID& value) {
+        tileID = value;
+        debugLabel.clear();
+    }
 
     /// Get cull face mode
     const gfx::CullFaceMode& getCullFaceMode() const;
@@ -245,6 +254,7 @@ protected:
     bool is3D = false;
     bool isCustom = false;
     std::string name;
+    mutable std::string debugLabel;
     const util::SimpleIdentity uniqueID;
     gfx::ShaderProgramBasePtr shader;
     mbgl::RenderPass renderPass;
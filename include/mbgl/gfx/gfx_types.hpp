@@ -61,6 +61,11 @@ enum class AttributeDataType : uint8_t {
     Float3, ///< pack of 3 floating point values
     Float4, ///< pack of 4 floating point values
 
+    HalfFloat,  ///< 16 bit floating point value
+    HalfFloat2, ///< pack of 2 16 bit floating point values
+    HalfFloat3, ///< pack of 3 16 bit floating point values
+    HalfFloat4, ///< pack of 4 16 bit floating point values
+
     Invalid = 255,
 };
 
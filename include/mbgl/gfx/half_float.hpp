@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace mbgl {
+namespace gfx {
+
+/// IEEE 754 half precision (16 bit) floating point value, as stored in vertex attributes
+/// of type `AttributeDataType::HalfFloat`.  Conversions from float round to the nearest
+/// value, ties to even, and saturate to infinity.
+class HalfFloat {
+public:
+    HalfFloat() = default;
+    HalfFloat(float value)
+        : bits(fromFloat(value)) {}
+
+    explicit operator float() const { return toFloat(bits); }
+
+    static HalfFloat fromBits(uint16_t value) {
+        HalfFloat half;
+        half.bits = value;
+        return half;
+    }
+    uint16_t getBits() const { return bits; }
+
+    bool operator==(const HalfFloat& rhs) const { return bits == rhs.bits; }
+    bool operator!=(const HalfFloat& rhs) const { return bits != rhs.bits; }
+
+private:
+    static uint16_t fromFloat(float value) {
+        uint32_t f;
+        std::memcpy(&f, &value, sizeof(f));
+        const auto sign = static_cast<uint16_t>((f >> 16) & 0x8000);
+        const uint32_t exponent = (f >> 23) & 0xff;
+        const uint32_t mantissa = f & 0x7fffff;
+
+        if (exponent == 0xff) {
+            // Infinity, or a quiet NaN
+            return static_cast<uint16_t>(sign | 0x7c00 | (mantissa ? 0x200 : 0));
+        }
+        const float magnitude = std::fabs(value);
+        if (magnitude < 6.103515625e-05f) {
+            // Subnormal half, in units of 2^-24
+            return static_cast<uint16_t>(sign | static_cast<uint16_t>(std::nearbyint(magnitude * 16777216.0f)));
+        }
+        if (exponent > 127 + 15) {
+            return static_cast<uint16_t>(sign | 0x7c00);
+        }
+
+        // Round the mantissa to 10 bits, ties to even. A carry into the exponent is correct,
+        // up to rounding the largest values to infinity.
+        uint32_t half = ((exponent - 127 + 15) << 10) | (mantissa >> 13);
+        const uint32_t rest = mantissa & 0x1fff;
+        if (rest > 0x1000 || (rest == 0x1000 && (half & 1))) {
+            ++half;
+        }
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    static float toFloat(uint16_t half) {
+        const uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+        const uint32_t exponent = (half >> 10) & 0x1f;
+        const uint32_t mantissa = half & 0x3ff;
+
+        uint32_t f;
+        if (exponent == 0) {
+            const float magnitude = static_cast<float>(mantissa) / 16777216.0f;
+            return sign ? -magnitude : magnitude;
+        } else if (exponent == 0x1f) {
+            f = sign | 0x7f800000 | (mantissa << 13);
+        } else {
+            f = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+        }
+        float value;
+        std::memcpy(&value, &f, sizeof(value));
+        return value;
+    }
+
+    uint16_t bits = 0;
+};
+
+} // namespace gfx
+} // namespace mbgl
@@ -52,6 +52,11 @@ struct RenderingStats {
     int numUniformBuffers = 0;
     int numUniformUpdates = 0;
     std::size_t uniformUpdateBytes = 0;
+    /// Number of GL buffer objects the uniform buffers are sub-allocated from
+    int numUniformBufferObjs = 0;
+    /// Number of uploads to those buffer objects, and their total size
+    int uniformBufferObjUpdates = 0;
+    std::size_t uniformBufferObjUpdateBytes = 0;
 
     int memTextures = 0;
     int memBuffers = 0;
@@ -62,6 +67,25 @@ struct RenderingStats {
     int stencilClears = 0;
     int stencilUpdates = 0;
 
+    /// Number of program, texture, uniform buffer and vertex array bindings skipped
+    /// because the previously drawn drawable had left the same state bound
+    int avoidedProgramBinds = 0;
+    int avoidedTextureBinds = 0;
+    int avoidedUniformBufferBinds = 0;
+    int avoidedVertexArrayBinds = 0;
+
+    /// Number of symbols considered by the most recent placement, of those culled
+    /// as out of view before collision detection, and of those placed
+    int numSymbolsConsidered = 0;
+    int numSymbolsCulled = 0;
+    int numSymbolsPlaced = 0;
+
+    /// Time spent by the most recent frame creating the render tree, apart from symbol placement,
+    /// placing symbols, and building and uploading GPU resources, in seconds
+    double layoutTime = 0;
+    double placementTime = 0;
+    double uploadTime = 0;
+
     RenderingStats& operator+=(const RenderingStats&);
 
 #if !defined(NDEBUG)
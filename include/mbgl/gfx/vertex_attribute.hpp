@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mbgl/gfx/gfx_types.hpp>
+#include <mbgl/gfx/half_float.hpp>
 #include <mbgl/renderer/paint_property_binder.hpp>
 #include <mbgl/util/string_indexer.hpp>
 #include <mbgl/util/containers.hpp>
@@ -161,6 +162,29 @@ public:
         return items[i] = value;
     }
 
+    /// @brief Set the value of an item from 16 bit integers, which are stored as floats
+    /// @param i index of the item
+    /// @param value value to set
+    /// @return ElementType reference to item
+    template <std::size_t N, std::enable_if_t<N == 2 || N == 4, int> = 0>
+    const ElementType& set(std::size_t i, const std::array<std::uint16_t, N>& value) {
+        std::array<float, N> converted;
+        std::copy(value.begin(), value.end(), converted.begin());
+        return set(i, converted);
+    }
+
+    /// @brief Set the value of an item from half floats, which are stored as floats
+    /// @param i index of the item
+    /// @param value value to set
+    /// @return ElementType reference to item
+    template <std::size_t N, std::enable_if_t<N == 2 || N == 4, int> = 0>
+    const ElementType& set(std::size_t i, const std::array<HalfFloat, N>& value) {
+        std::array<float, N> converted;
+        std::transform(
+            value.begin(), value.end(), converted.begin(), [](HalfFloat half) { return static_cast<float>(half); });
+        return set(i, converted);
+    }
+
     /// @brief Set the value of an item
     /// @param i index of the item
     /// @param value value to set
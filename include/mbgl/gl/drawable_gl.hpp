@@ -26,6 +26,7 @@ using UniqueVertexBufferResource = std::unique_ptr<VertexBufferResource>;
 
 namespace gl {
 
+class DrawableSubmission;
 class Texture2D;
 class VertexArray;
 
@@ -36,6 +37,10 @@ public:
 
     void draw(PaintParameters&) const override;
 
+    /// Draw as part of a sequence of drawables, leaving the bindings in place
+    /// for the next one. See `DrawableSubmission`.
+    void draw(PaintParameters&, DrawableSubmission&) const;
+
     struct DrawSegmentGL;
     void setIndexData(gfx::IndexVectorBasePtr, std::vector<UniqueDrawSegment> segments) override;
 
@@ -56,9 +61,14 @@ protected:
     DrawableGL(std::unique_ptr<Impl>);
 
 private:
+    friend class DrawableSubmission;
+
     gfx::ColorMode makeColorMode(PaintParameters&) const;
     gfx::StencilMode makeStencilMode(PaintParameters&) const;
 
+    /// Applies the depth, stencil, color and cull face modes
+    void setRenderModes(PaintParameters&) const;
+
     void uploadTextures() const;
 
     void bindUniformBuffers() const;
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <mbgl/gl/drawable_submission.hpp>
 #include <mbgl/renderer/layer_group.hpp>
 
+#include <string>
+#include <vector>
+
 namespace mbgl {
 namespace gl {
 
@@ -17,6 +21,13 @@ public:
     void render(RenderOrchestrator&, PaintParameters&) override;
 
 protected:
+    // Drawables of the current pass in submission order, kept to reuse the storage
+    std::vector<gfx::Drawable*> drawOrder;
+    DrawableOrder order;
+
+    // Debug group labels, built once rather than on each frame
+    std::string clipMasksLabel;
+    std::string renderLabel;
 };
 
 /**
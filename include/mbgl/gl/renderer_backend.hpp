@@ -5,6 +5,9 @@
 #include <mbgl/util/size.hpp>
 #include <mbgl/util/util.hpp>
 
+#include <optional>
+#include <string>
+
 namespace mbgl {
 
 class ProgramParameters;
@@ -27,6 +30,11 @@ public:
     void initShaders(gfx::ShaderRegistry&, const ProgramParameters& programParameters) override;
 #endif
 
+    /// Sets an existing, writable directory in which linked shader programs are
+    /// kept across runs, so that later start-ups can skip compiling them. Takes
+    /// effect when the shaders are initialized.
+    void setProgramCacheDir(std::optional<std::string> directory) { programCacheDir = std::move(directory); }
+
 protected:
     std::unique_ptr<gfx::Context> createContext() override;
 
@@ -57,6 +65,9 @@ public:
     void setFramebufferBinding(FramebufferID fbo);
     void setViewport(int32_t x, int32_t y, const Size&);
     void setScissorTest(bool);
+
+private:
+    std::optional<std::string> programCacheDir;
 };
 
 } // namespace gl
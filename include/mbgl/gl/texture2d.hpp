@@ -58,6 +58,10 @@ public:
     /// @brief Unbind the texture, if it was bound
     void unbind() noexcept;
 
+    /// @brief Whether the texture is still bound as `bind(location, textureUnit)` left it
+    /// in the current program, so that binding it again would change nothing
+    bool isBound(int32_t location, int32_t textureUnit) const noexcept;
+
 private:
     void createObject() noexcept;
     void createStorage(const void* data = nullptr) noexcept;
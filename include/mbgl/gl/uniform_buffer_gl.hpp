@@ -2,6 +2,7 @@
 
 #include <mbgl/gfx/uniform_buffer.hpp>
 #include <mbgl/gl/types.hpp>
+#include <mbgl/gl/uniform_buffer_allocator.hpp>
 
 namespace mbgl {
 namespace gl {
@@ -10,18 +11,21 @@ class UniformBufferGL final : public gfx::UniformBuffer {
     UniformBufferGL(const UniformBufferGL&);
 
 public:
-    UniformBufferGL(const void* data, std::size_t size_);
-    UniformBufferGL(UniformBufferGL&& other)
-        : UniformBuffer(std::move(other)) {}
+    UniformBufferGL(UniformBufferAllocator&, const void* data, std::size_t size_);
+    UniformBufferGL(UniformBufferGL&& other);
     ~UniformBufferGL() override;
 
-    BufferID getID() const { return id; }
     void update(const void* data, std::size_t size_) override;
 
+    /// Binds the range of the buffer to the uniform buffer binding point
+    void bind(std::size_t binding) const;
+
     UniformBufferGL clone() const { return {*this}; }
 
 protected:
-    BufferID id = 0;
+    // Owned by the context, which outlives its uniform buffers. Null once moved from.
+    UniformBufferAllocator* allocator;
+    UniformBufferAllocator::Range range;
     uint32_t hash;
 };
 
@@ -38,6 +38,8 @@ struct PlacedSymbolData {
     float viewportPadding;
     /// Layer id (leader of the symbol layout group)
     std::string layer;
+    /// Symbol anchor, in the coordinates of the collision boxes
+    mapbox::geometry::point<float> anchor;
 };
 
 class Renderer {
@@ -59,6 +61,25 @@ public:
                                                const RenderedQueryOptions& options = {}) const;
     std::vector<Feature> queryRenderedFeatures(const ScreenBox& box, const RenderedQueryOptions& options = {}) const;
     std::vector<Feature> querySourceFeatures(const std::string& sourceID, const SourceQueryOptions& options = {}) const;
+
+    /**
+     * @brief Asynchronous rendered features query.
+     *
+     * The render state needed by the query (tile feature indexes, evaluated
+     * layer properties, placed symbols) is captured immediately. The per-tile
+     * queries then run on the background thread pool, and `callback` is
+     * invoked with the result on the calling thread's run loop.
+     *
+     * The result matches what `queryRenderedFeatures()` would have returned at
+     * the time of the call.
+     */
+    using QueryFeaturesCallback = std::function<void(const std::vector<Feature>&)>;
+    void queryRenderedFeaturesAsync(const ScreenLineString&,
+                                    const RenderedQueryOptions&,
+                                    QueryFeaturesCallback callback) const;
+    void queryRenderedFeaturesAsync(const ScreenBox& box,
+                                    const RenderedQueryOptions&,
+                                    QueryFeaturesCallback callback) const;
     AnnotationIDs queryPointAnnotations(const ScreenBox& box) const;
     AnnotationIDs queryShapeAnnotations(const ScreenBox& box) const;
     AnnotationIDs getAnnotationIDs(const std::vector<Feature>&) const;
@@ -90,7 +111,7 @@ public:
     void dumpDebugLogs();
 
     /**
-     * @brief In Tile map mode, enables or disables collecting of the placed
+     * @brief In Static and Tile map modes, enables or disables collecting of the placed
      * symbols data, which can be obtained with `getPlacedSymbolsData()`.
      *
      * The placed symbols data collecting is disabled by default.
@@ -107,6 +128,20 @@ public:
      */
     const std::vector<PlacedSymbolData>& getPlacedSymbolsData() const;
 
+    /**
+     * @brief In Static map mode, makes the following renders place the given
+     * symbols as they were placed before, e.g. in a render of an adjacent part
+     * of the map.
+     *
+     * A symbol matches an entry with the same layer, key and anchor. It is shown
+     * or hidden as the entry says, and the collision boxes of shown entries are
+     * taken before any other symbol is placed. Coordinates are the ones of
+     * `getPlacedSymbolsData()`, moved to the viewport of the following renders.
+     *
+     * @param symbols placed symbols data to keep, or an empty vector to place all symbols
+     */
+    void setFixedPlacedSymbols(std::vector<PlacedSymbolData> symbols);
+
     // Memory
     void reduceMemoryUse();
     void clearData();
@@ -9,6 +9,7 @@
 #include <map>
 #include <memory>
 #include <utility>
+#include <vector>
 
 namespace mbgl {
 
@@ -36,6 +37,22 @@ struct GeoJSONOptions {
 
     static Immutable<GeoJSONOptions> defaultOptions();
 };
+
+/**
+ * @brief A set of changes applied to the data of a GeoJSON source.
+ *
+ * Features are matched by their identifier, so only features that have one
+ * can be replaced or removed.
+ */
+struct GeoJSONDataDiff {
+    /// Removes every feature before the rest of the diff is applied.
+    bool removeAll = false;
+    /// Identifiers of the features to remove.
+    std::vector<FeatureIdentifier> remove;
+    /// Features to add. A feature replaces an existing feature with the same identifier.
+    mapbox::feature::feature_collection<double> add;
+};
+
 class GeoJSONData {
 public:
     using TileFeatures = mapbox::feature::feature_collection<int16_t>;
@@ -53,6 +70,15 @@ public:
     virtual std::uint8_t getClusterExpansionZoom(std::uint32_t) = 0;
 
     virtual std::shared_ptr<Scheduler> getScheduler() { return nullptr; }
+
+    /// Returns a new data object with the given diff applied, sharing the parts
+    /// of the index that the diff does not touch. Returns nullptr if this data
+    /// does not support incremental updates.
+    virtual std::shared_ptr<GeoJSONData> update(const GeoJSONDataDiff&) { return nullptr; }
+
+    /// Returns whether the given tile may differ between `previous` and this
+    /// data. Exact only when this data was created by `previous.update()`.
+    virtual bool isTileChanged(const GeoJSONData& /* previous */, const CanonicalTileID&) const { return true; }
 };
 
 class GeoJSONSource final : public Source {
@@ -63,6 +89,8 @@ public:
     void setURL(const std::string& url);
     void setGeoJSON(const GeoJSON&);
     void setGeoJSONData(std::shared_ptr<GeoJSONData>);
+    /// Applies the diff to the current data. Only tiles touched by the diff are reloaded.
+    void updateData(const GeoJSONDataDiff&);
 
     std::optional<std::string> getURL() const;
     const GeoJSONOptions& getOptions() const;
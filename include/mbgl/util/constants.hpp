@@ -51,6 +51,10 @@ constexpr uint64_t DEFAULT_MAX_CACHE_SIZE = 50 * 1024 * 1024;
 constexpr std::size_t DEFAULT_ON_DEMAND_IMAGES_CACHE_SIZE = 100 * 8192;
 
 constexpr Duration DEFAULT_TRANSITION_DURATION = Milliseconds(300);
+
+// Time the map thread spends on queued tasks before it lets the platform loop,
+// and with it rendering, run. About half a frame at 60 fps.
+constexpr Duration DEFAULT_MAP_THREAD_TIME_BUDGET = Milliseconds(8);
 constexpr Seconds CLOCK_SKEW_RETRY_TIMEOUT{30};
 
 constexpr UnitBezier DEFAULT_TRANSITION_EASE = {0, 0, 0.25, 1};
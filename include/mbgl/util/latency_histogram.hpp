@@ -0,0 +1,58 @@
+#pragma once
+
+#include <mbgl/util/chrono.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace mbgl {
+namespace util {
+
+/// Histogram of durations, with power of two buckets: bucket `i` counts
+/// durations below `2^i` microseconds, the last bucket everything longer.
+class LatencyHistogram {
+public:
+    static constexpr std::size_t bucketCount = 24;
+
+    void record(Duration duration) {
+        const auto micros = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+        std::size_t bucket = 0;
+        while (bucket + 1 < bucketCount && (int64_t(1) << bucket) <= micros) {
+            ++bucket;
+        }
+        ++buckets[bucket];
+        ++count;
+        total += duration;
+        if (duration > max) {
+            max = duration;
+        }
+    }
+
+    /// Upper bound of the given percentile (0 to 1), at bucket resolution.
+    Duration percentile(double p) const {
+        if (count == 0) {
+            return Duration::zero();
+        }
+        const auto target = static_cast<uint64_t>(p * static_cast<double>(count - 1)) + 1;
+        uint64_t seen = 0;
+        for (std::size_t bucket = 0; bucket + 1 < bucketCount; ++bucket) {
+            seen += buckets[bucket];
+            if (seen >= target) {
+                return std::min<Duration>(std::chrono::microseconds(int64_t(1) << bucket), max);
+            }
+        }
+        return max;
+    }
+
+    Duration mean() const { return count ? total / static_cast<Duration::rep>(count) : Duration::zero(); }
+
+    std::array<uint64_t, bucketCount> buckets{};
+    uint64_t count = 0;
+    Duration total = Duration::zero();
+    Duration max = Duration::zero();
+};
+
+} // namespace util
+} // namespace mbgl
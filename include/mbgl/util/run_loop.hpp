@@ -2,11 +2,15 @@
 
 #include <mbgl/actor/scheduler.hpp>
 #include <mbgl/actor/mailbox.hpp>
+#include <mbgl/util/chrono.hpp>
+#include <mbgl/util/latency_histogram.hpp>
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/util.hpp>
 #include <mbgl/util/work_task.hpp>
 #include <mbgl/util/work_request.hpp>
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <functional>
 #include <utility>
@@ -25,9 +29,24 @@ public:
         New,
     };
 
-    enum class Priority : bool {
-        Default = false,
-        High = true,
+    /// Tasks run in order of priority, and in the order they were posted
+    /// within one priority.
+    using Priority = Scheduler::Priority;
+    static constexpr std::size_t priorityCount = 4;
+
+    /// Queue wait and execution times of the tasks of one priority.
+    class TaskStats {
+    public:
+        LatencyHistogram wait;
+        LatencyHistogram execution;
+    };
+
+    class Stats {
+    public:
+        std::array<TaskStats, priorityCount> tasks;
+        /// Number of times processing stopped with tasks left, because the
+        /// time budget was used up.
+        uint64_t yields = 0;
     };
 
     enum class Event : uint8_t {
@@ -52,8 +71,35 @@ public:
     /// loop. It will be called from any thread and is up to the platform
     /// to, after receiving the callback, call RunLoop::runOnce() from the
     /// same thread as the Map object lives.
+    /// When processing yields because its time budget is used up, the
+    /// callback is also invoked on the RunLoop thread itself.
     void setPlatformCallback(std::function<void()> callback) { platformCallback = std::move(callback); }
 
+    /// Limits the time spent running queued tasks before returning control to
+    /// the platform loop; the remaining tasks run on the next iteration.
+    /// Critical tasks are never deferred. A zero budget (the default) runs
+    /// every queued task at once.
+    void setTimeBudget(Duration budget) {
+        std::lock_guard<std::mutex> lock(mutex);
+        timeBudget = budget;
+    }
+
+    /// Records queue wait and execution times of every task while enabled.
+    void setStatsEnabled(bool enabled) {
+        std::lock_guard<std::mutex> lock(mutex);
+        statsEnabled = enabled;
+    }
+
+    Stats getStats() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return stats;
+    }
+
+    void resetStats() {
+        std::lock_guard<std::mutex> lock(mutex);
+        stats = {};
+    }
+
     // So far only needed by the libcurl backend.
     void addWatch(int fd, Event, std::function<void(int, Event)>&& callback);
     void removeWatch(int fd);
@@ -79,14 +125,43 @@ public:
     }
 
     void schedule(std::function<void()> fn) override { invoke(std::move(fn)); }
+    void schedule(Priority priority, std::function<void()> fn) { invoke(priority, std::move(fn)); }
     ::mapbox::base::WeakPtr<Scheduler> makeWeakPtr() override { return weakFactory.makeWeakPtr(); }
 
+    Scheduler& withPriority(Priority priority) override {
+        return priority == Priority::Default ? static_cast<Scheduler&>(*this)
+                                             : prioritySchedulers[static_cast<std::size_t>(priority)];
+    }
+
     class Impl;
 
 private:
     MBGL_STORE_THREAD(tid)
 
-    using Queue = std::queue<std::shared_ptr<WorkTask>>;
+    class QueuedTask {
+    public:
+        std::shared_ptr<WorkTask> task;
+        TimePoint queued;
+    };
+
+    using Queue = std::queue<QueuedTask>;
+
+    // Posts the tasks scheduled on it to the RunLoop with a fixed priority.
+    class PriorityScheduler final : public Scheduler {
+    public:
+        PriorityScheduler(RunLoop& loop_, Priority priority_)
+            : loop(loop_),
+              priority(priority_) {}
+
+        void schedule(std::function<void()> fn) override { loop.schedule(priority, std::move(fn)); }
+        ::mapbox::base::WeakPtr<Scheduler> makeWeakPtr() override { return weakFactory.makeWeakPtr(); }
+        Scheduler& withPriority(Priority other) override { return loop.withPriority(other); }
+
+    private:
+        RunLoop& loop;
+        const Priority priority;
+        ::mapbox::base::WeakPtrFactory<Scheduler> weakFactory{this};
+    };
 
     // Wakes up the RunLoop so that it starts processing items in the queue.
     void wake();
@@ -94,11 +169,8 @@ private:
     // Adds a WorkTask to the queue, and wakes it up.
     void push(Priority priority, std::shared_ptr<WorkTask> task) {
         std::lock_guard<std::mutex> lock(mutex);
-        if (priority == Priority::High) {
-            highPriorityQueue.emplace(std::move(task));
-        } else {
-            defaultQueue.emplace(std::move(task));
-        }
+        const bool timed = statsEnabled || timeBudget > Duration::zero();
+        queues[static_cast<std::size_t>(priority)].push({std::move(task), timed ? Clock::now() : TimePoint()});
         wake();
 
         if (platformCallback) {
@@ -107,32 +179,61 @@ private:
     }
 
     void process() {
-        std::shared_ptr<WorkTask> task;
+        QueuedTask next;
         std::unique_lock<std::mutex> lock(mutex);
+        const Duration budget = timeBudget;
+        const bool timed = statsEnabled || budget > Duration::zero();
+        const TimePoint start = timed ? Clock::now() : TimePoint();
         while (true) {
-            if (!highPriorityQueue.empty()) {
-                task = std::move(highPriorityQueue.front());
-                highPriorityQueue.pop();
-            } else if (!defaultQueue.empty()) {
-                task = std::move(defaultQueue.front());
-                defaultQueue.pop();
-            } else {
+            auto queue = std::find_if(queues.rbegin(), queues.rend(), [](const Queue& q) { return !q.empty(); });
+            if (queue == queues.rend()) {
                 break;
             }
+            const auto priority = static_cast<std::size_t>(std::distance(queue, queues.rend()) - 1);
+
+            TimePoint now = timed ? Clock::now() : TimePoint();
+            if (budget > Duration::zero() && priority != static_cast<std::size_t>(Priority::Critical) &&
+                now - start >= budget) {
+                // Let the platform loop (and with it rendering) run, and
+                // continue with the remaining tasks on the next iteration.
+                ++stats.yields;
+                lock.unlock();
+                wake();
+                if (platformCallback) {
+                    platformCallback();
+                }
+                return;
+            }
+
+            next = std::move(queue->front());
+            queue->pop();
+            const bool recordStats = statsEnabled && next.queued != TimePoint();
             lock.unlock();
-            (*task)();
-            task.reset();
+            (*next.task)();
+            next.task.reset();
             lock.lock();
+
+            if (recordStats) {
+                const TimePoint finished = Clock::now();
+                stats.tasks[priority].wait.record(now - next.queued);
+                stats.tasks[priority].execution.record(finished - now);
+            }
         }
     }
 
     std::function<void()> platformCallback;
 
-    Queue defaultQueue;
-    Queue highPriorityQueue;
-    std::mutex mutex;
+    std::array<Queue, priorityCount> queues;
+    Duration timeBudget = Duration::zero();
+    bool statsEnabled = false;
+    Stats stats;
+    mutable std::mutex mutex;
 
     std::unique_ptr<Impl> impl;
+    std::array<PriorityScheduler, priorityCount> prioritySchedulers{{{*this, Priority::Low},
+                                                                     {*this, Priority::Default},
+                                                                     {*this, Priority::High},
+                                                                     {*this, Priority::Critical}}};
     ::mapbox::base::WeakPtrFactory<Scheduler> weakFactory{this};
 };
 
@@ -18,7 +18,7 @@ namespace android {
 class ForwardingRendererObserver : public RendererObserver {
 public:
     ForwardingRendererObserver(util::RunLoop& mapRunLoop, RendererObserver& delegate_)
-        : mailbox(std::make_shared<Mailbox>(mapRunLoop)),
+        : mailbox(std::make_shared<Mailbox>(mapRunLoop.withPriority(Scheduler::Priority::Critical))),
           delegate(delegate_, mailbox) {}
 
     ~ForwardingRendererObserver() { mailbox->close(); }
@@ -57,6 +57,8 @@
 #include "logger.hpp"
 #include "text/local_glyph_rasterizer_jni.hpp"
 
+#include <mbgl/util/constants.hpp>
+
 namespace mbgl {
 namespace android {
 
@@ -69,6 +71,7 @@ void registerNatives(JavaVM* vm) {
 
     // For the FileSource
     static mbgl::util::RunLoop mainRunLoop;
+    mainRunLoop.setTimeBudget(mbgl::util::DEFAULT_MAP_THREAD_TIME_BUDGET);
     FileSource::registerNative(env);
 
     // Basic types
@@ -5,6 +5,7 @@
 #include <mbgl/gfx/renderer_backend.hpp>
 #include <mbgl/util/image.hpp>
 
+#include <functional>
 #include <memory>
 
 namespace mbgl {
@@ -28,6 +29,17 @@ public:
     }
 
     virtual PremultipliedImage readStillImage() = 0;
+
+    using StillImageCallback = std::function<void(PremultipliedImage)>;
+    // Starts reading the rendered image back and passes it to the callback once it
+    // is available, from a later call to this function or to pollStillImages. The
+    // image is written into `buffer` when it has the right size. Backends without
+    // asynchronous readback read synchronously and run the callback right away.
+    virtual void readStillImageAsync(StillImageCallback, PremultipliedImage buffer);
+    // Runs the callbacks of the reads that have completed; with `wait` set, waits
+    // for all of them.
+    virtual void pollStillImages(bool wait);
+
     virtual RendererBackend* getRendererBackend() = 0;
     void setSize(Size);
 
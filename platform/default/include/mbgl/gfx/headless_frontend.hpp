@@ -7,6 +7,7 @@
 #include <mbgl/util/async_task.hpp>
 
 #include <atomic>
+#include <functional>
 #include <memory>
 #include <optional>
 
@@ -56,6 +57,17 @@ public:
 
     PremultipliedImage readStillImage();
     RenderResult render(Map&);
+
+    using RenderCallback = std::function<void(RenderResult)>;
+    // Renders a still image like render(), but returns as soon as the frame has
+    // been submitted, so that the next one can be rendered while this one is read
+    // back. The callback runs from a later call to renderAsync() or finishRenders(),
+    // in the order the frames were rendered. `buffer` is reused for the image when
+    // it has the right size.
+    void renderAsync(Map&, RenderCallback, PremultipliedImage buffer = {});
+    // Waits for the images of all pending renderAsync() calls.
+    void finishRenders();
+
     void renderOnce(Map&);
     void renderFrame();
 
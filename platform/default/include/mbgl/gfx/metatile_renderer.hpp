@@ -0,0 +1,80 @@
+#pragma once
+
+#include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/geo.hpp>
+#include <mbgl/util/image.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace mbgl {
+
+class HeadlessFrontend;
+class Map;
+
+/**
+ * Renders the tiles of a raster tile pyramid a metatile at a time: a block of
+ * tiles is rendered as one image and then sliced into tiles.
+ *
+ * Rendering a metatile lays out and places the labels of its tiles once, so labels
+ * crossing the tile boundaries inside a metatile aren't cut. Labels along the edge
+ * of a metatile are carried over to the neighbouring metatiles rendered after it,
+ * which show or hide them the same way (see `Renderer::setFixedPlacedSymbols()`), so
+ * they aren't cut at the seams either. Each metatile is rendered with a buffer around
+ * it, which is cropped off, so that it lays out the labels reaching into it from its
+ * neighbours. Metatiles are rendered in Hilbert curve order, so that consecutive
+ * metatiles are adjacent and the parsed tiles that they share stay in the tile
+ * cache of the map.
+ *
+ * The map must use MapMode::Static and ConstrainMode::None, and render to the given
+ * frontend, whose size is changed to fit the metatiles. Any other constrain mode
+ * moves the center of metatiles at the top and bottom of the world, and raises the
+ * scale of low zoom levels, so that the tiles are no longer where they're sliced.
+ */
+class MetatileRenderer {
+public:
+    struct Options {
+        /// Tiles along each side of a metatile
+        uint32_t metatileSize = 8;
+        /// Size of the output tiles, in logical pixels
+        uint32_t tileSize = 512;
+        /// Rendered around each metatile and cropped off, in logical pixels. Labels
+        /// larger than the buffer may still be cut at the seams between metatiles.
+        uint32_t buffer = 128;
+    };
+
+    /// A block of tiles of one zoom level, given by its top left tile and its size in tiles
+    struct Metatile {
+        uint8_t z;
+        uint32_t x;
+        uint32_t y;
+        uint32_t width;
+        uint32_t height;
+    };
+
+    using TileCallback = std::function<void(const CanonicalTileID&, PremultipliedImage)>;
+
+    MetatileRenderer(HeadlessFrontend&, Map&, Options);
+    MetatileRenderer(HeadlessFrontend&, Map&);
+
+    /// Renders every tile of zoom level `z` or, if `bounds` are given, the tiles
+    /// covering them. The callback receives each tile's image as it is sliced off
+    /// its metatile.
+    void render(uint8_t z, const TileCallback&, const std::optional<LatLngBounds>& bounds = std::nullopt);
+
+    /// The metatiles covering zoom level `z` or the bounds, in the order they are
+    /// rendered. Metatiles are aligned to multiples of the metatile size and clipped
+    /// to the bounds and the world.
+    std::vector<Metatile> metatiles(uint8_t z, const std::optional<LatLngBounds>& bounds = std::nullopt) const;
+
+private:
+    void slice(const Metatile&, const PremultipliedImage&, const TileCallback&) const;
+
+    HeadlessFrontend& frontend;
+    Map& map;
+    const Options options;
+};
+
+} // namespace mbgl
@@ -8,6 +8,8 @@
 namespace mbgl {
 namespace gl {
 
+class FramebufferReadback;
+
 class HeadlessBackend final : public gl::RendererBackend, public gfx::HeadlessBackend {
 public:
     HeadlessBackend(Size = {256, 256},
@@ -17,6 +19,8 @@ public:
     void updateAssumedState() override;
     gfx::Renderable& getDefaultRenderable() override;
     PremultipliedImage readStillImage() override;
+    void readStillImageAsync(StillImageCallback, PremultipliedImage buffer) override;
+    void pollStillImages(bool wait) override;
     RendererBackend* getRendererBackend() override;
 
     void swap();
@@ -42,6 +46,7 @@ private:
 
 private:
     std::unique_ptr<Impl> impl;
+    std::unique_ptr<FramebufferReadback> readback;
     bool active = false;
     SwapBehaviour swapBehaviour = SwapBehaviour::NoFlush;
 };
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <mbgl/map/camera.hpp>
+#include <mbgl/map/map_snapshotter.hpp>
+#include <mbgl/util/client_options.hpp>
+#include <mbgl/util/size.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace mbgl {
+
+class ResourceOptions;
+
+/**
+ * A fixed number of snapshotters that render the snapshots of a queue of jobs, each
+ * on whichever snapshotter is free.
+ *
+ * Every snapshotter keeps its renderer thread and GL context alive between jobs.
+ * The snapshotters share the file source of the resource options, and with it the
+ * tiles, glyphs and sprites it caches. A snapshotter also keeps the last style it
+ * loaded, so jobs are routed to a free snapshotter that already has their style
+ * where possible, which saves parsing the style and loading its sprites and
+ * glyphs again.
+ *
+ * Must be used from a thread with a run loop; the callbacks run on that thread.
+ */
+class MapSnapshotterPool {
+public:
+    struct Job {
+        /// Exactly one of the style URL and the style JSON is set.
+        std::string styleURL;
+        std::string styleJSON;
+        Size size;
+        CameraOptions camera;
+    };
+
+    MapSnapshotterPool(std::size_t poolSize,
+                       float pixelRatio,
+                       const ResourceOptions&,
+                       const ClientOptions& = ClientOptions(),
+                       std::optional<std::string> localFontFamily = std::nullopt);
+    ~MapSnapshotterPool();
+
+    /// Queues the job. Jobs are started in order, as snapshotters become free.
+    void snapshot(Job, MapSnapshotter::Callback);
+
+    /// Drops the jobs that haven't started yet, without running their callbacks.
+    void cancelPending();
+
+    std::size_t size() const;
+    /// Jobs that are queued, not counting those being rendered.
+    std::size_t pending() const;
+    /// Jobs that are being rendered.
+    std::size_t active() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl;
+};
+
+} // namespace mbgl
@@ -11,5 +11,11 @@ void HeadlessBackend::setSize(Size size_) {
     resource.reset();
 }
 
+void HeadlessBackend::readStillImageAsync(StillImageCallback callback, PremultipliedImage) {
+    callback(readStillImage());
+}
+
+void HeadlessBackend::pollStillImages(bool) {}
+
 } // namespace gfx
 } // namespace mbgl
@@ -153,6 +153,40 @@ HeadlessFrontend::RenderResult HeadlessFrontend::render(Map& map) {
     return result;
 }
 
+void HeadlessFrontend::renderAsync(Map& map, RenderCallback callback, PremultipliedImage buffer) {
+    bool rendered = false;
+    std::exception_ptr error;
+    gfx::BackendScope guard{*getBackend()};
+
+    // Deliver the frames that have been read back in the meantime
+    backend->pollStillImages(false);
+
+    map.renderStill([&](const std::exception_ptr& e) {
+        if (e) {
+            error = e;
+            return;
+        }
+        rendered = true;
+        backend->readStillImageAsync(
+            [callback_ = std::move(callback), stats = getBackend()->getContext().renderingStats()](
+                PremultipliedImage image) { callback_({std::move(image), stats}); },
+            std::move(buffer));
+    });
+
+    while (!rendered && !error) {
+        util::RunLoop::Get()->runOnce();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void HeadlessFrontend::finishRenders() {
+    gfx::BackendScope guard{*getBackend()};
+    backend->pollStillImages(true);
+}
+
 void HeadlessFrontend::renderOnce(Map&) {
     util::RunLoop::Get()->runOnce();
 }
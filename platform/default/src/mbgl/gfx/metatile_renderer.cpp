@@ -0,0 +1,246 @@
+#include <mbgl/gfx/metatile_renderer.hpp>
+
+#include <mbgl/gfx/headless_frontend.hpp>
+#include <mbgl/map/camera.hpp>
+#include <mbgl/map/map.hpp>
+#include <mbgl/map/map_options.hpp>
+#include <mbgl/renderer/renderer.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/projection.hpp>
+#include <mbgl/util/tile_range.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <map>
+#include <set>
+#include <utility>
+
+namespace mbgl {
+
+namespace {
+
+// Position of (x, y) along the Hilbert curve filling a square with the given
+// side, which must be a power of two.
+uint64_t hilbertIndex(uint32_t side, uint32_t x, uint32_t y) {
+    uint64_t index = 0;
+    for (uint32_t s = side / 2; s > 0; s /= 2) {
+        const uint32_t rx = (x & s) ? 1 : 0;
+        const uint32_t ry = (y & s) ? 1 : 0;
+        index += static_cast<uint64_t>(s) * s * ((3 * rx) ^ ry);
+        if (ry == 0) {
+            if (rx == 1) {
+                x = side - 1 - x;
+                y = side - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return index;
+}
+
+using Cell = std::pair<int64_t, int64_t>;
+
+void translate(PlacedSymbolData& symbol, float dx, float dy) {
+    for (auto* box : {&symbol.textCollisionBox, &symbol.iconCollisionBox}) {
+        if (*box) {
+            **box = {{(*box)->min.x + dx, (*box)->min.y + dy}, {(*box)->max.x + dx, (*box)->max.y + dy}};
+        }
+    }
+    symbol.anchor = {symbol.anchor.x + dx, symbol.anchor.y + dy};
+}
+
+// Whether the collision boxes of the symbol reach into the rectangle.
+bool intersects(const PlacedSymbolData& symbol, float x1, float y1, float x2, float y2) {
+    for (const auto& box : {symbol.textCollisionBox, symbol.iconCollisionBox}) {
+        if (box && box->max.x > x1 && box->min.x < x2 && box->max.y > y1 && box->min.y < y2) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+MetatileRenderer::MetatileRenderer(HeadlessFrontend& frontend_, Map& map_, Options options_)
+    : frontend(frontend_),
+      map(map_),
+      options(options_) {
+    assert(options.metatileSize > 0);
+    assert(options.tileSize > 0);
+    assert(map.getMapOptions().mapMode() == MapMode::Static);
+    assert(map.getMapOptions().constrainMode() == ConstrainMode::None);
+}
+
+MetatileRenderer::MetatileRenderer(HeadlessFrontend& frontend_, Map& map_)
+    : MetatileRenderer(frontend_, map_, Options()) {}
+
+std::vector<MetatileRenderer::Metatile> MetatileRenderer::metatiles(uint8_t z,
+                                                                    const std::optional<LatLngBounds>& bounds) const {
+    const uint32_t worldTiles = 1u << z;
+    uint32_t minX = 0;
+    uint32_t minY = 0;
+    uint32_t maxX = worldTiles - 1;
+    uint32_t maxY = worldTiles - 1;
+    if (bounds) {
+        const auto range = util::TileRange::fromLatLngBounds(*bounds, z).range;
+        // Bounds crossing the antimeridian cover the whole width.
+        if (range.min.x <= range.max.x) {
+            minX = std::min(range.min.x, maxX);
+            maxX = std::min(range.max.x, maxX);
+        }
+        minY = std::min(range.min.y, maxY);
+        maxY = std::min(range.max.y, maxY);
+    }
+
+    const uint32_t size = options.metatileSize;
+    std::vector<std::pair<uint64_t, Metatile>> ordered;
+    uint32_t side = 1;
+    while (side < (worldTiles + size - 1) / size) {
+        side *= 2;
+    }
+    for (uint32_t my = minY / size; my <= maxY / size; ++my) {
+        for (uint32_t mx = minX / size; mx <= maxX / size; ++mx) {
+            const uint32_t x = std::max(mx * size, minX);
+            const uint32_t y = std::max(my * size, minY);
+            const Metatile metatile{z,
+                                    x,
+                                    y,
+                                    std::min(mx * size + size - 1, maxX) - x + 1,
+                                    std::min(my * size + size - 1, maxY) - y + 1};
+            ordered.emplace_back(hilbertIndex(side, mx, my), metatile);
+        }
+    }
+
+    std::sort(ordered.begin(), ordered.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    std::vector<Metatile> result;
+    result.reserve(ordered.size());
+    for (const auto& entry : ordered) {
+        result.push_back(entry.second);
+    }
+    return result;
+}
+
+void MetatileRenderer::render(uint8_t z, const TileCallback& callback, const std::optional<LatLngBounds>& bounds) {
+    // Tiles of the map are 512 px, so smaller output tiles are rendered from the zoom level above.
+    const double zoom = z + std::log2(static_cast<double>(options.tileSize) / util::tileSize_D);
+    const double scale = std::pow(2.0, z);
+    const auto tileSize = static_cast<float>(options.tileSize);
+    const auto buffer = static_cast<float>(options.buffer);
+    const auto worldWidth = static_cast<float>(1u << z) * tileSize;
+    const int64_t columns = ((int64_t(1) << z) + options.metatileSize - 1) / options.metatileSize;
+
+    const auto list = metatiles(z, bounds);
+    const auto cellOf = [this](const Metatile& metatile) {
+        return Cell{metatile.x / options.metatileSize, metatile.y / options.metatileSize};
+    };
+    std::set<Cell> pending;
+    for (const auto& metatile : list) {
+        pending.insert(cellOf(metatile));
+    }
+    // Calls `fn(cell, dx)` for the cells around `cell`, where `dx` moves the
+    // coordinates of the cell across the antimeridian.
+    const auto forEachNeighbour = [columns, worldWidth](const Cell& cell, const auto& fn) {
+        for (int64_t dy = -1; dy <= 1; ++dy) {
+            for (int64_t dx = -1; dx <= 1; ++dx) {
+                const int64_t x = cell.first + dx;
+                const float wrap = x < 0 ? -worldWidth : x >= columns ? worldWidth : 0.0f;
+                fn(Cell{(x + columns) % columns, cell.second + dy}, wrap);
+            }
+        }
+    };
+
+    // Symbols shown or hidden in the output of the rendered metatiles, in
+    // logical pixels of zoom level `z`. A metatile places the symbols reaching
+    // into it from its rendered neighbours the same way, so that labels along
+    // the seams between metatiles aren't cut off or placed twice.
+    std::map<Cell, std::vector<PlacedSymbolData>> placedSymbols;
+    Renderer& renderer = *frontend.getRenderer();
+    renderer.collectPlacedSymbolData(true);
+
+    for (const auto& metatile : list) {
+        const Size size{metatile.width * options.tileSize + 2 * options.buffer,
+                        metatile.height * options.tileSize + 2 * options.buffer};
+        map.setSize(size);
+        frontend.setSize(size);
+
+        // Top left corner of the viewport.
+        const float originX = static_cast<float>(metatile.x) * tileSize - buffer;
+        const float originY = static_cast<float>(metatile.y) * tileSize - buffer;
+        const Cell cell = cellOf(metatile);
+
+        std::vector<PlacedSymbolData> fixedSymbols;
+        forEachNeighbour(cell, [&](const Cell& neighbour, float wrap) {
+            const auto it = placedSymbols.find(neighbour);
+            if (it == placedSymbols.end()) return;
+            for (const auto& symbol : it->second) {
+                PlacedSymbolData fixed = symbol;
+                translate(fixed, wrap - originX + symbol.viewportPadding, -originY + symbol.viewportPadding);
+                const float padding = symbol.viewportPadding;
+                if (intersects(fixed, padding, padding, padding + size.width, padding + size.height)) {
+                    fixedSymbols.push_back(std::move(fixed));
+                }
+            }
+        });
+        renderer.setFixedPlacedSymbols(std::move(fixedSymbols));
+
+        const LatLng center = Projection::unproject({(metatile.x + metatile.width / 2.0) * util::tileSize_D,
+                                                     (metatile.y + metatile.height / 2.0) * util::tileSize_D},
+                                                    scale);
+        map.jumpTo(CameraOptions().withCenter(center).withZoom(zoom).withBearing(0.0).withPitch(0.0));
+
+        // The next metatile is rendered while this one is read back.
+        frontend.renderAsync(map, [this, metatile, &callback](HeadlessFrontend::RenderResult result) {
+            slice(metatile, result.image, callback);
+        });
+
+        // Keep the symbols that touch the output, which is cropped off the buffer.
+        auto& shown = placedSymbols[cell];
+        for (const auto& symbol : renderer.getPlacedSymbolsData()) {
+            const float x1 = symbol.viewportPadding + buffer;
+            const float y1 = symbol.viewportPadding + buffer;
+            if (intersects(symbol,
+                           x1,
+                           y1,
+                           x1 + static_cast<float>(metatile.width) * tileSize,
+                           y1 + static_cast<float>(metatile.height) * tileSize)) {
+                shown.push_back(symbol);
+                translate(shown.back(), originX - symbol.viewportPadding, originY - symbol.viewportPadding);
+            }
+        }
+        pending.erase(cell);
+
+        // Symbols of a metatile are no longer needed once its neighbours are rendered.
+        forEachNeighbour(cell, [&](const Cell& rendered, float) {
+            bool done = pending.count(rendered) == 0;
+            forEachNeighbour(rendered, [&](const Cell& neighbour, float) { done = done && !pending.count(neighbour); });
+            if (done) placedSymbols.erase(rendered);
+        });
+    }
+    frontend.finishRenders();
+    renderer.setFixedPlacedSymbols({});
+    renderer.collectPlacedSymbolData(false);
+}
+
+void MetatileRenderer::slice(const Metatile& metatile,
+                             const PremultipliedImage& image,
+                             const TileCallback& callback) const {
+    const uint32_t logicalWidth = metatile.width * options.tileSize + 2 * options.buffer;
+    const double pixelRatio = static_cast<double>(image.size.width) / logicalWidth;
+    const auto tilePixels = static_cast<uint32_t>(std::lround(options.tileSize * pixelRatio));
+    const auto bufferPixels = static_cast<uint32_t>(std::lround(options.buffer * pixelRatio));
+
+    for (uint32_t row = 0; row < metatile.height; ++row) {
+        for (uint32_t column = 0; column < metatile.width; ++column) {
+            PremultipliedImage tile({tilePixels, tilePixels});
+            PremultipliedImage::copy(image,
+                                     tile,
+                                     {bufferPixels + column * tilePixels, bufferPixels + row * tilePixels},
+                                     {0, 0},
+                                     tile.size);
+            callback(CanonicalTileID(metatile.z, metatile.x + column, metatile.y + row), std::move(tile));
+        }
+    }
+}
+
+} // namespace mbgl
@@ -1,6 +1,7 @@
 #include <mbgl/gl/headless_backend.hpp>
 #include <mbgl/gl/renderable_resource.hpp>
 #include <mbgl/gl/context.hpp>
+#include <mbgl/gl/framebuffer_readback.hpp>
 #include <mbgl/gfx/backend_scope.hpp>
 
 #include <cassert>
@@ -49,8 +50,9 @@ HeadlessBackend::~HeadlessBackend() {
     if (impl != nullptr && impl->glNeedsActiveContextOnDestruction()) {
         impl->activateContext();
     }
-    // Explicitly reset the renderable resource
+    // Explicitly reset the renderable resource and pending reads
     resource.reset();
+    readback.reset();
     // Explicitly reset the context so that it is destructed and cleaned up
     // before we destruct the impl object.
     context.reset();
@@ -101,6 +103,19 @@ PremultipliedImage HeadlessBackend::readStillImage() {
     return static_cast<gl::Context&>(getContext()).readFramebuffer<PremultipliedImage>(size);
 }
 
+void HeadlessBackend::readStillImageAsync(StillImageCallback callback, PremultipliedImage buffer) {
+    if (!readback) {
+        readback = std::make_unique<FramebufferReadback>(static_cast<gl::Context&>(getContext()));
+    }
+    readback->read(size, std::move(callback), std::move(buffer));
+}
+
+void HeadlessBackend::pollStillImages(bool wait) {
+    if (readback) {
+        readback->poll(wait);
+    }
+}
+
 RendererBackend* HeadlessBackend::getRendererBackend() {
     return this;
 }
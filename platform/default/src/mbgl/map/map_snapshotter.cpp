@@ -27,7 +27,7 @@ MapSnapshotterObserver& MapSnapshotterObserver::nullObserver() {
 class ForwardingRendererObserver final : public RendererObserver {
 public:
     explicit ForwardingRendererObserver(RendererObserver& delegate_)
-        : mailbox(std::make_shared<Mailbox>(*Scheduler::GetCurrent())),
+        : mailbox(std::make_shared<Mailbox>(Scheduler::GetCurrent()->withPriority(Scheduler::Priority::Critical))),
           delegate(delegate_, mailbox) {}
 
     ~ForwardingRendererObserver() override { mailbox->close(); }
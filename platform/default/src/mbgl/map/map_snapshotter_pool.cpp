@@ -0,0 +1,176 @@
+#include <mbgl/map/map_snapshotter_pool.hpp>
+
+#include <mbgl/storage/resource_options.hpp>
+#include <mbgl/util/async_task.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <deque>
+#include <utility>
+#include <vector>
+
+namespace mbgl {
+
+class MapSnapshotterPool::Impl {
+public:
+    Impl(std::size_t poolSize,
+         float pixelRatio,
+         const ResourceOptions& resourceOptions,
+         const ClientOptions& clientOptions,
+         const std::optional<std::string>& localFontFamily)
+        : dispatchTask([this] {
+              for (const auto& worker : workers) {
+                  if (worker->state == Worker::State::Finished) {
+                      worker->state = Worker::State::Idle;
+                  }
+              }
+              dispatch();
+          }) {
+        workers.reserve(poolSize);
+        for (std::size_t i = 0; i < std::max<std::size_t>(poolSize, 1); ++i) {
+            auto worker = std::make_unique<Worker>();
+            worker->snapshotter = std::make_unique<MapSnapshotter>(Size{256, 256},
+                                                                   pixelRatio,
+                                                                   resourceOptions,
+                                                                   clientOptions,
+                                                                   MapSnapshotterObserver::nullObserver(),
+                                                                   localFontFamily);
+            workers.push_back(std::move(worker));
+        }
+    }
+
+    void snapshot(Job job, MapSnapshotter::Callback callback) {
+        assert(job.styleURL.empty() != job.styleJSON.empty());
+        queue.push_back({std::move(job), std::move(callback)});
+        dispatch();
+    }
+
+    void cancelPending() { queue.clear(); }
+
+    std::size_t size() const { return workers.size(); }
+    std::size_t pending() const { return queue.size(); }
+    std::size_t active() const {
+        return static_cast<std::size_t>(std::count_if(workers.begin(), workers.end(), [](const auto& worker) {
+            return worker->state != Worker::State::Idle;
+        }));
+    }
+
+private:
+    struct Worker {
+        // A snapshotter only accepts the next job once the callback of the previous
+        // one has returned, so finished workers become idle from the run loop.
+        enum class State {
+            Idle,
+            Rendering,
+            Finished
+        };
+
+        std::unique_ptr<MapSnapshotter> snapshotter;
+        // URL or JSON of the loaded style, empty if none is known to be loaded
+        std::string style;
+        State state = State::Idle;
+    };
+
+    struct Entry {
+        Job job;
+        MapSnapshotter::Callback callback;
+    };
+
+    static const std::string& styleOf(const Job& job) { return job.styleURL.empty() ? job.styleJSON : job.styleURL; }
+
+    void dispatch() {
+        while (!queue.empty()) {
+            Worker* worker = nullptr;
+            for (const auto& candidate : workers) {
+                if (candidate->state != Worker::State::Idle) continue;
+                if (candidate->style == styleOf(queue.front().job)) {
+                    worker = candidate.get();
+                    break;
+                }
+                if (!worker) {
+                    worker = candidate.get();
+                }
+            }
+            if (!worker) {
+                return;
+            }
+
+            Entry entry = std::move(queue.front());
+            queue.pop_front();
+            start(*worker, std::move(entry));
+        }
+    }
+
+    void start(Worker& worker, Entry entry) {
+        MapSnapshotter& snapshotter = *worker.snapshotter;
+        const Job& job = entry.job;
+        if (worker.style != styleOf(job)) {
+            if (!job.styleURL.empty()) {
+                snapshotter.setStyleURL(job.styleURL);
+            } else {
+                snapshotter.setStyleJSON(job.styleJSON);
+            }
+            worker.style = styleOf(job);
+        }
+        if (snapshotter.getSize() != job.size) {
+            snapshotter.setSize(job.size);
+        }
+        snapshotter.setCameraOptions(job.camera);
+
+        worker.state = Worker::State::Rendering;
+        snapshotter.snapshot([this, &worker, callback = std::move(entry.callback)](
+                                 std::exception_ptr error,
+                                 PremultipliedImage image,
+                                 MapSnapshotter::Attributions attributions,
+                                 MapSnapshotter::PointForFn pointForFn,
+                                 MapSnapshotter::LatLngForFn latLngForFn) {
+            worker.state = Worker::State::Finished;
+            if (error) {
+                // The style may have failed to load; load it again for the next job.
+                worker.style.clear();
+            }
+            dispatchTask.send();
+            callback(std::move(error),
+                     std::move(image),
+                     std::move(attributions),
+                     std::move(pointForFn),
+                     std::move(latLngForFn));
+        });
+    }
+
+    std::deque<Entry> queue;
+    util::AsyncTask dispatchTask;
+    // Declared last, so that pending snapshots are cancelled first on destruction.
+    std::vector<std::unique_ptr<Worker>> workers;
+};
+
+MapSnapshotterPool::MapSnapshotterPool(std::size_t poolSize,
+                                       float pixelRatio,
+                                       const ResourceOptions& resourceOptions,
+                                       const ClientOptions& clientOptions,
+                                       std::optional<std::string> localFontFamily)
+    : impl(std::make_unique<Impl>(poolSize, pixelRatio, resourceOptions, clientOptions, localFontFamily)) {}
+
+MapSnapshotterPool::~MapSnapshotterPool() = default;
+
+void MapSnapshotterPool::snapshot(Job job, MapSnapshotter::Callback callback) {
+    impl->snapshot(std::move(job), std::move(callback));
+}
+
+void MapSnapshotterPool::cancelPending() {
+    impl->cancelPending();
+}
+
+std::size_t MapSnapshotterPool::size() const {
+    return impl->size();
+}
+
+std::size_t MapSnapshotterPool::pending() const {
+    return impl->pending();
+}
+
+std::size_t MapSnapshotterPool::active() const {
+    return impl->active();
+}
+
+} // namespace mbgl
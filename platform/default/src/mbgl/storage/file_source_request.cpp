@@ -7,7 +7,7 @@ namespace mbgl {
 
 FileSourceRequest::FileSourceRequest(FileSource::Callback&& callback)
     : responseCallback(callback),
-      mailbox(std::make_shared<Mailbox>(*Scheduler::GetCurrent())) {}
+      mailbox(std::make_shared<Mailbox>(Scheduler::GetCurrent()->withPriority(Scheduler::Priority::Low))) {}
 
 FileSourceRequest::~FileSourceRequest() {
     if (cancelCallback) {
@@ -20,6 +20,7 @@
 #include <mbgl/style/style.hpp>
 #include <mbgl/style/transition_options.hpp>
 #include <mbgl/util/chrono.hpp>
+#include <mbgl/util/constants.hpp>
 #include <mbgl/util/geo.hpp>
 #include <mbgl/util/interpolate.hpp>
 #include <mbgl/util/io.hpp>
@@ -980,6 +981,7 @@ void GLFWView::run() {
         }
     };
 
+    runLoop.setTimeBudget(mbgl::util::DEFAULT_MAP_THREAD_TIME_BUDGET);
     frameTick.start(mbgl::Duration::zero(), mbgl::Milliseconds(1000 / 60), callback);
 #if defined(__APPLE__)
     while (!glfwWindowShouldClose(window)) runLoop.run();
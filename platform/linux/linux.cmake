@@ -20,6 +20,7 @@ target_sources(
     PRIVATE
         ${PROJECT_SOURCE_DIR}/platform/default/src/mbgl/gfx/headless_backend.cpp
         ${PROJECT_SOURCE_DIR}/platform/default/src/mbgl/gfx/headless_frontend.cpp
+        ${PROJECT_SOURCE_DIR}/platform/default/src/mbgl/gfx/metatile_renderer.cpp
         ${PROJECT_SOURCE_DIR}/platform/default/src/mbgl/gl/headless_backend.cpp
         ${PROJECT_SOURCE_DIR}/platform/default/src/mbgl/i18n/collator.cpp
         ${PROJECT_SOURCE_DIR}/platform/default/src/mbgl/i18n/number_format.cpp
@@ -212,6 +213,17 @@ target_link_libraries(
 if(NOT DEFINED ENV{CI})
     add_test(NAME mbgl-benchmark-runner COMMAND mbgl-benchmark-runner WORKING_DIRECTORY ${PROJECT_SOURCE_DIR})
 endif()
+
+# Runs the stages of the tile pipeline and writes their timings to a JSON report
+add_custom_target(
+    mbgl-benchmark-tile-pipeline
+    COMMAND
+        mbgl-benchmark-runner --benchmark_filter=^TilePipeline_ --benchmark_out=${CMAKE_BINARY_DIR}/tile-pipeline.json
+        --benchmark_out_format=json
+    DEPENDS mbgl-benchmark-runner
+    WORKING_DIRECTORY ${PROJECT_SOURCE_DIR}
+)
+
 add_test(NAME mbgl-test-runner COMMAND mbgl-test-runner WORKING_DIRECTORY ${PROJECT_SOURCE_DIR})
 
 install(TARGETS mbgl-render-test-runner RUNTIME DESTINATION bin)
@@ -223,4 +223,76 @@ declare module '@maplibre/maplibre-gl-native' {
      */
     setYSkew: (y: number) => void;
   }
+
+  type RenderPoolOptions = {
+    /**
+     * Number of maps rendering in parallel, each on its own thread
+     *
+     * @default 4
+     */
+    size?: number;
+
+    /**
+     * Pixel ratio at which to render images
+     *
+     * @default 1
+     */
+    ratio?: number;
+
+    /**
+     * Mode in which map views will be rendered
+     *
+     * @default MapMode.Static
+     */
+    mode?: MapMode;
+
+    /**
+     * Number of renders that may wait for a free map, after which `render` throws
+     *
+     * @default 64
+     */
+    maxQueue?: number;
+
+    /**
+     * Path of the resource cache
+     *
+     * @default ':memory:'
+     */
+    cachePath?: string;
+
+    /**
+     * Directory that `asset://` URLs are loaded from
+     *
+     * @default '.'
+     */
+    assetPath?: string;
+  };
+
+  /**
+   * A `RenderPool` instance renders images on several maps in parallel, off the main thread.
+   * Resources are loaded by the built-in file sources rather than by a `request` function.
+   */
+  class RenderPool {
+    constructor(options?: RenderPoolOptions);
+
+    /**
+     * Render a map view of a style on the next free map. Throws if the queue of waiting renders is full.
+     */
+    render(style: any, renderOptions: RenderOptions, callback: (...args: [error: Error, buffer: undefined] | [error: undefined, buffer: Uint8Array]) => void): void;
+
+    /**
+     * Number of renders waiting for a free map
+     */
+    pending: () => number;
+
+    /**
+     * Number of maps that are rendering
+     */
+    active: () => number;
+
+    /**
+     * Stop the threads of the pool and dispose its maps, calling back unfinished renders with an error
+     */
+    release: () => void;
+  }
 }
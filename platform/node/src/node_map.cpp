@@ -23,6 +23,7 @@
 #include <mbgl/map/map.hpp>
 #include <mbgl/map/map_observer.hpp>
 #include <mbgl/storage/file_source_manager.hpp>
+#include <mbgl/storage/main_resource_loader.hpp>
 #include <mbgl/storage/resource_options.hpp>
 #include <mbgl/style/image.hpp>
 #include <mbgl/style/light.hpp>
@@ -34,21 +35,6 @@
 
 namespace node_mbgl {
 
-struct NodeMap::RenderOptions {
-    double zoom = 0;
-    double bearing = 0;
-    mbgl::style::Light light;
-    double pitch = 0;
-    double latitude = 0;
-    double longitude = 0;
-    mbgl::Size size = {512, 512};
-    bool axonometric = false;
-    double xSkew = 0;
-    double ySkew = 1;
-    std::vector<std::string> classes;
-    mbgl::MapDebugOptions debugOptions = mbgl::MapDebugOptions::NoDebug;
-};
-
 Nan::Persistent<v8::Function> NodeMap::constructor;
 Nan::Persistent<v8::Object> NodeMap::parseError;
 
@@ -208,7 +194,12 @@ void NodeMap::New(const Nan::FunctionCallbackInfo<v8::Value>& info) {
         Nan::Get(options, Nan::New("request").ToLocalChecked()).ToLocalChecked()->IsFunction()) {
         mbgl::FileSourceManager::get()->registerFileSourceFactory(
             mbgl::FileSourceType::ResourceLoader,
-            [](const mbgl::ResourceOptions& resourceOptions, const mbgl::ClientOptions&) {
+            [](const mbgl::ResourceOptions& resourceOptions,
+               const mbgl::ClientOptions& clientOptions) -> std::unique_ptr<mbgl::FileSource> {
+                // Maps of a RenderPool have no NodeMap to ask for resources.
+                if (!resourceOptions.platformContext()) {
+                    return std::make_unique<mbgl::MainResourceLoader>(resourceOptions, clientOptions);
+                }
                 return std::make_unique<node_mbgl::NodeFileSource>(
                     reinterpret_cast<node_mbgl::NodeMap*>(resourceOptions.platformContext()));
             });
@@ -520,9 +511,11 @@ void NodeMap::startRender() {
     uv_ref(reinterpret_cast<uv_handle_t*>(async));
 }
 
-void NodeMap::startRender(const NodeMap::RenderOptions& options) {
-    frontend->setSize(options.size);
-    map->setSize(options.size);
+mbgl::CameraOptions NodeMap::PrepareRender(mbgl::HeadlessFrontend& frontend,
+                                           mbgl::Map& map,
+                                           const NodeMap::RenderOptions& options) {
+    frontend.setSize(options.size);
+    map.setSize(options.size);
 
     mbgl::CameraOptions camera;
     camera.center = mbgl::LatLng{options.latitude, options.longitude};
@@ -533,7 +526,13 @@ void NodeMap::startRender(const NodeMap::RenderOptions& options) {
     auto projectionOptions =
         mbgl::ProjectionMode().withAxonometric(options.axonometric).withXSkew(options.xSkew).withYSkew(options.ySkew);
 
-    map->setProjectionMode(projectionOptions);
+    map.setProjectionMode(projectionOptions);
+
+    return camera;
+}
+
+void NodeMap::startRender(const NodeMap::RenderOptions& options) {
+    auto camera = PrepareRender(*frontend, *map, options);
 
     map->renderStill(camera, options.debugOptions, [this](const std::exception_ptr& eptr) {
         if (eptr) {
@@ -3,11 +3,14 @@
 #include <mbgl/map/map.hpp>
 #include <mbgl/storage/file_source.hpp>
 #include <mbgl/storage/resource_options.hpp>
+#include <mbgl/style/light.hpp>
 #include <mbgl/util/async_request.hpp>
 #include <mbgl/util/client_options.hpp>
 #include <mbgl/util/image.hpp>
 
 #include <exception>
+#include <string>
+#include <vector>
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-parameter"
@@ -29,7 +32,20 @@ class RenderRequest;
 
 class NodeMap : public Nan::ObjectWrap {
 public:
-    struct RenderOptions;
+    struct RenderOptions {
+        double zoom = 0;
+        double bearing = 0;
+        mbgl::style::Light light;
+        double pitch = 0;
+        double latitude = 0;
+        double longitude = 0;
+        mbgl::Size size = {512, 512};
+        bool axonometric = false;
+        double xSkew = 0;
+        double ySkew = 1;
+        std::vector<std::string> classes;
+        mbgl::MapDebugOptions debugOptions = mbgl::MapDebugOptions::NoDebug;
+    };
     class RenderWorker;
 
     NodeMap(v8::Local<v8::Object>);
@@ -81,6 +97,8 @@ public:
     void cancel();
 
     static RenderOptions ParseOptions(v8::Local<v8::Object>);
+    // Resizes the map and sets its projection for a render, and returns its camera.
+    static mbgl::CameraOptions PrepareRender(mbgl::HeadlessFrontend&, mbgl::Map&, const RenderOptions&);
 
     const float pixelRatio;
     mbgl::MapMode mode;
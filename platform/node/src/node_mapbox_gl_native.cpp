@@ -11,6 +11,7 @@
 
 #include "node_map.hpp"
 #include "node_logging.hpp"
+#include "node_render_pool.hpp"
 #include "node_request.hpp"
 #include "node_expression.hpp"
 
@@ -35,6 +36,7 @@ void RegisterModule(v8::Local<v8::Object> target, v8::Local<v8::Object> module)
 
     node_mbgl::NodeMap::Init(target);
     node_mbgl::NodeRequest::Init(target);
+    node_mbgl::NodeRenderPool::Init(target);
     node_mbgl::NodeExpression::Init(target);
 
     // Exports Resource constants.
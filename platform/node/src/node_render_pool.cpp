@@ -0,0 +1,447 @@
+#include "node_render_pool.hpp"
+#include "node_map.hpp"
+#include "util/async_queue.hpp"
+
+#include <mbgl/gfx/headless_frontend.hpp>
+#include <mbgl/map/map.hpp>
+#include <mbgl/map/map_observer.hpp>
+#include <mbgl/map/map_options.hpp>
+#include <mbgl/style/conversion.hpp>
+#include <mbgl/style/style.hpp>
+#include <mbgl/util/exception.hpp>
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/thread.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <exception>
+#include <optional>
+
+namespace node_mbgl {
+
+class RenderPoolJob : public Nan::AsyncResource {
+public:
+    RenderPoolJob(v8::Local<v8::Function> callback_, std::string style_, NodeMap::RenderOptions options_)
+        : AsyncResource("mbgl:RenderPoolJob"),
+          style(std::move(style_)),
+          options(std::move(options_)) {
+        callback.Reset(callback_);
+    }
+    ~RenderPoolJob() { callback.Reset(); }
+
+    Nan::Persistent<v8::Function> callback;
+    const std::string style;
+    const NodeMap::RenderOptions options;
+};
+
+struct RenderPoolResult {
+    std::size_t worker;
+    std::exception_ptr error;
+    mbgl::PremultipliedImage image;
+};
+
+// Lives on the thread of a worker, and renders the jobs sent to it there.
+class RenderPoolWorker {
+public:
+    RenderPoolWorker(std::size_t index_,
+                     float pixelRatio,
+                     mbgl::MapMode mode,
+                     const mbgl::ResourceOptions& resourceOptions,
+                     util::AsyncQueue<RenderPoolResult>* results_)
+        : index(index_),
+          results(results_),
+          frontend(mbgl::Size{512, 512}, pixelRatio),
+          map(frontend,
+              mbgl::MapObserver::nullObserver(),
+              mbgl::MapOptions().withSize(frontend.getSize()).withPixelRatio(pixelRatio).withMapMode(mode),
+              resourceOptions) {}
+
+    // The style is empty if the map has the style of the job loaded already.
+    void render(const std::string& style, const NodeMap::RenderOptions& options) {
+        RenderPoolResult result{index, nullptr, {}};
+
+        try {
+            if (!style.empty()) {
+                map.getStyle().loadJSON(style);
+            }
+            map.jumpTo(NodeMap::PrepareRender(frontend, map, options));
+            map.setDebug(options.debugOptions);
+            result.image = frontend.render(map).image;
+        } catch (...) {
+            result.error = std::current_exception();
+        }
+
+        results->send(std::move(result));
+    }
+
+private:
+    const std::size_t index;
+    util::AsyncQueue<RenderPoolResult>* results;
+    mbgl::HeadlessFrontend frontend;
+    mbgl::Map map;
+};
+
+struct NodeRenderPool::Worker {
+    std::unique_ptr<mbgl::util::Thread<RenderPoolWorker>> thread;
+    // The style loaded by the map of the worker.
+    std::string style;
+    // The job being rendered, if any.
+    std::unique_ptr<RenderPoolJob> job;
+};
+
+Nan::Persistent<v8::Function> NodeRenderPool::constructor;
+
+static const char* releasedMessage() {
+    return "Render pool resources have already been released";
+}
+
+void NodeRenderPool::Init(v8::Local<v8::Object> target) {
+#if defined NODE_MODULE_VERSION && NODE_MODULE_VERSION < 93
+    v8::Local<v8::Context> context = target->CreationContext();
+#else
+    v8::Local<v8::Context> context = target->GetCreationContext().ToLocalChecked();
+#endif
+
+    v8::Local<v8::FunctionTemplate> tpl = Nan::New<v8::FunctionTemplate>(New);
+
+    tpl->SetClassName(Nan::New("RenderPool").ToLocalChecked());
+    tpl->InstanceTemplate()->SetInternalFieldCount(1);
+
+    Nan::SetPrototypeMethod(tpl, "render", Render);
+    Nan::SetPrototypeMethod(tpl, "pending", Pending);
+    Nan::SetPrototypeMethod(tpl, "active", Active);
+    Nan::SetPrototypeMethod(tpl, "release", Release);
+
+    constructor.Reset(tpl->GetFunction(context).ToLocalChecked());
+    Nan::Set(target, Nan::New("RenderPool").ToLocalChecked(), tpl->GetFunction(context).ToLocalChecked());
+}
+
+/**
+ * A pool of maps that render images in parallel, each on its own thread, so
+ * that the main thread is free while they render. Resources are loaded from
+ * the network, the cache and the asset path rather than by a `request`
+ * function.
+ *
+ * @class
+ * @name RenderPool
+ * @param {Object} [options]
+ * @param {number} [options.size=4] number of maps rendering in parallel
+ * @param {number} [options.ratio=1] pixel ratio
+ * @param {string} [options.mode="static"] "static" or "tile"
+ * @param {number} [options.maxQueue=64] number of renders that may wait for a
+ * free map, after which `render` throws
+ * @param {string} [options.cachePath=":memory:"] path of the resource cache
+ * @param {string} [options.assetPath="."] directory of `asset://` URLs
+ * @example
+ * var pool = new mbgl.RenderPool({ size: 4 });
+ * pool.render(require('./test/fixtures/style.json'), { zoom: 2 }, function(err, image) {
+ *     if (err) throw err;
+ *     fs.writeFileSync('image.raw', image);
+ * });
+ */
+void NodeRenderPool::New(const Nan::FunctionCallbackInfo<v8::Value>& info) {
+    if (!info.IsConstructCall()) {
+        return Nan::ThrowTypeError("Use the new operator to create new RenderPool objects");
+    }
+
+    if (info.Length() > 0 && !info[0]->IsObject()) {
+        return Nan::ThrowTypeError("Requires an options object as first argument");
+    }
+
+    v8::Local<v8::Object> options = info.Length() > 0 ? Nan::To<v8::Object>(info[0]).ToLocalChecked()
+                                                       : Nan::New<v8::Object>();
+
+    auto number = [&](const char* name, double defaultValue) -> std::optional<double> {
+        if (!Nan::Has(options, Nan::New(name).ToLocalChecked()).FromJust()) {
+            return defaultValue;
+        }
+        auto value = Nan::Get(options, Nan::New(name).ToLocalChecked()).ToLocalChecked();
+        if (!value->IsNumber()) {
+            return std::nullopt;
+        }
+        return Nan::To<double>(value).ToChecked();
+    };
+    auto string = [&](const char* name) -> std::optional<std::string> {
+        if (!Nan::Has(options, Nan::New(name).ToLocalChecked()).FromJust()) {
+            return std::nullopt;
+        }
+        return std::string(*Nan::Utf8String(Nan::Get(options, Nan::New(name).ToLocalChecked()).ToLocalChecked()));
+    };
+
+    const auto size = number("size", 4);
+    if (!size || *size < 1) {
+        return Nan::ThrowError("Options object 'size' property must be a positive number");
+    }
+
+    const auto ratio = number("ratio", 1);
+    if (!ratio) {
+        return Nan::ThrowError("Options object 'ratio' property must be a number");
+    }
+
+    const auto maxQueue = number("maxQueue", 64);
+    if (!maxQueue || *maxQueue < 0) {
+        return Nan::ThrowError("Options object 'maxQueue' property must be a number");
+    }
+
+    const auto mode = string("mode").value_or("") == "tile" ? mbgl::MapMode::Tile : mbgl::MapMode::Static;
+
+    mbgl::ResourceOptions resourceOptions;
+    if (auto cachePath = string("cachePath")) {
+        resourceOptions.withCachePath(*cachePath);
+    }
+    if (auto assetPath = string("assetPath")) {
+        resourceOptions.withAssetPath(*assetPath);
+    }
+
+    try {
+        auto pool = new NodeRenderPool(static_cast<std::size_t>(*size),
+                                       static_cast<float>(*ratio),
+                                       mode,
+                                       static_cast<std::size_t>(*maxQueue),
+                                       std::move(resourceOptions));
+        pool->Wrap(info.This());
+    } catch (std::exception& ex) {
+        return Nan::ThrowError(ex.what());
+    }
+
+    info.GetReturnValue().Set(info.This());
+}
+
+/**
+ * Render an image of a style on the next free map of the pool. The image is
+ * given to the callback as a buffer over the memory it was read back into.
+ *
+ * @name render
+ * @param {string|Object} stylesheet either an object or a JSON representation
+ * @param {Object} options the same options as `Map#render`
+ * @param {Function} callback
+ * @returns {undefined} calls callback
+ * @throws {Error} if the queue of renders waiting for a free map is full
+ */
+void NodeRenderPool::Render(const Nan::FunctionCallbackInfo<v8::Value>& info) {
+    v8::Local<v8::Context> context = info.GetIsolate()->GetCurrentContext();
+    auto pool = Nan::ObjectWrap::Unwrap<NodeRenderPool>(info.Holder());
+    if (pool->workers.empty()) return Nan::ThrowError(releasedMessage());
+
+    if (info.Length() < 3) {
+        return Nan::ThrowTypeError("Requires a style, an options object and a callback function");
+    }
+
+    std::string style;
+    if (info[0]->IsString()) {
+        style = *Nan::Utf8String(info[0]);
+    } else if (info[0]->IsObject()) {
+        Nan::JSON JSON;
+        style = *Nan::Utf8String(JSON.Stringify(info[0]->ToObject(context).ToLocalChecked()).ToLocalChecked());
+    } else {
+        return Nan::ThrowTypeError("First argument must be a string or object");
+    }
+
+    if (!info[1]->IsObject()) {
+        return Nan::ThrowTypeError("Second argument must be an options object");
+    }
+
+    if (!info[2]->IsFunction()) {
+        return Nan::ThrowTypeError("Third argument must be a callback function");
+    }
+
+    // Renders that can start right away don't count towards the queue.
+    if (pool->queue.size() >= pool->maxQueue && pool->active() == pool->workers.size()) {
+        return Nan::ThrowError("Render queue is full");
+    }
+
+    try {
+        auto options = NodeMap::ParseOptions(Nan::To<v8::Object>(info[1]).ToLocalChecked());
+        pool->queue.push_back(std::make_unique<RenderPoolJob>(
+            Nan::To<v8::Function>(info[2]).ToLocalChecked(), std::move(style), std::move(options)));
+    } catch (const mbgl::style::conversion::Error& err) {
+        return Nan::ThrowTypeError(err.message.c_str());
+    }
+
+    // Retain this object until the job has been rendered, and keep the loop
+    // alive while waiting for it.
+    pool->Ref();
+    pool->results->ref();
+
+    pool->dispatch();
+
+    info.GetReturnValue().SetUndefined();
+}
+
+/**
+ * The number of renders waiting for a free map.
+ *
+ * @name pending
+ * @returns {number}
+ */
+void NodeRenderPool::Pending(const Nan::FunctionCallbackInfo<v8::Value>& info) {
+    auto pool = Nan::ObjectWrap::Unwrap<NodeRenderPool>(info.Holder());
+    info.GetReturnValue().Set(Nan::New(static_cast<double>(pool->queue.size())));
+}
+
+/**
+ * The number of maps that are rendering.
+ *
+ * @name active
+ * @returns {number}
+ */
+void NodeRenderPool::Active(const Nan::FunctionCallbackInfo<v8::Value>& info) {
+    auto pool = Nan::ObjectWrap::Unwrap<NodeRenderPool>(info.Holder());
+    info.GetReturnValue().Set(Nan::New(static_cast<double>(pool->active())));
+}
+
+/**
+ * Stop the threads of the pool and release its maps. Renders that have not
+ * finished are called back with an error.
+ *
+ * @name release
+ * @returns {undefined}
+ */
+void NodeRenderPool::Release(const Nan::FunctionCallbackInfo<v8::Value>& info) {
+    auto pool = Nan::ObjectWrap::Unwrap<NodeRenderPool>(info.Holder());
+    if (pool->workers.empty()) return Nan::ThrowError(releasedMessage());
+
+    pool->release();
+
+    info.GetReturnValue().SetUndefined();
+}
+
+NodeRenderPool::NodeRenderPool(std::size_t size,
+                               float pixelRatio,
+                               mbgl::MapMode mode,
+                               std::size_t maxQueue_,
+                               mbgl::ResourceOptions resourceOptions)
+    : maxQueue(maxQueue_),
+      results(new util::AsyncQueue<RenderPoolResult>(
+          uv_default_loop(), [this](RenderPoolResult& result) { renderFinished(result); })) {
+    // Make sure the async handle doesn't keep the loop alive.
+    results->unref();
+
+    workers.reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        auto worker = std::make_unique<Worker>();
+        worker->thread = std::make_unique<mbgl::util::Thread<RenderPoolWorker>>(
+            "RenderPool", i, pixelRatio, mode, resourceOptions.clone(), results);
+        workers.push_back(std::move(worker));
+    }
+}
+
+NodeRenderPool::~NodeRenderPool() {
+    // Jobs retain the pool, so there are none left by the time it is collected.
+    assert(!active() && queue.empty());
+    workers.clear();
+    results->stop();
+}
+
+std::size_t NodeRenderPool::active() const {
+    return std::count_if(workers.begin(), workers.end(), [](const auto& worker) { return bool(worker->job); });
+}
+
+void NodeRenderPool::dispatch() {
+    while (!queue.empty()) {
+        // Prefer a free map that has the style of the job loaded already, so
+        // that it doesn't have to be loaded and parsed again.
+        Worker* free = nullptr;
+        for (auto& worker : workers) {
+            if (!worker->job && (!free || worker->style == queue.front()->style)) {
+                free = worker.get();
+            }
+        }
+        if (!free) {
+            return;
+        }
+
+        free->job = std::move(queue.front());
+        queue.pop_front();
+
+        const bool reload = free->style != free->job->style;
+        if (reload) {
+            free->style = free->job->style;
+        }
+        free->thread->actor().invoke(
+            &RenderPoolWorker::render, reload ? free->job->style : std::string(), free->job->options);
+    }
+}
+
+void NodeRenderPool::renderFinished(RenderPoolResult& result) {
+    Nan::HandleScope scope;
+
+    // The results of released workers are still delivered by the queue.
+    if (result.worker >= workers.size() || !workers[result.worker]->job) {
+        return;
+    }
+
+    auto& worker = *workers[result.worker];
+    auto job = std::move(worker.job);
+    if (result.error) {
+        // The style might not have loaded, so load it again next time.
+        worker.style.clear();
+    }
+
+    // Hand the map its next job before calling back, so that it keeps rendering.
+    dispatch();
+    if (!active()) {
+        results->unref();
+    }
+
+    v8::Local<v8::Function> callback = Nan::New(job->callback);
+    v8::Local<v8::Object> target = Nan::New<v8::Object>();
+
+    if (result.error) {
+        v8::Local<v8::Value> err;
+
+        try {
+            std::rethrow_exception(result.error);
+        } catch (const mbgl::util::StyleParseException& ex) {
+            err = NodeMap::ParseError(ex.what());
+        } catch (const std::exception& ex) {
+            err = Nan::Error(ex.what());
+        }
+
+        v8::Local<v8::Value> argv[] = {err};
+        job->runInAsyncScope(target, callback, 1, argv);
+    } else {
+        auto& image = result.image;
+        v8::Local<v8::Object> pixels = Nan::NewBuffer(
+                                           reinterpret_cast<char*>(image.data.get()),
+                                           image.bytes(),
+                                           // Retain the data until the buffer is deleted.
+                                           [](char*, void* hint) { delete[] reinterpret_cast<uint8_t*>(hint); },
+                                           image.data.get())
+                                           .ToLocalChecked();
+        if (!pixels.IsEmpty()) {
+            image.data.release();
+        }
+
+        v8::Local<v8::Value> argv[] = {Nan::Null(), pixels};
+        job->runInAsyncScope(target, callback, 2, argv);
+    }
+
+    Unref();
+}
+
+void NodeRenderPool::release() {
+    // Waits for the maps to finish what they are rendering.
+    std::vector<std::unique_ptr<RenderPoolJob>> jobs;
+    for (auto& worker : workers) {
+        worker->thread.reset();
+        if (worker->job) {
+            jobs.push_back(std::move(worker->job));
+        }
+    }
+    workers.clear();
+    for (auto& job : queue) {
+        jobs.push_back(std::move(job));
+    }
+    queue.clear();
+    results->unref();
+
+    Nan::HandleScope scope;
+    for (auto& job : jobs) {
+        v8::Local<v8::Value> argv[] = {Nan::Error(releasedMessage())};
+        job->runInAsyncScope(Nan::New<v8::Object>(), Nan::New(job->callback), 1, argv);
+        Unref();
+    }
+}
+
+} // namespace node_mbgl
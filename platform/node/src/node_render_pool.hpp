@@ -0,0 +1,63 @@
+#pragma once
+
+#include <mbgl/map/mode.hpp>
+#include <mbgl/storage/resource_options.hpp>
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#pragma GCC diagnostic ignored "-Wshadow"
+#include <nan.h>
+#pragma GCC diagnostic pop
+
+namespace node_mbgl {
+
+namespace util {
+template <typename T>
+class AsyncQueue;
+} // namespace util
+
+class RenderPoolJob;
+struct RenderPoolResult;
+class RenderPoolWorker;
+
+// Owns several maps, each rendering on its own thread with its own context,
+// and renders the jobs given to it on whichever map is free. Resources are
+// loaded by the default file sources, since JavaScript request functions can
+// only be called on the main thread.
+class NodeRenderPool : public Nan::ObjectWrap {
+public:
+    NodeRenderPool(std::size_t size, float pixelRatio, mbgl::MapMode, std::size_t maxQueue, mbgl::ResourceOptions);
+    ~NodeRenderPool() override;
+
+    static Nan::Persistent<v8::Function> constructor;
+
+    static void Init(v8::Local<v8::Object>);
+
+    static void New(const Nan::FunctionCallbackInfo<v8::Value>&);
+    static void Render(const Nan::FunctionCallbackInfo<v8::Value>&);
+    static void Pending(const Nan::FunctionCallbackInfo<v8::Value>&);
+    static void Active(const Nan::FunctionCallbackInfo<v8::Value>&);
+    static void Release(const Nan::FunctionCallbackInfo<v8::Value>&);
+
+private:
+    struct Worker;
+
+    void dispatch();
+    void renderFinished(RenderPoolResult&);
+    void release();
+    std::size_t active() const;
+
+    const std::size_t maxQueue;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::deque<std::unique_ptr<RenderPoolJob>> queue;
+
+    // Delivers the rendered images from the worker threads.
+    util::AsyncQueue<RenderPoolResult>* results;
+};
+
+} // namespace node_mbgl
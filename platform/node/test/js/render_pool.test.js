@@ -0,0 +1,86 @@
+'use strict';
+
+var test = require('tape');
+var mbgl = require('../../index');
+
+var style = {
+    version: 8,
+    sources: {},
+    layers: [{ id: 'background', type: 'background', paint: { 'background-color': 'red' } }]
+};
+
+test('RenderPool', function(t) {
+    t.test('must be constructed with no options or with options object', function(t) {
+        t.doesNotThrow(function() {
+            var pool = new mbgl.RenderPool();
+            pool.release();
+        });
+
+        t.throws(function() {
+            new mbgl.RenderPool('options');
+        }, /Requires an options object as first argument/);
+
+        t.throws(function() {
+            new mbgl.RenderPool({ size: 0 });
+        }, /Options object 'size' property must be a positive number/);
+
+        t.end();
+    });
+
+    t.test('renders concurrently', function(t) {
+        var pool = new mbgl.RenderPool({ size: 2 });
+        var remaining = 5;
+
+        for (var i = 0; i < 5; ++i) {
+            pool.render(style, { width: 32, height: 16 }, function(err, pixels) {
+                t.error(err);
+                t.equal(pixels.length, 32 * 16 * 4);
+                t.deepEqual(Array.from(pixels.slice(0, 4)), [255, 0, 0, 255]);
+                if (--remaining === 0) {
+                    t.equal(pool.active(), 0);
+                    t.equal(pool.pending(), 0);
+                    pool.release();
+                    t.end();
+                }
+            });
+        }
+
+        t.equal(pool.active(), 2);
+        t.equal(pool.pending(), 3);
+    });
+
+    t.test('throws when the queue is full', function(t) {
+        var pool = new mbgl.RenderPool({ size: 1, maxQueue: 1 });
+        var callbacks = 0;
+        var done = function() {
+            if (++callbacks === 2) {
+                pool.release();
+                t.end();
+            }
+        };
+
+        pool.render(style, {}, done);
+        pool.render(style, {}, done);
+        t.throws(function() {
+            pool.render(style, {}, done);
+        }, /Render queue is full/);
+    });
+
+    t.test('calls back renders with an error on release', function(t) {
+        var pool = new mbgl.RenderPool({ size: 1 });
+        var errors = [];
+
+        pool.render(style, {}, function() {});
+        pool.render(style, {}, function(err) {
+            errors.push(err);
+        });
+        pool.release();
+
+        t.equal(errors.length, 1);
+        t.match(errors[0].message, /released/);
+        t.throws(function() {
+            pool.render(style, {}, function() {});
+        }, /Render pool resources have already been released/);
+        t.end();
+    });
+});
@@ -0,0 +1,115 @@
+'use strict';
+
+// Measures renders per second in a single process, rendering with a pool of
+// `mbgl.Map` objects on the main thread and with an `mbgl.RenderPool` of the
+// same size.
+
+var fs = require('fs');
+var path = require('path');
+var mbgl = require('../index');
+
+var params = {
+    poolSize: 4,
+    numRenderings: 400,
+    width: 512,
+    height: 512,
+    ratio: 1
+};
+
+var tiles = 'file://' + path.resolve(__dirname, 'fixtures/tiles') + '/{z}-{x}-{y}.vector.pbf';
+var style = require('./fixtures/style.json');
+style.sources.mapbox.tiles = [tiles];
+style.sources.mapbox.maxzoom = 0;
+
+function renderOptions(i) {
+    return {
+        zoom: i % 4,
+        center: [(i % 17) * 10 - 80, (i % 7) * 10 - 30],
+        width: params.width,
+        height: params.height
+    };
+}
+
+function report(name, start, failures) {
+    var seconds = Number(process.hrtime.bigint() - start) / 1e9;
+    console.log(name + ': ' + (params.numRenderings / seconds).toFixed(1) + ' renders/s' +
+        (failures ? ' (' + failures + ' failures)' : ''));
+}
+
+function benchmarkMaps(callback) {
+    var maps = [];
+    for (var i = 0; i < params.poolSize; ++i) {
+        var map = new mbgl.Map({
+            request: function(req, callback) {
+                fs.readFile(req.url.replace('file://', ''), function(err, data) {
+                    callback(err, { data: data });
+                });
+            },
+            ratio: params.ratio
+        });
+        map.load(style);
+        maps.push(map);
+    }
+
+    var started = 0;
+    var finished = 0;
+    var failures = 0;
+    var start = process.hrtime.bigint();
+
+    function next(map) {
+        if (started === params.numRenderings) {
+            return;
+        }
+        map.render(renderOptions(started++), function(err) {
+            if (err) failures += 1;
+            if (++finished === params.numRenderings) {
+                report('Map x ' + params.poolSize, start, failures);
+                maps.forEach(function(map) { map.release(); });
+                callback();
+            } else {
+                next(map);
+            }
+        });
+    }
+
+    maps.forEach(next);
+}
+
+function benchmarkRenderPool(callback) {
+    var pool = new mbgl.RenderPool({ size: params.poolSize, ratio: params.ratio, maxQueue: params.poolSize * 4 });
+
+    var started = 0;
+    var finished = 0;
+    var failures = 0;
+    var start = process.hrtime.bigint();
+
+    // Keeps the queue topped up, the way a server would stop reading requests
+    // while the pool is busy.
+    function fill() {
+        while (started < params.numRenderings) {
+            try {
+                pool.render(style, renderOptions(started), done);
+            } catch (err) {
+                return;
+            }
+            started += 1;
+        }
+    }
+
+    function done(err) {
+        if (err) failures += 1;
+        if (++finished === params.numRenderings) {
+            report('RenderPool x ' + params.poolSize, start, failures);
+            pool.release();
+            callback();
+        } else {
+            fill();
+        }
+    }
+
+    fill();
+}
+
+benchmarkMaps(function() {
+    benchmarkRenderPool(function() {});
+});
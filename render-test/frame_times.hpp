@@ -0,0 +1,35 @@
+#pragma once
+
+#include <mbgl/math/clamp.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+namespace mbgl {
+
+// Frame times in milliseconds.
+struct FrameTimeSummary {
+    float median = 0.0f;
+    float p95 = 0.0f;
+    float p99 = 0.0f;
+    // Half-width of the 95% confidence interval of the median.
+    float confidence = 0.0f;
+};
+
+// Percentiles are the samples at the nearest rank. The confidence interval of the median is taken
+// from the order statistics 1.96 * sqrt(n) / 2 ranks around it, so that it doesn't depend on how
+// frame times are distributed.
+inline FrameTimeSummary summarizeFrameTimes(std::vector<float> samples) {
+    assert(!samples.empty());
+    std::sort(samples.begin(), samples.end());
+    const auto last = static_cast<double>(samples.size() - 1);
+    auto at = [&](double rank) {
+        return samples[static_cast<std::size_t>(std::round(util::clamp(rank, 0.0, last)))];
+    };
+    const double spread = 0.98 * std::sqrt(static_cast<double>(samples.size()));
+    return {at(0.5 * last), at(0.95 * last), at(0.99 * last), (at(0.5 * last + spread) - at(0.5 * last - spread)) / 2};
+}
+
+} // namespace mbgl
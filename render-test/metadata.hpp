@@ -8,6 +8,7 @@
 #include <mbgl/util/size.hpp>
 
 #include "filesystem.hpp"
+#include "frame_times.hpp"
 
 #include <list>
 #include <map>
@@ -96,6 +97,22 @@ struct FpsProbe {
     float tolerance = 0.0f;
 };
 
+// Timings of a test's final frame, redrawn a fixed number of times after warm-up.
+struct PerformanceProbe {
+    using FrameTime = FrameTimeSummary;
+
+    FrameTime frame;     // Whole frame, including the update and the readback (ms)
+    FrameTime render;    // Renderer only (ms)
+    FrameTime layout;    // Render tree creation, apart from symbol placement (ms)
+    FrameTime placement; // Symbol placement (ms)
+    FrameTime upload;    // Building and uploading GPU resources (ms)
+    float cpuTime = 0.0f;          // CPU time per frame of the thread rendering the frame (ms)
+    float workerCpuTime = 0.0f;    // CPU time per frame of the scheduler threads, summed (ms)
+    float maxWorkerCpuTime = 0.0f; // CPU time per frame of the busiest scheduler thread (ms)
+    float allocations = 0.0f;      // Allocations per frame
+    float tolerance = 0.0f;
+};
+
 struct NetworkProbe {
     NetworkProbe() = default;
     NetworkProbe(size_t requests_, size_t transferred_)
@@ -132,12 +149,16 @@ struct GfxProbe {
 
 class TestMetrics {
 public:
-    bool isEmpty() const { return fileSize.empty() && memory.empty() && network.empty() && fps.empty() && gfx.empty(); }
+    bool isEmpty() const {
+        return fileSize.empty() && memory.empty() && network.empty() && fps.empty() && gfx.empty() &&
+               performance.empty();
+    }
     std::map<std::string, FileSizeProbe> fileSize;
     std::map<std::string, MemoryProbe> memory;
     std::map<std::string, NetworkProbe> network;
     std::map<std::string, FpsProbe> fps;
     std::map<std::string, GfxProbe> gfx;
+    std::map<std::string, PerformanceProbe> performance;
 };
 
 struct TestMetadata {
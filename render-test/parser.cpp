@@ -289,6 +289,38 @@ std::string serializeMetrics(const TestMetrics& metrics) {
         // End gfx section
     }
 
+    if (!metrics.performance.empty()) {
+        // Start performance section
+        auto writeFrameTime = [&writer](const PerformanceProbe::FrameTime& frameTime) {
+            writer.StartArray();
+            writer.Double(frameTime.median);
+            writer.Double(frameTime.p95);
+            writer.Double(frameTime.p99);
+            writer.Double(frameTime.confidence);
+            writer.EndArray();
+        };
+        writer.Key("performance");
+        writer.StartArray();
+        for (const auto& performanceProbe : metrics.performance) {
+            assert(!performanceProbe.first.empty());
+            writer.StartArray();
+            writer.String(performanceProbe.first.c_str());
+            writeFrameTime(performanceProbe.second.frame);
+            writeFrameTime(performanceProbe.second.render);
+            writeFrameTime(performanceProbe.second.layout);
+            writeFrameTime(performanceProbe.second.placement);
+            writeFrameTime(performanceProbe.second.upload);
+            writer.Double(performanceProbe.second.cpuTime);
+            writer.Double(performanceProbe.second.workerCpuTime);
+            writer.Double(performanceProbe.second.maxWorkerCpuTime);
+            writer.Double(performanceProbe.second.allocations);
+            writer.Double(performanceProbe.second.tolerance);
+            writer.EndArray();
+        }
+        writer.EndArray();
+        // End performance section
+    }
+
     writer.EndObject();
 
     return s.GetString();
@@ -444,6 +476,44 @@ TestMetrics readExpectedMetrics(const mbgl::filesystem::path& path) {
         }
     }
 
+    if (document.HasMember("performance")) {
+        const mbgl::JSValue& performanceValue = document["performance"];
+        assert(performanceValue.IsArray());
+        auto readFrameTime = [](const mbgl::JSValue& value) {
+            assert(value.IsArray());
+            assert(value.Size() >= 4u);
+            return PerformanceProbe::FrameTime{
+                value[0].GetFloat(), value[1].GetFloat(), value[2].GetFloat(), value[3].GetFloat()};
+        };
+        for (auto& probeValue : performanceValue.GetArray()) {
+            assert(probeValue.IsArray());
+            assert(probeValue.Size() >= 11u);
+            assert(probeValue[0].IsString());
+            assert(probeValue[6].IsNumber());  // Render thread CPU time
+            assert(probeValue[7].IsNumber());  // Scheduler threads CPU time
+            assert(probeValue[8].IsNumber());  // Busiest scheduler thread CPU time
+            assert(probeValue[9].IsNumber());  // Allocations
+            assert(probeValue[10].IsNumber()); // Tolerance
+
+            const std::string mark{probeValue[0].GetString(), probeValue[0].GetStringLength()};
+            assert(!mark.empty());
+
+            PerformanceProbe probe;
+            probe.frame = readFrameTime(probeValue[1]);
+            probe.render = readFrameTime(probeValue[2]);
+            probe.layout = readFrameTime(probeValue[3]);
+            probe.placement = readFrameTime(probeValue[4]);
+            probe.upload = readFrameTime(probeValue[5]);
+            probe.cpuTime = probeValue[6].GetFloat();
+            probe.workerCpuTime = probeValue[7].GetFloat();
+            probe.maxWorkerCpuTime = probeValue[8].GetFloat();
+            probe.allocations = probeValue[9].GetFloat();
+            probe.tolerance = probeValue[10].GetFloat();
+
+            result.performance.insert({mark, std::move(probe)});
+        }
+    }
+
     return result;
 }
 
@@ -630,6 +700,7 @@ const std::string fileSizeProbeOp("probeFileSize");
 const std::string memoryProbeOp("probeMemory");
 const std::string memoryProbeStartOp("probeMemoryStart");
 const std::string memoryProbeEndOp("probeMemoryEnd");
+const std::string frameAllocationsProbeOp("probeFrameAllocations");
 const std::string networkProbeOp("probeNetwork");
 const std::string networkProbeStartOp("probeNetworkStart");
 const std::string networkProbeEndOp("probeNetworkEnd");
@@ -640,6 +711,7 @@ const std::string panGestureOp("panGesture");
 const std::string gfxProbeOp("probeGFX");
 const std::string gfxProbeStartOp("probeGFXStart");
 const std::string gfxProbeEndOp("probeGFXEnd");
+const std::string performanceProbeOp("probePerformance");
 } // namespace TestOperationNames
 
 using namespace TestOperationNames;
@@ -1004,6 +1076,55 @@ TestOperations parseTestOperations(TestMetadata& metadata) {
                 AllocationIndex::reset();
                 return true;
             });
+        } else if (operationArray[0].GetString() == frameAllocationsProbeOp) {
+            // probeFrameAllocations
+            assert(operationArray.Size() >= 3u);
+            assert(operationArray[1].IsString());
+            assert(operationArray[2].IsUint());
+            std::string mark = std::string(operationArray[1].GetString(), operationArray[1].GetStringLength());
+            const std::size_t maxAllocations = operationArray[2].GetUint();
+            result.emplace_back([mark, maxAllocations](TestContext& ctx) {
+                assert(!AllocationIndex::isActive());
+                auto& frontend = ctx.getFrontend();
+                const auto countFrame = [&frontend] {
+                    AllocationIndex::setActive(true);
+                    frontend.renderFrame();
+                    AllocationIndex::setActive(false);
+                    const MemoryProbe frame(AllocationIndex::getAllocatedSizePeak(),
+                                            AllocationIndex::getAllocationsCount());
+                    AllocationIndex::reset();
+                    return frame;
+                };
+                // Redraw the unchanged map once to warm up, then count two more frames. The second frame
+                // must stay within the budget given by the test, and must not allocate more than the first.
+                // The metric is how much it allocates on top of the first, which is zero as long as the
+                // render loop reuses its storage.
+                frontend.renderFrame();
+                const MemoryProbe first = countFrame();
+                const MemoryProbe second = countFrame();
+                ctx.getMetadata().metrics.memory.emplace(
+                    std::piecewise_construct,
+                    std::forward_as_tuple(mark),
+                    std::forward_as_tuple(second.peak > first.peak ? second.peak - first.peak : 0,
+                                          second.allocations > first.allocations
+                                              ? second.allocations - first.allocations
+                                              : 0));
+                if (second.allocations > maxAllocations) {
+                    ctx.getMetadata().errorMessage = "Frame at probe \"" + mark + "\" made " +
+                                                     std::to_string(second.allocations) +
+                                                     " allocations, expected at most " +
+                                                     std::to_string(maxAllocations);
+                    return false;
+                }
+                if (second.allocations > first.allocations) {
+                    ctx.getMetadata().errorMessage = "Frame at probe \"" + mark + "\" made " +
+                                                     std::to_string(second.allocations) +
+                                                     " allocations, more than the " +
+                                                     std::to_string(first.allocations) + " of the frame before";
+                    return false;
+                }
+                return true;
+            });
         } else if (operationArray[0].GetString() == networkProbeStartOp) {
             // probeNetworkStart
             result.emplace_back([](TestContext&) {
@@ -66,4 +66,5 @@ extern const std::string panGestureOp;
 extern const std::string gfxProbeOp;
 extern const std::string gfxProbeStartOp;
 extern const std::string gfxProbeEndOp;
+extern const std::string performanceProbeOp;
 } // namespace TestOperationNames
@@ -11,9 +11,11 @@
 #include <mbgl/util/chrono.hpp>
 #include <mbgl/util/image.hpp>
 #include <mbgl/util/io.hpp>
+#include <mbgl/util/monotonic_timer.hpp>
 #include <mbgl/util/projection.hpp>
 #include <mbgl/util/run_loop.hpp>
 #include <mbgl/util/string.hpp>
+#include <mbgl/util/thread_pool.hpp>
 #include <mbgl/util/tile_cover.hpp>
 
 #include <mapbox/pixelmatch.hpp>
@@ -27,6 +29,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <utility>
 #include <sstream>
 
@@ -528,11 +531,82 @@ void TestRunner::checkProbingResults(TestMetadata& resultMetadata) {
         }
     };
 
+    // Check performance metrics. Only slowdowns fail: the median of a phase regresses once its
+    // confidence interval lies above the expected one, widened by the tolerance.
+    auto checkPerformance = [](TestMetadata& metadata) {
+        if (metadata.metrics.performance.empty()) return;
+        for (const auto& expected : metadata.expectedMetrics.performance) {
+            auto actual = metadata.metrics.performance.find(expected.first);
+            if (actual == metadata.metrics.performance.end()) {
+                metadata.errorMessage = "Failed to find performance probe: " + expected.first;
+                metadata.metricsErrored++;
+                return;
+            }
+
+            const auto& probeName = expected.first;
+            const auto& expectedValue = expected.second;
+            const auto& actualValue = actual->second;
+            const float scale = 1.0f + expectedValue.tolerance;
+            std::stringstream ss;
+
+            auto checkFrameTime = [&](const char* phase,
+                                      const PerformanceProbe::FrameTime& expectedTime,
+                                      const PerformanceProbe::FrameTime& actualTime) {
+                const float limit = (expectedTime.median + expectedTime.confidence) * scale;
+                if (actualTime.median - actualTime.confidence > limit) {
+                    if (ss.tellp() > 0) ss << std::endl;
+                    ss << "Median " << phase << " time at probe \"" << probeName << "\" is " << actualTime.median
+                       << " ± " << actualTime.confidence << " ms, expected is " << expectedTime.median << " ± "
+                       << expectedTime.confidence << " ms with tolerance of " << expectedValue.tolerance;
+                    metadata.metricsFailed++;
+                }
+                if (actualTime.p95 > expectedTime.p95 * scale) {
+                    if (ss.tellp() > 0) ss << std::endl;
+                    ss << "95th percentile " << phase << " time at probe \"" << probeName << "\" is "
+                       << actualTime.p95 << " ms, expected is " << expectedTime.p95 << " ms with tolerance of "
+                       << expectedValue.tolerance;
+                    metadata.metricsFailed++;
+                }
+            };
+            checkFrameTime("frame", expectedValue.frame, actualValue.frame);
+            checkFrameTime("render", expectedValue.render, actualValue.render);
+            checkFrameTime("layout", expectedValue.layout, actualValue.layout);
+            checkFrameTime("placement", expectedValue.placement, actualValue.placement);
+            checkFrameTime("upload", expectedValue.upload, actualValue.upload);
+
+            auto checkCpuTime = [&](const char* threads, float expectedTime, float actualTime) {
+                if (actualTime > expectedTime * scale) {
+                    if (ss.tellp() > 0) ss << std::endl;
+                    ss << "CPU time per frame of the " << threads << " at probe \"" << probeName << "\" is "
+                       << actualTime << " ms, expected is " << expectedTime << " ms with tolerance of "
+                       << expectedValue.tolerance;
+                    metadata.metricsFailed++;
+                }
+            };
+            checkCpuTime("render thread", expectedValue.cpuTime, actualValue.cpuTime);
+            checkCpuTime("scheduler threads", expectedValue.workerCpuTime, actualValue.workerCpuTime);
+            checkCpuTime("busiest scheduler thread", expectedValue.maxWorkerCpuTime, actualValue.maxWorkerCpuTime);
+
+#if !defined(SANITIZE)
+            if (actualValue.allocations > expectedValue.allocations * scale) {
+                if (ss.tellp() > 0) ss << std::endl;
+                ss << "Allocations per frame at probe \"" << probeName << "\" are " << actualValue.allocations
+                   << ", expected are " << expectedValue.allocations << " with tolerance of "
+                   << expectedValue.tolerance;
+                metadata.metricsFailed++;
+            }
+#endif // !defined(SANITIZE)
+
+            metadata.errorMessage += metadata.errorMessage.empty() ? ss.str() : "\n" + ss.str();
+        }
+    };
+
     checkFileSize(resultMetadata);
     checkMemory(resultMetadata);
     checkNetwork(resultMetadata);
     checkFps(resultMetadata);
     checkGfx(resultMetadata);
+    checkPerformance(resultMetadata);
 
     if (resultMetadata.ignoredTest) {
         return;
@@ -552,6 +626,89 @@ TestOperation unsupportedOperation(const std::string& operation) {
     };
 }
 
+constexpr std::size_t performanceWarmupFrames = 5;
+constexpr std::size_t performanceFrames = 60;
+constexpr std::size_t performanceAllocationFrames = 3;
+constexpr float performanceTolerance = 0.1f;
+
+// Redraws the final frame of a test, measures the frames that follow the warm-up and then counts
+// their allocations in separate frames, as indexing allocations slows frames down. CPU time is
+// taken per thread: the thread rendering the frame, and each scheduler thread running tasks.
+TestOperation performanceProbe(std::string mark) {
+    return [mark = std::move(mark)](TestContext& ctx) {
+        auto& frontend = ctx.getFrontend();
+        auto& map = ctx.getMap();
+        std::vector<float> frameTimes;
+        std::vector<float> renderTimes;
+        std::vector<float> layoutTimes;
+        std::vector<float> placementTimes;
+        std::vector<float> uploadTimes;
+        Duration cpuTime = Duration::zero();
+        std::map<uint64_t, Duration> workerCpuTimes;
+        PerformanceProbe probe;
+        try {
+            ThreadedSchedulerBase::setCPUTimeTracking(true);
+            for (std::size_t i = 0; i < performanceWarmupFrames + performanceFrames; ++i) {
+                const auto cpuStart = ThreadedSchedulerBase::getCurrentThreadCPUTime();
+                const auto workerCpuStart = ThreadedSchedulerBase::getThreadCPUTimes();
+                const auto start = util::MonotonicTimer::now();
+                const auto stats = frontend.render(map).stats;
+                const auto end = util::MonotonicTimer::now();
+                if (i < performanceWarmupFrames) continue;
+                cpuTime += ThreadedSchedulerBase::getCurrentThreadCPUTime() - cpuStart;
+                // Threads started during the frame count from zero.
+                for (const auto& thread : ThreadedSchedulerBase::getThreadCPUTimes()) {
+                    auto previous = workerCpuStart.find(thread.first);
+                    workerCpuTimes[thread.first] += thread.second - (previous != workerCpuStart.end()
+                                                                         ? previous->second
+                                                                         : Duration::zero());
+                }
+                frameTimes.push_back(static_cast<float>((end - start).count() * 1000.0));
+                renderTimes.push_back(static_cast<float>(frontend.getFrameTime() * 1000.0));
+                layoutTimes.push_back(static_cast<float>(stats.layoutTime * 1000.0));
+                placementTimes.push_back(static_cast<float>(stats.placementTime * 1000.0));
+                uploadTimes.push_back(static_cast<float>(stats.uploadTime * 1000.0));
+            }
+
+            // Don't reset the index if a memory probe is using it.
+            const bool indexing = AllocationIndex::isActive();
+            AllocationIndex::setActive(true);
+            const auto allocations = AllocationIndex::getAllocationsCount();
+            for (std::size_t i = 0; i < performanceAllocationFrames; ++i) {
+                frontend.render(map);
+            }
+            probe.allocations = static_cast<float>(AllocationIndex::getAllocationsCount() - allocations) /
+                                performanceAllocationFrames;
+            if (!indexing) {
+                AllocationIndex::setActive(false);
+                AllocationIndex::reset();
+            }
+            ThreadedSchedulerBase::setCPUTimeTracking(false);
+        } catch (const std::exception& e) {
+            ThreadedSchedulerBase::setCPUTimeTracking(false);
+            ctx.getMetadata().errorMessage = std::string("Performance probe raised an exception: ") + e.what();
+            return false;
+        }
+
+        probe.frame = summarizeFrameTimes(std::move(frameTimes));
+        probe.render = summarizeFrameTimes(std::move(renderTimes));
+        probe.layout = summarizeFrameTimes(std::move(layoutTimes));
+        probe.placement = summarizeFrameTimes(std::move(placementTimes));
+        probe.upload = summarizeFrameTimes(std::move(uploadTimes));
+        const auto perFrame = [](Duration time) {
+            return static_cast<float>(std::chrono::duration<double, std::milli>(time).count() / performanceFrames);
+        };
+        probe.cpuTime = perFrame(cpuTime);
+        for (const auto& thread : workerCpuTimes) {
+            probe.workerCpuTime += perFrame(thread.second);
+            probe.maxWorkerCpuTime = std::max(probe.maxWorkerCpuTime, perFrame(thread.second));
+        }
+        probe.tolerance = performanceTolerance;
+        ctx.getMetadata().metrics.performance.insert({mark, probe});
+        return true;
+    };
+}
+
 TestOperations getBeforeOperations(const Manifest& manifest) {
     static const std::string mark = " - default - start";
     TestOperations result;
@@ -590,6 +747,10 @@ TestOperations getBeforeOperations(const Manifest& manifest) {
             });
             continue;
         }
+        if (performanceProbeOp == probe) {
+            // Measured once the test has rendered its final frame.
+            continue;
+        }
         result.emplace_back(unsupportedOperation(probe));
     }
     return result;
@@ -641,6 +802,10 @@ TestOperations getAfterOperations(const Manifest& manifest) {
             });
             continue;
         }
+        if (performanceProbeOp == probe) {
+            result.emplace_back(performanceProbe(performanceProbeOp + mark));
+            continue;
+        }
         result.emplace_back(unsupportedOperation(probe));
     }
     return result;
@@ -0,0 +1,90 @@
+#!/usr/bin/env python3
+
+"""
+Bundles glyph range PBFs into a glyph pack, the file that GlyphManager serves
+ranges from when a style's glyph URL is a file:// URL ending in .glyphpack.
+
+Ranges are read from a directory laid out like a glyph server, with one
+directory per font stack holding a `<start>-<end>.pbf` file per range, or given
+one at a time with --range. The glyph URL template of the style is recorded in
+the pack, so that ranges missing from it can still be requested.
+
+    scripts/pack-glyphs.py --url 'https://example.com/fonts/{fontstack}/{range}.pbf' \\
+        --directory fonts/ output.glyphpack
+
+The format is described in src/mbgl/text/glyph_pack.hpp.
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+MAGIC = b"MLNGPAK1"
+RANGE_FILE = re.compile(r"^(\d+)-(\d+)\.pbf$")
+
+
+def read_directory(directory):
+    ranges = {}
+    for font_stack in sorted(os.listdir(directory)):
+        stack_directory = os.path.join(directory, font_stack)
+        if not os.path.isdir(stack_directory):
+            continue
+        for name in sorted(os.listdir(stack_directory)):
+            match = RANGE_FILE.match(name)
+            if not match:
+                continue
+            start, end = int(match.group(1)), int(match.group(2))
+            if start % 256 != 0 or end != start + 255:
+                sys.exit("Not a glyph range: " + os.path.join(stack_directory, name))
+            with open(os.path.join(stack_directory, name), "rb") as f:
+                ranges[(font_stack, start)] = f.read()
+    return ranges
+
+
+def encode(ranges, url):
+    url = url.encode("utf-8")
+    entries = sorted((font_stack.encode("utf-8"), start, data) for (font_stack, start), data in ranges.items())
+
+    table_size = len(MAGIC) + 4 + len(url) + 4
+    for font_stack, _, _ in entries:
+        table_size += 4 + len(font_stack) + 2 + 8 + 8
+
+    out = bytearray(MAGIC)
+    out += struct.pack("<I", len(url)) + url
+    out += struct.pack("<I", len(entries))
+    offset = table_size
+    for font_stack, start, data in entries:
+        out += struct.pack("<I", len(font_stack)) + font_stack
+        out += struct.pack("<HQQ", start, offset, len(data))
+        offset += len(data)
+    for _, _, data in entries:
+        out += data
+    return bytes(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("output", help="path of the glyph pack to write")
+    parser.add_argument("--url", default="", help="glyph URL template for the ranges missing from the pack")
+    parser.add_argument("--directory", help="directory with a subdirectory of range PBFs per font stack")
+    parser.add_argument("--range", nargs=3, action="append", default=[], metavar=("FONTSTACK", "START", "PBF"),
+                        help="adds the range starting at START of the comma separated FONTSTACK")
+    args = parser.parse_args()
+
+    ranges = read_directory(args.directory) if args.directory else {}
+    for font_stack, start, path in args.range:
+        if int(start) % 256 != 0:
+            sys.exit("Not the start of a glyph range: " + start)
+        with open(path, "rb") as f:
+            ranges[(font_stack, int(start))] = f.read()
+    if not ranges:
+        sys.exit("No glyph ranges given")
+
+    with open(args.output, "wb") as f:
+        f.write(encode(ranges, args.url))
+
+
+if __name__ == "__main__":
+    main()
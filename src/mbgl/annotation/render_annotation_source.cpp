@@ -2,6 +2,7 @@
 #include <mbgl/annotation/annotation_tile.hpp>
 #include <mbgl/renderer/render_tile.hpp>
 #include <mbgl/renderer/paint_parameters.hpp>
+#include <mbgl/renderer/source_state.hpp>
 
 #include <mbgl/layermanager/layer_manager.hpp>
 
@@ -51,6 +52,14 @@ std::unordered_map<std::string, std::vector<Feature>> RenderAnnotationSource::qu
     return tilePyramid.queryRenderedFeatures(geometry, transformState, layers, options, projMatrix, {});
 }
 
+void RenderAnnotationSource::snapshotRenderedFeatures(RenderedQuerySnapshot& snapshot,
+                                                      const ScreenLineString& geometry,
+                                                      const TransformState& transformState,
+                                                      const mat4& projMatrix) const {
+    tilePyramid.snapshotRenderedFeatures(
+        snapshot, geometry, transformState, projMatrix, std::make_shared<const SourceFeatureState>());
+}
+
 std::vector<Feature> RenderAnnotationSource::querySourceFeatures(const SourceQueryOptions&) const {
     return {};
 }
@@ -22,6 +22,11 @@ public:
         const RenderedQueryOptions& options,
         const mat4& projMatrix) const final;
 
+    void snapshotRenderedFeatures(RenderedQuerySnapshot&,
+                                  const ScreenLineString& geometry,
+                                  const TransformState& transformState,
+                                  const mat4& projMatrix) const final;
+
     std::vector<Feature> querySourceFeatures(const SourceQueryOptions&) const final;
 
 private:
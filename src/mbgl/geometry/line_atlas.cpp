@@ -8,6 +8,8 @@
 #include <mbgl/util/logging.hpp>
 #include <mbgl/util/platform.hpp>
 
+#include <algorithm>
+
 namespace mbgl {
 namespace {
 
@@ -137,22 +139,13 @@ void addRegularDash(std::vector<DashRange>& ranges, uint32_t yOffset, AlphaImage
     }
 }
 
-LinePatternPos addDashPattern(AlphaImage& image,
-                              uint32_t yOffset,
-                              const std::vector<float>& dasharray,
-                              const LinePatternCap patternCap) {
+void drawDashPattern(AlphaImage& image,
+                     uint32_t yOffset,
+                     const std::vector<float>& dasharray,
+                     const LinePatternCap patternCap,
+                     const float length) {
     const uint8_t n = patternCap == LinePatternCap::Round ? 7 : 0;
 
-    if (dasharray.size() < 2) {
-        Log::Warning(Event::ParseStyle, "line dasharray requires at least two elements");
-        return {};
-    }
-
-    float length = 0;
-    for (const float part : dasharray) {
-        length += part;
-    }
-
     float stretch = image.size.width / length;
     std::vector<DashRange> ranges = getDashRanges(dasharray, stretch);
 
@@ -161,127 +154,249 @@ LinePatternPos addDashPattern(AlphaImage& image,
     } else {
         addRegularDash(ranges, yOffset, image);
     }
-
-    LinePatternPos position;
-    position.y = (0.5f + yOffset + n) / image.size.height;
-    position.height = (2.0f * n + 1) / image.size.height;
-    position.width = length;
-
-    return position;
 }
 
 } // namespace
 
-DashPatternTexture::DashPatternTexture(const std::vector<float>& from_,
-                                       const std::vector<float>& to_,
-                                       const LinePatternCap cap) {
-    const bool patternsIdentical = from_ == to_;
-    const uint32_t patternHeight = cap == LinePatternCap::Round ? 15 : 1;
-    const uint32_t height = (patternsIdentical ? 1 : 2) * patternHeight;
-
-    // The OpenGL ES 2.0 spec, section 3.8.2 states:
-    //
-    //     Calling a sampler from a fragment shader will return (R,G,B,A) =
-    //     (0,0,0,1) if any of the following conditions are true: […]
-    //     - A two-dimensional sampler is called, the corresponding texture
-    //     image is a
-    //       non-power-of-two image […], and either the texture wrap mode is not
-    //       CLAMP_TO_EDGE, or the minification filter is neither NEAREST nor
-    //       LINEAR.
-    //     […]
-    //
-    // This means that texture lookups won't work for NPOT textures unless they
-    // use GL_CLAMP_TO_EDGE. We're using GL_CLAMP_TO_EDGE for the vertical
-    // direction, but GL_REPEAT for the horizontal direction, which means that
-    // we need a power-of-two texture for our line dash patterns to work on
-    // OpenGL ES 2.0 conforming implementations. Fortunately, this just means
-    // changing the height from 15 to 16, and from 30 to 32, so we don't waste
-    // many pixels.
-    const uint32_t textureHeight = 1 << util::ceil_log2(height);
-    AlphaImage image({256, textureHeight});
-
-    from = addDashPattern(image, 0, from_, cap);
-    to = patternsIdentical ? from : addDashPattern(image, patternHeight, to_, cap);
-
-    texture = std::move(image);
-}
-
-void DashPatternTexture::upload(gfx::UploadPass& uploadPass) {
-#if MLN_DRAWABLE_RENDERER
-    if (std::holds_alternative<AlphaImage>(texture)) {
-        auto tempTexture = uploadPass.getContext().createTexture2D();
-        tempTexture->upload(std::get<AlphaImage>(texture));
-        tempTexture->setSamplerConfiguration(
-            {gfx::TextureFilterType::Linear, gfx::TextureWrapType::Repeat, gfx::TextureWrapType::Clamp});
-        texture = std::move(tempTexture);
-    }
-#else
-    if (texture.is<AlphaImage>()) {
-        texture = uploadPass.createTexture(texture.get<AlphaImage>());
-    }
-#endif
-}
+DashPatternTexture::DashPatternTexture(const LineAtlas& atlas_, size_t fromHash_, size_t toHash_)
+    : atlas(atlas_),
+      fromHash(fromHash_),
+      toHash(toHash_) {}
 
 #if MLN_LEGACY_RENDERER
 gfx::TextureBinding DashPatternTexture::textureBinding() const {
-    // The texture needs to have been uploaded already.
-    assert(texture.is<gfx::Texture>());
-    return {texture.get<gfx::Texture>().getResource(),
-            gfx::TextureFilterType::Linear,
-            gfx::TextureMipMapType::No,
-            gfx::TextureWrapType::Repeat,
-            gfx::TextureWrapType::Clamp};
+    return atlas.textureBinding();
 }
 #endif
 
 #if MLN_DRAWABLE_RENDERER
-static const gfx::Texture2DPtr noTexture;
 const std::shared_ptr<gfx::Texture2D>& DashPatternTexture::getTexture() const {
-    return (std::holds_alternative<gfx::Texture2DPtr>(texture)) ? std::get<gfx::Texture2DPtr>(texture) : noTexture;
+    return atlas.getTexture();
 }
 #endif
 
 Size DashPatternTexture::getSize() const {
-#if MLN_DRAWABLE_RENDERER
-    if (std::holds_alternative<AlphaImage>(texture)) {
-        return std::get<AlphaImage>(texture).size;
-    }
-    return std::get<gfx::Texture2DPtr>(texture)->getSize();
-#else
-    return texture.match([](const auto& obj) { return obj.size; });
-#endif
+    return atlas.getSize();
 }
 
-LineAtlas::LineAtlas() = default;
+// The OpenGL ES 2.0 spec, section 3.8.2 states:
+//
+//     Calling a sampler from a fragment shader will return (R,G,B,A) =
+//     (0,0,0,1) if any of the following conditions are true: […]
+//     - A two-dimensional sampler is called, the corresponding texture
+//     image is a
+//       non-power-of-two image […], and either the texture wrap mode is not
+//       CLAMP_TO_EDGE, or the minification filter is neither NEAREST nor
+//       LINEAR.
+//     […]
+//
+// This means that texture lookups won't work for NPOT textures unless they
+// use GL_CLAMP_TO_EDGE. We're using GL_CLAMP_TO_EDGE for the vertical
+// direction, but GL_REPEAT for the horizontal direction, which means that
+// we need a power-of-two texture for our line dash patterns to work on
+// OpenGL ES 2.0 conforming implementations. The atlas therefore starts at
+// a height of 16 rows and doubles whenever it runs out of rows.
+LineAtlas::LineAtlas(uint32_t maxHeight_)
+    : maxHeight(1 << util::ceil_log2(std::max(maxHeight_, 16u))),
+      image({256, 16}),
+      usedRows(image.size.height, false),
+      overflow(*this, 0, 0),
+      dirtyTop(image.size.height) {}
 
 LineAtlas::~LineAtlas() = default;
 
 DashPatternTexture& LineAtlas::getDashPatternTexture(const std::vector<float>& from,
                                                      const std::vector<float>& to,
                                                      const LinePatternCap cap) {
-    const size_t hash = util::hash(getDashPatternHash(from, cap), getDashPatternHash(to, cap));
+    const size_t fromHash = getDashPatternHash(from, cap);
+    const size_t toHash = getDashPatternHash(to, cap);
+    const size_t hash = util::hash(fromHash, toHash);
 
     // Note: We're not handling hash collisions here.
-    const auto it = textures.find(hash);
+    auto it = textures.find(hash);
     if (it == textures.end()) {
-        auto inserted = textures.emplace(
-            std::piecewise_construct, std::forward_as_tuple(hash), std::forward_as_tuple(from, to, cap));
-        assert(inserted.second);
-        needsUpload.emplace_back(hash);
-        return inserted.first->second;
-    } else {
-        return it->second;
+        if (!patterns.count(fromHash) && !addDashPattern(fromHash, from, cap)) {
+            return overflow;
+        }
+        // Holds on to the first pattern while the second one is added, so that it isn't evicted.
+        patterns.at(fromHash).references++;
+        if (!patterns.count(toHash) && !addDashPattern(toHash, to, cap)) {
+            releaseDashPattern(fromHash);
+            return overflow;
+        }
+        patterns.at(toHash).references++;
+
+        it = textures.emplace(std::piecewise_construct,
+                              std::forward_as_tuple(hash),
+                              std::forward_as_tuple(*this, fromHash, toHash))
+                 .first;
+        it->second.from = getPosition(fromHash);
+        it->second.to = getPosition(toHash);
     }
+
+    it->second.lastUsed = frame;
+    return it->second;
 }
 
-void LineAtlas::upload(gfx::UploadPass& uploadPass) {
-    for (const size_t hash : needsUpload) {
-        const auto it = textures.find(hash);
-        if (it != textures.end()) {
-            it->second.upload(uploadPass);
+bool LineAtlas::addDashPattern(size_t hash, const std::vector<float>& dasharray, const LinePatternCap cap) {
+    if (dasharray.size() < 2) {
+        Log::Warning(Event::ParseStyle, "line dasharray requires at least two elements");
+        patterns.emplace(hash, DashPattern{0, 0, 0.0f});
+        return true;
+    }
+
+    float length = 0;
+    for (const float part : dasharray) {
+        length += part;
+    }
+
+    const uint32_t height = cap == LinePatternCap::Round ? 15 : 1;
+    const auto row = allocateRows(height);
+    if (!row) {
+        if (!overflowed) {
+            Log::Warning(Event::Render, "Line atlas is full, dash patterns will not be drawn");
+            overflowed = true;
         }
+        return false;
+    }
+
+    AlphaImage::clear(image, {0, *row}, {image.size.width, height});
+    drawDashPattern(image, *row, dasharray, cap, length);
+    dirtyTop = std::min(dirtyTop, *row);
+    dirtyBottom = std::max(dirtyBottom, *row + height);
+
+    patterns.emplace(hash, DashPattern{*row, height, length});
+    return true;
+}
+
+void LineAtlas::releaseDashPattern(size_t hash) {
+    const auto it = patterns.find(hash);
+    assert(it != patterns.end());
+    if (--it->second.references == 0) {
+        std::fill_n(usedRows.begin() + it->second.row, it->second.height, false);
+        patterns.erase(it);
     }
-    needsUpload.clear();
 }
 
+std::optional<uint32_t> LineAtlas::allocateRows(uint32_t height) {
+    while (true) {
+        if (const auto row = findFreeRows(height)) {
+            std::fill_n(usedRows.begin() + *row, height, true);
+            return row;
+        }
+
+        if (image.size.height < maxHeight) {
+            image.resize({image.size.width, image.size.height * 2});
+            usedRows.resize(image.size.height, false);
+            dirtyTop = 0;
+            dirtyBottom = image.size.height;
+
+            // Positions are relative to the height of the atlas.
+            for (auto& entry : textures) {
+                entry.second.from = getPosition(entry.second.fromHash);
+                entry.second.to = getPosition(entry.second.toHash);
+            }
+        } else if (!evictLeastRecentlyUsed()) {
+            return std::nullopt;
+        }
+    }
+}
+
+std::optional<uint32_t> LineAtlas::findFreeRows(uint32_t height) const {
+    uint32_t free = 0;
+    for (uint32_t row = 0; row < usedRows.size(); ++row) {
+        free = usedRows[row] ? 0 : free + 1;
+        if (free == height) {
+            return row + 1 - height;
+        }
+    }
+    return std::nullopt;
+}
+
+bool LineAtlas::evictLeastRecentlyUsed() {
+    auto evicted = textures.end();
+    for (auto it = textures.begin(); it != textures.end(); ++it) {
+        // Patterns requested during this frame may still be drawn.
+        if (it->second.lastUsed >= frame) continue;
+        if (evicted == textures.end() || it->second.lastUsed < evicted->second.lastUsed) {
+            evicted = it;
+        }
+    }
+    if (evicted == textures.end()) {
+        return false;
+    }
+
+    releaseDashPattern(evicted->second.fromHash);
+    releaseDashPattern(evicted->second.toHash);
+    textures.erase(evicted);
+    return true;
+}
+
+LinePatternPos LineAtlas::getPosition(size_t hash) const {
+    const DashPattern& pattern = patterns.at(hash);
+    if (pattern.height == 0) {
+        return {};
+    }
+
+    const uint32_t n = (pattern.height - 1) / 2;
+    LinePatternPos position;
+    position.y = (0.5f + pattern.row + n) / image.size.height;
+    position.height = static_cast<float>(pattern.height) / image.size.height;
+    position.width = pattern.width;
+    return position;
+}
+
+void LineAtlas::upload([[maybe_unused]] gfx::UploadPass& uploadPass) {
+    if (dirtyTop < dirtyBottom) {
+        // Only the rows that changed are uploaded, unless the atlas has grown.
+        const auto changedRows = [&] {
+            AlphaImage rows({image.size.width, dirtyBottom - dirtyTop});
+            AlphaImage::copy(image, rows, {0, dirtyTop}, {0, 0}, rows.size);
+            return rows;
+        };
+#if MLN_DRAWABLE_RENDERER
+        if (!texture) {
+            texture = uploadPass.getContext().createTexture2D();
+            if (texture) {
+                texture->setSamplerConfiguration(
+                    {gfx::TextureFilterType::Linear, gfx::TextureWrapType::Repeat, gfx::TextureWrapType::Clamp});
+                texture->upload(image);
+            }
+        } else if (texture->getSize() != image.size) {
+            texture->upload(image);
+        } else {
+            texture->uploadSubRegion(changedRows(), 0, static_cast<uint16_t>(dirtyTop));
+        }
+#else
+        if (!texture) {
+            texture = uploadPass.createTexture(image);
+        } else if (texture->size != image.size) {
+            uploadPass.updateTexture(*texture, image);
+        } else {
+            uploadPass.updateTextureSub(*texture, changedRows(), 0, static_cast<uint16_t>(dirtyTop));
+        }
+#endif
+        dirtyTop = image.size.height;
+        dirtyBottom = 0;
+    }
+}
+
+#if MLN_LEGACY_RENDERER
+gfx::TextureBinding LineAtlas::textureBinding() const {
+    // The texture needs to have been uploaded already.
+    assert(texture);
+    return {texture->getResource(),
+            gfx::TextureFilterType::Linear,
+            gfx::TextureMipMapType::No,
+            gfx::TextureWrapType::Repeat,
+            gfx::TextureWrapType::Clamp};
+}
+#endif
+
+#if MLN_DRAWABLE_RENDERER
+const std::shared_ptr<gfx::Texture2D>& LineAtlas::getTexture() const {
+    return texture;
+}
+#endif
+
 } // namespace mbgl
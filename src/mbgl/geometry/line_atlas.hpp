@@ -6,14 +6,11 @@
 
 #if MLN_DRAWABLE_RENDERER
 #include <mbgl/gfx/texture2d.hpp>
-#include <variant>
-#else
-#include <mbgl/util/variant.hpp>
-#include <optional>
 #endif
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace mbgl {
@@ -41,41 +38,48 @@ struct DashRange {
     bool isZeroLength;
 };
 
+class LineAtlas;
+
+// The position of a pair of dash patterns in the line atlas, which are cross-faded
+// when the dash array of a layer changes.
 class DashPatternTexture {
 public:
-    DashPatternTexture(const std::vector<float>& from, const std::vector<float>& to, LinePatternCap);
+    DashPatternTexture(const LineAtlas&, size_t fromHash, size_t toHash);
 
-    // Uploads the texture to the GPU to be available when we need it. This is a
-    // lazy operation; the texture is only bound when the data is uploaded for
-    // the first time.
-    void upload(gfx::UploadPass&);
-
-    // Binds the atlas texture to the GPU, and uploads data if it is out of date.
+    // Binds the atlas texture to the GPU. The atlas needs to have been uploaded.
 #if MLN_DRAWABLE_RENDERER
     const std::shared_ptr<gfx::Texture2D>& getTexture() const;
 #else
     gfx::TextureBinding textureBinding() const;
 #endif
 
-    // Returns the size of the texture image.
+    // Returns the size of the atlas texture.
     Size getSize() const;
 
     const LinePatternPos& getFrom() const { return from; }
     const LinePatternPos& getTo() const { return to; }
 
 private:
-    LinePatternPos from, to;
+    friend class LineAtlas;
 
-#if MLN_DRAWABLE_RENDERER
-    std::variant<AlphaImage, gfx::Texture2DPtr> texture;
-#else
-    variant<AlphaImage, gfx::Texture> texture;
-#endif
+    const LineAtlas& atlas;
+    const size_t fromHash;
+    const size_t toHash;
+    LinePatternPos from{};
+    LinePatternPos to{};
+
+    // The frame in which the patterns were last requested.
+    uint64_t lastUsed = 0;
 };
 
+// Packs the dash patterns of all line layers as rows of a single texture. The
+// texture grows up to a maximum height; once it is full, the patterns that
+// haven't been requested during the current frame are evicted to make room.
 class LineAtlas {
 public:
-    LineAtlas();
+    static constexpr uint32_t defaultMaxHeight = 1024;
+
+    explicit LineAtlas(uint32_t maxHeight = defaultMaxHeight);
     ~LineAtlas();
 
     // Obtains or creates a texture that has both line patterns in it
@@ -83,16 +87,64 @@ public:
                                               const std::vector<float>& to,
                                               LinePatternCap);
 
-    // Uploads the textures to the GPU to be available when we need it.
+    // Starts a new frame. Called before the layers are prepared, so that patterns
+    // requested while preparing and drawing a frame belong to the same frame.
+    void beginFrame() { frame++; }
+
+    // Uploads the rows that changed since the last upload.
     void upload(gfx::UploadPass&);
 
+#if MLN_DRAWABLE_RENDERER
+    const std::shared_ptr<gfx::Texture2D>& getTexture() const;
+#else
+    gfx::TextureBinding textureBinding() const;
+#endif
+
+    Size getSize() const { return image.size; }
+
+    const AlphaImage& getAtlasImageForTests() const { return image; }
+
     bool isEmpty() const { return textures.empty(); }
 
 private:
+    // A dash array with a cap style, drawn into consecutive rows of the atlas.
+    // Patterns are shared by all textures that use them.
+    struct DashPattern {
+        uint32_t row;
+        uint32_t height;
+        float width;
+        size_t references = 0;
+    };
+
+    bool addDashPattern(size_t hash, const std::vector<float>& dasharray, LinePatternCap);
+    void releaseDashPattern(size_t hash);
+    std::optional<uint32_t> allocateRows(uint32_t height);
+    std::optional<uint32_t> findFreeRows(uint32_t height) const;
+    bool evictLeastRecentlyUsed();
+    LinePatternPos getPosition(size_t hash) const;
+
+    const uint32_t maxHeight;
+    AlphaImage image;
+    std::vector<bool> usedRows;
+    std::map<size_t, DashPattern> patterns;
     std::map<size_t, DashPatternTexture> textures;
 
-    // Stores a list of hashes of texture objects that need uploading.
-    std::vector<size_t> needsUpload;
+    // Used when the atlas is full of patterns needed for the current frame. Its
+    // positions have zero height, and lines using it aren't drawn.
+    DashPatternTexture overflow;
+    bool overflowed = false;
+
+    uint64_t frame = 1;
+
+    // The range of rows that need uploading.
+    uint32_t dirtyTop;
+    uint32_t dirtyBottom = 0;
+
+#if MLN_DRAWABLE_RENDERER
+    gfx::Texture2DPtr texture;
+#else
+    std::optional<gfx::Texture> texture;
+#endif
 };
 
 } // namespace mbgl
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mbgl/gfx/half_float.hpp>
 #include <mbgl/gfx/types.hpp>
 #include <mbgl/gfx/vertex_buffer.hpp>
 #include <mbgl/util/type_list.hpp>
@@ -88,6 +89,14 @@ template <>
 struct AttributeDataTypeOf<float, 3> : std::integral_constant<AttributeDataType, AttributeDataType::Float3> {};
 template <>
 struct AttributeDataTypeOf<float, 4> : std::integral_constant<AttributeDataType, AttributeDataType::Float4> {};
+template <>
+struct AttributeDataTypeOf<HalfFloat, 1> : std::integral_constant<AttributeDataType, AttributeDataType::HalfFloat> {};
+template <>
+struct AttributeDataTypeOf<HalfFloat, 2> : std::integral_constant<AttributeDataType, AttributeDataType::HalfFloat2> {};
+template <>
+struct AttributeDataTypeOf<HalfFloat, 3> : std::integral_constant<AttributeDataType, AttributeDataType::HalfFloat3> {};
+template <>
+struct AttributeDataTypeOf<HalfFloat, 4> : std::integral_constant<AttributeDataType, AttributeDataType::HalfFloat4> {};
 
 template <typename T, std::size_t N>
 class AttributeType {
@@ -6,6 +6,8 @@
 #include <mbgl/gfx/index_vector.hpp>
 #include <mbgl/gfx/types.hpp>
 #include <mbgl/renderer/render_pass.hpp>
+#include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/string.hpp>
 
 namespace mbgl {
 namespace gfx {
@@ -23,6 +25,16 @@ Drawable::Drawable(std::string name_)
 
 Drawable::~Drawable() = default;
 
+const std::string& Drawable::getDebugLabel() const {
+    if (debugLabel.empty()) {
+        debugLabel = util::toString(uniqueID.id()) + "/" + name;
+        if (tileID) {
+            debugLabel += "/" + util::toString(*tileID);
+        }
+    }
+    return debugLabel;
+}
+
 const gfx::ColorMode& Drawable::getColorMode() const {
     return impl->colorMode;
 }
@@ -46,6 +46,9 @@ RenderingStats& RenderingStats::operator+=(const RenderingStats& r) {
     numUniformBuffers += r.numUniformBuffers;
     numUniformUpdates += r.numUniformUpdates;
     uniformUpdateBytes += r.uniformUpdateBytes;
+    numUniformBufferObjs += r.numUniformBufferObjs;
+    uniformBufferObjUpdates += r.uniformBufferObjUpdates;
+    uniformBufferObjUpdateBytes += r.uniformBufferObjUpdateBytes;
     memTextures += r.memTextures;
     memBuffers += r.memBuffers;
     memIndexBuffers += r.memIndexBuffers;
@@ -53,6 +56,16 @@ RenderingStats& RenderingStats::operator+=(const RenderingStats& r) {
     memUniformBuffers += r.memUniformBuffers;
     stencilClears += r.stencilClears;
     stencilUpdates += r.stencilUpdates;
+    avoidedProgramBinds += r.avoidedProgramBinds;
+    avoidedTextureBinds += r.avoidedTextureBinds;
+    avoidedUniformBufferBinds += r.avoidedUniformBufferBinds;
+    avoidedVertexArrayBinds += r.avoidedVertexArrayBinds;
+    numSymbolsConsidered += r.numSymbolsConsidered;
+    numSymbolsCulled += r.numSymbolsCulled;
+    numSymbolsPlaced += r.numSymbolsPlaced;
+    layoutTime += r.layoutTime;
+    placementTime += r.placementTime;
+    uploadTime += r.uploadTime;
     return *this;
 }
 
@@ -70,10 +83,19 @@ std::string RenderingStats::toString(std::string_view sep) const {
        << "indexUpdateBytes = " << indexUpdateBytes << sep << "numVertexBuffers = " << numVertexBuffers << sep
        << "vertexUpdateBytes = " << vertexUpdateBytes << sep << "numUniformBuffers = " << numUniformBuffers << sep
        << "numUniformUpdates = " << numUniformUpdates << sep << "uniformUpdateBytes = " << uniformUpdateBytes << sep
+       << "numUniformBufferObjs = " << numUniformBufferObjs << sep
+       << "uniformBufferObjUpdates = " << uniformBufferObjUpdates << sep
+       << "uniformBufferObjUpdateBytes = " << uniformBufferObjUpdateBytes << sep
        << "memTextures = " << memTextures << sep << "memBuffers = " << memBuffers << sep
        << "memIndexBuffers = " << memIndexBuffers << sep << "memVertexBuffers = " << memVertexBuffers << sep
        << "memUniformBuffers = " << memUniformBuffers << sep << "stencilClears = " << stencilClears << sep
-       << "stencilUpdates = " << stencilUpdates << sep;
+       << "stencilUpdates = " << stencilUpdates << sep << "avoidedProgramBinds = " << avoidedProgramBinds << sep
+       << "avoidedTextureBinds = " << avoidedTextureBinds << sep
+       << "avoidedUniformBufferBinds = " << avoidedUniformBufferBinds << sep
+       << "avoidedVertexArrayBinds = " << avoidedVertexArrayBinds << sep
+       << "numSymbolsConsidered = " << numSymbolsConsidered << sep << "numSymbolsCulled = " << numSymbolsCulled << sep
+       << "numSymbolsPlaced = " << numSymbolsPlaced << sep << "layoutTime = " << layoutTime << sep
+       << "placementTime = " << placementTime << sep << "uploadTime = " << uploadTime << sep;
     return ss.str();
 }
 #endif
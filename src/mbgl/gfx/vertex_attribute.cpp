@@ -73,6 +73,14 @@ std::size_t VertexAttribute::getStrideOf(gfx::AttributeDataType type) {
             return 12;
         case gfx::AttributeDataType::Float4:
             return 16;
+        case gfx::AttributeDataType::HalfFloat:
+            return 2;
+        case gfx::AttributeDataType::HalfFloat2:
+            return 4;
+        case gfx::AttributeDataType::HalfFloat3:
+            return 6;
+        case gfx::AttributeDataType::HalfFloat4:
+            return 8;
         default:
             return 0;
     }
@@ -73,10 +73,20 @@ GLint getMaxVertexAttribs() {
 
 Context::Context(RendererBackend& backend_)
     : gfx::Context(/*maximumVertexBindingCount=*/getMaxVertexAttribs()),
-      backend(backend_) {}
+      backend(backend_)
+#if MLN_DRAWABLE_RENDERER
+      ,
+      uniformBufferAllocator(stats)
+#endif
+{
+}
 
 Context::~Context() noexcept {
     if (cleanupOnDestruction) {
+#if MLN_DRAWABLE_RENDERER
+        // Uniform buffers refer to the allocator, so none may outlive the context
+        assert(uniformBufferAllocator.getAllocatedCount() == 0);
+#endif
         reset();
 #if !defined(NDEBUG)
         Log::Debug(Event::General, "Rendering Stats:\n" + stats.toString("\n"));
@@ -154,9 +164,16 @@ UniqueShader Context::createShader(ShaderType type, const std::initializer_list<
     throw std::runtime_error("shader failed to compile");
 }
 
-UniqueProgram Context::createProgram(ShaderID vertexShader, ShaderID fragmentShader, const char* location0AttribName) {
+UniqueProgram Context::createProgram(ShaderID vertexShader,
+                                     ShaderID fragmentShader,
+                                     const char* location0AttribName,
+                                     bool retrievableBinary) {
     UniqueProgram result{MBGL_CHECK_ERROR(glCreateProgram()), {this}};
 
+    if (retrievableBinary) {
+        MBGL_CHECK_ERROR(glProgramParameteri(result, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+    }
+
     MBGL_CHECK_ERROR(glAttachShader(result, vertexShader));
     MBGL_CHECK_ERROR(glAttachShader(result, fragmentShader));
 
@@ -171,6 +188,59 @@ UniqueProgram Context::createProgram(ShaderID vertexShader, ShaderID fragmentSha
     return result;
 }
 
+std::optional<UniqueProgram> Context::createProgram(BinaryProgramFormat binaryFormat, std::string_view binary) {
+    UniqueProgram result{MBGL_CHECK_ERROR(glCreateProgram()), {this}};
+    MBGL_CHECK_ERROR(glProgramBinary(result, binaryFormat, binary.data(), static_cast<GLsizei>(binary.size())));
+
+    // Drivers reject binaries they can't use by failing the link; this is not
+    // an error, the program has to be compiled from source instead.
+    GLint status = GL_FALSE;
+    MBGL_CHECK_ERROR(glGetProgramiv(result, GL_LINK_STATUS, &status));
+    if (status != GL_TRUE) {
+        return std::nullopt;
+    }
+    return std::optional<UniqueProgram>{std::move(result)};
+}
+
+bool Context::supportsBinaryPrograms() {
+    if (!binaryProgramsSupported) {
+        GLint formats = 0;
+        MBGL_CHECK_ERROR(glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats));
+        binaryProgramsSupported = formats > 0;
+    }
+    return *binaryProgramsSupported;
+}
+
+std::optional<std::pair<BinaryProgramFormat, std::string>> Context::getBinaryProgram(ProgramID program_) {
+    GLint length = 0;
+    MBGL_CHECK_ERROR(glGetProgramiv(program_, GL_PROGRAM_BINARY_LENGTH, &length));
+    if (length <= 0) {
+        return std::nullopt;
+    }
+
+    std::string binary(length, '\0');
+    GLenum binaryFormat = 0;
+    GLsizei written = 0;
+    MBGL_CHECK_ERROR(glGetProgramBinary(program_, length, &written, &binaryFormat, binary.data()));
+    if (written <= 0) {
+        return std::nullopt;
+    }
+    binary.resize(written);
+    return std::make_pair(static_cast<BinaryProgramFormat>(binaryFormat), std::move(binary));
+}
+
+const std::string& Context::getDriverDescription() {
+    if (driverDescription.empty()) {
+        for (const GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+            if (const auto* value = reinterpret_cast<const char*>(MBGL_CHECK_ERROR(glGetString(name)))) {
+                driverDescription.append(value);
+            }
+            driverDescription.push_back('|');
+        }
+    }
+    return driverDescription;
+}
+
 void Context::linkProgram(ProgramID program_) {
     MBGL_CHECK_ERROR(glLinkProgram(program_));
     verifyProgramLinkage(program_);
@@ -427,6 +497,11 @@ void Context::reset() {
     std::copy(pooledTextures.begin(), pooledTextures.end(), std::back_inserter(abandonedTextures));
     pooledTextures.resize(0);
     performCleanup();
+#if MLN_DRAWABLE_RENDERER
+    if (uniformBufferAllocator.getAllocatedCount() == 0) {
+        uniformBufferAllocator.reset();
+    }
+#endif
 }
 
 #if MLN_DRAWABLE_RENDERER
@@ -494,7 +569,7 @@ gfx::UniqueDrawableBuilder Context::createDrawableBuilder(std::string name) {
 }
 
 gfx::UniformBufferPtr Context::createUniformBuffer(const void* data, std::size_t size, bool /*persistent*/) {
-    return std::make_shared<gl::UniformBufferGL>(data, size);
+    return std::make_shared<gl::UniformBufferGL>(uniformBufferAllocator, data, size);
 }
 
 gfx::ShaderProgramBasePtr Context::getGenericShader(gfx::ShaderRegistry& shaders, const std::string& name) {
@@ -647,6 +722,11 @@ void Context::draw(const gfx::DrawMode& drawMode, std::size_t indexOffset, std::
             break;
     }
 
+#if MLN_DRAWABLE_RENDERER
+    // Uniform buffer writes are batched until something is drawn
+    uniformBufferAllocator.flush();
+#endif
+
     MBGL_CHECK_ERROR(glDrawElements(Enum<gfx::DrawModeType>::to(drawMode.type),
                                     static_cast<GLsizei>(indexLength),
                                     GL_UNSIGNED_SHORT,
@@ -17,10 +17,15 @@
 
 #if MLN_DRAWABLE_RENDERER
 #include <mbgl/gfx/texture2d.hpp>
+#include <mbgl/gl/uniform_buffer_allocator.hpp>
 #endif
 
 #include <array>
 #include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 namespace mbgl {
@@ -49,7 +54,20 @@ public:
     void enableDebugging();
 
     UniqueShader createShader(ShaderType type, const std::initializer_list<const char*>& sources);
-    UniqueProgram createProgram(ShaderID vertexShader, ShaderID fragmentShader, const char* location0AttribName);
+    UniqueProgram createProgram(ShaderID vertexShader,
+                                ShaderID fragmentShader,
+                                const char* location0AttribName,
+                                bool retrievableBinary = false);
+    /// Loads a program binary retrieved with getBinaryProgram. Returns nothing
+    /// when the driver rejects it, e.g. after a driver update.
+    std::optional<UniqueProgram> createProgram(BinaryProgramFormat, std::string_view binary);
+    /// Whether the driver supports at least one program binary format.
+    bool supportsBinaryPrograms();
+    /// Returns the binary of a program linked with retrievableBinary set.
+    std::optional<std::pair<BinaryProgramFormat, std::string>> getBinaryProgram(ProgramID);
+    /// Vendor, renderer and version string of the driver; program binaries are
+    /// only valid for the driver that produced them.
+    const std::string& getDriverDescription();
     void verifyProgramLinkage(ProgramID);
     void linkProgram(ProgramID);
     UniqueTexture createUniqueTexture();
@@ -125,6 +143,8 @@ public:
                                       const void* data,
                                       std::size_t size,
                                       bool persistent) override;
+
+    UniformBufferAllocator& getUniformBufferAllocator() { return uniformBufferAllocator; }
 #endif
 
     void setDirtyState() override;
@@ -133,7 +153,13 @@ private:
     RendererBackend& backend;
     bool cleanupOnDestruction = true;
 
+#if MLN_DRAWABLE_RENDERER
+    UniformBufferAllocator uniformBufferAllocator;
+#endif
+
     std::unique_ptr<extension::Debugging> debugging;
+    std::optional<bool> binaryProgramsSupported;
+    std::string driverDescription;
 
 public:
     State<value::ActiveTextureUnit> activeTextureUnit;
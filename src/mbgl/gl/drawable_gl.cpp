@@ -1,5 +1,6 @@
 #include <mbgl/gl/drawable_gl.hpp>
 #include <mbgl/gl/drawable_gl_impl.hpp>
+#include <mbgl/gl/drawable_submission.hpp>
 #include <mbgl/gl/texture2d.hpp>
 #include <mbgl/gl/upload_pass.hpp>
 #include <mbgl/gl/vertex_array.hpp>
@@ -41,23 +42,7 @@ void DrawableGL::draw(PaintParameters& parameters) const {
         return;
     }
 
-    if (enableDepth) {
-        context.setDepthMode(getIs3D() ? parameters.depthModeFor3D()
-                                       : parameters.depthModeForSublayer(getSubLayerIndex(), getDepthType()));
-    } else {
-        context.setDepthMode(gfx::DepthMode::disabled());
-    }
-
-    // force disable depth test for debugging
-    // context.setDepthMode({gfx::DepthFunctionType::Always, gfx::DepthMaskType::ReadOnly, {0,1}});
-
-    // For 3D mode, stenciling is handled by the layer group
-    if (!is3D) {
-        context.setStencilMode(makeStencilMode(parameters));
-    }
-
-    context.setColorMode(getColorMode());
-    context.setCullFaceMode(getCullFaceMode());
+    setRenderModes(parameters);
 
     bindUniformBuffers();
     bindTextures();
@@ -77,6 +62,101 @@ void DrawableGL::draw(PaintParameters& parameters) const {
     unbindUniformBuffers();
 }
 
+void DrawableGL::draw(PaintParameters& parameters, DrawableSubmission& submission) const {
+    if (isCustom) {
+        return;
+    }
+
+    auto& context = static_cast<gl::Context&>(parameters.context);
+    auto& stats = context.renderingStats();
+
+    if (!shader) {
+        mbgl::Log::Warning(Event::General, "Missing shader for drawable " + util::toString(getID()) + "/" + getName());
+        assert(false);
+        return;
+    }
+
+    // Textures stay bound while consecutive drawables share the program and sampler locations
+    const auto* previous = submission.previous;
+    const bool keepTextures = previous && previous->shader == shader &&
+                              previous->textures.size() == textures.size() &&
+                              std::all_of(textures.begin(), textures.end(), [&](const auto& pair) {
+                                  return previous->textures.find(pair.first) != previous->textures.end();
+                              });
+    if (previous && !keepTextures) {
+        previous->unbindTextures();
+    }
+    submission.previous = this;
+
+    const auto& shaderGL = static_cast<const ShaderProgramGL&>(*shader);
+    if (context.program == shaderGL.getGLProgramID()) {
+        stats.avoidedProgramBinds++;
+    } else {
+        context.program = shaderGL.getGLProgramID();
+    }
+
+    setRenderModes(parameters);
+
+    for (const auto& element : shaderGL.getUniformBlocks().getMap()) {
+        if (const auto& uniformBuffer = getUniformBuffers().get(element.first)) {
+            submission.bindUniformBuffer(element.second->getIndex(), uniformBuffer);
+        } else {
+            Log::Error(Event::General,
+                       "draw: UBO " + std::string(stringIndexer().get(element.first)) + " not found for " +
+                           util::toString(getID()) + " / " + getName() + ". skipping.");
+            assert(false);
+        }
+    }
+
+    int32_t unit = 0;
+    for (const auto& pair : textures) {
+        if (const auto& tex = pair.second) {
+            auto& textureGL = static_cast<gl::Texture2D&>(*tex);
+            if (keepTextures && textureGL.isBound(pair.first, unit)) {
+                stats.avoidedTextureBinds++;
+            } else {
+                textureGL.bind(pair.first, unit);
+            }
+            unit++;
+        }
+    }
+
+    for (const auto& seg : impl->segments) {
+        const auto& glSeg = static_cast<DrawSegmentGL&>(*seg);
+        const auto& mlSeg = glSeg.getSegment();
+        if (mlSeg.indexLength > 0 && glSeg.getVertexArray().isValid()) {
+            if (context.bindVertexArray == glSeg.getVertexArray().getID()) {
+                stats.avoidedVertexArrayBinds++;
+            } else {
+                context.bindVertexArray = glSeg.getVertexArray().getID();
+            }
+            context.draw(glSeg.getMode(), mlSeg.indexOffset, mlSeg.indexLength);
+        }
+    }
+}
+
+void DrawableGL::setRenderModes(PaintParameters& parameters) const {
+    auto& context = static_cast<gl::Context&>(parameters.context);
+
+    if (enableDepth) {
+        context.setDepthMode(getIs3D() ? parameters.depthModeFor3D()
+                                       : parameters.depthModeForSublayer(getSubLayerIndex(), getDepthType()));
+    } else {
+        context.setDepthMode(gfx::DepthMode::disabled());
+    }
+
+    // force disable depth test for debugging
+    // context.setDepthMode({gfx::DepthFunctionType::Always, gfx::DepthMaskType::ReadOnly, {0,1}});
+
+    // For 3D mode, stenciling is handled by the layer group
+    if (!is3D) {
+        context.setStencilMode(makeStencilMode(parameters));
+    }
+
+    context.setColorMode(getColorMode());
+    context.setCullFaceMode(getCullFaceMode());
+}
+
 void DrawableGL::setIndexData(gfx::IndexVectorBasePtr indexes, std::vector<UniqueDrawSegment> segments) {
     impl->indexes = std::move(indexes);
     impl->segments = std::move(segments);
@@ -0,0 +1,133 @@
+#include <mbgl/gl/drawable_submission.hpp>
+
+#include <mbgl/gfx/drawable.hpp>
+#include <mbgl/gl/context.hpp>
+#include <mbgl/gl/defines.hpp>
+#include <mbgl/gl/drawable_gl.hpp>
+#include <mbgl/gl/uniform_buffer_gl.hpp>
+#include <mbgl/platform/gl_functions.hpp>
+#include <mbgl/shaders/shader_program_base.hpp>
+#include <mbgl/util/hash.hpp>
+
+#include <algorithm>
+#include <tuple>
+
+namespace mbgl {
+namespace gl {
+
+using namespace platform;
+
+namespace {
+
+std::size_t textureSetKey(const gfx::Drawable::Textures& textures) {
+    // Independent of the iteration order of the map
+    std::size_t key = 0;
+    for (const auto& [location, texture] : textures) {
+        if (texture) {
+            key += util::hash(location, texture.get());
+        }
+    }
+    return key;
+}
+
+std::size_t rank(mbgl::unordered_map<std::int64_t, std::size_t>& ranks, std::int64_t key) {
+    return ranks.emplace(key, ranks.size()).first->second;
+}
+
+std::size_t rank(mbgl::unordered_map<std::size_t, std::size_t>& ranks, std::size_t key) {
+    return ranks.emplace(key, ranks.size()).first->second;
+}
+
+} // namespace
+
+void DrawableOrder::sort(std::vector<gfx::Drawable*>& drawables) {
+    if (drawables.size() < 2) {
+        return;
+    }
+
+    // Shaders and texture sets are ranked by first use, which keeps the result
+    // independent of pointer values and so the same from frame to frame.
+    entries.clear();
+    shaderRanks.clear();
+    textureRanks.clear();
+    for (std::size_t i = 0; i < drawables.size(); ++i) {
+        auto* drawable = drawables[i];
+        const auto& shader = drawable->getShader();
+        entries.push_back({drawable,
+                           rank(shaderRanks, shader ? shader->getID().id() : 0),
+                           rank(textureRanks, textureSetKey(drawable->getTextures())),
+                           i});
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return std::make_tuple(a.drawable->getDrawPriority(), a.shaderRank, a.textureRank, a.index) <
+               std::make_tuple(b.drawable->getDrawPriority(), b.shaderRank, b.textureRank, b.index);
+    });
+
+    if (!keepsTileOrder()) {
+        return;
+    }
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        drawables[i] = entries[i].drawable;
+    }
+}
+
+bool DrawableOrder::keepsTileOrder() {
+    // Pair each drawable with its new position and visit them by tile, in the
+    // original order; the new positions must increase within each tile.
+    byTile.clear();
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        byTile.emplace_back(entries[i].drawable, i);
+    }
+    std::sort(byTile.begin(), byTile.end(), [&](const auto& a, const auto& b) {
+        const auto& tileA = a.first->getTileID();
+        const auto& tileB = b.first->getTileID();
+        if (tileA != tileB) {
+            return tileA < tileB;
+        }
+        return entries[a.second].index < entries[b.second].index;
+    });
+    for (std::size_t i = 1; i < byTile.size(); ++i) {
+        const auto& [previous, previousPosition] = byTile[i - 1];
+        const auto& [drawable, position] = byTile[i];
+        if (previous->getTileID() == drawable->getTileID() && previousPosition > position) {
+            return false;
+        }
+    }
+    return true;
+}
+
+DrawableSubmission::DrawableSubmission(Context& context_)
+    : context(context_) {}
+
+DrawableSubmission::~DrawableSubmission() {
+    finish();
+}
+
+void DrawableSubmission::bindUniformBuffer(std::size_t binding, const std::shared_ptr<gfx::UniformBuffer>& buffer) {
+    if (binding < maxUniformBufferBindings) {
+        if (uniformBuffers[binding] == buffer) {
+            context.renderingStats().avoidedUniformBufferBinds++;
+            return;
+        }
+        uniformBuffers[binding] = buffer;
+    }
+    static_cast<const UniformBufferGL&>(*buffer).bind(binding);
+}
+
+void DrawableSubmission::finish() {
+    if (previous) {
+        previous->unbindTextures();
+        previous = nullptr;
+    }
+    for (std::size_t binding = 0; binding < maxUniformBufferBindings; ++binding) {
+        if (uniformBuffers[binding]) {
+            MBGL_CHECK_ERROR(glBindBufferBase(GL_UNIFORM_BUFFER, static_cast<GLuint>(binding), 0));
+            uniformBuffers[binding].reset();
+        }
+    }
+    context.bindVertexArray = value::BindVertexArray::Default;
+}
+
+} // namespace gl
+} // namespace mbgl
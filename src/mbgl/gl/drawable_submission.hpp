@@ -0,0 +1,88 @@
+#pragma once
+
+#include <mbgl/util/containers.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace mbgl {
+
+namespace gfx {
+class Drawable;
+class UniformBuffer;
+} // namespace gfx
+
+namespace gl {
+
+class Context;
+class DrawableGL;
+
+/**
+ Orders the drawables of a layer group so that drawables using the same shader
+ and textures are drawn one after another.
+
+ Drawables of the same tile keep their relative order, since they may overlap.
+ The order across tiles follows drawable creation and carries no meaning, so
+ it is free to change. If no order satisfies both, the original is kept.
+ */
+class DrawableOrder {
+public:
+    /// Sorts the drawables in place. The storage used is kept for the next call.
+    void sort(std::vector<gfx::Drawable*>&);
+
+private:
+    struct Entry {
+        gfx::Drawable* drawable;
+        std::size_t shaderRank;
+        std::size_t textureRank;
+        std::size_t index;
+    };
+
+    bool keepsTileOrder();
+
+    std::vector<Entry> entries;
+    std::vector<std::pair<const gfx::Drawable*, std::size_t>> byTile;
+    mbgl::unordered_map<std::int64_t, std::size_t> shaderRanks;
+    mbgl::unordered_map<std::size_t, std::size_t> textureRanks;
+};
+
+/**
+ Tracks the bindings of a sequence of drawables drawn with
+ `DrawableGL::draw(PaintParameters&, DrawableSubmission&)`.
+
+ Program, textures, uniform buffers and vertex arrays are left bound after each
+ draw, so that the next drawable only changes the bindings that differ. They
+ are reset by `finish`, which runs on destruction as well.
+ */
+class DrawableSubmission {
+public:
+    explicit DrawableSubmission(Context&);
+    DrawableSubmission(const DrawableSubmission&) = delete;
+    DrawableSubmission& operator=(const DrawableSubmission&) = delete;
+    ~DrawableSubmission();
+
+    /// Resets the bindings left by the drawables submitted so far, e.g. before
+    /// handing the context to a custom layer.
+    void finish();
+
+private:
+    friend class DrawableGL;
+
+    /// Binds the buffer to the uniform buffer binding point, unless it is bound already
+    void bindUniformBuffer(std::size_t binding, const std::shared_ptr<gfx::UniformBuffer>&);
+
+    // Uniform buffers bound at each binding point. Holding on to them keeps their
+    // IDs from being reused by new buffers while the binding is assumed.
+    static constexpr std::size_t maxUniformBufferBindings = 16;
+    std::array<std::shared_ptr<gfx::UniformBuffer>, maxUniformBufferBindings> uniformBuffers;
+
+    Context& context;
+    const DrawableGL* previous = nullptr;
+};
+
+} // namespace gl
+} // namespace mbgl
@@ -0,0 +1,116 @@
+#include <mbgl/gl/framebuffer_readback.hpp>
+
+#include <mbgl/gl/context.hpp>
+#include <mbgl/gl/defines.hpp>
+#include <mbgl/platform/gl_functions.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace mbgl {
+namespace gl {
+
+using namespace platform;
+
+FramebufferReadback::FramebufferReadback(Context& context_, std::size_t ringSize)
+    : context(context_),
+      slots(std::max<std::size_t>(ringSize, 1)) {}
+
+FramebufferReadback::~FramebufferReadback() {
+    // Pending reads are dropped without running their callbacks; the buffers
+    // are released through the context.
+    for (auto& slot : slots) {
+        if (slot.fence) {
+            MBGL_CHECK_ERROR(glDeleteSync(slot.fence));
+        }
+    }
+}
+
+void FramebufferReadback::read(const Size size, Callback callback, PremultipliedImage destination) {
+    poll(false);
+    if (count == slots.size()) {
+        complete(true);
+    }
+
+    Slot& slot = slots[(first + count) % slots.size()];
+    const std::size_t byteSize = size.area() * PremultipliedImage::channels;
+
+    if (!slot.buffer) {
+        BufferID id = 0;
+        MBGL_CHECK_ERROR(glGenBuffers(1, &id));
+        context.renderingStats().numBuffers++;
+        // NOLINTNEXTLINE(performance-move-const-arg)
+        slot.buffer.emplace(std::move(id), detail::BufferDeleter{context});
+    }
+
+    // The pack buffer binding isn't tracked by the context, so it is reset right
+    // away: synchronous reads would otherwise write into the buffer.
+    MBGL_CHECK_ERROR(glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer->get()));
+    if (slot.capacity < byteSize) {
+        MBGL_CHECK_ERROR(glBufferData(GL_PIXEL_PACK_BUFFER, byteSize, nullptr, GL_STREAM_READ));
+        slot.capacity = byteSize;
+    }
+    context.pixelStorePack = {1};
+    MBGL_CHECK_ERROR(glReadPixels(0, 0, size.width, size.height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+    MBGL_CHECK_ERROR(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+
+    slot.fence = MBGL_CHECK_ERROR(glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+    // Submit the commands, so that the fence signals without anyone waiting on it.
+    MBGL_CHECK_ERROR(glFlush());
+
+    slot.size = size;
+    slot.destination = std::move(destination);
+    slot.callback = std::move(callback);
+    count++;
+}
+
+void FramebufferReadback::poll(bool wait) {
+    while (count && complete(wait)) {
+    }
+}
+
+bool FramebufferReadback::complete(bool wait) {
+    assert(count);
+    Slot& slot = slots[first];
+
+    const GLenum status = MBGL_CHECK_ERROR(
+        glClientWaitSync(slot.fence, wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, wait ? GL_TIMEOUT_IGNORED : 0));
+    if (status == GL_TIMEOUT_EXPIRED) {
+        return false;
+    }
+    // On GL_WAIT_FAILED, mapping the buffer below still waits for the copy.
+    MBGL_CHECK_ERROR(glDeleteSync(slot.fence));
+    slot.fence = nullptr;
+
+    const Size size = slot.size;
+    PremultipliedImage image = slot.destination.size == size ? std::move(slot.destination) : PremultipliedImage(size);
+    slot.destination = {};
+    const std::size_t stride = size.width * PremultipliedImage::channels;
+
+    MBGL_CHECK_ERROR(glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer->get()));
+    const auto* pixels = static_cast<const uint8_t*>(
+        MBGL_CHECK_ERROR(glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, stride * size.height, GL_MAP_READ_BIT)));
+    if (pixels) {
+        // The pixels have to be copied out of the mapping anyway, so the rows are
+        // flipped on the way rather than in a separate pass.
+        for (std::size_t row = 0; row < size.height; ++row) {
+            std::memcpy(image.data.get() + row * stride, pixels + (size.height - 1 - row) * stride, stride);
+        }
+        MBGL_CHECK_ERROR(glUnmapBuffer(GL_PIXEL_PACK_BUFFER));
+    }
+    MBGL_CHECK_ERROR(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+
+    auto callback = std::move(slot.callback);
+    slot.callback = {};
+    first = (first + 1) % slots.size();
+    count--;
+
+    if (callback) {
+        callback(std::move(image));
+    }
+    return true;
+}
+
+} // namespace gl
+} // namespace mbgl
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <mbgl/gl/object.hpp>
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/size.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <vector>
+
+struct __GLsync;
+
+namespace mbgl {
+namespace gl {
+
+class Context;
+
+/// Reads the bound framebuffer back without stalling the pipeline.
+///
+/// Each read copies the pixels into one of a ring of pixel pack buffers and
+/// places a fence behind it, so that the GPU performs the copy once it has
+/// finished the frame while the caller goes on to render the next one. Reads
+/// complete in the order they were started, when they are polled after their
+/// fence has signaled, or when the ring is full and another read is started.
+class FramebufferReadback {
+public:
+    using Callback = std::function<void(PremultipliedImage)>;
+
+    explicit FramebufferReadback(Context&, std::size_t ringSize = 3);
+    ~FramebufferReadback();
+
+    FramebufferReadback(const FramebufferReadback&) = delete;
+    FramebufferReadback& operator=(const FramebufferReadback&) = delete;
+
+    /// Starts reading `size` pixels of the bound framebuffer. `callback` receives
+    /// the image with its rows top to bottom. When `destination` has the same size,
+    /// the pixels are written into it instead of a newly allocated image, so that
+    /// callers can recycle their buffers.
+    void read(Size size, Callback callback, PremultipliedImage destination = {});
+
+    /// Completes the reads whose pixels have arrived. With `wait` set, waits for
+    /// all pending reads instead.
+    void poll(bool wait);
+
+    std::size_t pending() const { return count; }
+
+private:
+    struct Slot {
+        std::optional<UniqueBuffer> buffer;
+        std::size_t capacity = 0;
+        __GLsync* fence = nullptr;
+        Size size;
+        PremultipliedImage destination;
+        Callback callback;
+    };
+
+    // Completes the oldest pending read; returns false if it isn't ready and `wait` is unset.
+    bool complete(bool wait);
+
+    Context& context;
+    std::vector<Slot> slots;
+    // The pending reads occupy `count` slots, starting at `first`.
+    std::size_t first = 0;
+    std::size_t count = 0;
+};
+
+} // namespace gl
+} // namespace mbgl
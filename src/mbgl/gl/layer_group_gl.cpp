@@ -14,7 +14,9 @@ namespace mbgl {
 namespace gl {
 
 TileLayerGroupGL::TileLayerGroupGL(int32_t layerIndex_, std::size_t initialCapacity, std::string name_)
-    : TileLayerGroup(layerIndex_, initialCapacity, std::move(name_)) {}
+    : TileLayerGroup(layerIndex_, initialCapacity, std::move(name_)),
+      clipMasksLabel(getName() + (getName().empty() ? "" : "-") + "tile-clip-masks"),
+      renderLabel(getName() + (getName().empty() ? "" : "-") + "render") {}
 
 void TileLayerGroupGL::upload(gfx::UploadPass& uploadPass) {
     if (!enabled) {
@@ -29,12 +31,7 @@ void TileLayerGroupGL::upload(gfx::UploadPass& uploadPass) {
         auto& drawableGL = static_cast<gl::DrawableGL&>(drawable);
 
 #if !defined(NDEBUG)
-        std::string label;
-        if (const auto& tileID = drawable.getTileID()) {
-            label = drawable.getName() + "/" + util::toString(*tileID);
-        }
-        const auto labelPtr = (label.empty() ? drawable.getName() : label).c_str();
-        const auto debugGroup = uploadPass.createDebugGroup(labelPtr);
+        const auto debugGroup = uploadPass.createDebugGroup(drawable.getDebugLabel().c_str());
 #endif
 
         drawableGL.upload(uploadPass);
@@ -58,8 +55,7 @@ void TileLayerGroupGL::render(RenderOrchestrator&, PaintParameters& parameters)
 
     if (getDrawableCount()) {
 #if !defined(NDEBUG)
-        const auto label_clip = getName() + (getName().empty() ? "" : "-") + "tile-clip-masks";
-        const auto debugGroupClip = parameters.encoder->createDebugGroup(label_clip.c_str());
+        const auto debugGroupClip = parameters.encoder->createDebugGroup(clipMasksLabel.c_str());
 #endif
 
         // If we're using stencil clipping, we need to handle 3D features separately
@@ -86,25 +82,30 @@ void TileLayerGroupGL::render(RenderOrchestrator&, PaintParameters& parameters)
     }
 
 #if !defined(NDEBUG)
-    const auto label_render = getName() + (getName().empty() ? "" : "-") + "render";
-    const auto debugGroupRender = parameters.encoder->createDebugGroup(label_render.c_str());
+    const auto debugGroupRender = parameters.encoder->createDebugGroup(renderLabel.c_str());
 #endif
 
+    drawOrder.clear();
     visitDrawables([&](gfx::Drawable& drawable) {
-        if (!drawable.getEnabled() || !drawable.hasRenderPass(parameters.pass)) {
-            return;
+        if (drawable.getEnabled() && drawable.hasRenderPass(parameters.pass)) {
+            drawOrder.push_back(&drawable);
         }
+    });
+    order.sort(drawOrder);
+
+    DrawableSubmission submission(context);
+    for (auto* drawablePtr : drawOrder) {
+        auto& drawable = *drawablePtr;
 
 #if !defined(NDEBUG)
-        std::string label_tile;
-        if (const auto& tileID = drawable.getTileID()) {
-            label_tile = util::toString(drawable.getID().id()) + "/" + drawable.getName() + "/" +
-                         util::toString(*tileID);
-        }
-        const auto labelPtr = (label_tile.empty() ? drawable.getName() : label_tile).c_str();
-        const auto debugGroupTile = parameters.encoder->createDebugGroup(labelPtr);
+        const auto debugGroupTile = parameters.encoder->createDebugGroup(drawable.getDebugLabel().c_str());
 #endif
 
+        if (drawable.getIsCustom()) {
+            // Custom drawables issue their own GL calls from the tweakers
+            submission.finish();
+        }
+
         for (const auto& tweaker : drawable.getTweakers()) {
             tweaker->execute(drawable, parameters);
         }
@@ -116,8 +117,8 @@ void TileLayerGroupGL::render(RenderOrchestrator&, PaintParameters& parameters)
             context.setStencilMode(drawable.getEnableStencil() ? stencilMode3d : gfx::StencilMode::disabled());
         }
 
-        drawable.draw(parameters);
-    });
+        static_cast<const DrawableGL&>(drawable).draw(parameters, submission);
+    }
 }
 
 LayerGroupGL::LayerGroupGL(int32_t layerIndex_, std::size_t initialCapacity, std::string name_)
@@ -148,6 +149,8 @@ void LayerGroupGL::render(RenderOrchestrator&, PaintParameters& parameters) {
         return;
     }
 
+    // These drawables may overlap, so they are drawn in their original order
+    DrawableSubmission submission(static_cast<gl::Context&>(parameters.context));
     visitDrawables([&](gfx::Drawable& drawable) {
         if (!drawable.getEnabled() || !drawable.hasRenderPass(parameters.pass)) {
             return;
@@ -157,11 +160,16 @@ void LayerGroupGL::render(RenderOrchestrator&, PaintParameters& parameters) {
         const auto debugGroup = parameters.encoder->createDebugGroup(drawable.getName().c_str());
 #endif
 
+        if (drawable.getIsCustom()) {
+            // Custom drawables issue their own GL calls from the tweakers
+            submission.finish();
+        }
+
         for (const auto& tweaker : drawable.getTweakers()) {
             tweaker->execute(drawable, parameters);
         }
 
-        drawable.draw(parameters);
+        static_cast<const DrawableGL&>(drawable).draw(parameters, submission);
     });
 }
 
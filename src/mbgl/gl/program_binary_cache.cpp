@@ -0,0 +1,232 @@
+#include <mbgl/gl/program_binary_cache.hpp>
+
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/logging.hpp>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+namespace mbgl {
+namespace gl {
+
+namespace {
+
+constexpr std::string_view magic = "MLNPBIN1";
+constexpr std::string_view extension = ".pbin";
+
+// FNV-1a; unlike std::hash, the result doesn't depend on the standard library.
+constexpr uint64_t fnvOffset = 0xcbf29ce484222325ull;
+constexpr uint64_t fnvPrime = 0x100000001b3ull;
+
+uint64_t fnv1a(std::string_view data, uint64_t hash = fnvOffset) {
+    for (const char c : data) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= fnvPrime;
+    }
+    return hash;
+}
+
+template <typename T>
+void append(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+class Reader {
+public:
+    explicit Reader(std::string_view data_)
+        : data(data_) {}
+
+    template <typename T>
+    bool read(T& value) {
+        if (data.size() < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, data.data(), sizeof(T));
+        data.remove_prefix(sizeof(T));
+        return true;
+    }
+
+    bool read(std::string_view& value, std::size_t length) {
+        if (data.size() < length) {
+            return false;
+        }
+        value = data.substr(0, length);
+        data.remove_prefix(length);
+        return true;
+    }
+
+    bool done() const { return data.empty(); }
+
+private:
+    std::string_view data;
+};
+
+struct StoredEntry {
+    std::string path;
+    uint64_t size;
+    int64_t modified;
+};
+
+std::vector<StoredEntry> listEntries(const std::string& directory) {
+    std::vector<StoredEntry> entries;
+#if defined(_WIN32)
+    WIN32_FIND_DATAA data;
+    HANDLE find = FindFirstFileA((directory + "/*" + std::string(extension)).c_str(), &data);
+    if (find == INVALID_HANDLE_VALUE) {
+        return entries;
+    }
+    do {
+        entries.push_back({directory + "/" + data.cFileName,
+                           (uint64_t(data.nFileSizeHigh) << 32) | data.nFileSizeLow,
+                           (int64_t(data.ftLastWriteTime.dwHighDateTime) << 32) | data.ftLastWriteTime.dwLowDateTime});
+    } while (FindNextFileA(find, &data) != 0);
+    FindClose(find);
+#else
+    DIR* dir = opendir(directory.c_str());
+    if (dir == nullptr) {
+        return entries;
+    }
+    for (dirent* file = nullptr; (file = readdir(dir)) != nullptr;) {
+        const std::string_view name = file->d_name;
+        if (name.size() <= extension.size() || name.substr(name.size() - extension.size()) != extension) {
+            continue;
+        }
+        std::string path = directory + "/" + std::string(name);
+        struct stat info {};
+        if (stat(path.c_str(), &info) == 0 && S_ISREG(info.st_mode)) {
+            entries.push_back({std::move(path), uint64_t(info.st_size), int64_t(info.st_mtime)});
+        }
+    }
+    closedir(dir);
+#endif
+    return entries;
+}
+
+} // namespace
+
+ProgramBinaryCache::ProgramBinaryCache(std::string directory_, std::string driver_, uint64_t maxSize_)
+    : directory(std::move(directory_)),
+      driver(std::move(driver_)),
+      maxSize(maxSize_) {}
+
+uint64_t ProgramBinaryCache::key(std::initializer_list<std::string_view> parts) {
+    uint64_t hash = fnvOffset;
+    for (const auto part : parts) {
+        // Include the length, so that moving text between parts changes the key.
+        const auto length = static_cast<uint64_t>(part.size());
+        hash = fnv1a({reinterpret_cast<const char*>(&length), sizeof(length)}, hash);
+        hash = fnv1a(part, hash);
+    }
+    return hash;
+}
+
+std::string ProgramBinaryCache::path(uint64_t key_) const {
+    // Programs built from the same sources by another driver, or stored in
+    // another format, go to a file of their own.
+    const uint64_t name = key({magic, driver, {reinterpret_cast<const char*>(&key_), sizeof(key_)}});
+    char file[17];
+    std::snprintf(file, sizeof(file), "%016" PRIx64, name);
+    return directory + "/" + file + std::string(extension);
+}
+
+std::optional<ProgramBinaryCache::Entry> ProgramBinaryCache::load(uint64_t key_) const {
+    const auto data = util::readFile(path(key_));
+    if (!data) {
+        return std::nullopt;
+    }
+
+    Reader reader(*data);
+    std::string_view fileMagic;
+    uint64_t fileKey = 0;
+    uint32_t driverLength = 0;
+    std::string_view fileDriver;
+    Entry entry;
+    uint64_t binaryLength = 0;
+    std::string_view binary;
+    uint64_t checksum = 0;
+    if (!reader.read(fileMagic, magic.size()) || fileMagic != magic || !reader.read(fileKey) || fileKey != key_ ||
+        !reader.read(driverLength) || !reader.read(fileDriver, driverLength) || fileDriver != driver ||
+        !reader.read(entry.format) || !reader.read(binaryLength) || !reader.read(binary, binaryLength) ||
+        !reader.read(checksum) || checksum != fnv1a(binary) || !reader.done()) {
+        return std::nullopt;
+    }
+
+    entry.binary.assign(binary);
+    return entry;
+}
+
+bool ProgramBinaryCache::store(uint64_t key_, const Entry& entry) const {
+    std::string data;
+    data.reserve(magic.size() + driver.size() + entry.binary.size() + 40);
+    data.append(magic);
+    append<uint64_t>(data, key_);
+    append<uint32_t>(data, static_cast<uint32_t>(driver.size()));
+    data.append(driver);
+    append<uint32_t>(data, entry.format);
+    append<uint64_t>(data, entry.binary.size());
+    data.append(entry.binary);
+    append<uint64_t>(data, fnv1a(entry.binary));
+
+    // Write to a temporary file first, so that concurrent readers and crashes
+    // never leave a partially written entry behind.
+    const std::string target = path(key_);
+    const std::string temporary = target + ".tmp";
+    try {
+        util::write_file(temporary, data);
+    } catch (const util::IOException& e) {
+        Log::Warning(Event::Shader, "Failed to write program cache entry " + temporary + ": " + e.what());
+        return false;
+    }
+    if (std::rename(temporary.c_str(), target.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        Log::Warning(Event::Shader, "Failed to store program cache entry " + target);
+        return false;
+    }
+    prune(target);
+    return true;
+}
+
+void ProgramBinaryCache::remove(uint64_t key_) const {
+    std::remove(path(key_).c_str());
+}
+
+void ProgramBinaryCache::prune() const {
+    prune({});
+}
+
+void ProgramBinaryCache::prune(const std::string& keep) const {
+    auto entries = listEntries(directory);
+    uint64_t size = 0;
+    for (const auto& entry : entries) {
+        size += entry.size;
+    }
+    if (size <= maxSize) {
+        return;
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const StoredEntry& a, const StoredEntry& b) {
+        return a.modified != b.modified ? a.modified < b.modified : a.path < b.path;
+    });
+    for (const auto& entry : entries) {
+        if (size <= maxSize) {
+            break;
+        }
+        if (entry.path != keep && std::remove(entry.path.c_str()) == 0) {
+            size -= entry.size;
+        }
+    }
+}
+
+} // namespace gl
+} // namespace mbgl
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <mbgl/gl/types.hpp>
+
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace mbgl {
+namespace gl {
+
+/// Keeps linked program binaries on disk, one file per program, so that they
+/// can be loaded instead of compiled on the next start-up.
+///
+/// Files are named after the key of the sources a program was built from, the
+/// driver that built it and the file format, and record the key and driver so
+/// that both are checked again on load. Corrupt or truncated files are rejected
+/// as well, so that a rejected entry only costs a regular compile. The oldest
+/// files are removed once the directory grows beyond `maxSize` bytes.
+class ProgramBinaryCache {
+public:
+    struct Entry {
+        BinaryProgramFormat format = 0;
+        std::string binary;
+    };
+
+    static constexpr uint64_t defaultMaxSize = 32 * 1024 * 1024;
+
+    ProgramBinaryCache(std::string directory, std::string driver, uint64_t maxSize = defaultMaxSize);
+
+    /// Hashes the given parts into a key identifying the program sources. The
+    /// result is stable across runs and platforms.
+    static uint64_t key(std::initializer_list<std::string_view> parts);
+
+    std::optional<Entry> load(uint64_t key) const;
+
+    /// Writes the entry atomically and prunes the directory; returns false if
+    /// it couldn't be written.
+    bool store(uint64_t key, const Entry&) const;
+
+    void remove(uint64_t key) const;
+
+    std::string path(uint64_t key) const;
+
+    /// Removes the least recently written entries until the entries of the
+    /// directory take up at most `maxSize` bytes.
+    void prune() const;
+
+private:
+    void prune(const std::string& keep) const;
+
+    const std::string directory;
+    const std::string driver;
+    const uint64_t maxSize;
+};
+
+} // namespace gl
+} // namespace mbgl
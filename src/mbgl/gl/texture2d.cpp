@@ -180,6 +180,13 @@ void Texture2D::unbind() noexcept {
     }
 }
 
+bool Texture2D::isBound(int32_t location, int32_t textureUnit) const noexcept {
+    // Another texture may have been bound to the unit since
+    return boundLocation == location && boundTextureUnit == textureUnit && !samplerStateDirty &&
+           textureUnit < static_cast<int32_t>(gfx::MaxActiveTextureUnits) &&
+           context.texture[static_cast<size_t>(textureUnit)] == getTextureID();
+}
+
 void Texture2D::upload(const void* pixelData, const Size& size_) noexcept {
     if (!textureResource || storageDirty || size_ == Size{0, 0} || size_ != size) {
         size = size_;
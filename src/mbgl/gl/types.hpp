@@ -14,6 +14,7 @@ using TextureID = uint32_t;
 using VertexArrayID = uint32_t;
 using FramebufferID = uint32_t;
 using RenderbufferID = uint32_t;
+using BinaryProgramFormat = uint32_t;
 
 // OpenGL does not formally define a type for attribute locations, but most APIs
 // use GLuint. The exception is glGetAttribLocation, which returns GLint so that
@@ -13,9 +13,7 @@ using namespace platform;
 
 void UniformBlockGL::bindBuffer(const gfx::UniformBuffer& uniformBuffer) {
     assert(size == uniformBuffer.getSize());
-    GLint binding = index;
-    const auto& uniformBufferGL = static_cast<const UniformBufferGL&>(uniformBuffer);
-    MBGL_CHECK_ERROR(glBindBufferBase(GL_UNIFORM_BUFFER, binding, uniformBufferGL.getID()));
+    static_cast<const UniformBufferGL&>(uniformBuffer).bind(index);
 }
 
 void UniformBlockGL::unbindBuffer() {
@@ -0,0 +1,242 @@
+#include <mbgl/gl/uniform_buffer_allocator.hpp>
+
+#include <mbgl/gfx/rendering_stats.hpp>
+#include <mbgl/gl/defines.hpp>
+#include <mbgl/platform/gl_functions.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <iterator>
+#include <limits>
+
+namespace mbgl {
+namespace gl {
+
+using namespace platform;
+
+namespace {
+
+constexpr auto noPage = std::numeric_limits<std::size_t>::max();
+
+std::size_t alignUp(std::size_t size, std::size_t alignment) {
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+UniformBufferAllocator::UniformBufferAllocator(gfx::RenderingStats& stats_)
+    : stats(stats_) {}
+
+std::size_t UniformBufferAllocator::getAlignment() {
+    if (!alignment) {
+        GLint value = 0;
+        MBGL_CHECK_ERROR(glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &value));
+        alignment = std::max<std::size_t>(static_cast<std::size_t>(value), 16);
+    }
+    return alignment;
+}
+
+std::size_t UniformBufferAllocator::getPageCount() const {
+    return static_cast<std::size_t>(
+        std::count_if(pages.begin(), pages.end(), [](const Page& page) { return page.id != 0; }));
+}
+
+std::size_t UniformBufferAllocator::addPage(std::size_t size) {
+    Page page;
+    page.data.resize(size);
+    MBGL_CHECK_ERROR(glGenBuffers(1, &page.id));
+    MBGL_CHECK_ERROR(glBindBuffer(GL_UNIFORM_BUFFER, page.id));
+    MBGL_CHECK_ERROR(glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW));
+    MBGL_CHECK_ERROR(glBindBuffer(GL_UNIFORM_BUFFER, 0));
+    stats.numUniformBufferObjs++;
+
+    // Reuse the slot of a deleted page, so that the indices of the others stay valid
+    const auto slot = std::find_if(pages.begin(), pages.end(), [](const Page& p) { return p.id == 0; });
+    if (slot != pages.end()) {
+        *slot = std::move(page);
+        return static_cast<std::size_t>(slot - pages.begin());
+    }
+    pages.push_back(std::move(page));
+    return pages.size() - 1;
+}
+
+std::optional<UniformBufferAllocator::Range> UniformBufferAllocator::allocateFromFreeBlocks(std::size_t alignedSize) {
+    for (std::size_t i = 0; i < pages.size(); ++i) {
+        auto& blocks = pages[i].freeBlocks;
+        const auto block = std::find_if(
+            blocks.begin(), blocks.end(), [&](const Block& b) { return b.size >= alignedSize; });
+        if (block == blocks.end()) {
+            continue;
+        }
+        const Range range{i, block->offset, alignedSize};
+        block->offset += alignedSize;
+        block->size -= alignedSize;
+        if (block->size == 0) {
+            blocks.erase(block);
+        }
+        return range;
+    }
+    return std::nullopt;
+}
+
+UniformBufferAllocator::Range UniformBufferAllocator::allocate(std::size_t size) {
+    assert(size > 0);
+    const auto alignedSize = alignUp(size, getAlignment());
+    allocatedCount++;
+    stats.numUniformBuffers++;
+    stats.memUniformBuffers += static_cast<int>(size);
+
+    if (alignedSize > pageSize) {
+        const auto page = addPage(alignedSize);
+        pages[page].used = pages[page].allocated = alignedSize;
+        return {page, 0, size};
+    }
+
+    auto range = allocateFromFreeBlocks(alignedSize);
+    if (!range) {
+        // Otherwise take the space from the end of the most recent page with room, which
+        // isn't dedicated to one large range
+        auto page = noPage;
+        for (auto i = pages.size(); i > 0; --i) {
+            const auto& candidate = pages[i - 1];
+            if (candidate.id != 0 && candidate.data.size() == pageSize && candidate.used + alignedSize <= pageSize) {
+                page = i - 1;
+                break;
+            }
+        }
+        if (page == noPage) {
+            page = addPage(pageSize);
+        }
+        range = Range{page, pages[page].used, alignedSize};
+        pages[page].used += alignedSize;
+    }
+
+    pages[range->page].allocated += alignedSize;
+    range->size = size;
+    return *range;
+}
+
+void UniformBufferAllocator::release(const Range& range) {
+    assert(allocatedCount > 0);
+    allocatedCount--;
+    stats.numUniformBuffers--;
+    stats.memUniformBuffers -= static_cast<int>(range.size);
+
+    auto& page = pages[range.page];
+    const auto alignedSize = alignUp(range.size, getAlignment());
+    assert(page.allocated >= alignedSize);
+    page.allocated -= alignedSize;
+    if (page.allocated == 0) {
+        // The buffer object is deleted on the next flush, unless it's used again before that
+        page.freeBlocks.clear();
+        page.used = 0;
+        hasEmptyPages = true;
+        return;
+    }
+
+    // Insert the range into the free blocks of the page, merged with its free neighbours
+    auto& blocks = page.freeBlocks;
+    auto next = std::lower_bound(blocks.begin(), blocks.end(), range.offset, [](const Block& b, std::size_t offset) {
+        return b.offset < offset;
+    });
+    Block block{range.offset, alignedSize};
+    if (next != blocks.end() && block.offset + block.size == next->offset) {
+        block.size += next->size;
+        next = blocks.erase(next);
+    }
+    if (next != blocks.begin()) {
+        auto prev = std::prev(next);
+        if (prev->offset + prev->size == block.offset) {
+            block.offset = prev->offset;
+            block.size += prev->size;
+            next = blocks.erase(prev);
+        }
+    }
+    if (block.offset + block.size == page.used) {
+        // Hand space at the end back to the page, rather than keeping it as a free block
+        page.used = block.offset;
+    } else {
+        blocks.insert(next, block);
+    }
+}
+
+void UniformBufferAllocator::markDirty(Page& page, std::size_t begin, std::size_t end) {
+    if (page.dirtyBegin == page.dirtyEnd) {
+        page.dirtyBegin = begin;
+        page.dirtyEnd = end;
+    } else {
+        page.dirtyBegin = std::min(page.dirtyBegin, begin);
+        page.dirtyEnd = std::max(page.dirtyEnd, end);
+    }
+    dirty = true;
+}
+
+void UniformBufferAllocator::write(const Range& range, const void* data) {
+    auto& page = pages[range.page];
+    assert(range.offset + range.size <= page.data.size());
+    std::memcpy(page.data.data() + range.offset, data, range.size);
+    markDirty(page, range.offset, range.offset + range.size);
+    stats.numUniformUpdates++;
+    stats.uniformUpdateBytes += range.size;
+}
+
+void UniformBufferAllocator::copy(const Range& from, const Range& to) {
+    assert(from.size == to.size);
+    write(to, pages[from.page].data.data() + from.offset);
+}
+
+void UniformBufferAllocator::deleteEmptyPages() {
+    for (auto& page : pages) {
+        if (page.id != 0 && page.allocated == 0) {
+            MBGL_CHECK_ERROR(glDeleteBuffers(1, &page.id));
+            stats.numUniformBufferObjs--;
+            page = Page{};
+        }
+    }
+    hasEmptyPages = false;
+}
+
+void UniformBufferAllocator::flush() {
+    if (hasEmptyPages) {
+        deleteEmptyPages();
+    }
+    if (!dirty) {
+        return;
+    }
+    for (auto& page : pages) {
+        if (page.id == 0 || page.dirtyBegin == page.dirtyEnd) {
+            continue;
+        }
+        // The ranges in between are uploaded again rather than issuing one call per range
+        const auto size = page.dirtyEnd - page.dirtyBegin;
+        MBGL_CHECK_ERROR(glBindBuffer(GL_UNIFORM_BUFFER, page.id));
+        MBGL_CHECK_ERROR(glBufferSubData(GL_UNIFORM_BUFFER,
+                                         static_cast<GLintptr>(page.dirtyBegin),
+                                         static_cast<GLsizeiptr>(size),
+                                         page.data.data() + page.dirtyBegin));
+        stats.uniformBufferObjUpdates++;
+        stats.uniformBufferObjUpdateBytes += size;
+        page.dirtyBegin = page.dirtyEnd = 0;
+    }
+    MBGL_CHECK_ERROR(glBindBuffer(GL_UNIFORM_BUFFER, 0));
+    dirty = false;
+}
+
+void UniformBufferAllocator::bind(std::size_t binding, const Range& range) const {
+    MBGL_CHECK_ERROR(glBindBufferRange(GL_UNIFORM_BUFFER,
+                                       static_cast<GLuint>(binding),
+                                       pages[range.page].id,
+                                       static_cast<GLintptr>(range.offset),
+                                       static_cast<GLsizeiptr>(range.size)));
+}
+
+void UniformBufferAllocator::reset() {
+    assert(allocatedCount == 0);
+    deleteEmptyPages();
+    pages.clear();
+    dirty = false;
+}
+
+} // namespace gl
+} // namespace mbgl
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <mbgl/gl/types.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace mbgl {
+
+namespace gfx {
+struct RenderingStats;
+} // namespace gfx
+
+namespace gl {
+
+/**
+ Sub-allocates uniform buffers from a few large GL buffer objects.
+
+ Each range keeps its place for as long as it is allocated, since uniform
+ buffers are updated only when their contents change and must keep the last
+ contents in between. Released ranges are merged with their free neighbours,
+ and buffer objects left without ranges are deleted on the next `flush`.
+ Writes go to a copy kept in memory and are uploaded with one
+ `glBufferSubData` per buffer object in `flush`, which must run before any
+ draw call that may read them.
+
+ Uniform buffers refer to the allocator they were created from, so it must
+ outlive them. The allocator is owned by the GL context.
+ */
+class UniformBufferAllocator {
+public:
+    struct Range {
+        std::size_t page = 0;
+        std::size_t offset = 0;
+        std::size_t size = 0;
+    };
+
+    explicit UniformBufferAllocator(gfx::RenderingStats&);
+    UniformBufferAllocator(const UniformBufferAllocator&) = delete;
+    UniformBufferAllocator& operator=(const UniformBufferAllocator&) = delete;
+
+    /// Returns a range of at least the given size, aligned for `glBindBufferRange`
+    Range allocate(std::size_t size);
+    /// Makes the range available to later allocations
+    void release(const Range&);
+
+    /// Writes the contents of the range, of its full size
+    void write(const Range&, const void* data);
+    /// Copies the contents of one range into another of the same size
+    void copy(const Range& from, const Range& to);
+
+    /// Uploads everything written since the last flush and deletes the buffer
+    /// objects that no longer hold any range
+    void flush();
+
+    /// Binds the range to the given uniform buffer binding point
+    void bind(std::size_t binding, const Range&) const;
+
+    /// Number of ranges currently allocated
+    std::size_t getAllocatedCount() const { return allocatedCount; }
+    /// Number of buffer objects currently created
+    std::size_t getPageCount() const;
+
+    /// Deletes the buffer objects. Only valid once all ranges are released.
+    void reset();
+
+    /// Size of the buffer objects, larger ranges get a buffer object of their own
+    static constexpr std::size_t pageSize = 64 * 1024;
+
+private:
+    struct Block {
+        std::size_t offset = 0;
+        std::size_t size = 0;
+    };
+
+    struct Page {
+        BufferID id = 0; // Zero once the buffer object is deleted and the slot may be reused
+        std::vector<std::uint8_t> data;
+        std::vector<Block> freeBlocks; // Released space below `used`, by offset, never adjacent
+        std::size_t used = 0;          // End of the space handed out so far
+        std::size_t allocated = 0;     // Size of the ranges allocated from the page, aligned
+        std::size_t dirtyBegin = 0;
+        std::size_t dirtyEnd = 0;
+    };
+
+    std::size_t getAlignment();
+    std::size_t addPage(std::size_t size);
+    std::optional<Range> allocateFromFreeBlocks(std::size_t alignedSize);
+    void deleteEmptyPages();
+    void markDirty(Page&, std::size_t begin, std::size_t end);
+
+    gfx::RenderingStats& stats;
+    std::vector<Page> pages;
+    std::size_t alignment = 0;
+    std::size_t allocatedCount = 0;
+    bool dirty = false;
+    bool hasEmptyPages = false;
+};
+
+} // namespace gl
+} // namespace mbgl
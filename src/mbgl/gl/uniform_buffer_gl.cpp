@@ -1,6 +1,4 @@
 #include <mbgl/gl/uniform_buffer_gl.hpp>
-#include <mbgl/gl/defines.hpp>
-#include <mbgl/platform/gl_functions.hpp>
 #include <mbgl/util/compression.hpp>
 #include <mbgl/util/logging.hpp>
 
@@ -9,31 +7,33 @@
 namespace mbgl {
 namespace gl {
 
-using namespace platform;
-
-UniformBufferGL::UniformBufferGL(const void* data_, std::size_t size_)
+UniformBufferGL::UniformBufferGL(UniformBufferAllocator& allocator_, const void* data_, std::size_t size_)
     : UniformBuffer(size_),
+      allocator(&allocator_),
+      range(allocator_.allocate(size_)),
       hash(util::crc32(data_, size_)) {
-    MBGL_CHECK_ERROR(glGenBuffers(1, &id));
-    MBGL_CHECK_ERROR(glBindBuffer(GL_UNIFORM_BUFFER, id));
-    MBGL_CHECK_ERROR(glBufferData(GL_UNIFORM_BUFFER, size, data_, GL_DYNAMIC_DRAW));
-    MBGL_CHECK_ERROR(glBindBuffer(GL_UNIFORM_BUFFER, 0));
+    allocator->write(range, data_);
 }
 
 UniformBufferGL::UniformBufferGL(const UniformBufferGL& other)
     : UniformBuffer(other),
+      allocator(other.allocator),
+      range(other.allocator->allocate(other.size)),
+      hash(other.hash) {
+    allocator->copy(other.range, range);
+}
+
+UniformBufferGL::UniformBufferGL(UniformBufferGL&& other)
+    : UniformBuffer(std::move(other)),
+      allocator(other.allocator),
+      range(other.range),
       hash(other.hash) {
-    MBGL_CHECK_ERROR(glGenBuffers(1, &id));
-    MBGL_CHECK_ERROR(glCopyBufferSubData(other.id, id, 0, 0, size));
-    MBGL_CHECK_ERROR(glBindBuffer(GL_COPY_READ_BUFFER, other.id));
-    MBGL_CHECK_ERROR(glBindBuffer(GL_COPY_WRITE_BUFFER, id));
-    MBGL_CHECK_ERROR(glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, size));
+    other.allocator = nullptr;
 }
 
 UniformBufferGL::~UniformBufferGL() {
-    if (id) {
-        MBGL_CHECK_ERROR(glDeleteBuffers(1, &id));
-        id = 0;
+    if (allocator) {
+        allocator->release(range);
     }
 }
 
@@ -49,11 +49,13 @@ void UniformBufferGL::update(const void* data_, std::size_t size_) {
     const uint32_t newHash = util::crc32(data_, size_);
     if (newHash != hash) {
         hash = newHash;
-        MBGL_CHECK_ERROR(glBindBuffer(GL_UNIFORM_BUFFER, id));
-        MBGL_CHECK_ERROR(glBufferSubData(GL_UNIFORM_BUFFER, 0, size_, data_));
-        MBGL_CHECK_ERROR(glBindBuffer(GL_UNIFORM_BUFFER, 0));
+        allocator->write(range, data_);
     }
 }
 
+void UniformBufferGL::bind(std::size_t binding) const {
+    allocator->bind(binding, range);
+}
+
 } // namespace gl
 } // namespace mbgl
@@ -431,6 +431,11 @@ GLenum vertexType(const gfx::AttributeDataType type) {
         case gfx::AttributeDataType::Float3:
         case gfx::AttributeDataType::Float4:
             return GL_FLOAT;
+        case gfx::AttributeDataType::HalfFloat:
+        case gfx::AttributeDataType::HalfFloat2:
+        case gfx::AttributeDataType::HalfFloat3:
+        case gfx::AttributeDataType::HalfFloat4:
+            return GL_HALF_FLOAT;
         default:
             return GL_FLOAT;
     }
@@ -445,6 +450,7 @@ GLint components(const gfx::AttributeDataType type) {
         case gfx::AttributeDataType::Int:
         case gfx::AttributeDataType::UInt:
         case gfx::AttributeDataType::Float:
+        case gfx::AttributeDataType::HalfFloat:
             return 1;
         case gfx::AttributeDataType::Byte2:
         case gfx::AttributeDataType::UByte2:
@@ -453,6 +459,7 @@ GLint components(const gfx::AttributeDataType type) {
         case gfx::AttributeDataType::Int2:
         case gfx::AttributeDataType::UInt2:
         case gfx::AttributeDataType::Float2:
+        case gfx::AttributeDataType::HalfFloat2:
             return 2;
         case gfx::AttributeDataType::Byte3:
         case gfx::AttributeDataType::UByte3:
@@ -461,6 +468,7 @@ GLint components(const gfx::AttributeDataType type) {
         case gfx::AttributeDataType::Int3:
         case gfx::AttributeDataType::UInt3:
         case gfx::AttributeDataType::Float3:
+        case gfx::AttributeDataType::HalfFloat3:
             return 3;
         case gfx::AttributeDataType::Byte4:
         case gfx::AttributeDataType::UByte4:
@@ -469,6 +477,7 @@ GLint components(const gfx::AttributeDataType type) {
         case gfx::AttributeDataType::Int4:
         case gfx::AttributeDataType::UInt4:
         case gfx::AttributeDataType::Float4:
+        case gfx::AttributeDataType::HalfFloat4:
             return 4;
         default:
             return 0;
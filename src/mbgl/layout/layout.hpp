@@ -13,6 +13,7 @@ class BucketParameters;
 class RenderLayer;
 class FeatureIndex;
 class LayerRenderData;
+class ShapingCache;
 
 class Layout {
 public:
@@ -25,7 +26,8 @@ public:
                               bool,
                               const CanonicalTileID&) = 0;
 
-    virtual void prepareSymbols(const GlyphMap&, const GlyphPositions&, const ImageMap&, const ImagePositions&){};
+    virtual void prepareSymbols(
+        const GlyphMap&, const GlyphPositions&, const ImageMap&, const ImagePositions&, ShapingCache*){};
 
     virtual bool hasSymbolInstances() const { return true; };
 
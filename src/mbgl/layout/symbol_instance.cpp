@@ -87,10 +87,10 @@ SymbolInstance::SymbolInstance(Anchor& anchor_,
                                const float iconBoxScale,
                                const float iconPadding,
                                const std::array<float, 2>& iconOffset_,
-                               const IndexedSubfeature& indexedFeature,
+                               const IndexedSubfeature& indexedFeature_,
                                const std::size_t layoutFeatureIndex_,
                                const std::size_t dataFeatureIndex_,
-                               std::u16string key_,
+                               std::shared_ptr<const std::u16string> key_,
                                const float overscaling,
                                const float iconRotation,
                                const float textRotation,
@@ -98,8 +98,13 @@ SymbolInstance::SymbolInstance(Anchor& anchor_,
                                bool allowVerticalPlacement,
                                const SymbolContent iconType)
     : sharedData(std::move(sharedData_)),
+      sharedKey(std::move(key_)),
       anchor(anchor_),
       symbolContent(iconType),
+      writingModes(WritingModeType::None),
+      singleLine(shapedTextOrientations.singleLine),
+      textBoxScale(textBoxScale_),
+      variableTextOffset(variableTextOffset_),
       // Create the collision features that will be used to check whether this
       // symbol instance can be placed As a collision approximation, we can use
       // either the vertical or any of the horizontal versions of the feature
@@ -109,20 +114,14 @@ SymbolInstance::SymbolInstance(Anchor& anchor_,
                            textBoxScale_,
                            textPadding,
                            textPlacement,
-                           indexedFeature,
                            overscaling,
                            textRotation),
-      iconCollisionFeature(
-          sharedData->line, anchor, shapedIcon, iconBoxScale, iconPadding, indexedFeature, iconRotation),
-      writingModes(WritingModeType::None),
-      layoutFeatureIndex(layoutFeatureIndex_),
-      dataFeatureIndex(dataFeatureIndex_),
+      iconCollisionFeature(sharedData->line, anchor, shapedIcon, iconBoxScale, iconPadding, iconRotation),
+      layoutFeatureIndex(static_cast<uint32_t>(layoutFeatureIndex_)),
+      dataFeatureIndex(static_cast<uint32_t>(dataFeatureIndex_)),
       textOffset(textOffset_),
       iconOffset(iconOffset_),
-      key(std::move(key_)),
-      textBoxScale(textBoxScale_),
-      variableTextOffset(variableTextOffset_),
-      singleLine(shapedTextOrientations.singleLine) {
+      indexedFeature(indexedFeature_) {
     // 'hasText' depends on finding at least one glyph in the shaping that's also in the GlyphPositionMap
     if (!sharedData->empty()) symbolContent |= SymbolContent::Text;
     if (allowVerticalPlacement && shapedTextOrientations.vertical) {
@@ -133,7 +132,6 @@ SymbolInstance::SymbolInstance(Anchor& anchor_,
                                                         textBoxScale_,
                                                         textPadding,
                                                         textPlacement,
-                                                        indexedFeature,
                                                         overscaling,
                                                         textRotation + verticalPointLabelAngle);
         if (verticallyShapedIcon) {
@@ -142,16 +140,15 @@ SymbolInstance::SymbolInstance(Anchor& anchor_,
                                                             verticallyShapedIcon,
                                                             iconBoxScale,
                                                             iconPadding,
-                                                            indexedFeature,
                                                             iconRotation + verticalPointLabelAngle);
         }
     }
 
-    rightJustifiedGlyphQuadsSize = sharedData->rightJustifiedGlyphQuads.size();
-    centerJustifiedGlyphQuadsSize = sharedData->centerJustifiedGlyphQuads.size();
-    leftJustifiedGlyphQuadsSize = sharedData->leftJustifiedGlyphQuads.size();
-    verticalGlyphQuadsSize = sharedData->verticalGlyphQuads.size();
-    iconQuadsSize = sharedData->iconQuads ? sharedData->iconQuads->size() : 0;
+    rightJustifiedGlyphQuadsSize = static_cast<uint32_t>(sharedData->rightJustifiedGlyphQuads.size());
+    centerJustifiedGlyphQuadsSize = static_cast<uint32_t>(sharedData->centerJustifiedGlyphQuads.size());
+    leftJustifiedGlyphQuadsSize = static_cast<uint32_t>(sharedData->leftJustifiedGlyphQuads.size());
+    verticalGlyphQuadsSize = static_cast<uint32_t>(sharedData->verticalGlyphQuads.size());
+    iconQuadsSize = static_cast<uint32_t>(sharedData->iconQuads ? sharedData->iconQuads->size() : 0);
 
     if (rightJustifiedGlyphQuadsSize || centerJustifiedGlyphQuadsSize || leftJustifiedGlyphQuadsSize) {
         writingModes |= WritingModeType::Horizontal;
@@ -162,6 +159,11 @@ SymbolInstance::SymbolInstance(Anchor& anchor_,
     }
 }
 
+const std::u16string& SymbolInstance::key() const {
+    assert(sharedKey);
+    return *sharedKey;
+}
+
 const GeometryCoordinates& SymbolInstance::line() const {
     assert(sharedData);
     return sharedData->line;
@@ -213,7 +215,7 @@ void SymbolInstance::releaseSharedData() {
     sharedData.reset();
 }
 
-std::optional<size_t> SymbolInstance::getDefaultHorizontalPlacedTextIndex() const {
+std::optional<uint32_t> SymbolInstance::getDefaultHorizontalPlacedTextIndex() const {
     if (placedRightTextIndex) return placedRightTextIndex;
     if (placedCenterTextIndex) return placedCenterTextIndex;
     if (placedLeftTextIndex) return placedLeftTextIndex;
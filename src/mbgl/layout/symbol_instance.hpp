@@ -69,7 +69,7 @@ public:
                    const IndexedSubfeature& indexedFeature,
                    std::size_t layoutFeatureIndex,
                    std::size_t dataFeatureIndex,
-                   std::u16string key,
+                   std::shared_ptr<const std::u16string> key,
                    float overscaling,
                    float iconRotation,
                    float textRotation,
@@ -77,7 +77,10 @@ public:
                    bool allowVerticalPlacement,
                    SymbolContent iconType = SymbolContent::None);
 
-    std::optional<size_t> getDefaultHorizontalPlacedTextIndex() const;
+    std::optional<uint32_t> getDefaultHorizontalPlacedTextIndex() const;
+    /// Text of the symbol, used to match it with the same symbol in other tiles. Instances
+    /// of the same text share the string.
+    const std::u16string& key() const;
     const GeometryCoordinates& line() const;
     const SymbolQuads& rightJustifiedGlyphQuads() const;
     const SymbolQuads& leftJustifiedGlyphQuads() const;
@@ -92,38 +95,44 @@ public:
 
 private:
     std::shared_ptr<SymbolInstanceSharedData> sharedData;
+    std::shared_ptr<const std::u16string> sharedKey;
 
 public:
+    // Fields read for every symbol on each placement come first, the ones only needed
+    // while laying out, querying or indexing the bucket follow.
     Anchor anchor;
+    uint32_t crossTileID = 0;
     SymbolContent symbolContent;
-
-    std::size_t rightJustifiedGlyphQuadsSize;
-    std::size_t centerJustifiedGlyphQuadsSize;
-    std::size_t leftJustifiedGlyphQuadsSize;
-    std::size_t verticalGlyphQuadsSize;
-    std::size_t iconQuadsSize;
+    WritingModeType writingModes;
+    bool singleLine;
+    bool isDuplicate;
+    float textBoxScale;
+    std::array<float, 2> variableTextOffset;
 
     CollisionFeature textCollisionFeature;
     CollisionFeature iconCollisionFeature;
     std::optional<CollisionFeature> verticalTextCollisionFeature = std::nullopt;
     std::optional<CollisionFeature> verticalIconCollisionFeature = std::nullopt;
-    WritingModeType writingModes;
-    std::size_t layoutFeatureIndex; // Index into the set of features included at layout time
-    std::size_t dataFeatureIndex;   // Index into the underlying tile data feature set
+
+    std::optional<uint32_t> placedRightTextIndex;
+    std::optional<uint32_t> placedCenterTextIndex;
+    std::optional<uint32_t> placedLeftTextIndex;
+    std::optional<uint32_t> placedVerticalTextIndex;
+    std::optional<uint32_t> placedIconIndex;
+    std::optional<uint32_t> placedVerticalIconIndex;
+
+    uint32_t rightJustifiedGlyphQuadsSize;
+    uint32_t centerJustifiedGlyphQuadsSize;
+    uint32_t leftJustifiedGlyphQuadsSize;
+    uint32_t verticalGlyphQuadsSize;
+    uint32_t iconQuadsSize;
+
+    uint32_t layoutFeatureIndex; // Index into the set of features included at layout time
+    uint32_t dataFeatureIndex;   // Index into the underlying tile data feature set
     std::array<float, 2> textOffset;
     std::array<float, 2> iconOffset;
-    std::u16string key;
-    bool isDuplicate;
-    std::optional<size_t> placedRightTextIndex;
-    std::optional<size_t> placedCenterTextIndex;
-    std::optional<size_t> placedLeftTextIndex;
-    std::optional<size_t> placedVerticalTextIndex;
-    std::optional<size_t> placedIconIndex;
-    std::optional<size_t> placedVerticalIconIndex;
-    float textBoxScale;
-    std::array<float, 2> variableTextOffset;
-    bool singleLine;
-    uint32_t crossTileID = 0;
+    // Shared by the text, icon and vertical collision features of the symbol.
+    IndexedSubfeature indexedFeature;
 
     static constexpr uint32_t invalidCrossTileID() { return std::numeric_limits<uint32_t>::max(); }
 };
@@ -349,7 +349,8 @@ std::array<float, 2> SymbolLayout::evaluateVariableOffset(style::SymbolAnchorTyp
 void SymbolLayout::prepareSymbols(const GlyphMap& glyphMap,
                                   const GlyphPositions& glyphPositions,
                                   const ImageMap& imageMap,
-                                  const ImagePositions& imagePositions) {
+                                  const ImagePositions& imagePositions,
+                                  ShapingCache* shapingCache) {
     const bool isPointPlacement = layout->get<SymbolPlacement>() == SymbolPlacementType::Point;
     const bool textAlongLine = layout->get<TextRotationAlignment>() == AlignmentType::Map && !isPointPlacement;
 
@@ -391,7 +392,8 @@ void SymbolLayout::prepareSymbols(const GlyphMap& glyphMap,
                     /* images */ imagePositions,
                     layoutTextSize,
                     layoutTextSizeAtBucketZoomLevel,
-                    allowVerticalPlacement);
+                    allowVerticalPlacement,
+                    shapingCache);
 
                 return result;
             };
@@ -574,6 +576,7 @@ void SymbolLayout::addFeature(const std::size_t layoutFeatureIndex,
     const float textRepeatDistance = symbolSpacing / 2;
     const auto evaluatedLayoutProperties = layout->evaluate(zoom, feature);
     IndexedSubfeature indexedFeature(feature.index, sourceLayer->getName(), bucketLeaderID, symbolInstances.size());
+    const auto key = internKey(feature.formattedText ? feature.formattedText->rawText() : std::u16string());
 
     const auto iconTextFit = evaluatedLayoutProperties.get<style::IconTextFit>();
     const bool hasIconTextFit = iconTextFit != IconTextFitType::None;
@@ -619,7 +622,7 @@ void SymbolLayout::addFeature(const std::size_t layoutFeatureIndex,
                                          indexedFeature,
                                          layoutFeatureIndex,
                                          feature.index,
-                                         feature.formattedText ? feature.formattedText->rawText() : std::u16string(),
+                                         key,
                                          overscaling,
                                          iconRotation,
                                          textRotation,
@@ -739,6 +742,14 @@ void SymbolLayout::addFeature(const std::size_t layoutFeatureIndex,
     }
 }
 
+std::shared_ptr<const std::u16string> SymbolLayout::internKey(const std::u16string& text) {
+    auto& key = symbolKeys[text];
+    if (!key) {
+        key = std::make_shared<const std::u16string>(text);
+    }
+    return key;
+}
+
 bool SymbolLayout::anchorIsTooClose(const std::u16string& text, const float repeatDistance, const Anchor& anchor) {
     if (compareText.find(text) == compareText.end()) {
         compareText.emplace(text, Anchors());
@@ -827,7 +838,7 @@ void SymbolLayout::createBucket(const ImagePositions&,
                                                       writingMode,
                                                       symbolInstance.line(),
                                                       std::vector<float>());
-                index = iconBuffer.placedSymbols.size() - 1;
+                index = static_cast<uint32_t>(iconBuffer.placedSymbols.size() - 1);
                 PlacedSymbol& iconSymbol = iconBuffer.placedSymbols.back();
                 iconSymbol.angle = (allowVerticalPlacement && writingMode == WritingModeType::Vertical)
                                        ? static_cast<float>(M_PI_2)
@@ -852,7 +863,7 @@ void SymbolLayout::createBucket(const ImagePositions&,
         if (hasText && feature.formattedText) {
             std::optional<std::size_t> lastAddedSection;
             if (singleLine) {
-                std::optional<std::size_t> placedTextIndex;
+                std::optional<uint32_t> placedTextIndex;
                 lastAddedSection = addSymbolGlyphQuads(*bucket,
                                                        symbolInstance,
                                                        feature,
@@ -941,7 +952,7 @@ std::size_t SymbolLayout::addSymbolGlyphQuads(SymbolBucket& bucket,
                                               SymbolInstance& symbolInstance,
                                               const SymbolFeature& feature,
                                               WritingModeType writingMode,
-                                              std::optional<size_t>& placedIndex,
+                                              std::optional<uint32_t>& placedIndex,
                                               const SymbolQuads& glyphQuads,
                                               const CanonicalTileID& canonical,
                                               std::optional<std::size_t> lastAddedSection) {
@@ -958,7 +969,7 @@ std::size_t SymbolLayout::addSymbolGlyphQuads(SymbolBucket& bucket,
                                            symbolInstance.line(),
                                            calculateTileDistances(symbolInstance.line(), symbolInstance.anchor),
                                            placedIconIndex);
-    placedIndex = bucket.text.placedSymbols.size() - 1;
+    placedIndex = static_cast<uint32_t>(bucket.text.placedSymbols.size() - 1);
     PlacedSymbol& placedSymbol = bucket.text.placedSymbols.back();
     placedSymbol.angle = (allowVerticalPlacement && writingMode == WritingModeType::Vertical)
                              ? static_cast<float>(M_PI_2)
@@ -35,7 +35,8 @@ public:
     void prepareSymbols(const GlyphMap& glyphMap,
                         const GlyphPositions&,
                         const ImageMap&,
-                        const ImagePositions&) override;
+                        const ImagePositions&,
+                        ShapingCache*) override;
 
     void createBucket(const ImagePositions&,
                       std::unique_ptr<FeatureIndex>&,
@@ -80,6 +81,10 @@ private:
     bool anchorIsTooClose(const std::u16string& text, float repeatDistance, const Anchor&);
     std::map<std::u16string, std::vector<Anchor>> compareText;
 
+    // Returns the copy of the key shared by all the symbol instances with this text.
+    std::shared_ptr<const std::u16string> internKey(const std::u16string&);
+    std::map<std::u16string, std::shared_ptr<const std::u16string>> symbolKeys;
+
     void addToDebugBuffers(SymbolBucket&);
 
     // Adds placed items to the buffer.
@@ -102,7 +107,7 @@ private:
                                     SymbolInstance&,
                                     const SymbolFeature&,
                                     WritingModeType,
-                                    std::optional<size_t>& placedIndex,
+                                    std::optional<uint32_t>& placedIndex,
                                     const SymbolQuads&,
                                     const CanonicalTileID& canonical,
                                     std::optional<std::size_t> lastAddedSection = std::nullopt);
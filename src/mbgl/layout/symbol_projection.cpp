@@ -4,6 +4,11 @@
 #include <mbgl/renderer/buckets/symbol_bucket.hpp>
 #include <mbgl/renderer/layers/render_symbol_layer.hpp>
 #include <mbgl/util/math.hpp>
+#include <mbgl/util/parallel.hpp>
+
+#include <algorithm>
+#include <array>
+#include <vector>
 
 namespace mbgl {
 
@@ -114,6 +119,26 @@ PointAndCameraDistance project(const Point<float>& point, const mat4& matrix) {
     return {{static_cast<float>(pos[0] / pos[3]), static_cast<float>(pos[1] / pos[3])}, static_cast<float>(pos[3])};
 }
 
+void projectPoints(const float* xs,
+                   const float* ys,
+                   const std::size_t count,
+                   const mat4& matrix,
+                   double* outX,
+                   double* outY,
+                   double* outW) {
+    // Points lie in the z = 0 plane, so only these elements of the matrix contribute
+    const double m0 = matrix[0], m1 = matrix[1], m3 = matrix[3];
+    const double m4 = matrix[4], m5 = matrix[5], m7 = matrix[7];
+    const double m12 = matrix[12], m13 = matrix[13], m15 = matrix[15];
+    for (std::size_t i = 0; i < count; ++i) {
+        const double x = xs[i];
+        const double y = ys[i];
+        outX[i] = m0 * x + m4 * y + m12;
+        outY[i] = m1 * x + m5 * y + m13;
+        outW[i] = m3 * x + m7 * y + m15;
+    }
+}
+
 float evaluateSizeForFeature(const ZoomEvaluatedSize& zoomEvaluatedSize, const PlacedSymbol& placedSymbol) {
     if (zoomEvaluatedSize.isFeatureConstant) {
         return zoomEvaluatedSize.size;
@@ -158,6 +183,77 @@ enum PlacementResult {
     UseVertical
 };
 
+namespace {
+
+using DynamicVertex = gfx::Vertex<SymbolDynamicLayoutAttributes>;
+
+// Line labels are reprojected on worker threads once a bucket has more than this many of them
+constexpr std::size_t symbolsPerTask = 256;
+
+/*
+ * Projects the vertices of a line into the label plane the first time they
+ * are needed, a block at a time, and keeps them for the following labels on
+ * the same line. Labels repeated along a line, and the vertical variant that
+ * follows each horizontal label, share one copy of the line geometry.
+ */
+class ProjectedLine {
+public:
+    explicit ProjectedLine(const mat4& matrix_)
+        : matrix(matrix_) {}
+
+    void setLine(const GeometryCoordinates& line_) {
+        if (line == &line_ || (line && *line == line_)) {
+            line = &line_;
+            return;
+        }
+        line = &line_;
+        points.resize(line_.size());
+        distances.resize(line_.size());
+        projected.assign((line_.size() + blockSize - 1) / blockSize, false);
+    }
+
+    PointAndCameraDistance operator()(const std::size_t index) {
+        const std::size_t block = index / blockSize;
+        if (!projected[block]) {
+            projectBlock(block);
+        }
+        return {points[index], distances[index]};
+    }
+
+private:
+    static constexpr std::size_t blockSize = 16;
+
+    void projectBlock(const std::size_t block) {
+        const std::size_t begin = block * blockSize;
+        const std::size_t count = std::min(blockSize, line->size() - begin);
+        std::array<float, blockSize> xs;
+        std::array<float, blockSize> ys;
+        for (std::size_t i = 0; i < count; ++i) {
+            xs[i] = (*line)[begin + i].x;
+            ys[i] = (*line)[begin + i].y;
+        }
+        std::array<double, blockSize> x;
+        std::array<double, blockSize> y;
+        std::array<double, blockSize> w;
+        projectPoints(xs.data(), ys.data(), count, matrix, x.data(), y.data(), w.data());
+        for (std::size_t i = 0; i < count; ++i) {
+            points[begin + i] = {static_cast<float>(x[i] / w[i]), static_cast<float>(y[i] / w[i])};
+            distances[begin + i] = static_cast<float>(w[i]);
+        }
+        projected[block] = true;
+    }
+
+    const mat4& matrix;
+    const GeometryCoordinates* line = nullptr;
+    std::vector<Point<float>> points;
+    std::vector<float> distances;
+    std::vector<bool> projected;
+};
+
+void writeGlyph(DynamicVertex* vertices, const Point<float>& anchorPoint, const float angle) {
+    std::fill(vertices, vertices + 4, SymbolSDFIconProgram::dynamicLayoutVertex(anchorPoint, angle));
+}
+
 Point<float> projectTruncatedLineSegment(const Point<float>& previousTilePoint,
                                          const Point<float>& currentTilePoint,
                                          const Point<float>& previousProjectedPoint,
@@ -175,6 +271,8 @@ Point<float> projectTruncatedLineSegment(const Point<float>& previousTilePoint,
     return previousProjectedPoint + (projectedUnitSegment * (minimumLength / util::mag<float>(projectedUnitSegment)));
 }
 
+// `projectVertex(index)` returns the vertex of the line at the given index, projected with `labelPlaneMatrix`
+template <typename ProjectVertex>
 std::optional<PlacedGlyph> placeGlyphAlongLine(const float offsetX,
                                                const float lineOffsetX,
                                                const float lineOffsetY,
@@ -185,6 +283,7 @@ std::optional<PlacedGlyph> placeGlyphAlongLine(const float offsetX,
                                                const GeometryCoordinates& line,
                                                const std::vector<float>& tileDistances,
                                                const mat4& labelPlaneMatrix,
+                                               ProjectVertex& projectVertex,
                                                const bool returnTileDistance) {
     const float combinedOffsetX = flip ? offsetX - lineOffsetX : offsetX + lineOffsetX;
 
@@ -218,7 +317,7 @@ std::optional<PlacedGlyph> placeGlyphAlongLine(const float offsetX,
         }
 
         prev = current;
-        PointAndCameraDistance projection = project(convertPoint<float>(line.at(currentIndex)), labelPlaneMatrix);
+        PointAndCameraDistance projection = projectVertex(static_cast<std::size_t>(currentIndex));
         if (projection.second > 0) {
             current = projection.first;
         } else {
@@ -254,15 +353,17 @@ std::optional<PlacedGlyph> placeGlyphAlongLine(const float offsetX,
                  : std::optional<TileDistance>()}};
 }
 
-std::optional<std::pair<PlacedGlyph, PlacedGlyph>> placeFirstAndLastGlyph(const float fontScale,
-                                                                          const float lineOffsetX,
-                                                                          const float lineOffsetY,
-                                                                          const bool flip,
-                                                                          const Point<float>& anchorPoint,
-                                                                          const Point<float>& tileAnchorPoint,
-                                                                          const PlacedSymbol& symbol,
-                                                                          const mat4& labelPlaneMatrix,
-                                                                          const bool returnTileDistance) {
+template <typename ProjectVertex>
+std::optional<std::pair<PlacedGlyph, PlacedGlyph>> placeFirstAndLast(const float fontScale,
+                                                                     const float lineOffsetX,
+                                                                     const float lineOffsetY,
+                                                                     const bool flip,
+                                                                     const Point<float>& anchorPoint,
+                                                                     const Point<float>& tileAnchorPoint,
+                                                                     const PlacedSymbol& symbol,
+                                                                     const mat4& labelPlaneMatrix,
+                                                                     ProjectVertex& projectVertex,
+                                                                     const bool returnTileDistance) {
     if (symbol.glyphOffsets.empty()) {
         assert(false);
         return {};
@@ -270,7 +371,6 @@ std::optional<std::pair<PlacedGlyph, PlacedGlyph>> placeFirstAndLastGlyph(const
 
     const float firstGlyphOffset = symbol.glyphOffsets.front();
     const float lastGlyphOffset = symbol.glyphOffsets.back();
-    ;
 
     std::optional<PlacedGlyph> firstPlacedGlyph = placeGlyphAlongLine(fontScale * firstGlyphOffset,
                                                                       lineOffsetX,
@@ -282,6 +382,7 @@ std::optional<std::pair<PlacedGlyph, PlacedGlyph>> placeFirstAndLastGlyph(const
                                                                       symbol.line,
                                                                       symbol.tileDistances,
                                                                       labelPlaneMatrix,
+                                                                      projectVertex,
                                                                       returnTileDistance);
     if (!firstPlacedGlyph) return {};
 
@@ -295,6 +396,7 @@ std::optional<std::pair<PlacedGlyph, PlacedGlyph>> placeFirstAndLastGlyph(const
                                                                      symbol.line,
                                                                      symbol.tileDistances,
                                                                      labelPlaneMatrix,
+                                                                     projectVertex,
                                                                      returnTileDistance);
     if (!lastPlacedGlyph) return {};
 
@@ -325,6 +427,7 @@ std::optional<PlacementResult> requiresOrientationChange(const WritingModeType w
     return {};
 }
 
+// Writes the four vertices of each glyph of the symbol, unless the result is not OK
 PlacementResult placeGlyphsAlongLine(const PlacedSymbol& symbol,
                                      const float fontSize,
                                      const bool flip,
@@ -332,16 +435,16 @@ PlacementResult placeGlyphsAlongLine(const PlacedSymbol& symbol,
                                      const mat4& posMatrix,
                                      const mat4& labelPlaneMatrix,
                                      const mat4& glCoordMatrix,
-                                     gfx::VertexVector<gfx::Vertex<SymbolDynamicLayoutAttributes>>& dynamicVertexArray,
+                                     ProjectedLine& projectedLine,
+                                     DynamicVertex* vertices,
                                      const Point<float>& projectedAnchorPoint,
                                      const float aspectRatio) {
     const float fontScale = fontSize / util::ONE_EM;
     const float lineOffsetX = symbol.lineOffset[0] * fontScale;
     const float lineOffsetY = symbol.lineOffset[1] * fontScale;
 
-    std::vector<PlacedGlyph> placedGlyphs;
     if (symbol.glyphOffsets.size() > 1) {
-        const std::optional<std::pair<PlacedGlyph, PlacedGlyph>> firstAndLastGlyph = placeFirstAndLastGlyph(
+        const std::optional<std::pair<PlacedGlyph, PlacedGlyph>> firstAndLastGlyph = placeFirstAndLast(
             fontScale,
             lineOffsetX,
             lineOffsetY,
@@ -350,6 +453,7 @@ PlacementResult placeGlyphsAlongLine(const PlacedSymbol& symbol,
             symbol.anchorPoint,
             symbol,
             labelPlaneMatrix,
+            projectedLine,
             false);
         if (!firstAndLastGlyph) {
             return PlacementResult::NotEnoughRoom;
@@ -365,8 +469,9 @@ PlacementResult placeGlyphsAlongLine(const PlacedSymbol& symbol,
             }
         }
 
-        placedGlyphs.push_back(firstAndLastGlyph->first);
-        for (size_t glyphIndex = 1; glyphIndex < symbol.glyphOffsets.size() - 1; glyphIndex++) {
+        const std::size_t lastIndex = symbol.glyphOffsets.size() - 1;
+        writeGlyph(vertices, firstAndLastGlyph->first.point, firstAndLastGlyph->first.angle);
+        for (size_t glyphIndex = 1; glyphIndex < lastIndex; glyphIndex++) {
             const float glyphOffsetX = symbol.glyphOffsets[glyphIndex];
             // Since first and last glyph fit on the line, we're sure that the
             // rest of the glyphs can be placed
@@ -380,14 +485,15 @@ PlacementResult placeGlyphsAlongLine(const PlacedSymbol& symbol,
                                                    symbol.line,
                                                    symbol.tileDistances,
                                                    labelPlaneMatrix,
+                                                   projectedLine,
                                                    false);
             if (placedGlyph) {
-                placedGlyphs.push_back(*placedGlyph);
+                writeGlyph(vertices + glyphIndex * 4, placedGlyph->point, placedGlyph->angle);
             } else {
-                placedGlyphs.emplace_back(Point<float>{-INFINITY, -INFINITY}, 0.0f, std::nullopt);
+                writeGlyph(vertices + glyphIndex * 4, {-INFINITY, -INFINITY}, 0.0f);
             }
         }
-        placedGlyphs.push_back(firstAndLastGlyph->second);
+        writeGlyph(vertices + lastIndex * 4, firstAndLastGlyph->second.point, firstAndLastGlyph->second.angle);
     } else if (symbol.glyphOffsets.size() == 1) {
         // Only a single glyph to place
         // So, determine whether to flip based on projected angle of the line segment it's on
@@ -420,20 +526,143 @@ PlacementResult placeGlyphsAlongLine(const PlacedSymbol& symbol,
                                                                      symbol.line,
                                                                      symbol.tileDistances,
                                                                      labelPlaneMatrix,
+                                                                     projectedLine,
                                                                      false);
         if (!singleGlyph) return PlacementResult::NotEnoughRoom;
 
-        placedGlyphs.push_back(*singleGlyph);
+        writeGlyph(vertices, singleGlyph->point, singleGlyph->angle);
     }
 
-    // The number of placedGlyphs must equal the number of glyphOffsets, which
-    // must correspond to the number of glyph vertices There may be 0 glyphs
-    // here, if a label consists entirely of glyphs that have 0x0 dimensions
-    for (auto& placedGlyph : placedGlyphs) {
-        addDynamicAttributes(placedGlyph.point, placedGlyph.angle, dynamicVertexArray);
+    // There may be 0 glyphs here, if a label consists entirely of glyphs
+    // that have 0x0 dimensions
+    return PlacementResult::OK;
+}
+
+struct LineLabelProjection {
+    const std::vector<PlacedSymbol>& placedSymbols;
+    const std::vector<std::size_t>& vertexOffsets;
+    DynamicVertex* vertices;
+    const mat4& posMatrix;
+    const mat4& labelPlaneMatrix;
+    const mat4& glCoordMatrix;
+    const ZoomEvaluatedSize& partiallyEvaluatedSize;
+    const std::array<double, 2>& clippingBuffer;
+    const bool pitchWithMap;
+    const bool keepUpright;
+    const float cameraToCenterDistance;
+    const float aspectRatio;
+
+    // Places the symbols in [begin, end). The range must not start with a
+    // symbol whose placement depends on the one before it. The vertices of
+    // symbols which are not placed are left hidden.
+    void run(const std::size_t begin, const std::size_t end) const {
+        // Anchors are projected with both matrices up front, all at once
+        const std::size_t count = end - begin;
+        std::vector<float> tileX(count);
+        std::vector<float> tileY(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            tileX[i] = placedSymbols[begin + i].anchorPoint.x;
+            tileY[i] = placedSymbols[begin + i].anchorPoint.y;
+        }
+        std::vector<double> anchors(count * 6);
+        double* const posX = anchors.data();
+        double* const posY = posX + count;
+        double* const posW = posY + count;
+        double* const labelX = posW + count;
+        double* const labelY = labelX + count;
+        double* const labelW = labelY + count;
+        projectPoints(tileX.data(), tileY.data(), count, posMatrix, posX, posY, posW);
+        projectPoints(tileX.data(), tileY.data(), count, labelPlaneMatrix, labelX, labelY, labelW);
+
+        ProjectedLine projectedLine(labelPlaneMatrix);
+        bool useVertical = false;
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const PlacedSymbol& placedSymbol = placedSymbols[begin + i];
+            // Don't do calculations for vertical glyphs unless the previous symbol
+            // was horizontal and we determined that vertical glyphs were necessary.
+            // Also don't do calculations for symbols that are collided and fully
+            // faded out
+            if (placedSymbol.hidden || (placedSymbol.writingModes == WritingModeType::Vertical && !useVertical)) {
+                continue;
+            }
+            // Awkward... but we're counting on the paired "vertical" symbol coming
+            // immediately after its horizontal counterpart
+            useVertical = false;
+
+            // Don't bother calculating the correct point for invisible labels.
+            const vec4 anchorPos = {{posX[i], posY[i], 0, posW[i]}};
+            if (!isVisible(anchorPos, clippingBuffer)) {
+                continue;
+            }
+
+            const auto cameraToAnchorDistance = static_cast<float>(posW[i]);
+            const float perspectiveRatio = 0.5f + 0.5f * (cameraToAnchorDistance / cameraToCenterDistance);
+
+            const float fontSize = evaluateSizeForFeature(partiallyEvaluatedSize, placedSymbol);
+            const float pitchScaledFontSize = pitchWithMap ? fontSize * perspectiveRatio : fontSize / perspectiveRatio;
+
+            const Point<float> anchorPoint = {static_cast<float>(labelX[i] / labelW[i]),
+                                              static_cast<float>(labelY[i] / labelW[i])};
+
+            projectedLine.setLine(placedSymbol.line);
+            DynamicVertex* symbolVertices = vertices + vertexOffsets[begin + i];
+
+            PlacementResult placeUnflipped = placeGlyphsAlongLine(placedSymbol,
+                                                                  pitchScaledFontSize,
+                                                                  false /*unflipped*/,
+                                                                  keepUpright,
+                                                                  posMatrix,
+                                                                  labelPlaneMatrix,
+                                                                  glCoordMatrix,
+                                                                  projectedLine,
+                                                                  symbolVertices,
+                                                                  anchorPoint,
+                                                                  aspectRatio);
+
+            useVertical = placeUnflipped == PlacementResult::UseVertical;
+
+            if (placeUnflipped == PlacementResult::NeedsFlipping) {
+                placeGlyphsAlongLine(placedSymbol,
+                                     pitchScaledFontSize,
+                                     true /*flipped*/,
+                                     keepUpright,
+                                     posMatrix,
+                                     labelPlaneMatrix,
+                                     glCoordMatrix,
+                                     projectedLine,
+                                     symbolVertices,
+                                     anchorPoint,
+                                     aspectRatio);
+            }
+        }
     }
+};
 
-    return PlacementResult::OK;
+} // namespace
+
+std::optional<std::pair<PlacedGlyph, PlacedGlyph>> placeFirstAndLastGlyph(const float fontScale,
+                                                                          const float lineOffsetX,
+                                                                          const float lineOffsetY,
+                                                                          const bool flip,
+                                                                          const Point<float>& anchorPoint,
+                                                                          const Point<float>& tileAnchorPoint,
+                                                                          const PlacedSymbol& symbol,
+                                                                          const mat4& labelPlaneMatrix,
+                                                                          const bool returnTileDistance) {
+    auto projectVertex = [&](const std::size_t index) {
+        return project(convertPoint<float>(symbol.line[index]), labelPlaneMatrix);
+    };
+    return placeFirstAndLast(fontScale,
+                             lineOffsetX,
+                             lineOffsetY,
+                             flip,
+                             anchorPoint,
+                             tileAnchorPoint,
+                             symbol,
+                             labelPlaneMatrix,
+                             projectVertex,
+                             returnTileDistance);
 }
 
 void reprojectLineLabels(gfx::VertexVector<gfx::Vertex<SymbolDynamicLayoutAttributes>>& dynamicVertexArray,
@@ -456,67 +685,57 @@ void reprojectLineLabels(gfx::VertexVector<gfx::Vertex<SymbolDynamicLayoutAttrib
 
     const mat4 glCoordMatrix = getGlCoordMatrix(posMatrix, pitchWithMap, rotateWithMap, state, pixelsToTileUnits);
 
-    dynamicVertexArray.clear();
-
-    bool useVertical = false;
-
-    for (auto& placedSymbol : placedSymbols) {
-        // Don't do calculations for vertical glyphs unless the previous symbol
-        // was horizontal and we determined that vertical glyphs were necessary.
-        // Also don't do calculations for symbols that are collided and fully
-        // faded out
-        if (placedSymbol.hidden || (placedSymbol.writingModes == WritingModeType::Vertical && !useVertical)) {
-            hideGlyphs(placedSymbol.glyphOffsets.size(), dynamicVertexArray);
-            continue;
-        }
-        // Awkward... but we're counting on the paired "vertical" symbol coming
-        // immediately after its horizontal counterpart
-        useVertical = false;
+    // Each symbol owns four vertices per glyph, whether it is placed or not,
+    // so every symbol can be written independently of the others.
+    std::vector<std::size_t> vertexOffsets;
+    vertexOffsets.reserve(placedSymbols.size());
+    std::size_t vertexCount = 0;
+    for (const auto& placedSymbol : placedSymbols) {
+        vertexOffsets.push_back(vertexCount);
+        vertexCount += placedSymbol.glyphOffsets.size() * 4;
+    }
 
-        vec4 anchorPos = {{placedSymbol.anchorPoint.x, placedSymbol.anchorPoint.y, 0, 1}};
-        matrix::transformMat4(anchorPos, anchorPos, posMatrix);
+    dynamicVertexArray.clear();
+    if (vertexCount == 0) {
+        return;
+    }
+    dynamicVertexArray.extend(vertexCount,
+                              SymbolSDFIconProgram::dynamicLayoutVertex({-INFINITY, -INFINITY}, 0.0f));
+
+    const LineLabelProjection projection{placedSymbols,
+                                         vertexOffsets,
+                                         &dynamicVertexArray.at(0),
+                                         posMatrix,
+                                         labelPlaneMatrix,
+                                         glCoordMatrix,
+                                         partiallyEvaluatedSize,
+                                         clippingBuffer,
+                                         pitchWithMap,
+                                         keepUpright,
+                                         state.getCameraToCenterDistance(),
+                                         state.getSize().aspectRatio()};
+
+    if (placedSymbols.size() <= symbolsPerTask) {
+        projection.run(0, placedSymbols.size());
+        return;
+    }
 
-        // Don't bother calculating the correct point for invisible labels.
-        if (!isVisible(anchorPos, clippingBuffer)) {
-            hideGlyphs(placedSymbol.glyphOffsets.size(), dynamicVertexArray);
-            continue;
+    // A vertical symbol is only placed if the horizontal one before it asks
+    // for it, so ranges start at the next symbol that is placed on its own.
+    std::vector<std::size_t> rangeStarts{0};
+    for (std::size_t i = symbolsPerTask; i < placedSymbols.size(); i += symbolsPerTask) {
+        while (i < placedSymbols.size() &&
+               (placedSymbols[i].hidden || placedSymbols[i].writingModes == WritingModeType::Vertical)) {
+            ++i;
         }
-
-        const auto cameraToAnchorDistance = static_cast<float>(anchorPos[3]);
-        const float perspectiveRatio = 0.5f + 0.5f * (cameraToAnchorDistance / state.getCameraToCenterDistance());
-
-        const float fontSize = evaluateSizeForFeature(partiallyEvaluatedSize, placedSymbol);
-        const float pitchScaledFontSize = pitchWithMap ? fontSize * perspectiveRatio : fontSize / perspectiveRatio;
-
-        const Point<float> anchorPoint = project(placedSymbol.anchorPoint, labelPlaneMatrix).first;
-
-        PlacementResult placeUnflipped = placeGlyphsAlongLine(placedSymbol,
-                                                              pitchScaledFontSize,
-                                                              false /*unflipped*/,
-                                                              keepUpright,
-                                                              posMatrix,
-                                                              labelPlaneMatrix,
-                                                              glCoordMatrix,
-                                                              dynamicVertexArray,
-                                                              anchorPoint,
-                                                              state.getSize().aspectRatio());
-
-        useVertical = placeUnflipped == PlacementResult::UseVertical;
-
-        if (placeUnflipped == PlacementResult::NotEnoughRoom || useVertical ||
-            (placeUnflipped == PlacementResult::NeedsFlipping &&
-             placeGlyphsAlongLine(placedSymbol,
-                                  pitchScaledFontSize,
-                                  true /*flipped*/,
-                                  keepUpright,
-                                  posMatrix,
-                                  labelPlaneMatrix,
-                                  glCoordMatrix,
-                                  dynamicVertexArray,
-                                  anchorPoint,
-                                  state.getSize().aspectRatio()) == PlacementResult::NotEnoughRoom)) {
-            hideGlyphs(placedSymbol.glyphOffsets.size(), dynamicVertexArray);
+        if (i < placedSymbols.size()) {
+            rangeStarts.push_back(i);
         }
     }
+    rangeStarts.push_back(placedSymbols.size());
+
+    util::parallelFor(*Scheduler::GetBackground(), rangeStarts.size() - 1, [&](const std::size_t range) {
+        projection.run(rangeStarts[range], rangeStarts[range + 1]);
+    });
 }
 } // end namespace mbgl
@@ -48,6 +48,16 @@ mat4 getGlCoordMatrix(
 using PointAndCameraDistance = std::pair<Point<float>, float>;
 PointAndCameraDistance project(const Point<float>& point, const mat4& matrix);
 
+/// Transforms `count` points of the z = 0 plane with the matrix, writing their homogeneous x, y and w
+/// coordinates. This is `project` before the division, for whole arrays of points at a time.
+void projectPoints(const float* xs,
+                   const float* ys,
+                   std::size_t count,
+                   const mat4& matrix,
+                   double* outX,
+                   double* outY,
+                   double* outW);
+
 void reprojectLineLabels(gfx::VertexVector<gfx::Vertex<SymbolDynamicLayoutAttributes>>&,
                          const std::vector<PlacedSymbol>&,
                          const mat4& posMatrix,
@@ -462,6 +462,14 @@ MTL::VertexFormat mtlVertexTypeOf(gfx::AttributeDataType type) noexcept {
             return MTL::VertexFormatFloat3;
         case gfx::AttributeDataType::Float4:
             return MTL::VertexFormatFloat4;
+        case gfx::AttributeDataType::HalfFloat:
+            return MTL::VertexFormatHalf;
+        case gfx::AttributeDataType::HalfFloat2:
+            return MTL::VertexFormatHalf2;
+        case gfx::AttributeDataType::HalfFloat3:
+            return MTL::VertexFormatHalf3;
+        case gfx::AttributeDataType::HalfFloat4:
+            return MTL::VertexFormatHalf4;
         default:
             assert(!"Unsupported vertex attribute format");
             return MTL::VertexFormatInvalid;
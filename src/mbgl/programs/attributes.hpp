@@ -16,6 +16,8 @@ MBGL_DEFINE_ATTRIBUTE(int16_t, 4, pixeloffset);
 MBGL_DEFINE_ATTRIBUTE(int16_t, 2, label_pos);
 MBGL_DEFINE_ATTRIBUTE(int16_t, 2, anchor_pos);
 MBGL_DEFINE_ATTRIBUTE(uint16_t, 2, texture_pos);
+// TODO: the fill extrusion normal components would fit in 8 bits, but the shaders decode
+// them from the 2^14 scale of FillExtrusionProgram::layoutVertex.
 MBGL_DEFINE_ATTRIBUTE(int16_t, 4, normal_ed);
 MBGL_DEFINE_ATTRIBUTE(float, 1, fade_opacity);
 MBGL_DEFINE_ATTRIBUTE(uint16_t, 2, placed);
@@ -31,14 +33,31 @@ struct data {
 
 // Paint attributes
 
-MBGL_DEFINE_ATTRIBUTE(float, 2, color);
-MBGL_DEFINE_ATTRIBUTE(float, 2, fill_color);
-MBGL_DEFINE_ATTRIBUTE(float, 2, halo_color);
-MBGL_DEFINE_ATTRIBUTE(float, 2, stroke_color);
-MBGL_DEFINE_ATTRIBUTE(float, 2, outline_color);
-MBGL_DEFINE_ATTRIBUTE(float, 1, opacity);
-MBGL_DEFINE_ATTRIBUTE(float, 1, stroke_opacity);
-MBGL_DEFINE_ATTRIBUTE(float, 1, blur);
+// With MLN_COMPACT_PAINT_ATTRIBUTES, data-driven paint attributes that fit in 16 bits
+// are stored as such, and OpenGL converts them to floats when they are fetched:
+// - Colors are packed into two values holding two 8 bit channels each (see
+//   attributeValue(const Color&)), which 16 bit integers store exactly.
+// - Opacities and blurs are stored as half floats. Their 11 bit precision is finer
+//   than the 8 bit color channels opacities end up in, and than a pixel of blur.
+// The other float attributes keep full precision.
+// Single values are padded to the 4 byte vertex alignment, so the savings come from
+// colors and zoom-and-property expressions.
+#if MLN_COMPACT_PAINT_ATTRIBUTES
+using ColorAttributeElement = uint16_t;
+using HalfAttributeElement = gfx::HalfFloat;
+#else
+using ColorAttributeElement = float;
+using HalfAttributeElement = float;
+#endif
+
+MBGL_DEFINE_ATTRIBUTE(ColorAttributeElement, 2, color);
+MBGL_DEFINE_ATTRIBUTE(ColorAttributeElement, 2, fill_color);
+MBGL_DEFINE_ATTRIBUTE(ColorAttributeElement, 2, halo_color);
+MBGL_DEFINE_ATTRIBUTE(ColorAttributeElement, 2, stroke_color);
+MBGL_DEFINE_ATTRIBUTE(ColorAttributeElement, 2, outline_color);
+MBGL_DEFINE_ATTRIBUTE(HalfAttributeElement, 1, opacity);
+MBGL_DEFINE_ATTRIBUTE(HalfAttributeElement, 1, stroke_opacity);
+MBGL_DEFINE_ATTRIBUTE(HalfAttributeElement, 1, blur);
 MBGL_DEFINE_ATTRIBUTE(float, 1, radius);
 MBGL_DEFINE_ATTRIBUTE(float, 1, width);
 MBGL_DEFINE_ATTRIBUTE(float, 1, floorwidth);
@@ -47,7 +66,7 @@ MBGL_DEFINE_ATTRIBUTE(float, 1, base);
 MBGL_DEFINE_ATTRIBUTE(float, 1, gapwidth);
 MBGL_DEFINE_ATTRIBUTE(float, 1, stroke_width);
 MBGL_DEFINE_ATTRIBUTE(float, 1, halo_width);
-MBGL_DEFINE_ATTRIBUTE(float, 1, halo_blur);
+MBGL_DEFINE_ATTRIBUTE(HalfAttributeElement, 1, halo_blur);
 MBGL_DEFINE_ATTRIBUTE(float, 1, weight);
 MBGL_DEFINE_ATTRIBUTE(uint16_t, 4, pattern_to);
 MBGL_DEFINE_ATTRIBUTE(uint16_t, 4, pattern_from);
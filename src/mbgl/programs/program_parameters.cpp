@@ -34,6 +34,12 @@ ProgramParameters ProgramParameters::withDefaultSource(const ProgramSource& sour
     return params;
 }
 
+ProgramParameters ProgramParameters::withProgramCacheDir(const std::string& directory) const noexcept {
+    ProgramParameters params = *this;
+    params.programCacheDir = directory;
+    return params;
+}
+
 const std::string& ProgramParameters::getDefinesString() const {
     if (definesStr.empty() && !defines.empty()) {
         definesStr.assign(defines.size() * 32, '\0');
@@ -4,6 +4,7 @@
 
 #include <array>
 #include <cassert>
+#include <optional>
 #include <string>
 #include <unordered_map>
 
@@ -42,6 +43,12 @@ public:
     /// @return Mutated ProgramParameters
     ProgramParameters withDefaultSource(const ProgramSource& source) const noexcept;
 
+    /// @brief Store linked program binaries in the given directory and reuse them on later runs, where the
+    /// backend supports it
+    /// @param directory Existing, writable directory
+    /// @return Mutated ProgramParameters
+    ProgramParameters withProgramCacheDir(const std::string& directory) const noexcept;
+
     /// @brief Get a list of built-in shader preprocessor defines
     /// @return Shader source string
     /// @todo With the addition of future backends, defines should also be backend-aware
@@ -63,6 +70,7 @@ public:
 
     bool getOverdrawInspectorEnabled() const { return overdrawInspector; }
     std::uint64_t getDefinesHash() const { return definesHash; }
+    const std::optional<std::string>& getProgramCacheDir() const { return programCacheDir; }
 
 private:
     std::unordered_map<std::string, std::string> defines;
@@ -74,6 +82,8 @@ private:
     std::array<ProgramSource, static_cast<size_t>(gfx::Backend::Type::TYPE_MAX)> defaultSources;
     std::array<ProgramSource, static_cast<size_t>(gfx::Backend::Type::TYPE_MAX)> userSources;
 
+    std::optional<std::string> programCacheDir;
+
     bool overdrawInspector;
 };
 
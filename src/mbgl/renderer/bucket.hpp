@@ -44,6 +44,9 @@ public:
                             std::size_t,
                             const CanonicalTileID&){};
 
+    // Called once all features of a tile have been added.
+    virtual void finalize() {}
+
     virtual void update(const FeatureStates&, const GeometryTileLayer&, const std::string&, const ImagePositions&) {}
 
     // As long as this bucket has a Prepare render pass, this function is
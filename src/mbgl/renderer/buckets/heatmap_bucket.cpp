@@ -5,20 +5,75 @@
 #include <mbgl/renderer/layers/render_heatmap_layer.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/math.hpp>
+#include <mbgl/style/expression/dsl.hpp>
+
+#include <cmath>
 
 namespace mbgl {
 
 using namespace style;
 
+namespace {
+
+// The weight of the cells of a binned bucket, which is read from BinnedFeature.
+PossiblyEvaluatedPropertyValue<float> binnedWeight() {
+    static const PropertyExpression<float> weight(expression::dsl::number(expression::dsl::get("weight")));
+    return {weight};
+}
+
+class BinnedFeature : public GeometryTileFeature {
+public:
+    FeatureType getType() const override { return FeatureType::Point; }
+    std::optional<Value> getValue(const std::string&) const override { return {static_cast<double>(weight)}; }
+
+    float weight = 0.0f;
+};
+
+} // namespace
+
 HeatmapBucket::HeatmapBucket(const BucketParameters& parameters,
-                             const std::vector<Immutable<style::LayerProperties>>& layers)
-    : mode(parameters.mode) {
-    for (const auto& layer : layers) {
-        paintPropertyBinders.emplace(
-            std::piecewise_construct,
-            std::forward_as_tuple(layer->baseImpl->id),
-            std::forward_as_tuple(getEvaluated<HeatmapLayerProperties>(layer), parameters.tileID.overscaledZ));
+                             const std::vector<Immutable<style::LayerProperties>>& layers_,
+                             std::size_t binningThreshold_)
+    : mode(parameters.mode),
+      layers(layers_),
+      zoom(parameters.tileID.overscaledZ),
+      canonical(parameters.tileID.canonical),
+      binningThreshold(binningThreshold_) {
+    float radius = std::numeric_limits<float>::max();
+    bool binnable = true;
+    for (std::size_t i = 0; i < layers.size(); ++i) {
+        const auto& layer = layers[i];
+        const auto& evaluated = getEvaluated<HeatmapLayerProperties>(layer);
+        paintPropertyBinders.emplace(std::piecewise_construct,
+                                     std::forward_as_tuple(layer->baseImpl->id),
+                                     std::forward_as_tuple(evaluated, parameters.tileID.overscaledZ));
+
+        // The points in a cell need to share their radius, and the sum of their
+        // weights mustn't depend on the zoom level.
+        const bool zoomConstantWeight = evaluated.get<HeatmapWeight>().match(
+            [](float) { return true; },
+            [](const PropertyExpression<float>& function) { return function.isZoomConstant(); });
+        binnable = binnable && zoomConstantWeight && evaluated.get<HeatmapRadius>().isConstant();
+        // Cells are drawn at the centroid of their points weighted by the data-driven weight,
+        // which is only right for a single layer.
+        if (!evaluated.get<HeatmapWeight>().isConstant()) {
+            binnable = binnable && !centroidWeightLayer;
+            centroidWeightLayer = i;
+        }
+        radius = std::min(radius, evaluated.get<HeatmapRadius>().constantOr(HeatmapRadius::defaultValue()));
     }
+
+#if MLN_LEGACY_RENDERER
+    // The drawable renderer sets up the weight attribute from the evaluated properties of
+    // the layer alone, so it can't draw binned buckets.
+    if (binnable && !layers.empty() && binningThreshold < std::numeric_limits<std::size_t>::max()) {
+        // Tiles are displayed at up to twice their size, where the radius covers half as
+        // many tile units, so cells are an eighth of the radius at that scale to keep the
+        // error within the kernel small.
+        const double tileUnitsPerPixel = util::EXTENT / (util::tileSize_D * parameters.tileID.overscaleFactor());
+        cellSize = static_cast<int32_t>(radius * tileUnitsPerPixel / 16.0);
+    }
+#endif
 }
 
 HeatmapBucket::~HeatmapBucket() {
@@ -47,58 +102,174 @@ void HeatmapBucket::addFeature(const GeometryTileFeature& feature,
                                const ImagePositions&,
                                const PatternLayerMap&,
                                std::size_t featureIndex,
-                               const CanonicalTileID& canonical) {
-    constexpr const uint16_t vertexLength = 4;
-
-    for (auto& points : geometry) {
-        for (auto& point : points) {
-            auto x = point.x;
-            auto y = point.y;
+                               const CanonicalTileID& canonical_) {
+    if (cellSize > 0) {
+        // Constant weights are applied at render time, so the cells only count the points.
+        featureWeights.resize(layers.size());
+        for (std::size_t i = 0; i < layers.size(); ++i) {
+            const auto& weight = getEvaluated<HeatmapLayerProperties>(layers[i]).get<HeatmapWeight>();
+            featureWeights[i] = weight.isConstant()
+                                    ? 1.0f
+                                    : weight.evaluate(feature, zoom, canonical_, HeatmapWeight::defaultValue());
+        }
+    }
 
+    for (auto& points_ : geometry) {
+        for (auto& point : points_) {
             // Do not include points that are outside the tile boundaries.
-            if (x < 0 || x >= util::EXTENT || y < 0 || y >= util::EXTENT) {
+            if (point.x < 0 || point.x >= util::EXTENT || point.y < 0 || point.y >= util::EXTENT) {
                 continue;
             }
 
-            if (segments.empty() ||
-                segments.back().vertexLength + vertexLength > std::numeric_limits<uint16_t>::max()) {
-                // Move to a new segments because the old one can't hold the geometry.
-                segments.emplace_back(vertices.elements(), triangles.elements());
+            if (binned) {
+                binPoint(point, featureWeights.data());
+                continue;
             }
 
-            // this geometry will be of the Point type, and we'll derive
-            // two triangles from it.
-            //
-            // ┌─────────┐
-            // │ 4     3 │
-            // │         │
-            // │ 1     2 │
-            // └─────────┘
-            //
-            vertices.emplace_back(HeatmapProgram::vertex(point, -1, -1)); // 1
-            vertices.emplace_back(HeatmapProgram::vertex(point, 1, -1));  // 2
-            vertices.emplace_back(HeatmapProgram::vertex(point, 1, 1));   // 3
-            vertices.emplace_back(HeatmapProgram::vertex(point, -1, 1));  // 4
-
-            auto& segment = segments.back();
-            assert(segment.vertexLength <= std::numeric_limits<uint16_t>::max());
-            const auto index = static_cast<uint16_t>(segment.vertexLength);
-
-            // 1, 2, 3
-            // 1, 4, 3
-            triangles.emplace_back(index, index + 1, index + 2);
-            triangles.emplace_back(index, index + 3, index + 2);
-
-            segment.vertexLength += vertexLength;
-            segment.indexLength += 6;
+            addPoint(point);
+            if (cellSize > 0) {
+                points.push_back(point);
+                pointWeights.insert(pointWeights.end(), featureWeights.begin(), featureWeights.end());
+                if (points.size() > binningThreshold) {
+                    startBinning();
+                }
+            }
         }
     }
 
+    if (binned) {
+        return;
+    }
+
     for (auto& pair : paintPropertyBinders) {
-        pair.second.populateVertexVectors(feature, vertices.elements(), featureIndex, {}, {}, canonical);
+        pair.second.populateVertexVectors(feature, vertices.elements(), featureIndex, {}, {}, canonical_);
     }
 }
 
+void HeatmapBucket::addPoint(const Point<int16_t> point) {
+    constexpr const uint16_t vertexLength = 4;
+
+    if (segments.empty() || segments.back().vertexLength + vertexLength > std::numeric_limits<uint16_t>::max()) {
+        // Move to a new segments because the old one can't hold the geometry.
+        segments.emplace_back(vertices.elements(), triangles.elements());
+    }
+
+    // this geometry will be of the Point type, and we'll derive
+    // two triangles from it.
+    //
+    // ┌─────────┐
+    // │ 4     3 │
+    // │         │
+    // │ 1     2 │
+    // └─────────┘
+    //
+    vertices.emplace_back(HeatmapProgram::vertex(point, -1, -1)); // 1
+    vertices.emplace_back(HeatmapProgram::vertex(point, 1, -1));  // 2
+    vertices.emplace_back(HeatmapProgram::vertex(point, 1, 1));   // 3
+    vertices.emplace_back(HeatmapProgram::vertex(point, -1, 1));  // 4
+
+    auto& segment = segments.back();
+    assert(segment.vertexLength <= std::numeric_limits<uint16_t>::max());
+    const auto index = static_cast<uint16_t>(segment.vertexLength);
+
+    // 1, 2, 3
+    // 1, 4, 3
+    triangles.emplace_back(index, index + 1, index + 2);
+    triangles.emplace_back(index, index + 3, index + 2);
+
+    segment.vertexLength += vertexLength;
+    segment.indexLength += 6;
+}
+
+void HeatmapBucket::binPoint(const Point<int16_t> point, const float* weights) {
+    const uint32_t columns = (util::EXTENT + cellSize - 1) / cellSize;
+    const uint32_t key = (point.y / cellSize) * columns + point.x / cellSize;
+
+    const auto inserted = cellIndices.emplace(key, cells.size());
+    if (inserted.second) {
+        cells.emplace_back();
+        cellWeights.resize(cellWeights.size() + layers.size(), 0.0f);
+    }
+
+    const std::size_t index = inserted.first->second;
+    Cell& cell = cells[index];
+    const float weight = centroidWeightLayer ? weights[*centroidWeightLayer] : 1.0f;
+    cell.x += static_cast<double>(weight) * point.x;
+    cell.y += static_cast<double>(weight) * point.y;
+    cell.weight += weight;
+    cell.unweightedX += point.x;
+    cell.unweightedY += point.y;
+    cell.count++;
+    for (std::size_t i = 0; i < layers.size(); ++i) {
+        cellWeights[index * layers.size() + i] += weights[i];
+    }
+}
+
+void HeatmapBucket::startBinning() {
+    binned = true;
+    vertices.clear();
+    triangles.clear();
+    segments.clear();
+    paintPropertyBinders.clear();
+
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        binPoint(points[i], &pointWeights[i * layers.size()]);
+    }
+    points = {};
+    pointWeights = {};
+}
+
+void HeatmapBucket::finalize() {
+    points = {};
+    pointWeights = {};
+    featureWeights = {};
+
+    if (!binned) {
+        return;
+    }
+
+    for (const auto& layer : layers) {
+        auto evaluated = getEvaluated<HeatmapLayerProperties>(layer);
+        evaluated.get<HeatmapWeight>() = binnedWeight();
+        paintPropertyBinders.emplace(std::piecewise_construct,
+                                     std::forward_as_tuple(layer->baseImpl->id),
+                                     std::forward_as_tuple(evaluated, zoom));
+    }
+
+    // Each cell is drawn at the weighted centroid of its points, or at their centroid if
+    // their weights are all zero.
+    BinnedFeature feature;
+    for (std::size_t index = 0; index < cells.size(); ++index) {
+        const Cell& cell = cells[index];
+        if (cell.weight > 0) {
+            addPoint({static_cast<int16_t>(std::lround(cell.x / cell.weight)),
+                      static_cast<int16_t>(std::lround(cell.y / cell.weight))});
+        } else {
+            addPoint({static_cast<int16_t>(cell.unweightedX / cell.count),
+                      static_cast<int16_t>(cell.unweightedY / cell.count)});
+        }
+
+        for (std::size_t i = 0; i < layers.size(); ++i) {
+            feature.weight = cellWeights[index * layers.size() + i];
+            paintPropertyBinders.at(layers[i]->baseImpl->id)
+                .populateVertexVectors(feature, vertices.elements(), index, {}, {}, canonical);
+        }
+    }
+
+    cellIndices = {};
+    cells = {};
+    cellWeights = {};
+}
+
+HeatmapPaintProperties::PossiblyEvaluated HeatmapBucket::binnedProperties(
+    const HeatmapPaintProperties::PossiblyEvaluated& evaluated) const {
+    assert(binned);
+    auto result = evaluated;
+    result.get<HeatmapIntensity>() *= evaluated.get<HeatmapWeight>().constantOr(1.0f);
+    result.get<HeatmapWeight>() = binnedWeight();
+    return result;
+}
+
 float HeatmapBucket::getQueryRadius(const RenderLayer& layer) const {
     (void)layer;
     return 0;
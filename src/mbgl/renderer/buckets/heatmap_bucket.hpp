@@ -9,13 +9,23 @@
 #include <mbgl/programs/heatmap_program.hpp>
 #include <mbgl/style/layers/heatmap_layer_properties.hpp>
 
+#include <optional>
+#include <unordered_map>
+
 namespace mbgl {
 
 class BucketParameters;
 
 class HeatmapBucket final : public Bucket {
 public:
-    HeatmapBucket(const BucketParameters&, const std::vector<Immutable<style::LayerProperties>>&);
+    // Tiles with more points than this merge the points that are close to each
+    // other into the cells of a grid, which are drawn instead of the points. A
+    // threshold of std::numeric_limits<std::size_t>::max() disables binning.
+    static constexpr std::size_t defaultBinningThreshold = 16384;
+
+    HeatmapBucket(const BucketParameters&,
+                  const std::vector<Immutable<style::LayerProperties>>&,
+                  std::size_t binningThreshold = defaultBinningThreshold);
     ~HeatmapBucket() override;
 
     void addFeature(const GeometryTileFeature&,
@@ -24,12 +34,21 @@ public:
                     const PatternLayerMap&,
                     std::size_t,
                     const CanonicalTileID&) override;
+    void finalize() override;
     bool hasData() const override;
 
     void upload(gfx::UploadPass&) override;
 
     float getQueryRadius(const RenderLayer&) const override;
 
+    bool isBinned() const { return binned; }
+
+    // The cells of a binned bucket store the sum of the weights of their points
+    // as a vertex attribute. A constant weight isn't part of that sum, and is
+    // applied through the intensity instead.
+    style::HeatmapPaintProperties::PossiblyEvaluated binnedProperties(
+        const style::HeatmapPaintProperties::PossiblyEvaluated&) const;
+
     using VertexVector = gfx::VertexVector<HeatmapLayoutVertex>;
     const std::shared_ptr<VertexVector> sharedVertices = std::make_shared<VertexVector>();
     VertexVector& vertices = *sharedVertices;
@@ -48,6 +67,41 @@ public:
     std::map<std::string, HeatmapProgram::Binders> paintPropertyBinders;
 
     const MapMode mode;
+
+private:
+    struct Cell {
+        // Sums of the coordinates weighted by the data-driven weight, and of the weights.
+        double x = 0;
+        double y = 0;
+        double weight = 0;
+        int64_t unweightedX = 0;
+        int64_t unweightedY = 0;
+        uint32_t count = 0;
+    };
+
+    void addPoint(Point<int16_t>);
+    void binPoint(Point<int16_t>, const float* weights);
+    void startBinning();
+
+    const std::vector<Immutable<style::LayerProperties>> layers;
+    const float zoom;
+    const CanonicalTileID canonical;
+    const std::size_t binningThreshold;
+
+    // The side of a grid cell in tile units, or 0 if the points of this bucket can't be binned.
+    int32_t cellSize = 0;
+    bool binned = false;
+    // The layer whose data-driven weight the centroids of the cells are weighted by.
+    std::optional<std::size_t> centroidWeightLayer;
+
+    // The points added before binning starts, with the weight of each point for every layer.
+    std::vector<Point<int16_t>> points;
+    std::vector<float> pointWeights;
+    std::vector<float> featureWeights;
+
+    std::unordered_map<uint32_t, std::size_t> cellIndices;
+    std::vector<Cell> cells;
+    std::vector<float> cellWeights;
 };
 
 } // namespace mbgl
@@ -1,3 +1,4 @@
+#include <mbgl/math/clamp.hpp>
 #include <mbgl/renderer/bucket_parameters.hpp>
 #include <mbgl/renderer/buckets/symbol_bucket.hpp>
 #include <mbgl/renderer/layers/render_symbol_layer.hpp>
@@ -6,7 +7,9 @@
 #include <mbgl/text/cross_tile_symbol_index.hpp>
 #include <mbgl/text/glyph_atlas.hpp>
 #include <mbgl/text/placement.hpp>
+#include <mbgl/util/constants.hpp>
 
+#include <cmath>
 #include <utility>
 
 namespace mbgl {
@@ -58,10 +61,34 @@ SymbolBucket::SymbolBucket(Immutable<style::SymbolLayoutProperties::PossiblyEval
             std::forward_as_tuple(PaintProperties{{RenderSymbolLayer::iconPaintProperties(evaluated), zoom},
                                                   {RenderSymbolLayer::textPaintProperties(evaluated), zoom}}));
     }
+
+    for (const SymbolInstance& symbolInstance : symbolInstances) {
+        CollisionBounds& bounds = collisionRegions[getCollisionRegion(symbolInstance)];
+        bounds.add(symbolInstance.anchor.point);
+        bounds.add(symbolInstance.textCollisionFeature);
+        bounds.add(symbolInstance.iconCollisionFeature);
+        if (symbolInstance.verticalTextCollisionFeature) {
+            bounds.add(*symbolInstance.verticalTextCollisionFeature);
+        }
+        if (symbolInstance.verticalIconCollisionFeature) {
+            bounds.add(*symbolInstance.verticalIconCollisionFeature);
+        }
+    }
+    for (const CollisionBounds& bounds : collisionRegions) {
+        collisionBounds.add(bounds);
+    }
 }
 
 SymbolBucket::~SymbolBucket() = default;
 
+std::size_t SymbolBucket::getCollisionRegion(const SymbolInstance& symbolInstance) {
+    const auto cell = [](const float coordinate) {
+        const auto index = static_cast<int>(std::floor(coordinate * collisionRegionsPerSide / util::EXTENT));
+        return static_cast<std::size_t>(util::clamp(index, 0, static_cast<int>(collisionRegionsPerSide) - 1));
+    };
+    return cell(symbolInstance.anchor.point.y) * collisionRegionsPerSide + cell(symbolInstance.anchor.point.x);
+}
+
 void SymbolBucket::upload([[maybe_unused]] gfx::UploadPass& uploadPass) {
 #if MLN_LEGACY_RENDERER
     if (hasTextData()) {
@@ -13,6 +13,7 @@
 #include <mbgl/text/glyph_range.hpp>
 #include <mbgl/text/placement.hpp>
 
+#include <array>
 #include <memory>
 #include <vector>
 
@@ -30,7 +31,7 @@ public:
                  WritingModeType writingModes_,
                  GeometryCoordinates line_,
                  std::vector<float> tileDistances_,
-                 std::optional<size_t> placedIconIndex_ = std::nullopt)
+                 std::optional<uint32_t> placedIconIndex_ = std::nullopt)
         : anchorPoint(anchorPoint_),
           segment(segment_),
           lowerSize(lowerSize_),
@@ -61,7 +62,7 @@ public:
     float angle = 0;
 
     // Reference to placed icon, only applicable for text symbols.
-    std::optional<size_t> placedIconIndex;
+    std::optional<uint32_t> placedIconIndex;
 };
 
 class SymbolBucket final : public Bucket {
@@ -125,6 +126,13 @@ public:
     std::vector<SymbolInstance> symbolInstances;
     const std::vector<SortKeyRange> sortKeyRanges;
 
+    // Bounds of the collision boxes of the symbols anchored in each cell of a grid
+    // over the tile, and of all symbols, for skipping symbols which are out of view.
+    static constexpr std::size_t collisionRegionsPerSide = 4;
+    static std::size_t getCollisionRegion(const SymbolInstance&);
+    std::array<CollisionBounds, collisionRegionsPerSide * collisionRegionsPerSide> collisionRegions;
+    CollisionBounds collisionBounds;
+
     struct PaintProperties {
         SymbolIconProgram::Binders iconBinders;
         SymbolSDFTextProgram::Binders textBinders;
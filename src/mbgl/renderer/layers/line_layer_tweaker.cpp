@@ -183,19 +183,22 @@ void LineLayerTweaker::execute(LayerGroupBase& layerGroup, const PaintParameters
                         evaluated.get<LineDasharray>().to,
                         lineData.linePatternCap);
 
+                    const LinePatternPos& posA = dashPatternTexture.getFrom();
+                    const LinePatternPos& posB = dashPatternTexture.getTo();
+                    // Patterns that didn't fit into the atlas have no rows to draw from.
+                    bool enabled = posA.height > 0 && posB.height > 0;
+
                     // texture
                     if (const auto index = shader->getSamplerLocation(idTexImageName)) {
                         if (!drawable.getTexture(index.value())) {
-                            const auto& texture = dashPatternTexture.getTexture();
-                            drawable.setEnabled(!!texture);
-                            if (texture) {
+                            if (const auto& texture = dashPatternTexture.getTexture()) {
                                 drawable.setTexture(texture, index.value());
                             }
                         }
+                        enabled = enabled && drawable.getTexture(index.value());
                     }
-
-                    const LinePatternPos& posA = dashPatternTexture.getFrom();
-                    const LinePatternPos& posB = dashPatternTexture.getTo();
+                    drawable.setEnabled(enabled);
+                    if (!enabled) break;
                     const float widthA = posA.width * crossfade.fromScale;
                     const float widthB = posB.width * crossfade.toScale;
                     const LineSDFUBO lineSDFUBO{
@@ -120,7 +120,8 @@ void RenderHeatmapLayer::render(PaintParameters& parameters) {
                 continue;
             }
             auto& bucket = static_cast<HeatmapBucket&>(*renderData->bucket);
-            const auto& evaluated = getEvaluated<HeatmapLayerProperties>(renderData->layerProperties);
+            const auto& layerEvaluated = getEvaluated<HeatmapLayerProperties>(renderData->layerProperties);
+            const auto evaluated = bucket.isBinned() ? bucket.binnedProperties(layerEvaluated) : layerEvaluated;
 
             const auto extrudeScale = tile.id.pixelsToTileUnits(1.0f, static_cast<float>(parameters.state.getZoom()));
 
@@ -182,6 +182,8 @@ void RenderLineLayer::render(PaintParameters& parameters) {
                                                                                           : LinePatternCap::Square;
             const auto& dashPatternTexture = parameters.lineAtlas.getDashPatternTexture(
                 evaluated.get<LineDasharray>().from, evaluated.get<LineDasharray>().to, cap);
+            // Patterns that didn't fit into the atlas have no rows to draw from.
+            if (dashPatternTexture.getFrom().height == 0 || dashPatternTexture.getTo().height == 0) continue;
 
             draw(*lineSDFProgram,
                  LineSDFProgram::layoutUniformValues(evaluated,
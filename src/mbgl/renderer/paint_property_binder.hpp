@@ -61,15 +61,27 @@ inline uint16_t packUint8Pair(T a, T b) {
 
     Also note that colors come in as floats 0..1, so we scale by 255.
 */
-inline std::array<float, 2> attributeValue(const Color& color) {
-    return {{static_cast<float>(packUint8Pair(255 * color.r, 255 * color.g)),
-             static_cast<float>(packUint8Pair(255 * color.b, 255 * color.a))}};
+inline std::array<attributes::ColorAttributeElement, 2> attributeValue(const Color& color) {
+    return {{static_cast<attributes::ColorAttributeElement>(packUint8Pair(255 * color.r, 255 * color.g)),
+             static_cast<attributes::ColorAttributeElement>(packUint8Pair(255 * color.b, 255 * color.a))}};
 }
 
-template <size_t N>
-std::array<float, N * 2> zoomInterpolatedAttributeValue(const std::array<float, N>& min,
-                                                        const std::array<float, N>& max) {
-    std::array<float, N * 2> result;
+/*
+    Convert an attribute value to the element type the attribute is stored as, which
+    differs from float for the compact paint attributes (see attributes.hpp).
+*/
+template <class AttributeType, typename T, size_t N>
+std::array<typename AttributeType::ElementType, N> attributeValueAs(const std::array<T, N>& value) {
+    std::array<typename AttributeType::ElementType, N> result;
+    for (size_t i = 0; i < N; i++) {
+        result[i] = static_cast<typename AttributeType::ElementType>(value[i]);
+    }
+    return result;
+}
+
+template <typename T, size_t N>
+std::array<T, N * 2> zoomInterpolatedAttributeValue(const std::array<T, N>& min, const std::array<T, N>& max) {
+    std::array<T, N * 2> result;
     for (size_t i = 0; i < N; i++) {
         result[i] = min[i];
         result[i + N] = max[i];
@@ -143,6 +155,12 @@ public:
 
     virtual gfx::VertexVectorBasePtr getSharedVertexVector() const = 0;
 
+    /// Size of the vertex data held for the property
+    virtual std::size_t getVertexBytes() const {
+        const auto& vector = getSharedVertexVector();
+        return vector ? vector->getRawSize() * vector->getRawCount() : 0;
+    }
+
     static std::unique_ptr<PaintPropertyBinder> create(const PossiblyEvaluatedType& value, float zoom, T defaultValue);
 
     PaintPropertyStatistics<T> statistics;
@@ -285,7 +303,7 @@ public:
             EvaluationContext(&feature).withFormattedSection(&formattedSection).withCanonicalTileID(&canonical),
             defaultValue);
         this->statistics.add(evaluated);
-        auto value = attributeValue(evaluated);
+        auto value = attributeValueAs<BaseAttributeType>(attributeValue(evaluated));
         auto elements = vertexVector.elements();
         for (std::size_t i = elements; i < length; ++i) {
             vertexVector.emplace_back(BaseVertex{value});
@@ -322,7 +340,7 @@ public:
 
         auto evaluated = expression.evaluate(EvaluationContext(&feature).withFeatureState(&state), defaultValue);
         this->statistics.add(evaluated);
-        auto value = attributeValue(evaluated);
+        auto value = attributeValueAs<BaseAttributeType>(attributeValue(evaluated));
         for (std::size_t i = start; i < end; ++i) {
             vertexVector.at(i) = BaseVertex{value};
         }
@@ -412,8 +430,8 @@ public:
         };
         this->statistics.add(range.min);
         this->statistics.add(range.max);
-        const AttributeValue value = zoomInterpolatedAttributeValue(attributeValue(range.min),
-                                                                    attributeValue(range.max));
+        const AttributeValue value = zoomInterpolatedAttributeValue(attributeValueAs<A>(attributeValue(range.min)),
+                                                                    attributeValueAs<A>(attributeValue(range.max)));
         const auto elements = vertexVector.elements();
         for (std::size_t i = elements; i < length; ++i) {
             vertexVector.emplace_back(Vertex{value});
@@ -452,7 +470,8 @@ public:
         };
         this->statistics.add(range.min);
         this->statistics.add(range.max);
-        AttributeValue value = zoomInterpolatedAttributeValue(attributeValue(range.min), attributeValue(range.max));
+        AttributeValue value = zoomInterpolatedAttributeValue(attributeValueAs<A>(attributeValue(range.min)),
+                                                              attributeValueAs<A>(attributeValue(range.max)));
 
         for (std::size_t i = start; i < end; ++i) {
             vertexVector.at(i) = Vertex{value};
@@ -627,6 +646,10 @@ public:
 
     gfx::VertexVectorBasePtr getSharedVertexVector() const override { return sharedPatternToVertexVector; }
 
+    std::size_t getVertexBytes() const override {
+        return patternToVertexVector.bytes() + zoomInVertexVector.bytes() + zoomOutVertexVector.bytes();
+    }
+
 private:
     style::PropertyExpression<T> expression;
     T defaultValue;
@@ -809,6 +832,12 @@ public:
         return binders.template get<P>()->statistics;
     }
 
+    std::size_t vertexBytes() const {
+        std::size_t bytes = 0;
+        util::ignore({(bytes += binders.template get<Ps>()->getVertexBytes(), 0)...});
+        return bytes;
+    }
+
 private:
     Binders binders;
 };
@@ -0,0 +1,101 @@
+#include <mbgl/renderer/query_snapshot.hpp>
+
+#include <mbgl/layermanager/layer_manager.hpp>
+#include <mbgl/renderer/render_layer.hpp>
+#include <mbgl/renderer/source_state.hpp>
+#include <mbgl/util/parallel.hpp>
+
+#include <iterator>
+
+namespace mbgl {
+
+namespace {
+
+using ResultsByLayer = std::unordered_map<std::string, std::vector<Feature>>;
+
+void appendResults(ResultsByLayer& target, ResultsByLayer&& source) {
+    for (auto& entry : source) {
+        auto& features = target[entry.first];
+        std::move(entry.second.begin(), entry.second.end(), std::back_inserter(features));
+    }
+}
+
+} // namespace
+
+RenderedQuerySnapshot::RenderedQuerySnapshot(const TransformState& transformState_, RenderedQueryOptions options_)
+    : transformState(transformState_),
+      options(std::move(options_)) {}
+
+RenderedQuerySnapshot::~RenderedQuerySnapshot() = default;
+
+void RenderedQuerySnapshot::addLayer(const RenderLayer& layer) {
+    layerOrder.push_back(layer.getID());
+
+    // Layers without a source never hit a feature index, their results (if any)
+    // are resolved on the render thread and passed through `addResults()`.
+    if (layer.baseImpl->getTypeInfo()->source != style::LayerTypeInfo::Source::Required) {
+        return;
+    }
+
+    auto copy = LayerManager::get()->createRenderLayer(layer.baseImpl);
+    if (!copy) {
+        return;
+    }
+    copy->evaluatedProperties = layer.evaluatedProperties;
+    layers.emplace(layer.getID(), copy.get());
+    ownedLayers.push_back(std::move(copy));
+}
+
+void RenderedQuerySnapshot::addResults(ResultsByLayer&& results) {
+    appendResults(resolvedResults, std::move(results));
+}
+
+std::vector<Feature> RenderedQuerySnapshot::query(Scheduler& scheduler) const {
+    // Each tile and symbol bucket writes to its own result map, so the merged
+    // result keeps the same order as a query run on the render thread.
+    std::vector<ResultsByLayer> tileResults(tileQueries.size());
+    util::parallelFor(scheduler, tileQueries.size(), [&](const std::size_t i) {
+        const TileQuery& tileQuery = tileQueries[i];
+        tileQuery.featureIndex->query(tileResults[i],
+                                      tileQuery.queryGeometry,
+                                      transformState,
+                                      tileQuery.posMatrix,
+                                      tileQuery.tileSize,
+                                      tileQuery.scale,
+                                      options,
+                                      tileQuery.tileID,
+                                      layers,
+                                      tileQuery.additionalQueryPadding,
+                                      *tileQuery.featureState);
+    });
+
+    std::vector<ResultsByLayer> symbolResults(symbolQueries.size());
+    util::parallelFor(scheduler, symbolQueries.size(), [&](const std::size_t i) {
+        const SymbolQuery& symbolQuery = symbolQueries[i];
+        symbolResults[i] = symbolQuery.featureIndex->lookupSymbolFeatures(
+            symbolQuery.symbols, options, layers, symbolQuery.tileID, symbolQuery.featureSortOrder);
+    });
+
+    ResultsByLayer resultsByLayer;
+    for (auto& results : tileResults) {
+        appendResults(resultsByLayer, std::move(results));
+    }
+    for (auto& results : symbolResults) {
+        appendResults(resultsByLayer, std::move(results));
+    }
+    for (const auto& entry : resolvedResults) {
+        auto& features = resultsByLayer[entry.first];
+        features.insert(features.end(), entry.second.begin(), entry.second.end());
+    }
+
+    std::vector<Feature> result;
+    for (const auto& layerID : layerOrder) {
+        auto it = resultsByLayer.find(layerID);
+        if (it != resultsByLayer.end()) {
+            std::move(it->second.begin(), it->second.end(), std::back_inserter(result));
+        }
+    }
+    return result;
+}
+
+} // namespace mbgl
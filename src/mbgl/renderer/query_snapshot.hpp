@@ -0,0 +1,90 @@
+#pragma once
+
+#include <mbgl/geometry/feature_index.hpp>
+#include <mbgl/map/transform_state.hpp>
+#include <mbgl/renderer/query.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/feature.hpp>
+#include <mbgl/util/mat4.hpp>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mbgl {
+
+class RenderLayer;
+class Scheduler;
+class SourceFeatureState;
+
+/**
+ * @brief A copy of the render state read by a rendered features query.
+ *
+ * The snapshot is taken on the render thread. It holds only immutable data
+ * (feature indexes, evaluated layer properties, feature state copies), so the
+ * query itself can run on any thread while the renderer moves on.
+ */
+class RenderedQuerySnapshot {
+public:
+    /// Inputs for querying the feature index of one rendered tile.
+    class TileQuery {
+    public:
+        std::shared_ptr<const FeatureIndex> featureIndex;
+        UnwrappedTileID tileID;
+        GeometryCoordinates queryGeometry;
+        mat4 posMatrix;
+        double tileSize;
+        double scale;
+        float additionalQueryPadding;
+        std::shared_ptr<const SourceFeatureState> featureState;
+    };
+
+    /// Symbol hits of one bucket, taken from the collision index at snapshot time.
+    class SymbolQuery {
+    public:
+        std::shared_ptr<const FeatureIndex> featureIndex;
+        OverscaledTileID tileID;
+        FeatureSortOrder featureSortOrder;
+        std::vector<IndexedSubfeature> symbols;
+    };
+
+    RenderedQuerySnapshot(const TransformState&, RenderedQueryOptions);
+    ~RenderedQuerySnapshot();
+
+    RenderedQuerySnapshot(const RenderedQuerySnapshot&) = delete;
+    RenderedQuerySnapshot& operator=(const RenderedQuerySnapshot&) = delete;
+
+    /// Adds a layer to the query. Results are returned in the order the layers were added.
+    void addLayer(const RenderLayer&);
+    const std::unordered_map<std::string, const RenderLayer*>& getLayers() const { return layers; }
+
+    void addTileQuery(TileQuery tileQuery) { tileQueries.push_back(std::move(tileQuery)); }
+    void addSymbolQuery(SymbolQuery symbolQuery) { symbolQueries.push_back(std::move(symbolQuery)); }
+
+    /// Adds results that were already resolved while taking the snapshot.
+    void addResults(std::unordered_map<std::string, std::vector<Feature>>&&);
+
+    std::size_t tileQueryCount() const { return tileQueries.size(); }
+
+    /// Runs the query. Per-tile work is spread over the given scheduler; the
+    /// call returns once every tile has been queried.
+    std::vector<Feature> query(Scheduler&) const;
+
+private:
+    const TransformState transformState;
+    const RenderedQueryOptions options;
+
+    std::vector<std::string> layerOrder;
+    // Layers that carry source data are copied, so their evaluated properties
+    // stay valid for the lifetime of the snapshot.
+    std::vector<std::unique_ptr<RenderLayer>> ownedLayers;
+    std::unordered_map<std::string, const RenderLayer*> layers;
+
+    std::vector<TileQuery> tileQueries;
+    std::vector<SymbolQuery> symbolQueries;
+    std::unordered_map<std::string, std::vector<Feature>> resolvedResults;
+};
+
+} // namespace mbgl
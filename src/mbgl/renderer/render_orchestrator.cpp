@@ -20,6 +20,7 @@
 #include <mbgl/renderer/render_tile.hpp>
 #include <mbgl/renderer/style_diff.hpp>
 #include <mbgl/renderer/query.hpp>
+#include <mbgl/renderer/query_snapshot.hpp>
 #include <mbgl/renderer/image_manager.hpp>
 #include <mbgl/geometry/line_atlas.hpp>
 #include <mbgl/style/source_impl.hpp>
@@ -63,53 +64,84 @@ RendererObserver& nullObserver() {
     return observer;
 }
 
+// Although symbol query is global, symbol results are only sortable within
+// a bucket For a predictable global sort renderItems, we sort the buckets
+// based on their corresponding tile position
+std::vector<std::reference_wrapper<const RetainedQueryData>> getSortedQueryData(
+    const Placement& placement, const std::unordered_map<uint32_t, std::vector<IndexedSubfeature>>& renderedSymbols) {
+    std::vector<std::reference_wrapper<const RetainedQueryData>> bucketQueryData;
+    bucketQueryData.reserve(renderedSymbols.size());
+    for (const auto& entry : renderedSymbols) {
+        bucketQueryData.emplace_back(placement.getQueryData(entry.first));
+    }
+    std::sort(
+        bucketQueryData.begin(), bucketQueryData.end(), [](const RetainedQueryData& a, const RetainedQueryData& b) {
+            return std::tie(a.tileID.canonical.z, a.tileID.canonical.y, a.tileID.wrap, a.tileID.canonical.x) <
+                   std::tie(b.tileID.canonical.z, b.tileID.canonical.y, b.tileID.wrap, b.tileID.canonical.x);
+        });
+    return bucketQueryData;
+}
+
+} // namespace
+
+/// The render tree of the orchestrator. A single tree is kept and refilled on
+/// each frame, so that its containers keep their storage from frame to frame.
 class RenderTreeImpl final : public RenderTree {
 public:
-    RenderTreeImpl(std::unique_ptr<RenderTreeParameters> parameters_,
-                   std::set<LayerRenderItem> layerRenderItems_,
-                   std::vector<std::unique_ptr<RenderItem>> sourceRenderItems_,
-                   LineAtlas& lineAtlas_,
-                   PatternAtlas& patternAtlas_,
-                   RenderLayerReferences layersNeedPlacement_,
-                   Immutable<Placement> placement_,
-                   bool updateSymbolOpacities_,
-                   double startTime_)
-        : RenderTree(std::move(parameters_), startTime_),
-          layerRenderItems(std::move(layerRenderItems_)),
-          sourceRenderItems(std::move(sourceRenderItems_)),
-          lineAtlas(lineAtlas_),
-          patternAtlas(patternAtlas_),
-          layersNeedPlacement(std::move(layersNeedPlacement_)),
-          placement(std::move(placement_)),
-          updateSymbolOpacities(updateSymbolOpacities_) {}
+    /// Drops the items of the previous frame and starts a new one
+    RenderTreeParameters& start(const UpdateParameters& updateParameters,
+                                const EvaluatedLight& light,
+                                const double startTime_) {
+        layerItems.clear();
+        sourceItems.clear();
+        layerRenderItems.clear();
+        layersNeedPlacement.clear();
+        placement.reset();
+        startTime = startTime_;
+        return parameters.emplace(updateParameters.transformState,
+                                  updateParameters.mode,
+                                  updateParameters.debugOptions,
+                                  updateParameters.timePoint,
+                                  light);
+    }
+
+    /// Completes the tree once its layer and source items are in place
+    void finish(LineAtlas& lineAtlas_,
+                PatternAtlas& patternAtlas_,
+                Immutable<Placement> placement_,
+                const bool updateSymbolOpacities_) {
+        lineAtlas = &lineAtlas_;
+        patternAtlas = &patternAtlas_;
+        placement = std::move(placement_);
+        updateSymbolOpacities = updateSymbolOpacities_;
+        layerItems.assign(layerRenderItems.begin(), layerRenderItems.end());
+    }
 
     void prepare() override {
+        assert(placement);
         for (auto it = layersNeedPlacement.rbegin(); it != layersNeedPlacement.rend(); ++it) {
-            placement->updateLayerBuckets(*it, parameters->transformParams.state, updateSymbolOpacities);
+            (*placement)->updateLayerBuckets(*it, parameters->transformParams.state, updateSymbolOpacities);
         }
     }
 
-    const std::set<LayerRenderItem>& getLayerRenderItemMap() const noexcept override { return layerRenderItems; }
-    RenderItems getLayerRenderItems() const override { return {layerRenderItems.begin(), layerRenderItems.end()}; }
-    RenderItems getSourceRenderItems() const override {
-        RenderItems result;
-        result.reserve(sourceRenderItems.size());
-        for (const auto& item : sourceRenderItems) result.emplace_back(*item);
-        return result;
-    }
-    LineAtlas& getLineAtlas() const override { return lineAtlas; }
-    PatternAtlas& getPatternAtlas() const override { return patternAtlas; }
+    const std::vector<LayerRenderItem>& getLayerRenderItemMap() const noexcept override { return layerRenderItems; }
+    const RenderItems& getLayerRenderItems() const noexcept override { return layerItems; }
+    const RenderItems& getSourceRenderItems() const noexcept override { return sourceItems; }
+    LineAtlas& getLineAtlas() const override { return *lineAtlas; }
+    PatternAtlas& getPatternAtlas() const override { return *patternAtlas; }
 
-    std::set<LayerRenderItem> layerRenderItems;
-    std::vector<std::unique_ptr<RenderItem>> sourceRenderItems;
-    std::reference_wrapper<LineAtlas> lineAtlas;
-    std::reference_wrapper<PatternAtlas> patternAtlas;
+    std::vector<LayerRenderItem> layerRenderItems;
+    /// Render items of the enabled sources, which own them
+    RenderItems sourceItems;
     RenderLayerReferences layersNeedPlacement;
-    Immutable<Placement> placement;
-    bool updateSymbolOpacities;
-};
 
-} // namespace
+private:
+    RenderItems layerItems;
+    LineAtlas* lineAtlas = nullptr;
+    PatternAtlas* patternAtlas = nullptr;
+    std::optional<Immutable<Placement>> placement;
+    bool updateSymbolOpacities = false;
+};
 
 RenderOrchestrator::RenderOrchestrator(bool backgroundLayerAsColor_, const std::optional<std::string>& localFontFamily_)
     : observer(&nullObserver()),
@@ -143,8 +175,7 @@ void RenderOrchestrator::setObserver(RendererObserver* observer_) {
     observer = observer_ ? observer_ : &nullObserver();
 }
 
-std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
-    const std::shared_ptr<UpdateParameters>& updateParameters) {
+RenderTree* RenderOrchestrator::createRenderTree(const std::shared_ptr<UpdateParameters>& updateParameters) {
     const auto startTime = util::MonotonicTimer::now().count();
 
     const bool isMapModeContinuous = updateParameters->mode == MapMode::Continuous;
@@ -182,7 +213,8 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
                                         updateParameters->annotationManager,
                                         *imageManager,
                                         *glyphManager,
-                                        updateParameters->prefetchZoomDelta};
+                                        updateParameters->prefetchZoomDelta,
+                                        &tileCoverCache};
 
     glyphManager->setURL(updateParameters->glyphURL);
 
@@ -318,26 +350,21 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
     transformState = updateParameters->transformState;
     const bool tiltedView = transformState.getPitch() != 0.0f;
 
-    // Create parameters for the render tree.
-    auto renderTreeParameters = std::make_unique<RenderTreeParameters>(updateParameters->transformState,
-                                                                       updateParameters->mode,
-                                                                       updateParameters->debugOptions,
-                                                                       updateParameters->timePoint,
-                                                                       renderLight.getEvaluated());
-
-    std::set<LayerRenderItem> layerRenderItems;
-    layersNeedPlacement.clear();
-    auto renderItemsEmplaceHint = layerRenderItems.begin();
+    // Start the render tree of this frame and its parameters.
+    if (!renderTree) {
+        renderTree = std::make_unique<RenderTreeImpl>();
+    }
+    auto& renderTreeParameters = renderTree->start(*updateParameters, renderLight.getEvaluated(), startTime);
+    auto& layerRenderItems = renderTree->layerRenderItems;
+    auto& layersNeedPlacement = renderTree->layersNeedPlacement;
 
     // Reserve size for filteredLayersForSource if there are sources.
     if (!sourceImpls->empty()) {
         filteredLayersForSource.reserve(layerImpls->size());
     }
 
-#if MLN_DRAWABLE_RENDERER
     // Track which layers are flagged for rendering
-    std::vector<bool> updateList(orderedLayers.size());
-#endif
+    renderedLayerSources.assign(orderedLayers.size(), std::nullopt);
 
     // Update all sources and initialize renderItems.
     for (const auto& sourceImpl : *sourceImpls) {
@@ -350,7 +377,7 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
             const auto* layerInfo = layer.baseImpl->getTypeInfo();
             const bool layerIsVisible = layer.baseImpl->visibility != style::VisibilityType::None;
             const bool zoomFitsLayer = layer.supportsZoom(zoomHistory.lastZoom);
-            renderTreeParameters->has3D |= (layerInfo->pass3d == LayerTypeInfo::Pass3D::Required);
+            renderTreeParameters.has3D |= (layerInfo->pass3d == LayerTypeInfo::Pass3D::Required);
 
             if (layerInfo->source != LayerTypeInfo::Source::NotRequired) {
                 if (layer.baseImpl->source == sourceImpl->id) {
@@ -361,11 +388,7 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
                         filteredLayersForSource.push_back(layer.evaluatedProperties);
                         if (zoomFitsLayer) {
                             sourceNeedsRendering = true;
-                            renderItemsEmplaceHint = layerRenderItems.emplace_hint(
-                                renderItemsEmplaceHint, layer, source, static_cast<uint32_t>(index));
-#if MLN_DRAWABLE_RENDERER
-                            updateList[index] = true;
-#endif
+                            renderedLayerSources[index] = source;
                         }
                     }
                 }
@@ -377,34 +400,40 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
                 if (backgroundLayerAsColor && layer.baseImpl == layerImpls->front()) {
                     const auto& solidBackground = layer.getSolidBackground();
                     if (solidBackground) {
-                        renderTreeParameters->backgroundColor = *solidBackground;
+                        renderTreeParameters.backgroundColor = *solidBackground;
                         continue; // This layer is shown with background color,
                                   // and it shall not be added to render items.
                     }
                 }
-                renderItemsEmplaceHint = layerRenderItems.emplace_hint(
-                    renderItemsEmplaceHint, layer, nullptr, static_cast<uint32_t>(index));
-#if MLN_DRAWABLE_RENDERER
-                updateList[index] = true;
-#endif
+                renderedLayerSources[index] = nullptr;
             }
         }
         source->update(sourceImpl, filteredLayersForSource, sourceNeedsRendering, sourceNeedsRelayout, tileParameters);
         filteredLayersForSource.clear();
+    }
+
+    // Render items are emitted in layer order, which is the order the render tree keeps them in.
+    layerRenderItems.reserve(orderedLayers.size());
+    for (std::size_t index = 0; index < orderedLayers.size(); ++index) {
+        if (const auto& source = renderedLayerSources[index]) {
+            layerRenderItems.emplace_back(orderedLayers[index], *source, static_cast<uint32_t>(index));
+        }
+    }
 
 #if MLN_DRAWABLE_RENDERER
-        // Update all layers with their new renderability status, if it changed.
-        for (size_t i = 0; i < updateList.size(); i++) {
-            if (orderedLayers[i].get().isLayerRenderable() != updateList[i]) {
-                orderedLayers[i].get().markLayerRenderable(updateList[i], changes);
-            }
+    // Update all layers with their new renderability status, if it changed. This is done once all
+    // sources are visited, so that layers of later sources don't flip on and off in between.
+    for (std::size_t i = 0; i < renderedLayerSources.size(); i++) {
+        const bool willRender = renderedLayerSources[i].has_value();
+        if (orderedLayers[i].get().isLayerRenderable() != willRender) {
+            orderedLayers[i].get().markLayerRenderable(willRender, changes);
         }
-        addChanges(changes);
-#endif
     }
+    addChanges(changes);
+#endif
 
-    renderTreeParameters->loaded = updateParameters->styleLoaded && isLoaded();
-    if (!isMapModeContinuous && !renderTreeParameters->loaded) {
+    renderTreeParameters.loaded = updateParameters->styleLoaded && isLoaded();
+    if (!isMapModeContinuous && !renderTreeParameters.loaded) {
         return nullptr;
     }
 
@@ -412,10 +441,11 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
     for (const auto& entry : renderSources) {
         if (entry.second->isEnabled()) {
             entry.second->prepare(
-                {renderTreeParameters->transformParams, updateParameters->debugOptions, *imageManager});
+                {renderTreeParameters.transformParams, updateParameters->debugOptions, *imageManager});
         }
     }
 
+    lineAtlas->beginFrame();
     auto opaquePassCutOffEstimation = layerRenderItems.size();
     for (auto& renderItem : layerRenderItems) {
         RenderLayer& renderLayer = renderItem.layer;
@@ -424,24 +454,24 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
         if (renderLayer.needsPlacement()) {
             layersNeedPlacement.emplace_back(renderLayer);
         }
-        if (renderTreeParameters->opaquePassCutOff == 0) {
+        if (renderTreeParameters.opaquePassCutOff == 0) {
             --opaquePassCutOffEstimation;
             if (renderLayer.is3D()) {
-                renderTreeParameters->opaquePassCutOff = uint32_t(opaquePassCutOffEstimation);
+                renderTreeParameters.opaquePassCutOff = uint32_t(opaquePassCutOffEstimation);
             }
         }
     }
     // Symbol placement.
-    assert((updateParameters->mode == MapMode::Tile) || !placedSymbolDataCollected);
+    const auto placementStartTime = util::MonotonicTimer::now().count();
+    assert((updateParameters->mode != MapMode::Continuous) || !placedSymbolDataCollected);
+    assert((updateParameters->mode == MapMode::Static) || fixedPlacedSymbols.empty());
     bool symbolBucketsChanged = false;
     bool symbolBucketsAdded = false;
-    std::set<std::string> usedSymbolLayers;
     const auto longitude = static_cast<float>(updateParameters->transformState.getLatLng().longitude());
     for (auto it = layersNeedPlacement.crbegin(); it != layersNeedPlacement.crend(); ++it) {
         RenderLayer& layer = *it;
         auto result = crossTileSymbolIndex.addLayer(layer, longitude);
         if (isMapModeContinuous) {
-            usedSymbolLayers.insert(layer.getID());
             symbolBucketsAdded = symbolBucketsAdded || (result & CrossTileSymbolIndex::AddLayerResult::BucketsAdded);
             symbolBucketsChanged = symbolBucketsChanged || (result != CrossTileSymbolIndex::AddLayerResult::NoChanges);
         }
@@ -462,15 +492,20 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
             placementUpdatePeriodOverride = std::optional<Duration>(Milliseconds(30));
         }
 
-        renderTreeParameters->placementChanged = !placementController.placementIsRecent(
+        renderTreeParameters.placementChanged = !placementController.placementIsRecent(
             updateParameters->timePoint,
             static_cast<float>(updateParameters->transformState.getZoom()),
             placementUpdatePeriodOverride);
-        symbolBucketsChanged |= renderTreeParameters->placementChanged;
-        if (renderTreeParameters->placementChanged) {
+        symbolBucketsChanged |= renderTreeParameters.placementChanged;
+        if (renderTreeParameters.placementChanged) {
             Mutable<Placement> placement = Placement::create(updateParameters, placementController.getPlacement());
             placement->placeLayers(layersNeedPlacement);
             placementController.setPlacement(std::move(placement));
+            // Only collected when placing, as this copies the layer IDs
+            std::set<std::string> usedSymbolLayers;
+            for (const RenderLayer& layer : layersNeedPlacement) {
+                usedSymbolLayers.insert(layer.getID());
+            }
             crossTileSymbolIndex.pruneUnusedLayers(usedSymbolLayers);
             for (const auto& entry : renderSources) {
                 entry.second->updateFadingTiles();
@@ -478,48 +513,53 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
         } else {
             placementController.setPlacementStale();
         }
-        renderTreeParameters->symbolFadeChange = placementController.getPlacement()->symbolFadeChange(
+        renderTreeParameters.symbolFadeChange = placementController.getPlacement()->symbolFadeChange(
             updateParameters->timePoint);
-        renderTreeParameters->needsRepaint = hasTransitions(updateParameters->timePoint);
+        renderTreeParameters.needsRepaint = hasTransitions(updateParameters->timePoint);
     } else {
-        renderTreeParameters->placementChanged = symbolBucketsChanged = !layersNeedPlacement.empty();
-        if (renderTreeParameters->placementChanged) {
+        renderTreeParameters.placementChanged = symbolBucketsChanged = !layersNeedPlacement.empty();
+        if (renderTreeParameters.placementChanged) {
             Mutable<Placement> placement = Placement::create(updateParameters);
             placement->collectPlacedSymbolData(placedSymbolDataCollected);
+            placement->setFixedSymbols(fixedPlacedSymbols);
             placement->placeLayers(layersNeedPlacement);
             placementController.setPlacement(std::move(placement));
         }
         crossTileSymbolIndex.reset();
-        renderTreeParameters->symbolFadeChange = 1.0f;
-        renderTreeParameters->needsRepaint = false;
+        renderTreeParameters.symbolFadeChange = 1.0f;
+        renderTreeParameters.needsRepaint = false;
+    }
+
+    renderTreeParameters.placementTime = util::MonotonicTimer::now().count() - placementStartTime;
+
+    if (renderTreeParameters.placementChanged) {
+        const auto& symbolStats = placementController.getPlacement()->getSymbolStats();
+        renderTreeParameters.consideredSymbols = symbolStats.considered;
+        renderTreeParameters.culledSymbols = symbolStats.culled;
+        renderTreeParameters.placedSymbols = symbolStats.placed;
     }
 
-    if (!renderTreeParameters->needsRepaint && renderTreeParameters->loaded) {
+    if (!renderTreeParameters.needsRepaint && renderTreeParameters.loaded) {
         // Notify observer about unused images when map is fully loaded
         // and there are no ongoing transitions.
         imageManager->reduceMemoryUseIfCacheSizeExceedsLimit();
     }
 
-    std::vector<std::unique_ptr<RenderItem>> sourceRenderItems;
     for (const auto& entry : renderSources) {
         if (entry.second->isEnabled()) {
-            sourceRenderItems.emplace_back(entry.second->createRenderItem());
+            renderTree->sourceItems.emplace_back(entry.second->getRenderItem());
         }
     }
 
-    return std::make_unique<RenderTreeImpl>(std::move(renderTreeParameters),
-                                            std::move(layerRenderItems),
-                                            std::move(sourceRenderItems),
-                                            *lineAtlas,
-                                            *patternAtlas,
-                                            std::move(layersNeedPlacement),
-                                            placementController.getPlacement(),
-                                            symbolBucketsChanged,
-                                            startTime);
+    renderTreeParameters.layoutTime = util::MonotonicTimer::now().count() - startTime -
+                                      renderTreeParameters.placementTime;
+
+    renderTree->finish(*lineAtlas, *patternAtlas, placementController.getPlacement(), symbolBucketsChanged);
+    return renderTree.get();
 }
 
-std::vector<Feature> RenderOrchestrator::queryRenderedFeatures(const ScreenLineString& geometry,
-                                                               const RenderedQueryOptions& options) const {
+std::unordered_map<std::string, const RenderLayer*> RenderOrchestrator::getQueriedLayers(
+    const RenderedQueryOptions& options) const {
     std::unordered_map<std::string, const RenderLayer*> layers;
     if (options.layerIDs) {
         for (const auto& layerID : *options.layerIDs) {
@@ -532,8 +572,67 @@ std::vector<Feature> RenderOrchestrator::queryRenderedFeatures(const ScreenLineS
             layers.emplace(entry.second->getID(), entry.second.get());
         }
     }
+    return layers;
+}
+
+std::vector<Feature> RenderOrchestrator::queryRenderedFeatures(const ScreenLineString& geometry,
+                                                               const RenderedQueryOptions& options) const {
+    return queryRenderedFeatures(geometry, options, getQueriedLayers(options));
+}
+
+std::unique_ptr<RenderedQuerySnapshot> RenderOrchestrator::snapshotRenderedFeatures(
+    const ScreenLineString& geometry, const RenderedQueryOptions& options) const {
+    auto snapshot = std::make_unique<RenderedQuerySnapshot>(transformState, options);
+
+    std::unordered_set<std::string> sourceIDs;
+    std::unordered_map<std::string, const RenderLayer*> filteredLayers;
+    for (const auto& pair : getQueriedLayers(options)) {
+        if (!pair.second->needsRendering() || !pair.second->supportsZoom(zoomHistory.lastZoom)) {
+            continue;
+        }
+        filteredLayers.emplace(pair);
+        sourceIDs.emplace(pair.second->baseImpl->source);
+    }
+
+    // Same order in which `queryRenderedFeatures()` combines its results.
+    for (const auto& pair : filteredLayers) {
+        snapshot->addLayer(*pair.second);
+    }
+
+    mat4 projMatrix;
+    transformState.getProjMatrix(projMatrix);
+
+    for (const auto& sourceID : sourceIDs) {
+        if (RenderSource* renderSource = getRenderSource(sourceID)) {
+            renderSource->snapshotRenderedFeatures(*snapshot, geometry, transformState, projMatrix);
+        }
+    }
 
-    return queryRenderedFeatures(geometry, options, layers);
+    // The collision index belongs to the current placement, so it is queried
+    // right away; resolving the hits into features is left to the snapshot.
+    const auto hasCrossTileIndex = [](const auto& pair) {
+        return pair.second->baseImpl->getTypeInfo()->crossTileIndex == style::LayerTypeInfo::CrossTileIndex::Required;
+    };
+    if (std::any_of(filteredLayers.begin(), filteredLayers.end(), hasCrossTileIndex)) {
+        const Placement& placement = *placementController.getPlacement();
+        auto renderedSymbols = placement.getCollisionIndex().queryRenderedSymbols(geometry);
+        for (const RetainedQueryData& queryData : getSortedQueryData(placement, renderedSymbols)) {
+            snapshot->addSymbolQuery({queryData.featureIndex,
+                                      queryData.tileID,
+                                      queryData.featureSortOrder,
+                                      std::move(renderedSymbols[queryData.bucketInstanceId])});
+        }
+    }
+
+    mbgl::DynamicFeatureIndex dynamicIndex;
+    for (const auto& pair : filteredLayers) {
+        pair.second->populateDynamicRenderFeatureIndex(dynamicIndex);
+    }
+    std::unordered_map<std::string, std::vector<Feature>> dynamicResults;
+    dynamicIndex.query(dynamicResults, geometry, transformState);
+    snapshot->addResults(std::move(dynamicResults));
+
+    return snapshot;
 }
 
 void RenderOrchestrator::queryRenderedSymbols(std::unordered_map<std::string, std::vector<Feature>>& resultsByLayer,
@@ -555,21 +654,7 @@ void RenderOrchestrator::queryRenderedSymbols(std::unordered_map<std::string, st
     }
     const Placement& placement = *placementController.getPlacement();
     auto renderedSymbols = placement.getCollisionIndex().queryRenderedSymbols(geometry);
-    std::vector<std::reference_wrapper<const RetainedQueryData>> bucketQueryData;
-    bucketQueryData.reserve(renderedSymbols.size());
-    for (const auto& entry : renderedSymbols) {
-        bucketQueryData.emplace_back(placement.getQueryData(entry.first));
-    }
-    // Although symbol query is global, symbol results are only sortable within
-    // a bucket For a predictable global sort renderItems, we sort the buckets
-    // based on their corresponding tile position
-    std::sort(
-        bucketQueryData.begin(), bucketQueryData.end(), [](const RetainedQueryData& a, const RetainedQueryData& b) {
-            return std::tie(a.tileID.canonical.z, a.tileID.canonical.y, a.tileID.wrap, a.tileID.canonical.x) <
-                   std::tie(b.tileID.canonical.z, b.tileID.canonical.y, b.tileID.wrap, b.tileID.canonical.x);
-        });
-
-    for (auto wrappedQueryData : bucketQueryData) {
+    for (auto wrappedQueryData : getSortedQueryData(placement, renderedSymbols)) {
         auto& queryData = wrappedQueryData.get();
         auto bucketSymbols = queryData.featureIndex->lookupSymbolFeatures(renderedSymbols[queryData.bucketInstanceId],
                                                                           options,
@@ -727,6 +812,10 @@ const std::vector<PlacedSymbolData>& RenderOrchestrator::getPlacedSymbolsData()
     return placementController.getPlacement()->getPlacedSymbolsData();
 }
 
+void RenderOrchestrator::setFixedPlacedSymbols(std::vector<PlacedSymbolData> symbols) {
+    fixedPlacedSymbols = std::move(symbols);
+}
+
 RenderLayer* RenderOrchestrator::getRenderLayer(const std::string& id) {
     auto it = renderLayers.find(id);
     return it != renderLayers.end() ? it->second.get() : nullptr;
@@ -15,9 +15,11 @@
 #include <mbgl/renderer/image_manager_observer.hpp>
 #include <mbgl/text/placement.hpp>
 #include <mbgl/renderer/render_tree.hpp>
+#include <mbgl/util/tile_cover.hpp>
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -31,6 +33,7 @@ class RenderSource;
 class UpdateParameters;
 class RenderStaticData;
 class RenderedQueryOptions;
+class RenderedQuerySnapshot;
 class SourceQueryOptions;
 class GlyphManager;
 class ImageManager;
@@ -38,6 +41,7 @@ class LineAtlas;
 class PatternAtlas;
 class CrossTileSymbolIndex;
 class RenderTree;
+class RenderTreeImpl;
 
 namespace gfx {
 class ShaderRegistry;
@@ -62,9 +66,15 @@ public:
     // TODO: Introduce RenderOrchestratorObserver.
     void setObserver(RendererObserver*);
 
-    std::unique_ptr<RenderTree> createRenderTree(const std::shared_ptr<UpdateParameters>&);
+    /// Builds the render tree of the next frame, or returns nullptr if there is nothing to render. The tree
+    /// is owned by the orchestrator and reused by the following frames, so it is only valid until the next call.
+    RenderTree* createRenderTree(const std::shared_ptr<UpdateParameters>&);
 
     std::vector<Feature> queryRenderedFeatures(const ScreenLineString&, const RenderedQueryOptions&) const;
+    // Captures the current render state for a rendered features query that
+    // completes off the render thread, see `RenderedQuerySnapshot::query()`.
+    std::unique_ptr<RenderedQuerySnapshot> snapshotRenderedFeatures(const ScreenLineString&,
+                                                                    const RenderedQueryOptions&) const;
     std::vector<Feature> querySourceFeatures(const std::string& sourceID, const SourceQueryOptions&) const;
     std::vector<Feature> queryShapeAnnotations(const ScreenLineString&) const;
 
@@ -93,6 +103,7 @@ public:
     void dumpDebugLogs();
     void collectPlacedSymbolData(bool);
     const std::vector<PlacedSymbolData>& getPlacedSymbolsData() const;
+    void setFixedPlacedSymbols(std::vector<PlacedSymbolData>);
     void clearData();
 
     void update(const std::shared_ptr<UpdateParameters>&);
@@ -154,6 +165,8 @@ private:
     RenderLayer* getRenderLayer(const std::string& id);
     const RenderLayer* getRenderLayer(const std::string& id) const;
 
+    std::unordered_map<std::string, const RenderLayer*> getQueriedLayers(const RenderedQueryOptions&) const;
+
     void queryRenderedSymbols(std::unordered_map<std::string, std::vector<Feature>>& resultsByLayer,
                               const ScreenLineString& geometry,
                               const std::unordered_map<std::string, const RenderLayer*>& layers,
@@ -199,16 +212,20 @@ private:
 
     CrossTileSymbolIndex crossTileSymbolIndex;
     PlacementController placementController;
+    util::TileCoverCache tileCoverCache;
 
     const bool backgroundLayerAsColor;
     bool contextLost = false;
     bool placedSymbolDataCollected = false;
+    std::vector<PlacedSymbolData> fixedPlacedSymbols;
 
     // Vectors with reserved capacity of layerImpls->size() to avoid
     // reallocation on each frame.
     std::vector<Immutable<style::LayerProperties>> filteredLayersForSource;
     RenderLayerReferences orderedLayers;
-    RenderLayerReferences layersNeedPlacement;
+    // Source of each layer in `orderedLayers` rendered in the current frame
+    std::vector<std::optional<RenderSource*>> renderedLayerSources;
+    std::unique_ptr<RenderTreeImpl> renderTree;
 
 #if MLN_DRAWABLE_RENDERER
     std::vector<std::unique_ptr<ChangeRequest>> pendingChanges;
@@ -22,6 +22,7 @@ class TransformState;
 class RenderTile;
 class RenderLayer;
 class RenderedQueryOptions;
+class RenderedQuerySnapshot;
 class SourceQueryOptions;
 class Tile;
 class RenderSourceObserver;
@@ -58,8 +59,9 @@ public:
                         bool needsRendering,
                         bool needsRelayout,
                         const TileParameters&) = 0;
-    // Note: calling of this method might reset the contained render data.
-    virtual std::unique_ptr<RenderItem> createRenderItem() = 0;
+    // Returns the render item of the prepared frame. The source owns it and
+    // updates it in place on the next prepare().
+    virtual const RenderItem& getRenderItem() const = 0;
     // Creates the render data to be passed to the render item.
     virtual void prepare(const SourcePrepareParameters&) = 0;
     virtual void updateFadingTiles() = 0;
@@ -82,6 +84,13 @@ public:
         const RenderedQueryOptions& options,
         const mat4& projMatrix) const = 0;
 
+    // Captures the inputs of `queryRenderedFeatures()` into the given snapshot,
+    // if the source supports running the query off the render thread.
+    virtual void snapshotRenderedFeatures(RenderedQuerySnapshot&,
+                                          const ScreenLineString&,
+                                          const TransformState&,
+                                          const mat4&) const {}
+
     virtual std::vector<Feature> querySourceFeatures(const SourceQueryOptions&) const = 0;
 
     virtual FeatureExtensionValue queryFeatureExtensions(const Feature&,
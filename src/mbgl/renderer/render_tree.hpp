@@ -7,6 +7,7 @@
 
 #include <cassert>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -89,6 +90,13 @@ public:
     bool needsRepaint = false;
     bool loaded = false;
     bool placementChanged = false;
+    /// Symbols considered, culled as out of view and placed by the placement of this frame, if any
+    std::size_t consideredSymbols = 0;
+    std::size_t culledSymbols = 0;
+    std::size_t placedSymbols = 0;
+    /// Time spent creating the render tree, apart from symbol placement, and placing symbols (seconds)
+    double layoutTime = 0;
+    double placementTime = 0;
 };
 
 class RenderTree {
@@ -96,26 +104,27 @@ public:
     virtual ~RenderTree() = default;
     virtual void prepare() {}
     // Render items
-    virtual const std::set<LayerRenderItem>& getLayerRenderItemMap() const noexcept = 0;
-    virtual RenderItems getLayerRenderItems() const = 0;
-    virtual RenderItems getSourceRenderItems() const = 0;
+    /// Layer render items, ordered by layer index
+    virtual const std::vector<LayerRenderItem>& getLayerRenderItemMap() const noexcept = 0;
+    virtual const RenderItems& getLayerRenderItems() const noexcept = 0;
+    virtual const RenderItems& getSourceRenderItems() const noexcept = 0;
     // Resources
     virtual LineAtlas& getLineAtlas() const = 0;
     virtual PatternAtlas& getPatternAtlas() const = 0;
     // Parameters
-    const RenderTreeParameters& getParameters() const { return *parameters; }
+    const RenderTreeParameters& getParameters() const {
+        assert(parameters);
+        return *parameters;
+    }
 
     double getElapsedTime() const { return util::MonotonicTimer::now().count() - startTime; }
 
 protected:
-    RenderTree(std::unique_ptr<RenderTreeParameters> parameters_, double startTime_)
-        : parameters(std::move(parameters_)),
-          startTime(startTime_) {
-        assert(parameters);
-    }
-    std::unique_ptr<RenderTreeParameters> parameters;
+    RenderTree() = default;
+    /// Emplaced anew for each frame, so that a tree reused across frames doesn't reallocate them
+    std::optional<RenderTreeParameters> parameters;
 
-    double startTime;
+    double startTime = 0;
 };
 
 } // namespace mbgl
@@ -1,10 +1,12 @@
 #include <mbgl/renderer/renderer.hpp>
 
+#include <mbgl/actor/scheduler.hpp>
 #include <mbgl/annotation/annotation_manager.hpp>
 #include <mbgl/gfx/backend_scope.hpp>
 #include <mbgl/gfx/renderer_backend.hpp>
 #include <mbgl/layermanager/layer_manager.hpp>
 #include <mbgl/renderer/renderer_impl.hpp>
+#include <mbgl/renderer/query_snapshot.hpp>
 #include <mbgl/renderer/render_static_data.hpp>
 #include <mbgl/renderer/render_tree.hpp>
 #include <mbgl/renderer/update_parameters.hpp>
@@ -30,7 +32,7 @@ void Renderer::setObserver(RendererObserver* observer) {
 
 void Renderer::render(const std::shared_ptr<UpdateParameters>& updateParameters) {
     assert(updateParameters);
-    if (auto renderTree = impl->orchestrator.createRenderTree(updateParameters)) {
+    if (auto* renderTree = impl->orchestrator.createRenderTree(updateParameters)) {
         renderTree->prepare();
         impl->render(*renderTree, updateParameters);
     }
@@ -51,6 +53,25 @@ std::vector<Feature> Renderer::queryRenderedFeatures(const ScreenBox& box, const
         {box.min, {box.max.x, box.min.y}, box.max, {box.min.x, box.max.y}, box.min}, options);
 }
 
+void Renderer::queryRenderedFeaturesAsync(const ScreenLineString& geometry,
+                                          const RenderedQueryOptions& options,
+                                          QueryFeaturesCallback callback) const {
+    assert(callback);
+    std::shared_ptr<const RenderedQuerySnapshot> snapshot = impl->orchestrator.snapshotRenderedFeatures(geometry,
+                                                                                                        options);
+    // The pool outlives any of its running tasks: its destructor joins the worker threads.
+    Scheduler* threadPool = impl->threadPool.get();
+    threadPool->scheduleAndReplyValue([snapshot, threadPool] { return snapshot->query(*threadPool); },
+                                      std::move(callback));
+}
+
+void Renderer::queryRenderedFeaturesAsync(const ScreenBox& box,
+                                          const RenderedQueryOptions& options,
+                                          QueryFeaturesCallback callback) const {
+    queryRenderedFeaturesAsync(
+        {box.min, {box.max.x, box.min.y}, box.max, {box.min.x, box.max.y}, box.min}, options, std::move(callback));
+}
+
 AnnotationIDs Renderer::queryPointAnnotations(const ScreenBox& box) const {
     if (!LayerManager::annotationsEnabled) {
         return {};
@@ -132,6 +153,10 @@ const std::vector<PlacedSymbolData>& Renderer::getPlacedSymbolsData() const {
     return impl->orchestrator.getPlacedSymbolsData();
 }
 
+void Renderer::setFixedPlacedSymbols(std::vector<PlacedSymbolData> symbols) {
+    impl->orchestrator.setFixedPlacedSymbols(std::move(symbols));
+}
+
 void Renderer::reduceMemoryUse() {
     gfx::BackendScope guard{impl->backend};
     impl->reduceMemoryUse();
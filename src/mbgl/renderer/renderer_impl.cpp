@@ -1,5 +1,6 @@
 #include <mbgl/renderer/renderer_impl.hpp>
 
+#include <mbgl/actor/scheduler.hpp>
 #include <mbgl/geometry/line_atlas.hpp>
 #include <mbgl/gfx/backend_scope.hpp>
 #include <mbgl/gfx/context.hpp>
@@ -58,6 +59,7 @@ Renderer::Impl::Impl(gfx::RendererBackend& backend_,
                      float pixelRatio_,
                      const std::optional<std::string>& localFontFamily_)
     : orchestrator(!backend_.contextIsShared(), localFontFamily_),
+      threadPool(Scheduler::GetBackground()),
       backend(backend_),
       observer(&nullObserver()),
       pixelRatio(pixelRatio_) {}
@@ -158,6 +160,16 @@ void Renderer::Impl::render(const RenderTree& renderTree,
     staticData->has3D = renderTreeParameters.has3D;
     staticData->backendSize = backend.getDefaultRenderable().getSize();
 
+    context.renderingStats().layoutTime = renderTreeParameters.layoutTime;
+    context.renderingStats().placementTime = renderTreeParameters.placementTime;
+
+    if (renderTreeParameters.placementChanged) {
+        auto& stats = context.renderingStats();
+        stats.numSymbolsConsidered = static_cast<int>(renderTreeParameters.consideredSymbols);
+        stats.numSymbolsCulled = static_cast<int>(renderTreeParameters.culledSymbols);
+        stats.numSymbolsPlaced = static_cast<int>(renderTreeParameters.placedSymbols);
+    }
+
     if (renderState == RenderState::Never) {
         observer->onWillStartRenderingMap();
     }
@@ -189,6 +201,7 @@ void Renderer::Impl::render(const RenderTree& renderTree,
 
     // - UPLOAD PASS -------------------------------------------------------------------------------
     // Uploads all required buffers and images before we do any actual rendering.
+    const auto startUpload = util::MonotonicTimer::now().count();
     {
         const auto uploadPass = parameters.encoder->createUploadPass("upload",
                                                                      parameters.backend.getDefaultRenderable());
@@ -246,6 +259,8 @@ void Renderer::Impl::render(const RenderTree& renderTree,
     }
 #endif
 
+    context.renderingStats().uploadTime = util::MonotonicTimer::now().count() - startUpload;
+
     // - 3D PASS
     // -------------------------------------------------------------------------------------
     // Renders any 3D layers bottom-to-top to unique FBOs with texture
@@ -14,6 +14,7 @@ namespace mbgl {
 
 class RendererObserver;
 class RenderStaticData;
+class Scheduler;
 class RenderTree;
 
 namespace gfx {
@@ -38,6 +39,9 @@ private:
     // TODO: Move orchestrator to Map::Impl.
     RenderOrchestrator orchestrator;
 
+    // Runs asynchronous feature queries.
+    std::shared_ptr<Scheduler> threadPool;
+
     gfx::RendererBackend& backend;
 
     RendererObserver* observer;
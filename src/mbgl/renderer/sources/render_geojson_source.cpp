@@ -84,7 +84,8 @@ void RenderGeoJSONSource::update(Immutable<style::Source::Impl> baseImpl_,
     enabled = needsRendering;
 
     auto data_ = impl().getData().lock();
-    if (data.lock() != data_) {
+    auto previous = data.lock();
+    if (previous != data_) {
         data = data_;
         if (parameters.mode != MapMode::Continuous) {
             // Clearing the tile pyramid in order to avoid render tests being flaky.
@@ -93,8 +94,14 @@ void RenderGeoJSONSource::update(Immutable<style::Source::Impl> baseImpl_,
             tilePyramid.reduceMemoryUse();
             const uint8_t maxZ = impl().getZoomRange().max;
             for (const auto& pair : tilePyramid.getTiles()) {
-                if (pair.first.canonical.z <= maxZ) {
-                    static_cast<GeoJSONTile*>(pair.second.get())->updateData(data_, needsRelayout);
+                const auto& canonical = pair.first.canonical;
+                if (canonical.z > maxZ) continue;
+                auto* tile = static_cast<GeoJSONTile*>(pair.second.get());
+                if (needsRelayout || !previous || data_->isTileChanged(*previous, canonical)) {
+                    tile->updateData(data_, needsRelayout);
+                } else {
+                    // The tile is not touched by the incremental update, its features stay valid.
+                    tile->retainData(data_);
                 }
             }
         }
@@ -83,19 +83,24 @@ bool RenderImageSource::isLoaded() const {
     return !!bucket;
 }
 
-std::unique_ptr<RenderItem> RenderImageSource::createRenderItem() {
+const RenderItem& RenderImageSource::getRenderItem() const {
     assert(renderData);
-    return std::move(renderData);
+    return *renderData;
 }
 
 void RenderImageSource::prepare(const SourcePrepareParameters& parameters) {
-    assert(!renderData);
-    if (!isLoaded()) {
+    // The render data is kept from frame to frame and updated in place
+    if (!renderData) {
         renderData = std::make_unique<ImageSourceRenderData>(bucket, std::vector<mat4>{}, baseImpl->id);
+    }
+    renderData->bucket = bucket;
+    auto& matrices = renderData->matrices;
+    if (!isLoaded()) {
+        matrices.clear();
         return;
     }
 
-    std::vector<mat4> matrices{tileIds.size(), mat4()};
+    matrices.resize(tileIds.size());
     const auto& transformParams = parameters.transform;
     for (size_t i = 0u; i < tileIds.size(); ++i) {
         mat4& matrix = matrices[i];
@@ -103,7 +108,6 @@ void RenderImageSource::prepare(const SourcePrepareParameters& parameters) {
         transformParams.state.matrixFor(matrix, tileIds[i]);
         matrix::multiply(matrix, transformParams.alignedProjMatrix, matrix);
     }
-    renderData = std::make_unique<ImageSourceRenderData>(bucket, std::move(matrices), baseImpl->id);
 }
 
 std::unordered_map<std::string, std::vector<Feature>> RenderImageSource::queryRenderedFeatures(
@@ -16,8 +16,8 @@ public:
           matrices(std::move(matrices_)),
           name(std::move(name_)) {}
     ~ImageSourceRenderData() override;
-    const std::shared_ptr<RasterBucket> bucket;
-    const std::vector<mat4> matrices;
+    std::shared_ptr<RasterBucket> bucket;
+    std::vector<mat4> matrices;
 
 private:
     void upload(gfx::UploadPass&) const override;
@@ -38,7 +38,7 @@ public:
 
     bool isLoaded() const final;
 
-    std::unique_ptr<RenderItem> createRenderItem() override;
+    const RenderItem& getRenderItem() const override;
     void prepare(const SourcePrepareParameters&) final;
     void updateFadingTiles() final {}
     bool hasFadingTiles() const final { return false; }
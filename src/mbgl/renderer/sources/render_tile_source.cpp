@@ -376,7 +376,8 @@ void TileSourceRenderItem::updateDebugDrawables(DebugLayerGroupMap& debugLayerGr
 
 RenderTileSource::RenderTileSource(Immutable<style::Source::Impl> impl_)
     : RenderSource(std::move(impl_)),
-      renderTiles(makeMutable<std::vector<RenderTile>>()) {
+      renderTiles(makeMutable<std::vector<RenderTile>>()),
+      renderItem(renderTiles, baseImpl->id) {
     tilePyramid.setObserver(this);
 }
 
@@ -386,10 +387,6 @@ bool RenderTileSource::isLoaded() const {
     return tilePyramid.isLoaded();
 }
 
-std::unique_ptr<RenderItem> RenderTileSource::createRenderItem() {
-    return std::make_unique<TileSourceRenderItem>(renderTiles, baseImpl->id);
-}
-
 void RenderTileSource::prepare(const SourcePrepareParameters& parameters) {
     bearing = static_cast<float>(parameters.transform.state.getBearing());
     filteredRenderTiles = nullptr;
@@ -402,6 +399,7 @@ void RenderTileSource::prepare(const SourcePrepareParameters& parameters) {
     }
     featureState.coalesceChanges(*tiles);
     renderTiles = std::move(tiles);
+    renderItem.setRenderTiles(renderTiles);
 }
 
 void RenderTileSource::updateFadingTiles() {
@@ -462,6 +460,14 @@ std::unordered_map<std::string, std::vector<Feature>> RenderTileSource::queryRen
     return tilePyramid.queryRenderedFeatures(geometry, transformState, layers, options, projMatrix, featureState);
 }
 
+void RenderTileSource::snapshotRenderedFeatures(RenderedQuerySnapshot& snapshot,
+                                                const ScreenLineString& geometry,
+                                                const TransformState& transformState,
+                                                const mat4& projMatrix) const {
+    tilePyramid.snapshotRenderedFeatures(
+        snapshot, geometry, transformState, projMatrix, std::make_shared<const SourceFeatureState>(featureState));
+}
+
 std::vector<Feature> RenderTileSource::querySourceFeatures(const SourceQueryOptions& options) const {
     return tilePyramid.querySourceFeatures(options);
 }
@@ -12,6 +12,28 @@
 
 namespace mbgl {
 
+class TileSourceRenderItem : public RenderItem {
+public:
+    TileSourceRenderItem(Immutable<std::vector<RenderTile>> renderTiles_, std::string name_)
+        : renderTiles(std::move(renderTiles_)),
+          name(std::move(name_)) {}
+
+    void setRenderTiles(Immutable<std::vector<RenderTile>> renderTiles_) { renderTiles = std::move(renderTiles_); }
+
+private:
+    void upload(gfx::UploadPass&) const override;
+    void render(PaintParameters&) const override;
+    bool hasRenderPass(RenderPass) const override { return false; }
+    const std::string& getName() const override { return name; }
+
+#if MLN_DRAWABLE_RENDERER
+    void updateDebugDrawables(DebugLayerGroupMap&, PaintParameters&) const override;
+#endif
+
+    Immutable<std::vector<RenderTile>> renderTiles;
+    std::string name;
+};
+
 /**
  * @brief Base class for render sources that provide render tiles.
  */
@@ -21,7 +43,7 @@ public:
 
     bool isLoaded() const override;
 
-    std::unique_ptr<RenderItem> createRenderItem() override;
+    const RenderItem& getRenderItem() const override { return renderItem; }
     void prepare(const SourcePrepareParameters&) override;
     void updateFadingTiles() override;
     bool hasFadingTiles() const override;
@@ -37,6 +59,11 @@ public:
         const RenderedQueryOptions& options,
         const mat4& projMatrix) const override;
 
+    void snapshotRenderedFeatures(RenderedQuerySnapshot&,
+                                  const ScreenLineString& geometry,
+                                  const TransformState& transformState,
+                                  const mat4& projMatrix) const override;
+
     std::vector<Feature> querySourceFeatures(const SourceQueryOptions&) const override;
 
     void setFeatureState(const std::optional<std::string>&, const std::string&, const FeatureState&) override;
@@ -58,6 +85,7 @@ protected:
     mutable RenderTiles renderTilesSortedByY;
 
 private:
+    TileSourceRenderItem renderItem;
     float bearing = 0.0F;
     SourceFeatureState featureState;
 };
@@ -89,24 +117,4 @@ private:
     std::optional<Tileset> cachedTileset;
 };
 
-class TileSourceRenderItem : public RenderItem {
-public:
-    TileSourceRenderItem(Immutable<std::vector<RenderTile>> renderTiles_, std::string name_)
-        : renderTiles(std::move(renderTiles_)),
-          name(std::move(name_)) {}
-
-private:
-    void upload(gfx::UploadPass&) const override;
-    void render(PaintParameters&) const override;
-    bool hasRenderPass(RenderPass) const override { return false; }
-    const std::string& getName() const override { return name; }
-
-#if MLN_DRAWABLE_RENDERER
-    void updateDebugDrawables(DebugLayerGroupMap&, PaintParameters&) const override;
-#endif
-
-    Immutable<std::vector<RenderTile>> renderTiles;
-    std::string name;
-};
-
 } // namespace mbgl
@@ -0,0 +1,46 @@
+#include <mbgl/renderer/tile_load_order.hpp>
+
+#include <mbgl/map/transform_state.hpp>
+#include <mbgl/util/projection.hpp>
+#include <mbgl/util/tile_coordinate.hpp>
+
+#include <cmath>
+
+namespace mbgl {
+
+TileLoadOrder::TileLoadOrder(const TransformState& state)
+    : worldSize(Projection::worldSize(state.getScale())) {
+    const double width = state.getSize().width;
+    const double height = state.getSize().height;
+    const auto center = TileCoordinate::fromScreenCoordinate(state, 0, {width / 2.0, height / 2.0}).p;
+    centerX = center.x;
+    centerY = center.y;
+
+    const double tanPitch = std::tan(state.getPitch());
+    horizonFactor = tanPitch * tanPitch;
+
+    // The point right above the centre of the screen gives the direction
+    // towards the horizon.
+    const auto ahead = TileCoordinate::fromScreenCoordinate(state, 0, {width / 2.0, height / 2.0 - 1.0}).p;
+    const double dx = ahead.x - centerX;
+    const double dy = ahead.y - centerY;
+    const double length = std::sqrt(dx * dx + dy * dy);
+    if (length > 0 && std::isfinite(length)) {
+        forwardX = dx / length;
+        forwardY = dy / length;
+    }
+}
+
+double TileLoadOrder::distance(const OverscaledTileID& tileID) const {
+    // Tile centres are compared in pixels, so tiles of different zoom levels,
+    // as in the cover of a pitched map, can be ordered together.
+    const double tiles = static_cast<double>(1u << tileID.canonical.z);
+    const double dx = (tileID.wrap + (tileID.canonical.x + 0.5) / tiles - centerX) * worldSize;
+    const double dy = ((tileID.canonical.y + 0.5) / tiles - centerY) * worldSize;
+
+    const double ahead = dx * forwardX + dy * forwardY;
+    const double horizon = ahead > 0 ? ahead * ahead * horizonFactor : 0;
+    return dx * dx + dy * dy + horizon;
+}
+
+} // namespace mbgl
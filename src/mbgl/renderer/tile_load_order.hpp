@@ -0,0 +1,63 @@
+#pragma once
+
+#include <mbgl/tile/tile_id.hpp>
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+namespace mbgl {
+
+class TransformState;
+
+/**
+ * @brief Decides in which order tiles are created and requested.
+ *
+ * Tiles that leave a hole on the screen come before tiles that are already
+ * covered by a loaded parent. Within each group, tiles are ordered by their
+ * distance from the screen centre on the ground plane. On pitched maps,
+ * distances towards the horizon are stretched, so tiles close to the camera
+ * load before distant ones.
+ */
+class TileLoadOrder {
+public:
+    explicit TileLoadOrder(const TransformState&);
+
+    /// Sort key of a tile; smaller keys load first.
+    double distance(const OverscaledTileID&) const;
+
+    /// Sorts the tiles into load order. `isCovered(id)` reports whether the
+    /// tile already has renderable data to show in its place. The sort is
+    /// stable, so tiles with equal priority keep the tile cover order.
+    /// Returns the number of tiles that are not covered; they come first.
+    template <typename IsCoveredFn>
+    std::size_t sort(std::vector<OverscaledTileID>& tileIDs, IsCoveredFn isCovered) const {
+        std::vector<std::tuple<bool, double, std::size_t>> keys;
+        keys.reserve(tileIDs.size());
+        for (std::size_t i = 0; i < tileIDs.size(); ++i) {
+            keys.emplace_back(isCovered(tileIDs[i]), distance(tileIDs[i]), i);
+        }
+        std::sort(keys.begin(), keys.end());
+
+        std::vector<OverscaledTileID> sorted;
+        sorted.reserve(tileIDs.size());
+        std::size_t uncovered = 0;
+        for (const auto& key : keys) {
+            sorted.push_back(tileIDs[std::get<2>(key)]);
+            uncovered += std::get<0>(key) ? 0 : 1;
+        }
+        tileIDs = std::move(sorted);
+        return uncovered;
+    }
+
+private:
+    // Screen centre and view direction on the ground, in zoom 0 tile units.
+    double centerX;
+    double centerY;
+    double forwardX = 0;
+    double forwardY = 0;
+    double worldSize;     // Pixels per zoom 0 tile.
+    double horizonFactor; // Extra weight of squared distances towards the horizon.
+};
+
+} // namespace mbgl
@@ -14,6 +14,10 @@ class AnnotationManager;
 class ImageManager;
 class GlyphManager;
 
+namespace util {
+class TileCoverCache;
+} // namespace util
+
 class TileParameters {
 public:
     const float pixelRatio;
@@ -25,6 +29,8 @@ public:
     ImageManager& imageManager;
     GlyphManager& glyphManager;
     const uint8_t prefetchZoomDelta;
+    // Shared by the sources updated with these parameters, if set.
+    util::TileCoverCache* tileCoverCache = nullptr;
 };
 
 } // namespace mbgl
@@ -3,12 +3,17 @@
 #include <mbgl/renderer/render_source.hpp>
 #include <mbgl/renderer/tile_parameters.hpp>
 #include <mbgl/renderer/query.hpp>
+#include <mbgl/renderer/query_snapshot.hpp>
+#include <mbgl/renderer/source_state.hpp>
+#include <mbgl/renderer/tile_load_order.hpp>
 #include <mbgl/map/transform.hpp>
 #include <mbgl/math/clamp.hpp>
 #include <mbgl/util/tile_cover.hpp>
 #include <mbgl/util/tile_range.hpp>
 #include <mbgl/util/enum.hpp>
 #include <mbgl/util/logging.hpp>
+#include <mbgl/util/parallel.hpp>
+#include <mbgl/tile/geometry_tile.hpp>
 
 #include <mbgl/algorithm/update_renderables.hpp>
 
@@ -16,6 +21,7 @@
 
 #include <cmath>
 #include <algorithm>
+#include <iterator>
 
 namespace mbgl {
 
@@ -77,6 +83,7 @@ void TilePyramid::update(const std::vector<Immutable<style::LayerProperties>>& l
 
         tiles.clear();
         renderedTiles.clear();
+        loadOrder.clear();
 
         return;
     }
@@ -96,6 +103,12 @@ void TilePyramid::update(const std::vector<Immutable<style::LayerProperties>>& l
 
     std::vector<OverscaledTileID> idealTiles;
     std::vector<OverscaledTileID> panTiles;
+    // Sources with the same tile size and zoom range need the same covers.
+    auto cover = [&parameters](uint8_t z, std::optional<uint8_t> coverOverscaledZ) {
+        const auto& state = parameters.transformState;
+        return parameters.tileCoverCache ? parameters.tileCoverCache->get(state, z, coverOverscaledZ)
+                                         : util::tileCover(state, z, coverOverscaledZ);
+    };
 
     if (overscaledZoom >= zoomRange.min) {
         int32_t idealZoom = std::min<int32_t>(zoomRange.max, overscaledZoom);
@@ -117,11 +130,11 @@ void TilePyramid::update(const std::vector<Immutable<style::LayerProperties>>& l
             }
 
             if (panZoom < idealZoom) {
-                panTiles = util::tileCover(parameters.transformState, panZoom);
+                panTiles = cover(static_cast<uint8_t>(panZoom), std::nullopt);
             }
         }
 
-        idealTiles = util::tileCover(parameters.transformState, idealZoom, tileZoom);
+        idealTiles = cover(static_cast<uint8_t>(idealZoom), static_cast<uint8_t>(tileZoom));
         if (parameters.mode == MapMode::Tile && type != SourceType::Raster && type != SourceType::RasterDEM &&
             idealTiles.size() > 1) {
             mbgl::Log::Warning(mbgl::Event::General,
@@ -131,6 +144,28 @@ void TilePyramid::update(const std::vector<Immutable<style::LayerProperties>>& l
         }
     }
 
+    // Create and request the tiles that are most visible first. Prefetched
+    // tiles still go before the ideal tiles, as they cover them quickly.
+    const auto isCovered = [&](const OverscaledTileID& tileID) {
+        for (int32_t z = tileID.overscaledZ; z >= zoomRange.min; --z) {
+            auto it = tiles.find(tileID.scaledTo(static_cast<uint8_t>(z)));
+            if (it != tiles.end() && it->second->isRenderable()) {
+                return true;
+            }
+        }
+        return false;
+    };
+    const TileLoadOrder tileLoadOrder(parameters.transformState);
+    const std::size_t uncoveredPanTiles = tileLoadOrder.sort(panTiles, isCovered);
+    const std::size_t uncoveredIdealTiles = tileLoadOrder.sort(idealTiles, isCovered);
+    loadOrder = panTiles;
+    loadOrder.insert(loadOrder.end(), idealTiles.begin(), idealTiles.end());
+
+    // Covered tiles are requested at low priority, so the file source serves
+    // the tiles that leave a hole on the screen first.
+    std::set<OverscaledTileID> lowPriority(panTiles.begin() + uncoveredPanTiles, panTiles.end());
+    lowPriority.insert(idealTiles.begin() + uncoveredIdealTiles, idealTiles.end());
+
     // Stores a list of all the tiles that we're definitely going to retain.
     // There are two kinds of tiles we need: the ideal tiles determined by the
     // tile cover. They may not yet be in use because they're still loading. In
@@ -140,6 +175,7 @@ void TilePyramid::update(const std::vector<Immutable<style::LayerProperties>>& l
 
     auto retainTileFn = [&](Tile& tile, TileNecessity necessity) -> void {
         if (retain.emplace(tile.id).second) {
+            tile.setPriority(lowPriority.count(tile.id) ? Resource::Priority::Low : Resource::Priority::Regular);
             tile.setUpdateParameters({minimumUpdateInterval, isVolatile});
             tile.setNecessity(necessity);
         }
@@ -302,16 +338,18 @@ void TilePyramid::handleWrapJump(float lng) {
     }
 }
 
-std::unordered_map<std::string, std::vector<Feature>> TilePyramid::queryRenderedFeatures(
-    const ScreenLineString& geometry,
-    const TransformState& transformState,
-    const std::unordered_map<std::string, const RenderLayer*>& layers,
-    const RenderedQueryOptions& options,
-    const mat4& projMatrix,
-    const SourceFeatureState& featureState) const {
-    std::unordered_map<std::string, std::vector<Feature>> result;
+namespace {
+
+// Calls `fn(id, tile, tileSpaceQueryGeometry)` for every rendered tile whose
+// bounds (plus query padding) intersect the query geometry, in a stable order.
+template <typename Fn>
+void forEachQueriedTile(const std::map<UnwrappedTileID, std::reference_wrapper<Tile>>& renderedTiles,
+                        const ScreenLineString& geometry,
+                        const TransformState& transformState,
+                        const std::unordered_map<std::string, const RenderLayer*>& layers,
+                        Fn&& fn) {
     if (renderedTiles.empty() || geometry.empty()) {
-        return result;
+        return;
     }
 
     LineString<double> queryGeometry;
@@ -361,18 +399,106 @@ std::unordered_map<std::string, std::vector<Feature>> TilePyramid::queryRendered
             tileSpaceQueryGeometry.push_back(TileCoordinate::toGeometryCoordinate(id, c));
         }
 
-        tile.queryRenderedFeatures(
-            result, tileSpaceQueryGeometry, transformState, layers, options, projMatrix, featureState);
+        fn(id, tile, std::move(tileSpaceQueryGeometry));
+    }
+}
+
+} // namespace
+
+std::unordered_map<std::string, std::vector<Feature>> TilePyramid::queryRenderedFeatures(
+    const ScreenLineString& geometry,
+    const TransformState& transformState,
+    const std::unordered_map<std::string, const RenderLayer*>& layers,
+    const RenderedQueryOptions& options,
+    const mat4& projMatrix,
+    const SourceFeatureState& featureState) const {
+    using ResultsByLayer = std::unordered_map<std::string, std::vector<Feature>>;
+
+    std::vector<std::pair<std::reference_wrapper<Tile>, GeometryCoordinates>> queriedTiles;
+    forEachQueriedTile(
+        renderedTiles, geometry, transformState, layers, [&](const UnwrappedTileID&, Tile& tile, auto&& queryGeometry) {
+            queriedTiles.emplace_back(tile, std::move(queryGeometry));
+        });
+
+    // Tiles only read their own, immutable feature index here, so they are
+    // queried in parallel. Each one fills its own result map, which are then
+    // merged in tile order to keep the result deterministic.
+    std::vector<ResultsByLayer> tileResults(queriedTiles.size());
+    auto queryTile = [&](const std::size_t i) {
+        queriedTiles[i].first.get().queryRenderedFeatures(
+            tileResults[i], queriedTiles[i].second, transformState, layers, options, projMatrix, featureState);
+    };
+    if (queriedTiles.size() > 1) {
+        util::parallelFor(*Scheduler::GetBackground(), queriedTiles.size(), queryTile);
+    } else if (!queriedTiles.empty()) {
+        queryTile(0);
+    }
+
+    ResultsByLayer result;
+    for (auto& tileResult : tileResults) {
+        for (auto& entry : tileResult) {
+            auto& features = result[entry.first];
+            std::move(entry.second.begin(), entry.second.end(), std::back_inserter(features));
+        }
     }
 
     return result;
 }
 
-std::vector<Feature> TilePyramid::querySourceFeatures(const SourceQueryOptions& options) const {
-    std::vector<Feature> result;
+void TilePyramid::snapshotRenderedFeatures(RenderedQuerySnapshot& snapshot,
+                                           const ScreenLineString& geometry,
+                                           const TransformState& transformState,
+                                           const mat4& projMatrix,
+                                           const std::shared_ptr<const SourceFeatureState>& featureState) const {
+    const auto& layers = snapshot.getLayers();
+    forEachQueriedTile(
+        renderedTiles, geometry, transformState, layers, [&](const UnwrappedTileID&, Tile& tile, auto&& queryGeometry) {
+            if (tile.kind != Tile::Kind::Geometry) {
+                return;
+            }
+            auto featureIndex = static_cast<const GeometryTile&>(tile).getFeatureIndex();
+            if (!featureIndex || !featureIndex->getData()) {
+                return;
+            }
+
+            // Mirrors `GeometryTile::queryRenderedFeatures()`.
+            const OverscaledTileID& id = tile.id;
+            const float queryPadding = tile.getQueryPadding(layers);
+            mat4 posMatrix;
+            transformState.matrixFor(posMatrix, id.toUnwrapped());
+            matrix::multiply(posMatrix, projMatrix, posMatrix);
+
+            snapshot.addTileQuery({std::move(featureIndex),
+                                   id.toUnwrapped(),
+                                   std::move(queryGeometry),
+                                   posMatrix,
+                                   util::tileSize_D * id.overscaleFactor(),
+                                   std::pow(2, transformState.getZoom() - id.overscaledZ),
+                                   queryPadding * static_cast<float>(transformState.maxPitchScaleFactor()),
+                                   featureState});
+        });
+}
 
+std::vector<Feature> TilePyramid::querySourceFeatures(const SourceQueryOptions& options) const {
+    std::vector<std::reference_wrapper<Tile>> queriedTiles;
+    queriedTiles.reserve(tiles.size());
     for (const auto& pair : tiles) {
-        pair.second->querySourceFeatures(result, options);
+        queriedTiles.emplace_back(*pair.second);
+    }
+
+    std::vector<std::vector<Feature>> tileResults(queriedTiles.size());
+    auto queryTile = [&](const std::size_t i) {
+        queriedTiles[i].get().querySourceFeatures(tileResults[i], options);
+    };
+    if (queriedTiles.size() > 1) {
+        util::parallelFor(*Scheduler::GetBackground(), queriedTiles.size(), queryTile);
+    } else if (!queriedTiles.empty()) {
+        queryTile(0);
+    }
+
+    std::vector<Feature> result;
+    for (auto& tileResult : tileResults) {
+        std::move(tileResult.begin(), tileResult.end(), std::back_inserter(result));
     }
 
     return result;
@@ -400,6 +526,7 @@ void TilePyramid::clearAll() {
     fadingTiles = false;
     tiles.clear();
     renderedTiles.clear();
+    loadOrder.clear();
     cache.clear();
 }
 
@@ -23,6 +23,7 @@ class PaintParameters;
 class TransformState;
 class RenderLayer;
 class RenderedQueryOptions;
+class RenderedQuerySnapshot;
 class SourceQueryOptions;
 class TileParameters;
 class SourcePrepareParameters;
@@ -58,6 +59,14 @@ public:
         const mat4& projMatrix,
         const mbgl::SourceFeatureState& featureState) const;
 
+    /// Adds the per-tile inputs of a rendered features query to `snapshot`,
+    /// so that the query can be completed off the render thread.
+    void snapshotRenderedFeatures(RenderedQuerySnapshot& snapshot,
+                                  const ScreenLineString& geometry,
+                                  const TransformState& transformState,
+                                  const mat4& projMatrix,
+                                  const std::shared_ptr<const SourceFeatureState>& featureState) const;
+
     std::vector<Feature> querySourceFeatures(const SourceQueryOptions&) const;
 
     void setCacheSize(size_t);
@@ -67,6 +76,10 @@ public:
     void dumpDebugLogs() const;
 
     const std::map<OverscaledTileID, std::unique_ptr<Tile>>& getTiles() const { return tiles; }
+
+    /// Tiles wanted by the last update, in the order they were created and
+    /// requested (see TileLoadOrder).
+    const std::vector<OverscaledTileID>& getLoadOrder() const { return loadOrder; }
     void clearAll();
 
     void updateFadingTiles();
@@ -79,6 +92,7 @@ private:
     TileCache cache;
 
     std::map<UnwrappedTileID, std::reference_wrapper<Tile>> renderedTiles; // Sorted by tile id.
+    std::vector<OverscaledTileID> loadOrder;
     TileObserver* observer = nullptr;
 
     float prevLng = 0;
@@ -1,13 +1,16 @@
 #include <mbgl/shaders/gl/shader_program_gl.hpp>
 
 #include <mbgl/gl/defines.hpp>
+#include <mbgl/gl/program_binary_cache.hpp>
 #include <mbgl/gl/types.hpp>
 #include <mbgl/gl/vertex_attribute_gl.hpp>
 #include <mbgl/platform/gl_functions.hpp>
 #include <mbgl/programs/program_parameters.hpp>
 #include <mbgl/shaders/shader_manifest.hpp>
+#include <mbgl/util/logging.hpp>
 
 #include <cstring>
+#include <optional>
 #include <utility>
 
 namespace mbgl {
@@ -115,28 +118,62 @@ std::optional<uint32_t> ShaderProgramGL::getSamplerLocation(const StringIdentity
 
 std::shared_ptr<ShaderProgramGL> ShaderProgramGL::create(Context& context,
                                                          const ProgramParameters& programParameters,
-                                                         const std::string& /*name*/,
+                                                         const std::string& shaderName,
                                                          const std::string_view firstAttribName,
                                                          const std::string& vertexSource,
                                                          const std::string& fragmentSource,
                                                          const std::string& additionalDefines) noexcept(false) {
-    // throws on compile error
-    auto vertProg = context.createShader(
-        ShaderType::Vertex,
-        std::initializer_list<const char*>{
-            "#version 300 es\n",
-            programParameters.getDefinesString().c_str(),
-            additionalDefines.c_str(),
-            shaders::ShaderSource<shaders::BuiltIn::Prelude, gfx::Backend::Type::OpenGL>::vertex,
-            vertexSource.c_str()});
-    auto fragProg = context.createShader(
-        ShaderType::Fragment,
-        {"#version 300 es\n",
-         programParameters.getDefinesString().c_str(),
-         additionalDefines.c_str(),
-         shaders::ShaderSource<shaders::BuiltIn::Prelude, gfx::Backend::Type::OpenGL>::fragment,
-         fragmentSource.c_str()});
-    auto program = context.createProgram(vertProg, fragProg, firstAttribName.data());
+    const auto* vertexPrelude = shaders::ShaderSource<shaders::BuiltIn::Prelude, gfx::Backend::Type::OpenGL>::vertex;
+    const auto* fragmentPrelude =
+        shaders::ShaderSource<shaders::BuiltIn::Prelude, gfx::Backend::Type::OpenGL>::fragment;
+
+    std::optional<ProgramBinaryCache> cache;
+    uint64_t cacheKey = 0;
+    if (programParameters.getProgramCacheDir() && context.supportsBinaryPrograms()) {
+        cache.emplace(*programParameters.getProgramCacheDir(), context.getDriverDescription());
+        cacheKey = ProgramBinaryCache::key({programParameters.getDefinesString(),
+                                            additionalDefines,
+                                            vertexPrelude,
+                                            vertexSource,
+                                            fragmentPrelude,
+                                            fragmentSource,
+                                            firstAttribName});
+    }
+
+    std::optional<UniqueProgram> cached;
+    if (cache) {
+        if (auto entry = cache->load(cacheKey)) {
+            cached = context.createProgram(entry->format, entry->binary);
+            if (!cached) {
+                Log::Warning(Event::Shader, "Discarding cached program binary for " + shaderName);
+                cache->remove(cacheKey);
+            }
+        }
+    }
+
+    auto program = cached ? std::move(*cached) : [&] {
+        // throws on compile error
+        auto vertProg = context.createShader(ShaderType::Vertex,
+                                             std::initializer_list<const char*>{
+                                                 "#version 300 es\n",
+                                                 programParameters.getDefinesString().c_str(),
+                                                 additionalDefines.c_str(),
+                                                 vertexPrelude,
+                                                 vertexSource.c_str()});
+        auto fragProg = context.createShader(ShaderType::Fragment,
+                                             {"#version 300 es\n",
+                                              programParameters.getDefinesString().c_str(),
+                                              additionalDefines.c_str(),
+                                              fragmentPrelude,
+                                              fragmentSource.c_str()});
+        auto linked = context.createProgram(vertProg, fragProg, firstAttribName.data(), cache.has_value());
+        if (cache) {
+            if (auto binary = context.getBinaryProgram(linked)) {
+                cache->store(cacheKey, {binary->first, std::move(binary->second)});
+            }
+        }
+        return linked;
+    }();
 
     // GLES3.1
     // GLint numAttribs;
@@ -103,7 +103,7 @@ void SpriteLoader::emitSpriteLoadedIfComplete() {
         observer->onSpriteLoaded(std::move(result.images));
     };
 
-    threadPool->scheduleAndReplyValue(parseClosure, resultClosure);
+    threadPool->scheduleAndReplyValue(parseClosure, resultClosure, Scheduler::Priority::Low);
 }
 
 void SpriteLoader::setObserver(SpriteLoaderObserver* observer_) {
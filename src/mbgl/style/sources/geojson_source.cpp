@@ -62,6 +62,20 @@ void GeoJSONSource::setGeoJSONData(std::shared_ptr<GeoJSONData> geoJSONData) {
     observer->onSourceChanged(*this);
 }
 
+void GeoJSONSource::updateData(const GeoJSONDataDiff& diff) {
+    std::shared_ptr<GeoJSONData> updated;
+    if (auto data = impl().getData().lock()) {
+        updated = data->update(diff);
+        if (!updated) {
+            Log::Warning(Event::Style, "GeoJSON data of source '" + getID() + "' does not support updates");
+            return;
+        }
+    } else {
+        updated = GeoJSONData::create(diff.add, impl().getOptions());
+    }
+    setGeoJSONData(std::move(updated));
+}
+
 std::optional<std::string> GeoJSONSource::getURL() const {
     return url;
 }
@@ -1,7 +1,11 @@
 #include <mbgl/style/sources/geojson_source_impl.hpp>
+#include <mbgl/math/angles.hpp>
+#include <mbgl/math/clamp.hpp>
 #include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/cluster_index.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/feature.hpp>
+#include <mbgl/util/parallel.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/thread_pool.hpp>
 
@@ -11,23 +15,301 @@
 #endif
 
 #include <mapbox/geojsonvt.hpp>
-#include <supercluster.hpp>
+#include <mapbox/geometry/envelope.hpp>
 
 #ifdef _MSC_VER
 #pragma warning(pop)
 #endif
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include <map>
+#include <numeric>
 
 namespace mbgl {
 namespace style {
 
-class GeoJSONVTData final : public GeoJSONData {
+namespace {
+
+using Features = GeoJSONData::Features;
+using Box = mapbox::geometry::box<double>;
+
+// Features are sorted along a space-filling curve and split into partitions of
+// this size, each indexed on its own. Partitions are built in parallel, and an
+// update only rebuilds the partitions holding the features it changes.
+constexpr std::size_t partitionSize = 4096;
+
+// Partitions grown beyond this size by updates are split again.
+constexpr std::size_t maxPartitionSize = 2 * partitionSize;
+
+// Sort key of features without geometry, which go last.
+constexpr uint32_t noSpatialKey = std::numeric_limits<uint32_t>::max();
+
+// Upper bound of the individual boxes kept to find the tiles touched by an
+// update; larger updates fall back to a single box covering all of them.
+constexpr std::size_t maxChangedBoxes = 256;
+
+// Returns the bounds of the feature in normalized [0, 1] Mercator coordinates,
+// as used by GeoJSON-VT.
+std::optional<Box> projectedBounds(const GeoJSONFeature& feature) {
+    const Box box = mapbox::geometry::envelope(feature.geometry);
+    if (box.min.x > box.max.x || box.min.y > box.max.y) {
+        return std::nullopt;
+    }
+    const auto projectX = [](double lng) {
+        return lng / 360.0 + 0.5;
+    };
+    const auto projectY = [](double lat) {
+        const double sine = std::sin(util::deg2rad(util::clamp(lat, -util::LATITUDE_MAX, util::LATITUDE_MAX)));
+        const double y = 0.5 - 0.5 * std::log((1 + sine) / (1 - sine)) / util::M2PI;
+        return util::clamp(y, 0.0, 1.0);
+    };
+    return Box{{projectX(box.min.x), projectY(box.max.y)}, {projectX(box.max.x), projectY(box.min.y)}};
+}
+
+// Position of the center of the box along a Hilbert curve over the world.
+// Features close to each other along the curve are close on the map.
+uint32_t hilbertIndex(const Box& box) {
+    constexpr uint32_t n = 1u << 16;
+    const auto cell = [](double value) {
+        return static_cast<uint32_t>(util::clamp(value, 0.0, 1.0) * (n - 1));
+    };
+    uint32_t x = cell((box.min.x + box.max.x) / 2);
+    uint32_t y = cell((box.min.y + box.max.y) / 2);
+    uint32_t index = 0;
+    for (uint32_t s = n / 2; s > 0; s /= 2) {
+        const uint32_t rx = (x & s) > 0;
+        const uint32_t ry = (y & s) > 0;
+        index += s * s * ((3 * rx) ^ ry);
+        // Rotate the quadrant, so that the curve is continuous.
+        if (ry == 0) {
+            if (rx == 1) {
+                x = n - 1 - x;
+                y = n - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return index;
+}
+
+uint32_t spatialKey(const GeoJSONFeature& feature) {
+    auto bounds = projectedBounds(feature);
+    return bounds ? hilbertIndex(*bounds) : noSpatialKey;
+}
+
+// Features along with their position in the source. Tiles taken from several
+// partitions are merged back into this order, which decides draw order and
+// symbol priority.
+struct OrderedFeatures {
+    Features features;
+    std::vector<uint64_t> order;
+
+    void push_back(GeoJSONFeature feature, uint64_t position) {
+        features.push_back(std::move(feature));
+        order.push_back(position);
+    }
+};
+
+// Sorts the features along the curve and splits them into runs of at most
+// `partitionSize`, so that each partition covers a compact part of the map and
+// a tile only needs the few partitions around it. Features keep their source
+// order within a run.
+std::vector<OrderedFeatures> spatialChunks(OrderedFeatures input) {
+    std::vector<std::pair<uint32_t, std::size_t>> sorted(input.features.size());
+    for (std::size_t i = 0; i < input.features.size(); ++i) {
+        sorted[i] = {spatialKey(input.features[i]), i};
+    }
+    std::sort(sorted.begin(), sorted.end());
+
+    std::vector<OrderedFeatures> chunks((sorted.size() + partitionSize - 1) / partitionSize);
+    for (std::size_t c = 0; c < chunks.size(); ++c) {
+        const auto begin = sorted.begin() + c * partitionSize;
+        const auto end = sorted.begin() + std::min(sorted.size(), (c + 1) * partitionSize);
+        std::sort(begin, end, [&](const auto& a, const auto& b) {
+            return input.order[a.second] < input.order[b.second];
+        });
+        chunks[c].features.reserve(end - begin);
+        chunks[c].order.reserve(end - begin);
+        for (auto it = begin; it != end; ++it) {
+            chunks[c].push_back(std::move(input.features[it->second]), input.order[it->second]);
+        }
+    }
+    return chunks;
+}
+
+// Copy of the features with their position in the list as ID, so that tile
+// features can be traced back to the source feature.
+Features withPositionIDs(const Features& features) {
+    Features result = features;
+    for (std::size_t i = 0; i < result.size(); ++i) {
+        result[i].id = uint64_t(i);
+    }
+    return result;
+}
+
+void extend(Box& box, const Box& other) {
+    box.min.x = std::min(box.min.x, other.min.x);
+    box.min.y = std::min(box.min.y, other.min.y);
+    box.max.x = std::max(box.max.x, other.max.x);
+    box.max.y = std::max(box.max.y, other.max.y);
+}
+
+// Whether the box overlaps the given tile, including the tile buffer. Boxes
+// are also tested one world copy to either side, as GeoJSON-VT wraps features
+// crossing the antimeridian.
+bool intersectsTile(const Box& box, const CanonicalTileID& id, const double buffer) {
+    const double span = 1.0 / (1u << id.z);
+    const double padding = span * buffer;
+    const double minY = id.y * span - padding;
+    const double maxY = (id.y + 1) * span + padding;
+    if (box.max.y < minY || box.min.y > maxY) {
+        return false;
+    }
+    const double minX = id.x * span - padding;
+    const double maxX = (id.x + 1) * span + padding;
+    for (const double shift : {0.0, -1.0, 1.0}) {
+        if (box.max.x + shift >= minX && box.min.x + shift <= maxX) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Wraps a single geometry or feature into a collection, as GeoJSON-VT does.
+Features toFeatures(const GeoJSON& geoJSON) {
+    return geoJSON.match(
+        [](const mapbox::geometry::geometry<double>& geometry) { return Features{GeoJSONFeature{geometry}}; },
+        [](const GeoJSONFeature& feature) { return Features{feature}; },
+        [](const Features& features) { return features; });
+}
+
+// Applies the diff to a plain feature list. Features keep their position when replaced.
+Features applyDiff(const Features& features, const GeoJSONDataDiff& diff) {
+    std::map<FeatureIdentifier, std::size_t> indices;
+    Features result;
+    if (!diff.removeAll) {
+        result = features;
+        for (std::size_t i = 0; i < result.size(); ++i) {
+            if (!result[i].id.is<NullValue>()) {
+                indices[result[i].id] = i;
+            }
+        }
+    }
+
+    std::vector<bool> removed(result.size(), false);
+    for (const auto& id : diff.remove) {
+        auto it = indices.find(id);
+        if (it != indices.end()) {
+            removed[it->second] = true;
+            indices.erase(it);
+        }
+    }
+    for (const auto& feature : diff.add) {
+        auto it = feature.id.is<NullValue>() ? indices.end() : indices.find(feature.id);
+        if (it != indices.end()) {
+            result[it->second] = feature;
+        } else {
+            if (!feature.id.is<NullValue>()) {
+                indices[feature.id] = result.size();
+            }
+            result.push_back(feature);
+            removed.push_back(false);
+        }
+    }
+
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < result.size(); ++i) {
+        if (!removed[i]) {
+            if (kept != i) {
+                result[kept] = std::move(result[i]);
+            }
+            ++kept;
+        }
+    }
+    result.resize(kept);
+    return result;
+}
+
+} // namespace
+
+class GeoJSONVTData final : public GeoJSONData, public std::enable_shared_from_this<GeoJSONVTData> {
+    // A run of the source features along the curve, with its own GeoJSON-VT
+    // index. Partitions are immutable apart from the index, which GeoJSON-VT
+    // fills lazily and which is therefore only accessed on the worker scheduler.
+    // Data objects created through `update()` share partitions and scheduler.
+    // The index is built with the position of each feature as its ID, which
+    // `getTile()` replaces with the ID of the source feature.
+    class Partition {
+    public:
+        Partition(OrderedFeatures features_, const mapbox::geojsonvt::Options& options)
+            : features(std::move(features_.features)),
+              order(std::move(features_.order)),
+              index(withPositionIDs(features), options) {
+            assert(features.size() == order.size());
+            for (std::size_t i = 0; i < features.size(); ++i) {
+                const auto& feature = features[i];
+                if (!feature.id.is<NullValue>()) {
+                    ids[feature.id] = i;
+                }
+                if (auto featureBounds = projectedBounds(feature)) {
+                    firstKey = std::min(firstKey, hilbertIndex(*featureBounds));
+                    if (bounds) {
+                        extend(*bounds, *featureBounds);
+                    } else {
+                        bounds = featureBounds;
+                    }
+                }
+            }
+        }
+
+        const Features features;
+        const std::vector<uint64_t> order; // Position of each feature in the source.
+        std::map<FeatureIdentifier, std::size_t> ids;
+        std::optional<Box> bounds;
+        uint32_t firstKey = noSpatialKey; // Partitions are ordered by it.
+        mapbox::geojsonvt::GeoJSONVT index; // Accessed on worker thread.
+    };
+
+    using Partitions = std::vector<std::shared_ptr<Partition>>;
+
     void getTile(const CanonicalTileID& id, const std::function<void(TileFeatures)>& fn) final {
         assert(fn);
+        Partitions tilePartitions;
+        for (const auto& partition : partitions) {
+            if (partition->bounds && intersectsTile(*partition->bounds, id, buffer)) {
+                tilePartitions.push_back(partition);
+            }
+        }
         scheduler->scheduleAndReplyValue(
-            [id, geoJSONVT_impl = this->impl]() -> TileFeatures {
-                return geoJSONVT_impl->getTile(id.z, id.x, id.y).features;
+            [id, tilePartitions = std::move(tilePartitions)]() -> TileFeatures {
+                if (tilePartitions.size() == 1) {
+                    const auto& partition = *tilePartitions.front();
+                    TileFeatures result = partition.index.getTile(id.z, id.x, id.y).features;
+                    for (auto& feature : result) {
+                        feature.id = partition.features[feature.id.get<uint64_t>()].id;
+                    }
+                    return result;
+                }
+                // Features of each partition are in source order, merge them back into it.
+                std::vector<std::pair<uint64_t, TileFeatures::value_type>> merged;
+                for (const auto& partition : tilePartitions) {
+                    for (const auto& feature : partition->index.getTile(id.z, id.x, id.y).features) {
+                        const auto position = feature.id.get<uint64_t>();
+                        merged.emplace_back(partition->order[position], feature);
+                        merged.back().second.id = partition->features[position].id;
+                    }
+                }
+                std::stable_sort(merged.begin(), merged.end(), [](const auto& a, const auto& b) {
+                    return a.first < b.first;
+                });
+                TileFeatures result;
+                result.reserve(merged.size());
+                for (auto& entry : merged) {
+                    result.push_back(std::move(entry.second));
+                }
+                return result;
             },
             fn);
     }
@@ -40,39 +322,288 @@ class GeoJSONVTData final : public GeoJSONData {
 
     std::shared_ptr<Scheduler> getScheduler() final { return scheduler; }
 
+    std::shared_ptr<GeoJSONData> update(const GeoJSONDataDiff& diff) final {
+        if (options->cluster) {
+            // The source may only have been left unclustered because it was empty.
+            std::vector<std::pair<uint64_t, const GeoJSONFeature*>> sorted;
+            for (const auto& partition : partitions) {
+                for (std::size_t i = 0; i < partition->features.size(); ++i) {
+                    sorted.emplace_back(partition->order[i], &partition->features[i]);
+                }
+            }
+            std::sort(sorted.begin(), sorted.end());
+            Features features;
+            features.reserve(sorted.size());
+            for (const auto& entry : sorted) {
+                features.push_back(*entry.second);
+            }
+            return GeoJSONData::create(applyDiff(features, diff), options, scheduler);
+        }
+
+        auto result = std::shared_ptr<GeoJSONVTData>(new GeoJSONVTData(options, vtOptions, scheduler));
+        result->previous = weak_from_this();
+        result->nextPosition = nextPosition;
+        if (diff.removeAll) {
+            result->allChanged = true;
+        } else {
+            result->partitions = partitions;
+        }
+
+        // Changes per partition: a replacement feature, or nullopt for removal.
+        std::map<std::size_t, std::map<FeatureIdentifier, std::optional<GeoJSONFeature>>> changes;
+        OrderedFeatures appended;
+        std::map<FeatureIdentifier, std::size_t> appendedIDs;
+
+        const auto find = [&](const FeatureIdentifier& id) -> std::optional<std::size_t> {
+            for (std::size_t i = 0; i < result->partitions.size(); ++i) {
+                const auto& ids = result->partitions[i]->ids;
+                if (ids.find(id) != ids.end()) {
+                    return i;
+                }
+            }
+            return std::nullopt;
+        };
+        const auto changeExisting = [&](std::size_t index, const FeatureIdentifier& id) {
+            const auto& partition = *result->partitions[index];
+            result->addChangedFeature(partition.features[partition.ids.at(id)]);
+        };
+
+        const auto removed = [&](std::size_t index, const FeatureIdentifier& id) {
+            auto partitionChanges = changes.find(index);
+            if (partitionChanges == changes.end()) {
+                return false;
+            }
+            auto change = partitionChanges->second.find(id);
+            return change != partitionChanges->second.end() && !change->second;
+        };
+
+        // Removals are applied first, so a diff may remove and re-add the same
+        // feature. Re-added features move to the end of the source, replaced
+        // ones keep their position.
+        for (const auto& id : diff.remove) {
+            if (auto index = find(id)) {
+                auto& partitionChanges = changes[*index];
+                if (partitionChanges.find(id) == partitionChanges.end()) {
+                    changeExisting(*index, id);
+                }
+                partitionChanges[id] = std::nullopt;
+            }
+        }
+        for (const auto& feature : diff.add) {
+            result->addChangedFeature(feature);
+            if (feature.id.is<NullValue>()) {
+                appended.push_back(feature, result->nextPosition++);
+            } else if (auto it = appendedIDs.find(feature.id); it != appendedIDs.end()) {
+                appended.features[it->second] = feature;
+            } else if (auto index = find(feature.id); index && !removed(*index, feature.id)) {
+                auto& partitionChanges = changes[*index];
+                if (partitionChanges.find(feature.id) == partitionChanges.end()) {
+                    changeExisting(*index, feature.id);
+                }
+                partitionChanges[feature.id] = feature;
+            } else {
+                appendedIDs[feature.id] = appended.features.size();
+                appended.push_back(feature, result->nextPosition++);
+            }
+        }
+
+        // Collect the feature lists of every partition that needs rebuilding.
+        std::map<std::size_t, OrderedFeatures> rebuilds;
+        const auto rebuild = [&](std::size_t index) -> OrderedFeatures& {
+            auto it = rebuilds.find(index);
+            if (it == rebuilds.end()) {
+                const auto& partition = *result->partitions[index];
+                it = rebuilds.emplace(index, OrderedFeatures{partition.features, partition.order}).first;
+            }
+            return it->second;
+        };
+        for (const auto& entry : changes) {
+            const auto& partitionChanges = entry.second;
+            const auto& partition = *result->partitions[entry.first];
+            OrderedFeatures& features = rebuilds[entry.first];
+            for (std::size_t i = 0; i < partition.features.size(); ++i) {
+                const auto& feature = partition.features[i];
+                auto change = feature.id.is<NullValue>() ? partitionChanges.end() : partitionChanges.find(feature.id);
+                if (change == partitionChanges.end()) {
+                    features.push_back(feature, partition.order[i]);
+                } else if (change->second) {
+                    features.push_back(*change->second, partition.order[i]);
+                }
+            }
+        }
+
+        // New features go to the partition covering their place along the curve.
+        OrderedFeatures unplaced;
+        for (std::size_t i = 0; i < appended.features.size(); ++i) {
+            auto& feature = appended.features[i];
+            if (result->partitions.empty()) {
+                unplaced.push_back(std::move(feature), appended.order[i]);
+                continue;
+            }
+            auto it = std::upper_bound(result->partitions.begin(),
+                                       result->partitions.end(),
+                                       spatialKey(feature),
+                                       [](uint32_t key, const auto& partition) { return key < partition->firstKey; });
+            const std::size_t index = it == result->partitions.begin() ? 0 : it - result->partitions.begin() - 1;
+            rebuild(index).push_back(std::move(feature), appended.order[i]);
+        }
+
+        Partitions kept;
+        for (std::size_t i = 0; i < result->partitions.size(); ++i) {
+            if (rebuilds.find(i) == rebuilds.end()) {
+                kept.push_back(result->partitions[i]);
+            }
+        }
+        std::vector<OrderedFeatures> built;
+        const auto addChunks = [&](OrderedFeatures features) {
+            for (auto& chunk : spatialChunks(std::move(features))) {
+                built.push_back(std::move(chunk));
+            }
+        };
+        for (auto& entry : rebuilds) {
+            if (entry.second.features.size() > maxPartitionSize) {
+                addChunks(std::move(entry.second));
+            } else if (!entry.second.features.empty()) {
+                built.push_back(std::move(entry.second));
+            }
+        }
+        addChunks(std::move(unplaced));
+
+        result->partitions = std::move(kept);
+        const std::size_t first = result->partitions.size();
+        result->partitions.resize(first + built.size());
+        util::parallelFor(*Scheduler::GetBackground(), built.size(), [&](const std::size_t i) {
+            result->partitions[first + i] = std::make_shared<Partition>(std::move(built[i]), vtOptions);
+        });
+        std::stable_sort(result->partitions.begin(), result->partitions.end(), [](const auto& a, const auto& b) {
+            return a->firstKey < b->firstKey;
+        });
+        return result;
+    }
+
+    bool isTileChanged(const GeoJSONData& previous_, const CanonicalTileID& id) const final {
+        auto base = previous.lock();
+        if (allChanged || base.get() != &previous_) {
+            return true;
+        }
+        return std::any_of(changedBounds.begin(), changedBounds.end(), [&](const Box& box) {
+            return intersectsTile(box, id, buffer);
+        });
+    }
+
+    void addChangedFeature(const GeoJSONFeature& feature) {
+        auto bounds = projectedBounds(feature);
+        if (!bounds) {
+            return;
+        }
+        if (changedBounds.size() < maxChangedBoxes) {
+            changedBounds.push_back(*bounds);
+            return;
+        }
+        for (std::size_t i = 1; i < changedBounds.size(); ++i) {
+            extend(changedBounds.front(), changedBounds[i]);
+        }
+        changedBounds.resize(1);
+        extend(changedBounds.front(), *bounds);
+    }
+
     friend GeoJSONData;
-    GeoJSONVTData(const GeoJSON& geoJSON,
-                  const mapbox::geojsonvt::Options& options,
+    GeoJSONVTData(Immutable<GeoJSONOptions> options_,
+                  const mapbox::geojsonvt::Options& vtOptions_,
                   std::shared_ptr<Scheduler> scheduler_)
-        : impl(std::make_shared<mapbox::geojsonvt::GeoJSONVT>(geoJSON, options)),
+        : options(std::move(options_)),
+          vtOptions(vtOptions_),
+          buffer(static_cast<double>(vtOptions.buffer) / vtOptions.extent),
           scheduler(std::move(scheduler_)) {
         assert(scheduler);
     }
 
-    std::shared_ptr<mapbox::geojsonvt::GeoJSONVT> impl; // Accessed on worker thread.
+    GeoJSONVTData(const Features& features,
+                  Immutable<GeoJSONOptions> options_,
+                  const mapbox::geojsonvt::Options& vtOptions_,
+                  std::shared_ptr<Scheduler> scheduler_)
+        : GeoJSONVTData(std::move(options_), vtOptions_, std::move(scheduler_)) {
+        OrderedFeatures ordered{features, std::vector<uint64_t>(features.size())};
+        std::iota(ordered.order.begin(), ordered.order.end(), uint64_t(0));
+        nextPosition = features.size();
+        auto chunks = spatialChunks(std::move(ordered));
+        partitions.resize(chunks.size());
+        util::parallelFor(*Scheduler::GetBackground(), partitions.size(), [&](const std::size_t i) {
+            partitions[i] = std::make_shared<Partition>(std::move(chunks[i]), vtOptions);
+        });
+    }
+
+    Immutable<GeoJSONOptions> options;
+    mapbox::geojsonvt::Options vtOptions;
+    double buffer; // Tile buffer as a fraction of the tile size.
     std::shared_ptr<Scheduler> scheduler;
+    Partitions partitions;
+    uint64_t nextPosition = 0; // Source position of the next appended feature.
+
+    // The data this one was updated from, and the bounds of the features that changed.
+    std::weak_ptr<const GeoJSONData> previous;
+    std::vector<Box> changedBounds;
+    bool allChanged = false;
 };
 
-class SuperclusterData final : public GeoJSONData {
+class SuperclusterData final : public GeoJSONData, public std::enable_shared_from_this<SuperclusterData> {
     void getTile(const CanonicalTileID& id, const std::function<void(TileFeatures)>& fn) final {
         assert(fn);
-        fn(impl.getTile(id.z, id.x, id.y));
+        fn(index->getTile(id.z, id.x, id.y));
     }
 
-    Features getChildren(const std::uint32_t cluster_id) final { return impl.getChildren(cluster_id); }
+    Features getChildren(const std::uint32_t cluster_id) final { return index->getChildren(cluster_id); }
 
     Features getLeaves(const std::uint32_t cluster_id, const std::uint32_t limit, const std::uint32_t offset) final {
-        return impl.getLeaves(cluster_id, limit, offset);
+        return index->getLeaves(cluster_id, limit, offset);
     }
 
     std::uint8_t getClusterExpansionZoom(std::uint32_t cluster_id) final {
-        return impl.getClusterExpansionZoom(cluster_id);
+        return index->getClusterExpansionZoom(cluster_id);
+    }
+
+    // Small updates are applied to the index in place; once the updated points
+    // make up a large share of the index, clusters are rebuilt from scratch, as
+    // incrementally maintained clusters drift from what a rebuild would produce.
+    std::shared_ptr<GeoJSONData> update(const GeoJSONDataDiff& diff) final {
+        const std::size_t changes = diff.remove.size() + diff.add.size();
+        if (diff.removeAll || (index->getUpdateCount() + changes) * 4 > index->size()) {
+            return GeoJSONData::create(applyDiff(index->getFeatures(), diff), options);
+        }
+
+        // The update goes to a copy of the index, so data handed out earlier
+        // stays as it is. Only tiles overlapping the changed bounds are reloaded.
+        ClusterIndex::ChangedBounds changed;
+        auto updated = index->update(diff.remove, diff.add, &changed);
+        auto result = std::shared_ptr<SuperclusterData>(new SuperclusterData(std::move(updated), options, radius));
+        result->previous = shared_from_this();
+        result->changedBounds = std::move(changed);
+        return result;
+    }
+
+    bool isTileChanged(const GeoJSONData& previous_, const CanonicalTileID& id) const final {
+        auto base = previous.lock();
+        if (base.get() != &previous_) {
+            return true;
+        }
+        const auto zoom = util::clamp<uint8_t>(id.z, 0, options->clusterMaxZoom + 1);
+        auto it = changedBounds.find(zoom);
+        return it != changedBounds.end() && intersectsTile(it->second, id, radius);
     }
 
     friend GeoJSONData;
-    SuperclusterData(const Features& features, const mapbox::supercluster::Options& options)
-        : impl(features, options) {}
-    mapbox::supercluster::Supercluster impl;
+    SuperclusterData(std::shared_ptr<const ClusterIndex> index_, Immutable<GeoJSONOptions> options_, double radius_)
+        : index(std::move(index_)),
+          options(std::move(options_)),
+          radius(radius_) {}
+
+    std::shared_ptr<const ClusterIndex> index;
+    Immutable<GeoJSONOptions> options;
+    double radius; // Cluster radius as a fraction of the tile size.
+
+    // The data this one was updated from, and the bounds of the clusters that changed.
+    std::weak_ptr<const GeoJSONData> previous;
+    ClusterIndex::ChangedBounds changedBounds;
 };
 
 template <class T>
@@ -95,31 +626,52 @@ std::shared_ptr<GeoJSONData> GeoJSONData::create(const GeoJSON& geoJSON,
                                                  std::shared_ptr<Scheduler> scheduler) {
     constexpr double scale = util::EXTENT / util::tileSize_D;
     if (options->cluster && geoJSON.is<Features>() && !geoJSON.get<Features>().empty()) {
-        mapbox::supercluster::Options clusterOptions;
+        ClusterIndex::Options clusterOptions;
         clusterOptions.maxZoom = options->clusterMaxZoom;
         clusterOptions.extent = util::EXTENT;
         clusterOptions.radius = static_cast<uint16_t>(::round(scale * options->clusterRadius));
-        auto feature = std::make_shared<Feature>();
-        clusterOptions.map = [feature, options](const PropertyMap& properties) -> PropertyMap {
-            PropertyMap ret{};
-            if (properties.empty()) return ret;
-            for (const auto& p : options->clusterProperties) {
-                feature->properties = properties;
-                ret[p.first] = evaluateFeature<Value>(*feature, p.second.first);
-            }
-            return ret;
-        };
-        clusterOptions.reduce = [feature, options](PropertyMap& toReturn, const PropertyMap& toFill) {
-            for (const auto& p : options->clusterProperties) {
-                if (toFill.count(p.first) == 0) {
-                    continue;
+        // Cluster properties are computed on several threads at once, so each
+        // call evaluates the expressions against its own features. Each
+        // expression is evaluated over the whole batch before the next one.
+        if (!options->clusterProperties.empty()) {
+            clusterOptions.map = [options](const std::vector<const PropertyMap*>& points) {
+                std::vector<Feature> features(points.size());
+                for (std::size_t i = 0; i < points.size(); ++i) {
+                    features[i].properties = *points[i];
                 }
-                feature->properties = toFill;
-                std::optional<Value> accumulated(toReturn[p.first]);
-                toReturn[p.first] = evaluateFeature<Value>(*feature, p.second.second, accumulated);
-            }
-        };
-        return std::shared_ptr<GeoJSONData>(new SuperclusterData(geoJSON.get<Features>(), clusterOptions));
+                std::vector<PropertyMap> ret(points.size());
+                for (const auto& p : options->clusterProperties) {
+                    for (std::size_t i = 0; i < features.size(); ++i) {
+                        if (!features[i].properties.empty()) {
+                            ret[i][p.first] = evaluateFeature<Value>(features[i], p.second.first);
+                        }
+                    }
+                }
+                return ret;
+            };
+            clusterOptions.reduce = [options](std::vector<PropertyMap>& clusters,
+                                              const std::vector<ClusterIndex::Options::Member>& members) {
+                std::vector<Feature> features(members.size());
+                for (std::size_t i = 0; i < members.size(); ++i) {
+                    features[i].properties = *members[i].second;
+                }
+                // Members of a cluster are merged in order for every property, which
+                // only depends on the accumulated value of that same property.
+                for (const auto& p : options->clusterProperties) {
+                    for (std::size_t i = 0; i < members.size(); ++i) {
+                        if (features[i].properties.count(p.first) == 0) {
+                            continue;
+                        }
+                        PropertyMap& toReturn = clusters[members[i].first];
+                        std::optional<Value> accumulated(toReturn[p.first]);
+                        toReturn[p.first] = evaluateFeature<Value>(features[i], p.second.second, accumulated);
+                    }
+                }
+            };
+        }
+        const double radius = static_cast<double>(clusterOptions.radius) / clusterOptions.extent;
+        return std::shared_ptr<GeoJSONData>(new SuperclusterData(
+            std::make_shared<ClusterIndex>(geoJSON.get<Features>(), std::move(clusterOptions)), options, radius));
     }
 
     mapbox::geojsonvt::Options vtOptions;
@@ -129,7 +681,12 @@ std::shared_ptr<GeoJSONData> GeoJSONData::create(const GeoJSON& geoJSON,
     vtOptions.tolerance = scale * options->tolerance;
     vtOptions.lineMetrics = options->lineMetrics;
     if (!scheduler) scheduler = Scheduler::GetSequenced();
-    return std::shared_ptr<GeoJSONData>(new GeoJSONVTData(geoJSON, vtOptions, std::move(scheduler)));
+    if (geoJSON.is<Features>()) {
+        return std::shared_ptr<GeoJSONData>(
+            new GeoJSONVTData(geoJSON.get<Features>(), options, vtOptions, std::move(scheduler)));
+    }
+    return std::shared_ptr<GeoJSONData>(
+        new GeoJSONVTData(toFeatures(geoJSON), options, vtOptions, std::move(scheduler)));
 }
 
 GeoJSONSource::Impl::Impl(std::string id_, Immutable<GeoJSONOptions> options_)
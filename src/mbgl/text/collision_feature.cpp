@@ -3,6 +3,9 @@
 #include <mbgl/math/angles.hpp>
 #include <mbgl/math/log2.hpp>
 
+#include <algorithm>
+#include <cmath>
+
 namespace mbgl {
 
 CollisionFeature::CollisionFeature(const GeometryCoordinates& line,
@@ -15,11 +18,9 @@ CollisionFeature::CollisionFeature(const GeometryCoordinates& line,
                                    const float boxScale,
                                    const float padding,
                                    const style::SymbolPlacementType placement,
-                                   IndexedSubfeature indexedFeature_,
                                    const float overscaling,
                                    const float rotate)
-    : indexedFeature(std::move(indexedFeature_)),
-      alongLine(placement != style::SymbolPlacementType::Point) {
+    : alongLine(placement != style::SymbolPlacementType::Point) {
     if (top == 0 && bottom == 0 && left == 0 && right == 0) return;
 
     float y1 = top * boxScale - padding;
@@ -168,4 +169,27 @@ void CollisionFeature::bboxifyLabel(const GeometryCoordinates& line,
     }
 }
 
+void CollisionBounds::add(const Point<float>& anchor) {
+    minX = std::min(minX, anchor.x);
+    minY = std::min(minY, anchor.y);
+    maxX = std::max(maxX, anchor.x);
+    maxY = std::max(maxY, anchor.y);
+}
+
+void CollisionBounds::add(const CollisionFeature& feature) {
+    for (const auto& box : feature.boxes) {
+        add(box.anchor);
+        extent = std::max({extent, std::abs(box.x1), std::abs(box.y1), std::abs(box.x2), std::abs(box.y2)});
+    }
+}
+
+void CollisionBounds::add(const CollisionBounds& other) {
+    if (other.empty()) {
+        return;
+    }
+    add(Point<float>{other.minX, other.minY});
+    add(Point<float>{other.maxX, other.maxY});
+    extent = std::max(extent, other.extent);
+}
+
 } // namespace mbgl
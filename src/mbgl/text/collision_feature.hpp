@@ -5,6 +5,7 @@
 #include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/geometry/feature_index.hpp>
 
+#include <limits>
 #include <vector>
 
 namespace mbgl {
@@ -87,7 +88,6 @@ public:
                      const float boxScale,
                      const float padding,
                      const style::SymbolPlacementType placement,
-                     const IndexedSubfeature& indexedFeature_,
                      const float overscaling,
                      const float rotate)
         : CollisionFeature(line,
@@ -100,7 +100,6 @@ public:
                            boxScale,
                            padding,
                            placement,
-                           indexedFeature_,
                            overscaling,
                            rotate) {}
 
@@ -117,7 +116,6 @@ public:
                      std::optional<PositionedIcon> shapedIcon,
                      const float boxScale,
                      const float padding,
-                     const IndexedSubfeature& indexedFeature_,
                      const float rotate)
         : CollisionFeature(line,
                            anchor,
@@ -129,7 +127,6 @@ public:
                            boxScale,
                            padding,
                            style::SymbolPlacementType::Point,
-                           indexedFeature_,
                            1,
                            rotate) {}
 
@@ -143,12 +140,10 @@ public:
                      float boxScale,
                      float padding,
                      style::SymbolPlacementType,
-                     IndexedSubfeature,
                      float overscaling,
                      float rotate);
 
     std::vector<CollisionBox> boxes;
-    IndexedSubfeature indexedFeature;
     bool alongLine;
 
 private:
@@ -160,4 +155,27 @@ private:
                       float overscaling);
 };
 
+/**
+ Bounds of the collision boxes of a group of symbols, in tile units.
+
+ The boxes are anchored within [minX, maxX] x [minY, maxY] and reach no
+ further than `extent` from their anchors, before they are scaled to the
+ viewport. Used to tell that a whole group is out of view without projecting
+ any of its boxes.
+ */
+class CollisionBounds {
+public:
+    void add(const Point<float>& anchor);
+    void add(const CollisionFeature&);
+    void add(const CollisionBounds&);
+
+    bool empty() const { return minX > maxX; }
+
+    float minX = std::numeric_limits<float>::infinity();
+    float minY = std::numeric_limits<float>::infinity();
+    float maxX = -std::numeric_limits<float>::infinity();
+    float maxY = -std::numeric_limits<float>::infinity();
+    float extent = 0;
+};
+
 } // namespace mbgl
@@ -12,7 +12,9 @@
 
 #include <mbgl/renderer/buckets/symbol_bucket.hpp> // For PlacedSymbol: pull out to another location
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 namespace mbgl {
 
@@ -93,6 +95,46 @@ CollisionBoundaries CollisionIndex::projectTileBoundaries(const mat4& posMatrix)
     return {{topLeft.x, topLeft.y, bottomRight.x, bottomRight.y}};
 }
 
+bool CollisionIndex::isCulled(const CollisionBounds& bounds, const mat4& posMatrix, float textPixelRatio) const {
+    if (bounds.empty()) {
+        return false;
+    }
+
+    // The anchors project within the bounding box of the projected corners, as
+    // long as none of the corners is behind the camera.
+    const auto size = transformState.getSize();
+    CollisionBoundaries projected{{std::numeric_limits<float>::infinity(),
+                                   std::numeric_limits<float>::infinity(),
+                                   -std::numeric_limits<float>::infinity(),
+                                   -std::numeric_limits<float>::infinity()}};
+    double minW = std::numeric_limits<double>::infinity();
+    for (const auto& corner : {Point<float>{bounds.minX, bounds.minY},
+                               Point<float>{bounds.maxX, bounds.minY},
+                               Point<float>{bounds.minX, bounds.maxY},
+                               Point<float>{bounds.maxX, bounds.maxY}}) {
+        vec4 p = {{corner.x, corner.y, 0, 1}};
+        matrix::transformMat4(p, p, posMatrix);
+        if (p[3] <= 0) {
+            return false;
+        }
+        minW = std::min(minW, p[3]);
+        const auto x = static_cast<float>((((p[0] / p[3] + 1) / 2) * size.width) + viewportPadding);
+        const auto y = static_cast<float>((((-p[1] / p[3] + 1) / 2) * size.height) + viewportPadding);
+        projected = {{std::min(projected[0], x),
+                      std::min(projected[1], y),
+                      std::max(projected[2], x),
+                      std::max(projected[3], y)}};
+    }
+
+    // Boxes are scaled by the perspective ratio of their anchors, which is the
+    // largest for the closest anchor. One more pixel covers rounding.
+    const float perspectiveRatio = 0.5f +
+                                   0.5f * transformState.getCameraToCenterDistance() / static_cast<float>(minW);
+    const float margin = bounds.extent * textPixelRatio * perspectiveRatio + 1;
+    return !isInsideGrid(
+        {{projected[0] - margin, projected[1] - margin, projected[2] + margin, projected[3] + margin}});
+}
+
 // The tile border checks below are only well defined when the tile boundaries
 // are axis-aligned We are relying on it only being used in MapMode::Tile, where
 // that is always the case
@@ -329,6 +371,7 @@ std::pair<bool, bool> CollisionIndex::placeLineFeature(
 }
 
 void CollisionIndex::insertFeature(const CollisionFeature& feature,
+                                   const IndexedSubfeature& indexedFeature,
                                    const std::vector<ProjectedCollisionBox>& projectedBoxes,
                                    bool ignorePlacement,
                                    uint32_t bucketInstanceId,
@@ -340,10 +383,10 @@ void CollisionIndex::insertFeature(const CollisionFeature& feature,
             }
 
             if (ignorePlacement) {
-                ignoredGrid.insert(IndexedSubfeature(feature.indexedFeature, bucketInstanceId, collisionGroupId),
+                ignoredGrid.insert(IndexedSubfeature(indexedFeature, bucketInstanceId, collisionGroupId),
                                    circle.circle());
             } else {
-                collisionGrid.insert(IndexedSubfeature(feature.indexedFeature, bucketInstanceId, collisionGroupId),
+                collisionGrid.insert(IndexedSubfeature(indexedFeature, bucketInstanceId, collisionGroupId),
                                      circle.circle());
             }
         }
@@ -352,15 +395,20 @@ void CollisionIndex::insertFeature(const CollisionFeature& feature,
         auto& box = projectedBoxes[0];
         assert(box.isBox());
         if (ignorePlacement) {
-            ignoredGrid.insert(IndexedSubfeature(feature.indexedFeature, bucketInstanceId, collisionGroupId),
+            ignoredGrid.insert(IndexedSubfeature(indexedFeature, bucketInstanceId, collisionGroupId),
                                box.box());
         } else {
-            collisionGrid.insert(IndexedSubfeature(feature.indexedFeature, bucketInstanceId, collisionGroupId),
+            collisionGrid.insert(IndexedSubfeature(indexedFeature, bucketInstanceId, collisionGroupId),
                                  box.box());
         }
     }
 }
 
+void CollisionIndex::insertFixedBox(const mapbox::geometry::box<float>& box, uint16_t collisionGroupId) {
+    // Symbol buckets count their instances from 1, so bucket 0 is never queried.
+    collisionGrid.insert(IndexedSubfeature(IndexedSubfeature(0, {}, {}, 0), 0, collisionGroupId), box);
+}
+
 bool polygonIntersectsBox(const LineString<float>& polygon, const GridIndex<IndexedSubfeature>::BBox& bbox) {
     // This is just a wrapper that allows us to use the integer-based
     // util::polygonIntersectsPolygon Conversion limits our query accuracy to
@@ -405,6 +453,9 @@ std::unordered_map<uint32_t, std::vector<IndexedSubfeature>> CollisionIndex::que
         auto& feature = queryResult.first;
         auto& bbox = queryResult.second;
 
+        // Skip boxes of fixed symbols.
+        if (feature.bucketInstanceId == 0) continue;
+
         // Skip already seen features.
         auto& seenFeatures = seenBuckets[feature.bucketInstanceId];
         if (seenFeatures.find(feature.index) != seenFeatures.end()) continue;
@@ -53,17 +53,29 @@ public:
     );
 
     void insertFeature(const CollisionFeature& feature,
+                       const IndexedSubfeature& indexedFeature,
                        const std::vector<ProjectedCollisionBox>&,
                        bool ignorePlacement,
                        uint32_t bucketInstanceId,
                        uint16_t collisionGroupId);
 
+    /// Inserts a box taken by a symbol outside of the placed buckets. Other
+    /// symbols collide with it, but rendered symbol queries don't return it.
+    void insertFixedBox(const mapbox::geometry::box<float>&, uint16_t collisionGroupId);
+
     std::unordered_map<uint32_t, std::vector<IndexedSubfeature>> queryRenderedSymbols(const ScreenLineString&) const;
 
     CollisionBoundaries projectTileBoundaries(const mat4& posMatrix) const;
 
+    /// Returns whether all of the collision boxes within the bounds fall outside of the grid,
+    /// in which case `placeFeature` fails for each of them. Only holds for boxes placed without shift.
+    bool isCulled(const CollisionBounds&, const mat4& posMatrix, float textPixelRatio) const;
+
     const TransformState& getTransformState() const { return transformState; }
 
+    /// Projects a point of the tile to the coordinates of the collision boxes.
+    Point<float> projectPoint(const mat4& posMatrix, const Point<float>& point) const;
+
     float getViewportPadding() const { return viewportPadding; }
 
 private:
@@ -97,7 +109,6 @@ private:
     std::pair<float, float> projectAnchor(const mat4& posMatrix, const Point<float>& point) const;
     std::pair<Point<float>, float> projectAndGetPerspectiveRatio(const mat4& posMatrix,
                                                                  const Point<float>& point) const;
-    Point<float> projectPoint(const mat4& posMatrix, const Point<float>& point) const;
     CollisionBoundaries getProjectedCollisionBoundaries(const mat4& posMatrix,
                                                         Point<float> shift,
                                                         float textPixelRatio,
@@ -15,7 +15,7 @@ TileLayerIndex::TileLayerIndex(OverscaledTileID coord_,
       bucketLeaderId(std::move(bucketLeaderId_)) {
     for (SymbolInstance& symbolInstance : symbolInstances) {
         if (symbolInstance.crossTileID == SymbolInstance::invalidCrossTileID()) continue;
-        indexedSymbolInstances[symbolInstance.key].emplace_back(symbolInstance.crossTileID,
+        indexedSymbolInstances[symbolInstance.key()].emplace_back(symbolInstance.crossTileID,
                                                                 getScaledCoordinates(symbolInstance, coord));
     }
 }
@@ -47,7 +47,7 @@ void TileLayerIndex::findMatches(SymbolBucket& bucket,
             continue;
         }
 
-        auto it = indexedSymbolInstances.find(symbolInstance.key);
+        auto it = indexedSymbolInstances.find(symbolInstance.key());
         if (it == indexedSymbolInstances.end()) {
             // No symbol with this key in this bucket
             continue;
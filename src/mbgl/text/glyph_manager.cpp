@@ -1,10 +1,15 @@
+#include <mbgl/actor/scheduler.hpp>
 #include <mbgl/storage/file_source.hpp>
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/response.hpp>
 #include <mbgl/text/glyph_manager.hpp>
 #include <mbgl/text/glyph_manager_observer.hpp>
+#include <mbgl/text/glyph_pack.hpp>
 #include <mbgl/text/glyph_pbf.hpp>
+#include <mbgl/text/shaping_cache.hpp>
 #include <mbgl/util/async_request.hpp>
+#include <mbgl/util/logging.hpp>
+#include <mbgl/util/parallel.hpp>
 #include <mbgl/util/std.hpp>
 #include <mbgl/util/tiny_sdf.hpp>
 
@@ -14,10 +19,41 @@ static GlyphManagerObserver nullObserver;
 
 GlyphManager::GlyphManager(std::unique_ptr<LocalGlyphRasterizer> localGlyphRasterizer_)
     : observer(&nullObserver),
-      localGlyphRasterizer(std::move(localGlyphRasterizer_)) {}
+      localGlyphRasterizer(std::move(localGlyphRasterizer_)),
+      shapingCache(std::make_shared<ShapingCache>(ShapingCache::defaultMaxEntries)),
+      threadPool(Scheduler::GetBackground()) {}
 
 GlyphManager::~GlyphManager() = default;
 
+void GlyphManager::setURL(const std::string& url) {
+    if (url == glyphURL) {
+        return;
+    }
+    glyphURL = url;
+    shapingCache = std::make_shared<ShapingCache>(ShapingCache::defaultMaxEntries);
+
+    const std::string_view scheme = "file://";
+    const std::string_view extension = GlyphPack::fileExtension;
+    if (url.size() > scheme.size() + extension.size() && url.compare(0, scheme.size(), scheme) == 0 &&
+        url.compare(url.size() - extension.size(), extension.size(), extension) == 0) {
+        const std::string path = url.substr(scheme.size());
+        auto pack = GlyphPack::open(path);
+        if (!pack) {
+            Log::Warning(Event::Glyph, "Failed to open glyph pack " + path);
+        }
+        // Ranges missing from the pack come from the glyph URL of the style the pack was made for
+        rangeURL = pack ? std::string(pack->getGlyphURL()) : std::string();
+        setGlyphPack(std::move(pack));
+    } else {
+        rangeURL = url;
+        setGlyphPack(nullptr);
+    }
+}
+
+void GlyphManager::setGlyphPack(std::shared_ptr<const GlyphPack> glyphPack_) {
+    glyphPack = std::move(glyphPack_);
+}
+
 void GlyphManager::getGlyphs(GlyphRequestor& requestor, GlyphDependencies glyphDependencies, FileSource& fileSource) {
     auto dependencies = std::make_shared<GlyphDependencies>(std::move(glyphDependencies));
 
@@ -32,16 +68,22 @@ void GlyphManager::getGlyphs(GlyphRequestor& requestor, GlyphDependencies glyphD
 
         const GlyphIDs& glyphIDs = dependency.second;
         std::unordered_set<GlyphRange> ranges;
+        std::vector<GlyphID> localGlyphIDs;
         for (const auto& glyphID : glyphIDs) {
             if (localGlyphRasterizer->canRasterizeGlyph(fontStack, glyphID)) {
                 if (entry.glyphs.find(glyphID) == entry.glyphs.end()) {
-                    entry.glyphs.emplace(glyphID, makeMutable<Glyph>(generateLocalSDF(fontStack, glyphID)));
+                    localGlyphIDs.push_back(glyphID);
                 }
             } else {
                 ranges.insert(getGlyphRange(glyphID));
             }
         }
 
+        auto localGlyphs = generateLocalSDFs(fontStack, localGlyphIDs);
+        for (std::size_t i = 0; i < localGlyphs.size(); ++i) {
+            entry.glyphs.emplace(localGlyphIDs[i], makeMutable<Glyph>(std::move(localGlyphs[i])));
+        }
+
         for (const auto& range : ranges) {
             auto it = entry.ranges.find(range);
             if (it == entry.ranges.end() || !it->second.parsed) {
@@ -59,22 +101,45 @@ void GlyphManager::getGlyphs(GlyphRequestor& requestor, GlyphDependencies glyphD
     }
 }
 
-Glyph GlyphManager::generateLocalSDF(const FontStack& fontStack, GlyphID glyphID) {
-    Glyph local = localGlyphRasterizer->rasterizeGlyph(fontStack, glyphID);
-    local.bitmap = util::transformRasterToSDF(local.bitmap, 8, .25);
-    return local;
+std::vector<Glyph> GlyphManager::generateLocalSDFs(const FontStack& fontStack, const std::vector<GlyphID>& glyphIDs) {
+    // Platform rasterizers aren't thread safe, but the distance transforms, which
+    // take most of the time, are independent of each other.
+    std::vector<Glyph> glyphs;
+    glyphs.reserve(glyphIDs.size());
+    for (const GlyphID glyphID : glyphIDs) {
+        glyphs.push_back(localGlyphRasterizer->rasterizeGlyph(fontStack, glyphID));
+    }
+
+    util::parallelFor(*threadPool, glyphs.size(), [&glyphs](std::size_t i) {
+        glyphs[i].bitmap = util::transformRasterToSDF(glyphs[i].bitmap, 8, .25);
+    });
+    return glyphs;
 }
 
 void GlyphManager::requestRange(GlyphRequest& request,
                                 const FontStack& fontStack,
                                 const GlyphRange& range,
                                 FileSource& fileSource) {
-    if (request.req) {
+    if (request.req || request.parsing) {
+        return;
+    }
+
+    if (glyphPack) {
+        if (auto data = glyphPack->getRange(fontStack, range)) {
+            parseRange(fontStack, range, *data, glyphPack);
+            return;
+        }
+    }
+
+    if (rangeURL.empty()) {
+        observer->onGlyphsError(fontStack,
+                                range,
+                                std::make_exception_ptr(std::runtime_error("glyph range missing from the glyph pack")));
         return;
     }
 
     request.req = fileSource.request(
-        Resource::glyphs(glyphURL, fontStack, range),
+        Resource::glyphs(rangeURL, fontStack, range),
         [this, fontStack, range](const Response& res) { processResponse(res, fontStack, range); });
 }
 
@@ -88,25 +153,56 @@ void GlyphManager::processResponse(const Response& res, const FontStack& fontSta
         return;
     }
 
-    Entry& entry = entries[fontStack];
-    GlyphRequest& request = entry.ranges[range];
+    if (res.noContent) {
+        onRangeParsed(fontStack, range, {});
+        return;
+    }
 
-    if (!res.noContent) {
-        std::vector<Glyph> glyphs;
+    parseRange(fontStack, range, *res.data, res.data);
+}
+
+void GlyphManager::parseRange(const FontStack& fontStack,
+                              const GlyphRange& range,
+                              std::string_view data,
+                              std::shared_ptr<const void> owner) {
+    entries[fontStack].ranges[range].parsing = true;
 
+    // `owner` keeps `data` alive until it is parsed.
+    auto parse = [range, data, owner = std::move(owner)]() -> ParseResult {
+        ParseResult result;
         try {
-            glyphs = parseGlyphPBF(range, *res.data);
+            for (auto& glyph : parseGlyphPBF(range, data)) {
+                result.glyphs.emplace_back(makeMutable<Glyph>(std::move(glyph)));
+            }
         } catch (...) {
-            observer->onGlyphsError(fontStack, range, std::current_exception());
-            return;
+            result.error = std::current_exception();
         }
+        return result;
+    };
 
-        for (auto& glyph : glyphs) {
-            auto id = glyph.id;
-            if (!localGlyphRasterizer->canRasterizeGlyph(fontStack, id)) {
-                entry.glyphs.erase(id);
-                entry.glyphs.emplace(id, makeMutable<Glyph>(std::move(glyph)));
-            }
+    auto reply = [this, weak = weakFactory.makeWeakPtr(), fontStack, range](const ParseResult& result) {
+        if (!weak) return; // This instance has been deleted.
+        onRangeParsed(fontStack, range, result);
+    };
+
+    threadPool->scheduleAndReplyValue(parse, reply, Scheduler::Priority::Low);
+}
+
+void GlyphManager::onRangeParsed(const FontStack& fontStack, const GlyphRange& range, const ParseResult& result) {
+    Entry& entry = entries[fontStack];
+    GlyphRequest& request = entry.ranges[range];
+    request.parsing = false;
+
+    if (result.error) {
+        observer->onGlyphsError(fontStack, range, result.error);
+        return;
+    }
+
+    for (const auto& glyph : result.glyphs) {
+        auto id = glyph->id;
+        if (!localGlyphRasterizer->canRasterizeGlyph(fontStack, id)) {
+            entry.glyphs.erase(id);
+            entry.glyphs.emplace(id, glyph);
         }
     }
 
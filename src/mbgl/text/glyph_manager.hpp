@@ -7,14 +7,23 @@
 #include <mbgl/util/font_stack.hpp>
 #include <mbgl/util/immutable.hpp>
 
+#include <mapbox/std/weak.hpp>
+
+#include <exception>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 namespace mbgl {
 
 class FileSource;
 class AsyncRequest;
 class Response;
+class GlyphPack;
+class ShapingCache;
+class Scheduler;
 
 class GlyphRequestor {
 public:
@@ -36,11 +45,24 @@ public:
     // determined their `GlyphDependencies`. If all glyphs are already locally
     // available, GlyphManager will provide them to the requestor immediately.
     // Otherwise, it makes a request on the FileSource is made for each range
-    // needed, and notifies the observer when all are complete.
+    // needed, and notifies the observer when all are complete. Ranges found in
+    // the glyph pack are used without a request. Ranges are parsed on the
+    // background thread pool.
     void getGlyphs(GlyphRequestor&, GlyphDependencies, FileSource&);
     void removeRequestor(GlyphRequestor&);
 
-    void setURL(const std::string& url) { glyphURL = url; }
+    // A `file://` URL to a file with the glyph pack extension selects that pack.
+    // Ranges missing from it are requested from the glyph URL template that the
+    // pack recorded from its style. Any other URL is a template of the URL of
+    // each range.
+    void setURL(const std::string& url);
+    // Serves ranges from the pack before requesting them from the current URL template.
+    void setGlyphPack(std::shared_ptr<const GlyphPack>);
+
+    // Lines shaped with the glyphs of the current URL, for the symbol layouts of the
+    // tiles. Changing the URL starts a new cache, while layouts that are still
+    // working with the glyphs of the previous one keep theirs.
+    std::shared_ptr<ShapingCache> getShapingCache() const { return shapingCache; }
 
     void setObserver(GlyphManagerObserver*);
 
@@ -48,11 +70,14 @@ public:
     void evict(const std::set<FontStack>&);
 
 private:
-    Glyph generateLocalSDF(const FontStack& fontStack, GlyphID glyphID);
+    std::vector<Glyph> generateLocalSDFs(const FontStack& fontStack, const std::vector<GlyphID>& glyphIDs);
     std::string glyphURL;
+    // Template of the URL of the ranges that aren't in the glyph pack
+    std::string rangeURL;
 
     struct GlyphRequest {
         bool parsed = false;
+        bool parsing = false;
         std::unique_ptr<AsyncRequest> req;
         std::unordered_map<GlyphRequestor*, std::shared_ptr<GlyphDependencies>> requestors;
     };
@@ -66,11 +91,22 @@ private:
 
     void requestRange(GlyphRequest&, const FontStack&, const GlyphRange&, FileSource& fileSource);
     void processResponse(const Response&, const FontStack&, const GlyphRange&);
+    void parseRange(const FontStack&, const GlyphRange&, std::string_view data, std::shared_ptr<const void> owner);
+
+    struct ParseResult {
+        std::vector<Immutable<Glyph>> glyphs;
+        std::exception_ptr error;
+    };
+    void onRangeParsed(const FontStack&, const GlyphRange&, const ParseResult&);
     void notify(GlyphRequestor&, const GlyphDependencies&);
 
     GlyphManagerObserver* observer = nullptr;
 
     std::unique_ptr<LocalGlyphRasterizer> localGlyphRasterizer;
+    std::shared_ptr<const GlyphPack> glyphPack;
+    std::shared_ptr<ShapingCache> shapingCache;
+    std::shared_ptr<Scheduler> threadPool;
+    mapbox::base::WeakPtrFactory<GlyphManager> weakFactory{this};
 };
 
 } // namespace mbgl
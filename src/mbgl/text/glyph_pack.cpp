@@ -0,0 +1,167 @@
+#include <mbgl/text/glyph_pack.hpp>
+
+#include <mbgl/util/io.hpp>
+
+#include <cstring>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace mbgl {
+
+namespace {
+
+constexpr std::string_view magic = "MLNGPAK1";
+
+template <typename T>
+void append(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+class Reader {
+public:
+    explicit Reader(std::string_view data_)
+        : data(data_) {}
+
+    template <typename T>
+    bool read(T& value) {
+        if (data.size() < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, data.data(), sizeof(T));
+        data.remove_prefix(sizeof(T));
+        return true;
+    }
+
+    bool read(std::string_view& value, std::size_t length) {
+        if (data.size() < length) {
+            return false;
+        }
+        value = data.substr(0, length);
+        data.remove_prefix(length);
+        return true;
+    }
+
+private:
+    std::string_view data;
+};
+
+} // namespace
+
+GlyphPack::~GlyphPack() {
+#if !defined(_WIN32)
+    if (mapped) {
+        munmap(const_cast<char*>(mapped), mappedSize);
+    }
+#endif
+}
+
+std::shared_ptr<const GlyphPack> GlyphPack::open(const std::string& path) {
+#if !defined(_WIN32)
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat info {};
+    void* address = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        address = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    // The mapping stays valid after the descriptor is closed.
+    close(fd);
+    if (address == MAP_FAILED) {
+        return nullptr;
+    }
+
+    std::shared_ptr<GlyphPack> pack(new GlyphPack());
+    pack->mapped = static_cast<const char*>(address);
+    pack->mappedSize = static_cast<std::size_t>(info.st_size);
+    pack->contents = {pack->mapped, pack->mappedSize};
+    if (!pack->load()) {
+        return nullptr;
+    }
+    return pack;
+#else
+    auto data = util::readFile(path);
+    return data ? fromData(std::move(*data)) : nullptr;
+#endif
+}
+
+std::shared_ptr<const GlyphPack> GlyphPack::fromData(std::string data) {
+    std::shared_ptr<GlyphPack> pack(new GlyphPack());
+    pack->data = std::move(data);
+    pack->contents = pack->data;
+    if (!pack->load()) {
+        return nullptr;
+    }
+    return pack;
+}
+
+std::string GlyphPack::encode(const Ranges& ranges, std::string_view glyphURL) {
+    std::size_t tableSize = magic.size() + sizeof(uint32_t) + glyphURL.size() + sizeof(uint32_t);
+    for (const auto& range : ranges) {
+        tableSize += sizeof(uint32_t) + fontStackToString(range.first.first).size() + sizeof(uint16_t) +
+                     2 * sizeof(uint64_t);
+    }
+
+    std::string out;
+    out.append(magic);
+    append<uint32_t>(out, static_cast<uint32_t>(glyphURL.size()));
+    out.append(glyphURL);
+    append<uint32_t>(out, static_cast<uint32_t>(ranges.size()));
+    uint64_t offset = tableSize;
+    for (const auto& range : ranges) {
+        const std::string fontStack = fontStackToString(range.first.first);
+        append<uint32_t>(out, static_cast<uint32_t>(fontStack.size()));
+        out.append(fontStack);
+        append<uint16_t>(out, range.first.second.first);
+        append<uint64_t>(out, offset);
+        append<uint64_t>(out, range.second.size());
+        offset += range.second.size();
+    }
+    for (const auto& range : ranges) {
+        out.append(range.second);
+    }
+    return out;
+}
+
+bool GlyphPack::load() {
+    Reader reader(contents);
+    std::string_view fileMagic;
+    uint32_t glyphURLLength = 0;
+    uint32_t count = 0;
+    if (!reader.read(fileMagic, magic.size()) || fileMagic != magic || !reader.read(glyphURLLength) ||
+        !reader.read(glyphURL, glyphURLLength) || !reader.read(count)) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t fontStackLength = 0;
+        std::string_view fontStack;
+        uint16_t first = 0;
+        uint64_t offset = 0;
+        uint64_t length = 0;
+        if (!reader.read(fontStackLength) || !reader.read(fontStack, fontStackLength) || !reader.read(first) ||
+            !reader.read(offset) || !reader.read(length) || offset > contents.size() ||
+            length > contents.size() - offset) {
+            return false;
+        }
+        index.emplace(std::make_pair(std::string(fontStack), first),
+                      contents.substr(static_cast<std::size_t>(offset), static_cast<std::size_t>(length)));
+    }
+    return true;
+}
+
+std::optional<std::string_view> GlyphPack::getRange(const FontStack& fontStack, const GlyphRange& range) const {
+    const auto it = index.find({fontStackToString(fontStack), range.first});
+    if (it == index.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+} // namespace mbgl
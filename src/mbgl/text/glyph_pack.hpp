@@ -0,0 +1,62 @@
+#pragma once
+
+#include <mbgl/text/glyph_range.hpp>
+#include <mbgl/util/font_stack.hpp>
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace mbgl {
+
+/**
+ Glyph ranges of any number of font stacks, bundled into a single file so that
+ they can be served without requests.
+
+ A pack starts with the magic "MLNGPAK1", the glyph URL template of the style it
+ was made for and the number of ranges, followed by a table with the font stack,
+ the first glyph, and the offset and length of the PBF of each range. The PBFs
+ follow the table, in the format served for glyph URLs. Packs opened from files
+ are memory-mapped, so that only the pages of ranges that are used get read.
+
+ Packs are made with `scripts/pack-glyphs.py`.
+ */
+class GlyphPack {
+public:
+    using Ranges = std::map<std::pair<FontStack, GlyphRange>, std::string>;
+
+    GlyphPack(const GlyphPack&) = delete;
+    GlyphPack& operator=(const GlyphPack&) = delete;
+    ~GlyphPack();
+
+    /// Maps the pack at `path`. Returns nullptr if it can't be read or isn't a valid pack.
+    static std::shared_ptr<const GlyphPack> open(const std::string& path);
+    /// Returns nullptr if `data` isn't a valid pack.
+    static std::shared_ptr<const GlyphPack> fromData(std::string data);
+    static std::string encode(const Ranges&, std::string_view glyphURL = {});
+
+    /// Returns the PBF of the range, if the pack has it.
+    std::optional<std::string_view> getRange(const FontStack&, const GlyphRange&) const;
+
+    std::size_t rangeCount() const { return index.size(); }
+    /// Template of the URL of the ranges missing from the pack, empty if there is none.
+    std::string_view getGlyphURL() const { return glyphURL; }
+
+    static constexpr std::string_view fileExtension = ".glyphpack";
+
+private:
+    GlyphPack() = default;
+    bool load();
+
+    std::string data;
+    const char* mapped = nullptr;
+    std::size_t mappedSize = 0;
+    std::string_view contents;
+    std::string_view glyphURL;
+    std::map<std::pair<std::string, uint16_t>, std::string_view> index;
+};
+
+} // namespace mbgl
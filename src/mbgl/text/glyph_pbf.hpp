@@ -3,11 +3,11 @@
 #include <mbgl/text/glyph.hpp>
 #include <mbgl/text/glyph_range.hpp>
 
-#include <string>
+#include <string_view>
 #include <vector>
 
 namespace mbgl {
 
-std::vector<Glyph> parseGlyphPBF(const GlyphRange&, const std::string& data);
+std::vector<Glyph> parseGlyphPBF(const GlyphRange&, std::string_view data);
 
 } // namespace mbgl
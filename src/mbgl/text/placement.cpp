@@ -1,3 +1,4 @@
+#include <bitset>
 #include <list>
 #include <mbgl/layout/symbol_layout.hpp>
 #include <mbgl/renderer/bucket.hpp>
@@ -5,6 +6,7 @@
 #include <mbgl/renderer/render_layer.hpp>
 #include <mbgl/renderer/render_tile.hpp>
 #include <mbgl/renderer/update_parameters.hpp>
+#include <mbgl/style/layers/symbol_layer_impl.hpp>
 #include <mbgl/text/placement.hpp>
 #include <mbgl/tile/geometry_tile.hpp>
 #include <mbgl/util/math.hpp>
@@ -146,6 +148,9 @@ public:
     bool hasIconTextFit = getLayout().get<IconTextFit>() != IconTextFitType::None;
 
     std::optional<CollisionBoundaries> avoidEdges;
+
+    // Regions of the tile, as in `SymbolBucket::collisionRegions`, with no symbol in view
+    std::bitset<SymbolBucket::collisionRegionsPerSide * SymbolBucket::collisionRegionsPerSide> culledRegions;
 };
 
 // PlacementController implemenation
@@ -187,7 +192,8 @@ Placement::Placement(std::shared_ptr<const UpdateParameters> updateParameters_,
       placementZoom(static_cast<float>(updateParameters->transformState.getZoom())),
       collisionGroups(updateParameters->crossSourceCollisions),
       prevPlacement(std::move(prevPlacement_)),
-      showCollisionBoxes(updateParameters->debugOptions & MapDebugOptions::Collision) {
+      showCollisionBoxes(updateParameters->debugOptions & MapDebugOptions::Collision),
+      cullOutOfViewSymbols(updateParameters->mode == MapMode::Continuous && !showCollisionBoxes) {
     if (prevPlacement) {
         prevPlacement->get()->prevPlacement = std::nullopt; // Only hold on to one placement back
     }
@@ -214,6 +220,57 @@ void Placement::placeLayer(const RenderLayer& layer, std::set<uint32_t>& seenCro
     }
 }
 
+void Placement::setFixedSymbols(const std::vector<PlacedSymbolData>& symbols) {
+    assert(updateParameters);
+    fixedSymbols = symbols;
+    fixedSymbolsByKey.clear();
+    if (fixedSymbols.empty()) return;
+
+    std::unordered_map<std::string, const style::Layer::Impl*> layers;
+    for (const auto& layer : *updateParameters->layers) {
+        layers.emplace(layer->id, layer.get());
+    }
+    for (std::size_t i = 0; i < fixedSymbols.size(); ++i) {
+        const PlacedSymbolData& symbol = fixedSymbols[i];
+        fixedSymbolsByKey[symbol.key].push_back(i);
+
+        // The shown symbols take their boxes first, so that other symbols make room for them.
+        const auto layer = layers.find(symbol.layer);
+        if (layer == layers.end() || layer->second->getTypeInfo() != SymbolLayer::Impl::staticTypeInfo()) continue;
+        const auto& layout = static_cast<const SymbolLayer::Impl&>(*layer->second).layout;
+        const auto ignores = [](const auto& ignorePlacement) {
+            return ignorePlacement.isConstant() && ignorePlacement.asConstant();
+        };
+        const uint16_t collisionGroupId = collisionGroups.get(layer->second->source).first;
+        if (symbol.textPlaced && symbol.textCollisionBox && !ignores(layout.get<TextIgnorePlacement>())) {
+            collisionIndex.insertFixedBox(*symbol.textCollisionBox, collisionGroupId);
+        }
+        if (symbol.iconPlaced && symbol.iconCollisionBox && !ignores(layout.get<IconIgnorePlacement>())) {
+            collisionIndex.insertFixedBox(*symbol.iconCollisionBox, collisionGroupId);
+        }
+    }
+}
+
+const PlacedSymbolData* Placement::findFixedSymbol(const SymbolInstance& symbolInstance,
+                                                   const PlacementContext& ctx) const {
+    if (fixedSymbolsByKey.empty()) return nullptr;
+    const auto candidates = fixedSymbolsByKey.find(symbolInstance.key());
+    if (candidates == fixedSymbolsByKey.end()) return nullptr;
+
+    // Symbols are rendered at the same zoom level, so the anchors differ by rounding only.
+    constexpr float maxAnchorDistance = 0.5f;
+    const Point<float> anchor = collisionIndex.projectPoint(ctx.getRenderTile().matrix, symbolInstance.anchor.point);
+    for (const std::size_t i : candidates->second) {
+        const PlacedSymbolData& symbol = fixedSymbols[i];
+        if (symbol.layer == ctx.getBucket().bucketLeaderID &&
+            std::abs(symbol.anchor.x - anchor.x) <= maxAnchorDistance &&
+            std::abs(symbol.anchor.y - anchor.y) <= maxAnchorDistance) {
+            return &symbol;
+        }
+    }
+    return nullptr;
+}
+
 namespace {
 Point<float> calculateVariableLayoutOffset(style::SymbolAnchorType anchor,
                                            float width,
@@ -245,6 +302,21 @@ void Placement::placeSymbolBucket(const BucketPlacementData& params, std::set<ui
                          placementZoom,
                          collisionGroups.get(params.sourceId),
                          getAvoidEdges(symbolBucket, renderTile.matrix)};
+
+    // Symbols out of view are not placed. Finding them for the whole bucket, and
+    // then for regions of the tile, saves projecting their boxes one by one.
+    // Variable anchors shift boxes by amounts that are not known up front.
+    if (cullOutOfViewSymbols && ctx.getVariableTextAnchors().empty()) {
+        if (collisionIndex.isCulled(symbolBucket.collisionBounds, renderTile.matrix, ctx.pixelRatio)) {
+            ctx.culledRegions.set();
+        } else {
+            for (std::size_t i = 0; i < symbolBucket.collisionRegions.size(); ++i) {
+                ctx.culledRegions[i] = collisionIndex.isCulled(
+                    symbolBucket.collisionRegions[i], renderTile.matrix, ctx.pixelRatio);
+            }
+        }
+    }
+
     for (const SymbolInstance& symbol : getSortedSymbols(params, ctx.pixelRatio)) {
         if (seenCrossTileIDs.count(symbol.crossTileID) != 0u) continue;
         placeSymbol(symbol, ctx);
@@ -283,6 +355,55 @@ JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, cons
     textBoxes.clear();
     iconBoxes.clear();
 
+    symbolStats.considered++;
+    // A fixed symbol is shown or hidden as given, whatever it collides with. Where its text
+    // can take more than one box, it takes the given one.
+    const PlacedSymbolData* fixed = findFixedSymbol(symbolInstance, ctx);
+    const auto placeFixedText = [&](std::pair<bool, bool> placedFeature, bool matchBox) {
+        if (!fixed) return placedFeature;
+        constexpr float maxBoxDistance = 0.5f;
+        bool placedText = fixed->textPlaced;
+        if (placedText && matchBox) {
+            const auto& box = fixed->textCollisionBox;
+            placedText = box && !textBoxes.empty() && textBoxes.front().isBox() &&
+                         std::abs(textBoxes.front().box().min.x - box->min.x) <= maxBoxDistance &&
+                         std::abs(textBoxes.front().box().min.y - box->min.y) <= maxBoxDistance &&
+                         std::abs(textBoxes.front().box().max.x - box->max.x) <= maxBoxDistance &&
+                         std::abs(textBoxes.front().box().max.y - box->max.y) <= maxBoxDistance;
+        }
+        return std::pair<bool, bool>{placedText, placedFeature.second};
+    };
+    const bool culled = ctx.culledRegions[SymbolBucket::getCollisionRegion(symbolInstance)];
+    if (culled) {
+        symbolStats.culled++;
+    }
+    const auto placeCollisionFeature = [&](const CollisionFeature& collisionFeature,
+                                           Point<float> featureShift,
+                                           const mat4& labelPlaneMatrix,
+                                           const PlacedSymbol& placedSymbol,
+                                           float fontSize,
+                                           bool allowOverlap,
+                                           std::vector<ProjectedCollisionBox>& projectedBoxes) {
+        if (culled) {
+            // The result for boxes outside of the grid, which line features also count as offscreen
+            return std::pair<bool, bool>{false, collisionFeature.alongLine};
+        }
+        return collisionIndex.placeFeature(collisionFeature,
+                                           featureShift,
+                                           posMatrix,
+                                           labelPlaneMatrix,
+                                           ctx.pixelRatio,
+                                           placedSymbol,
+                                           ctx.scale,
+                                           fontSize,
+                                           allowOverlap,
+                                           ctx.pitchTextWithMap,
+                                           showCollisionBoxes,
+                                           ctx.avoidEdges,
+                                           collisionGroup.second,
+                                           projectedBoxes);
+    };
+
     bool placeText = false;
     bool placeIcon = false;
     bool offscreen = true;
@@ -290,7 +411,7 @@ JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, cons
     std::pair<bool, bool> placedVerticalText{false, false};
     std::pair<bool, bool> placedVerticalIcon{false, false};
     Point<float> shift{0.0f, 0.0f};
-    std::optional<size_t> horizontalTextIndex = symbolInstance.getDefaultHorizontalPlacedTextIndex();
+    std::optional<uint32_t> horizontalTextIndex = symbolInstance.getDefaultHorizontalPlacedTextIndex();
     if (horizontalTextIndex) {
         const PlacedSymbol& placedSymbol = bucket.text.placedSymbols.at(*horizontalTextIndex);
         const float fontSize = evaluateSizeForFeature(ctx.partiallyEvaluatedTextSize, placedSymbol);
@@ -328,20 +449,14 @@ JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, cons
             const auto placeFeature = [&](const CollisionFeature& collisionFeature,
                                           style::TextWritingModeType orientation) {
                 textBoxes.clear();
-                auto placedFeature = collisionIndex.placeFeature(collisionFeature,
-                                                                 {},
-                                                                 posMatrix,
-                                                                 ctx.textLabelPlaneMatrix,
-                                                                 ctx.pixelRatio,
-                                                                 placedSymbol,
-                                                                 ctx.scale,
-                                                                 fontSize,
-                                                                 ctx.textAllowOverlap,
-                                                                 ctx.pitchTextWithMap,
-                                                                 showCollisionBoxes,
-                                                                 ctx.avoidEdges,
-                                                                 collisionGroup.second,
-                                                                 textBoxes);
+                auto placedFeature = placeFixedText(placeCollisionFeature(collisionFeature,
+                                                                          {},
+                                                                          ctx.textLabelPlaneMatrix,
+                                                                          placedSymbol,
+                                                                          fontSize,
+                                                                          ctx.textAllowOverlap,
+                                                                          textBoxes),
+                                                    bucket.allowVerticalPlacement);
                 if (placedFeature.first) {
                     placedOrientations.emplace(symbolInstance.crossTileID, orientation);
                 }
@@ -421,39 +536,22 @@ JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, cons
                         continue;
                     }
 
-                    placedFeature = collisionIndex.placeFeature(textCollisionFeature,
-                                                                shift,
-                                                                posMatrix,
-                                                                mat4(),
-                                                                ctx.pixelRatio,
-                                                                placedSymbol,
-                                                                ctx.scale,
-                                                                fontSize,
-                                                                allowOverlap,
-                                                                ctx.pitchTextWithMap,
-                                                                showCollisionBoxes,
-                                                                ctx.avoidEdges,
-                                                                collisionGroup.second,
-                                                                textBoxes);
+                    placedFeature = placeFixedText(
+                        placeCollisionFeature(
+                            textCollisionFeature, shift, mat4(), placedSymbol, fontSize, allowOverlap, textBoxes),
+                        true);
 
                     if (doVariableIconPlacement) {
-                        auto placedIconFeature = collisionIndex.placeFeature(
-                            iconCollisionFeature,
-                            shift,
-                            posMatrix,
-                            ctx.iconLabelPlaneMatrix,
-                            ctx.pixelRatio,
-                            placedSymbol,
-                            ctx.scale,
-                            fontSize,
-                            ctx.iconAllowOverlap,
-                            ctx.pitchTextWithMap, // TODO: shall it be pitchIconWithMap?
-                            showCollisionBoxes,
-                            ctx.avoidEdges,
-                            collisionGroup.second,
-                            iconBoxes);
+                        // TODO: shall it use pitchIconWithMap?
+                        auto placedIconFeature = placeCollisionFeature(iconCollisionFeature,
+                                                                       shift,
+                                                                       ctx.iconLabelPlaneMatrix,
+                                                                       placedSymbol,
+                                                                       fontSize,
+                                                                       ctx.iconAllowOverlap,
+                                                                       iconBoxes);
                         iconBoxes.clear();
-                        if (!placedIconFeature.first) continue;
+                        if (!placedIconFeature.first && !fixed) continue;
                     }
 
                     if (placedFeature.first) {
@@ -532,20 +630,13 @@ JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, cons
         const PlacedSymbol& placedSymbol = iconBuffer.placedSymbols.at(*symbolInstance.placedIconIndex);
         const float fontSize = evaluateSizeForFeature(ctx.partiallyEvaluatedIconSize, placedSymbol);
         const auto& placeIconFeature = [&](const CollisionFeature& collisionFeature) {
-            return collisionIndex.placeFeature(collisionFeature,
-                                               shift,
-                                               posMatrix,
-                                               ctx.iconLabelPlaneMatrix,
-                                               ctx.pixelRatio,
-                                               placedSymbol,
-                                               ctx.scale,
-                                               fontSize,
-                                               ctx.iconAllowOverlap,
-                                               ctx.pitchTextWithMap,
-                                               showCollisionBoxes,
-                                               ctx.avoidEdges,
-                                               collisionGroup.second,
-                                               iconBoxes);
+            return placeCollisionFeature(collisionFeature,
+                                         shift,
+                                         ctx.iconLabelPlaneMatrix,
+                                         placedSymbol,
+                                         fontSize,
+                                         ctx.iconAllowOverlap,
+                                         iconBoxes);
         };
 
         std::pair<bool, bool> placedIcon = {false, false};
@@ -554,7 +645,7 @@ JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, cons
         } else {
             placedIcon = placeIconFeature(symbolInstance.iconCollisionFeature);
         }
-        placeIcon = placedIcon.first;
+        placeIcon = fixed ? fixed->iconPlaced : placedIcon.first;
         offscreen &= placedIcon.second;
     }
 
@@ -573,12 +664,14 @@ JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, cons
     if (placeText) {
         if (placedVerticalText.first && symbolInstance.verticalTextCollisionFeature) {
             collisionIndex.insertFeature(*symbolInstance.verticalTextCollisionFeature,
+                                         symbolInstance.indexedFeature,
                                          textBoxes,
                                          ctx.getLayout().get<TextIgnorePlacement>(),
                                          bucket.bucketInstanceId,
                                          collisionGroup.first);
         } else {
             collisionIndex.insertFeature(symbolInstance.textCollisionFeature,
+                                         symbolInstance.indexedFeature,
                                          textBoxes,
                                          ctx.getLayout().get<TextIgnorePlacement>(),
                                          bucket.bucketInstanceId,
@@ -589,12 +682,14 @@ JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, cons
     if (placeIcon) {
         if (placedVerticalIcon.first && symbolInstance.verticalIconCollisionFeature) {
             collisionIndex.insertFeature(*symbolInstance.verticalIconCollisionFeature,
+                                         symbolInstance.indexedFeature,
                                          iconBoxes,
                                          ctx.getLayout().get<IconIgnorePlacement>(),
                                          bucket.bucketInstanceId,
                                          collisionGroup.first);
         } else {
             collisionIndex.insertFeature(symbolInstance.iconCollisionFeature,
+                                         symbolInstance.indexedFeature,
                                          iconBoxes,
                                          ctx.getLayout().get<IconIgnorePlacement>(),
                                          bucket.bucketInstanceId,
@@ -621,6 +716,10 @@ JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, cons
         placements.erase(symbolInstance.crossTileID);
     }
 
+    if (placeText || placeIcon) {
+        symbolStats.placed++;
+    }
+
     JointPlacement result(
         placeText || ctx.alwaysShowText, placeIcon || ctx.alwaysShowIcon, offscreen || bucket.justReloaded);
     placements.emplace(symbolInstance.crossTileID, result);
@@ -1151,9 +1250,9 @@ void Placement::updateBucketOpacities(SymbolBucket& bucket,
 }
 
 namespace {
-std::optional<size_t> justificationToIndex(style::TextJustifyType justify,
-                                           const SymbolInstance& symbolInstance,
-                                           style::TextWritingModeType orientation) {
+std::optional<uint32_t> justificationToIndex(style::TextJustifyType justify,
+                                             const SymbolInstance& symbolInstance,
+                                             style::TextWritingModeType orientation) {
     // Vertical symbol has just one justification, style::TextJustifyType::Left.
     if (orientation == style::TextWritingModeType::Vertical) {
         return symbolInstance.placedVerticalTextIndex;
@@ -1184,10 +1283,10 @@ void Placement::markUsedJustification(SymbolBucket& bucket,
                                       style::TextWritingModeType orientation) const {
     style::TextJustifyType anchorJustify = getAnchorJustification(placedAnchor);
     assert(anchorJustify != style::TextJustifyType::Auto);
-    const std::optional<size_t>& autoIndex = justificationToIndex(anchorJustify, symbolInstance, orientation);
+    const std::optional<uint32_t>& autoIndex = justificationToIndex(anchorJustify, symbolInstance, orientation);
 
     for (auto& justify : justifyTypes) {
-        const std::optional<size_t> index = justificationToIndex(justify, symbolInstance, orientation);
+        const std::optional<uint32_t> index = justificationToIndex(justify, symbolInstance, orientation);
         if (index) {
             assert(bucket.text.placedSymbols.size() > *index);
             if (autoIndex && *index != *autoIndex) {
@@ -1312,6 +1411,17 @@ protected:
     float symbolFadeChange(TimePoint) const override { return 1.0f; }
     bool hasTransitions(TimePoint) const override { return false; }
     bool transitionsEnabled() const override { return false; }
+    void collectPlacedSymbolData(bool enable) override { collectData = enable; }
+    const std::vector<PlacedSymbolData>& getPlacedSymbolsData() const override { return placedSymbolsData; }
+    void newSymbolPlaced(const SymbolInstance&,
+                         const PlacementContext&,
+                         const JointPlacement&,
+                         style::SymbolPlacementType,
+                         const std::vector<ProjectedCollisionBox>&,
+                         const std::vector<ProjectedCollisionBox>&) override;
+
+    std::vector<PlacedSymbolData> placedSymbolsData;
+    bool collectData = false;
 };
 
 void StaticPlacement::commit() {
@@ -1323,6 +1433,52 @@ void StaticPlacement::commit() {
     }
 }
 
+namespace {
+
+// Bounds of the boxes or circles of a symbol part.
+std::optional<mapbox::geometry::box<float>> getCollisionBounds(const std::vector<ProjectedCollisionBox>& boxes) {
+    std::optional<mapbox::geometry::box<float>> bounds;
+    for (const auto& box : boxes) {
+        mapbox::geometry::box<float> extent{{0.0f, 0.0f}, {0.0f, 0.0f}};
+        if (box.isBox()) {
+            extent = box.box();
+        } else if (box.isCircle()) {
+            const auto& circle = box.circle();
+            extent = {{circle.center.x - circle.radius, circle.center.y - circle.radius},
+                      {circle.center.x + circle.radius, circle.center.y + circle.radius}};
+        } else {
+            continue;
+        }
+        if (bounds) {
+            extent = {{std::min(bounds->min.x, extent.min.x), std::min(bounds->min.y, extent.min.y)},
+                      {std::max(bounds->max.x, extent.max.x), std::max(bounds->max.y, extent.max.y)}};
+        }
+        bounds = extent;
+    }
+    return bounds;
+}
+
+} // namespace
+
+void StaticPlacement::newSymbolPlaced(const SymbolInstance& symbol,
+                                      const PlacementContext& ctx,
+                                      const JointPlacement& placement,
+                                      style::SymbolPlacementType,
+                                      const std::vector<ProjectedCollisionBox>& textCollisionBoxes,
+                                      const std::vector<ProjectedCollisionBox>& iconCollisionBoxes) {
+    if (!collectData) return;
+    // Line labels are described by the bounds of their circles.
+    placedSymbolsData.push_back({symbol.key(),
+                                 getCollisionBounds(textCollisionBoxes),
+                                 getCollisionBounds(iconCollisionBoxes),
+                                 placement.text,
+                                 placement.icon,
+                                 false,
+                                 collisionIndex.getViewportPadding(),
+                                 ctx.getBucket().bucketLeaderID,
+                                 collisionIndex.projectPoint(ctx.getRenderTile().matrix, symbol.anchor.point)});
+}
+
 /// Placement for Tile map mode.
 
 struct Intersection {
@@ -1345,8 +1501,6 @@ public:
 private:
     void placeLayers(const RenderLayerReferences&) override;
     void placeSymbolBucket(const BucketPlacementData&, std::set<uint32_t>&) override;
-    void collectPlacedSymbolData(bool enable) override { collectData = enable; }
-    const std::vector<PlacedSymbolData>& getPlacedSymbolsData() const override { return placedSymbolsData; }
 
     std::optional<CollisionBoundaries> getAvoidEdges(const SymbolBucket&, const mat4&) override;
     bool canPlaceAtVariableAnchor(const CollisionBox& box,
@@ -1367,11 +1521,9 @@ private:
     std::unordered_map<uint32_t, bool> locationCache;
     std::optional<CollisionBoundaries> tileBorders;
     std::set<uint32_t> seenCrossTileIDs;
-    std::vector<PlacedSymbolData> placedSymbolsData;
     std::vector<Intersection> intersections;
     bool populateIntersections = false;
     std::size_t currentIntersectionPriority{};
-    bool collectData = false;
 };
 
 void TilePlacement::placeLayers(const RenderLayerReferences& layers) {
@@ -1404,7 +1556,7 @@ void TilePlacement::placeLayers(const RenderLayerReferences& layers) {
             return a.symbol.get().anchor.point.x < b.symbol.get().anchor.point.x;
         }
         // Finally, looking at the key hashes.
-        return std::hash<std::u16string>()(a.symbol.get().key) < std::hash<std::u16string>()(b.symbol.get().key);
+        return std::hash<std::u16string>()(a.symbol.get().key()) < std::hash<std::u16string>()(b.symbol.get().key());
     });
     // Place intersections.
     for (const auto& intersection : intersections) {
@@ -1612,14 +1764,15 @@ void TilePlacement::newSymbolPlaced(const SymbolInstance& symbol,
         assert(box.isBox());
         iconCollisionBox = box.box();
     }
-    PlacedSymbolData symbolData{symbol.key,
+    PlacedSymbolData symbolData{symbol.key(),
                                 textCollisionBox,
                                 iconCollisionBox,
                                 placement.text,
                                 placement.icon,
                                 !placement.skipFade && populateIntersections,
                                 collisionIndex.getViewportPadding(),
-                                ctx.getBucket().bucketLeaderID};
+                                ctx.getBucket().bucketLeaderID,
+                                collisionIndex.projectPoint(ctx.getRenderTile().matrix, symbol.anchor.point)};
     placedSymbolsData.emplace_back(std::move(symbolData));
 }
 
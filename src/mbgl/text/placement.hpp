@@ -128,6 +128,8 @@ public:
     virtual bool transitionsEnabled() const;
     virtual void collectPlacedSymbolData(bool /*enable*/) {}
     virtual const std::vector<PlacedSymbolData>& getPlacedSymbolsData() const;
+    /// Places the matching symbols as given, see `Renderer::setFixedPlacedSymbols()`.
+    void setFixedSymbols(const std::vector<PlacedSymbolData>&);
 
     const CollisionIndex& getCollisionIndex() const;
     TimePoint getCommitTime() const { return commitTime; }
@@ -138,6 +140,16 @@ public:
 
     const RetainedQueryData& getQueryData(uint32_t bucketInstanceId) const;
 
+    struct SymbolStats {
+        /// Symbols considered for placement
+        std::size_t considered = 0;
+        /// Symbols skipped without collision detection, as they are out of view
+        std::size_t culled = 0;
+        /// Symbols with placed text or icon
+        std::size_t placed = 0;
+    };
+    const SymbolStats& getSymbolStats() const { return symbolStats; }
+
     // Public constructors are required for makeMutable(), shall not be called directly.
     Placement();
     Placement(std::shared_ptr<const UpdateParameters>, std::optional<Immutable<Placement>> prevPlacement);
@@ -180,6 +192,7 @@ protected:
     void markUsedOrientation(SymbolBucket&, style::TextWritingModeType, const SymbolInstance&) const;
     const Placement* getPrevPlacement() const { return prevPlacement ? prevPlacement->get() : nullptr; }
     bool isTiltedView() const;
+    const PlacedSymbolData* findFixedSymbol(const SymbolInstance&, const PlacementContext&) const;
 
     std::shared_ptr<const UpdateParameters> updateParameters;
     CollisionIndex collisionIndex;
@@ -200,6 +213,11 @@ protected:
     CollisionGroups collisionGroups;
     mutable std::optional<Immutable<Placement>> prevPlacement;
     bool showCollisionBoxes = false;
+    // Whether symbols out of view are culled before collision detection
+    bool cullOutOfViewSymbols = false;
+    SymbolStats symbolStats;
+    std::vector<PlacedSymbolData> fixedSymbols;
+    std::unordered_map<std::u16string, std::vector<std::size_t>> fixedSymbolsByKey;
 
     // Cache being used by placeSymbol()
     std::vector<ProjectedCollisionBox> textBoxes;
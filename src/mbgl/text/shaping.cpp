@@ -4,6 +4,7 @@
 #include <mbgl/layout/symbol_feature.hpp>
 #include <mbgl/math/minmax.hpp>
 #include <mbgl/text/bidi.hpp>
+#include <mbgl/text/shaping_cache.hpp>
 
 #include <algorithm>
 #include <list>
@@ -542,6 +543,32 @@ void shapeLines(Shaping& shaping,
     shaping.right = shaping.left + maxLineLength;
 }
 
+std::vector<TaggedString> reorderLines(const TaggedString& formattedString,
+                                       const float maxWidth,
+                                       const float spacing,
+                                       BiDi& bidi,
+                                       const GlyphMap& glyphMap,
+                                       const ImagePositions& imagePositions,
+                                       float layoutTextSize) {
+    std::vector<TaggedString> reorderedLines;
+    if (formattedString.sectionCount() == 1) {
+        auto untaggedLines = bidi.processText(
+            formattedString.rawText(),
+            determineLineBreaks(formattedString, spacing, maxWidth, glyphMap, imagePositions, layoutTextSize));
+        for (const auto& line : untaggedLines) {
+            reorderedLines.emplace_back(line, formattedString.sectionAt(0));
+        }
+    } else {
+        auto processedLines = bidi.processStyledText(
+            formattedString.getStyledText(),
+            determineLineBreaks(formattedString, spacing, maxWidth, glyphMap, imagePositions, layoutTextSize));
+        for (const auto& line : processedLines) {
+            reorderedLines.emplace_back(line, formattedString.getSections());
+        }
+    }
+    return reorderedLines;
+}
+
 Shaping getShaping(const TaggedString& formattedString,
                    const float maxWidth,
                    const float lineHeight,
@@ -556,22 +583,21 @@ Shaping getShaping(const TaggedString& formattedString,
                    const ImagePositions& imagePositions,
                    float layoutTextSize,
                    float layoutTextSizeAtBucketZoomLevel,
-                   bool allowVerticalPlacement) {
+                   bool allowVerticalPlacement,
+                   ShapingCache* cache) {
     assert(layoutTextSize);
     std::vector<TaggedString> reorderedLines;
-    if (formattedString.sectionCount() == 1) {
-        auto untaggedLines = bidi.processText(
-            formattedString.rawText(),
-            determineLineBreaks(formattedString, spacing, maxWidth, glyphMap, imagePositions, layoutTextSize));
-        for (const auto& line : untaggedLines) {
-            reorderedLines.emplace_back(line, formattedString.sectionAt(0));
-        }
+    std::optional<ShapingCache::Key> cacheKey;
+    if (cache) {
+        cacheKey = ShapingCache::Key::create(formattedString, maxWidth, spacing);
+    }
+    if (auto cachedLines = cacheKey ? cache->get(*cacheKey) : std::nullopt) {
+        reorderedLines = std::move(*cachedLines);
     } else {
-        auto processedLines = bidi.processStyledText(
-            formattedString.getStyledText(),
-            determineLineBreaks(formattedString, spacing, maxWidth, glyphMap, imagePositions, layoutTextSize));
-        for (const auto& line : processedLines) {
-            reorderedLines.emplace_back(line, formattedString.getSections());
+        reorderedLines = reorderLines(
+            formattedString, maxWidth, spacing, bidi, glyphMap, imagePositions, layoutTextSize);
+        if (cacheKey) {
+            cache->put(std::move(*cacheKey), reorderedLines);
         }
     }
     Shaping shaping(translate[0], translate[1], writingMode);
@@ -27,6 +27,7 @@ style::TextJustifyType getAnchorJustification(style::SymbolAnchorType anchor);
 
 class SymbolFeature;
 class BiDi;
+class ShapingCache;
 
 class Padding {
 public:
@@ -95,6 +96,7 @@ Shaping getShaping(const TaggedString& string,
                    const ImagePositions& imagePositions,
                    float layoutTextSize,
                    float layoutTextSizeAtBucketZoomLevel,
-                   bool allowVerticalPlacement);
+                   bool allowVerticalPlacement,
+                   ShapingCache* cache = nullptr);
 
 } // namespace mbgl
@@ -0,0 +1,99 @@
+#include <mbgl/text/shaping_cache.hpp>
+#include <mbgl/util/hash.hpp>
+
+namespace mbgl {
+
+bool ShapingCache::Key::Section::operator==(const Section& other) const {
+    return fontStackHash == other.fontStackHash && scale == other.scale && textColor == other.textColor;
+}
+
+std::optional<ShapingCache::Key> ShapingCache::Key::create(const TaggedString& string,
+                                                           float maxWidth,
+                                                           float spacing) {
+    Key key{string.getStyledText(), {}, maxWidth, spacing, 0};
+    key.sections.reserve(string.sectionCount());
+    for (const auto& section : string.getSections()) {
+        if (section.imageID) {
+            return std::nullopt;
+        }
+        key.sections.push_back({section.fontStackHash, section.scale, section.textColor});
+    }
+
+    key.hash = util::hash(key.text.first, maxWidth, spacing);
+    for (const auto& section : key.sections) {
+        util::hash_combine(key.hash, section.fontStackHash);
+        util::hash_combine(key.hash, section.scale);
+    }
+    if (key.sections.size() > 1) {
+        for (const auto sectionIndex : key.text.second) {
+            util::hash_combine(key.hash, sectionIndex);
+        }
+    }
+    return key;
+}
+
+bool ShapingCache::Key::operator==(const Key& other) const {
+    return hash == other.hash && maxWidth == other.maxWidth && spacing == other.spacing && text == other.text &&
+           sections == other.sections;
+}
+
+double ShapingCache::Stats::hitRate() const {
+    const std::size_t lookups = hits + misses;
+    return lookups ? static_cast<double>(hits) / static_cast<double>(lookups) : 0.0;
+}
+
+ShapingCache::ShapingCache(std::size_t maxEntries_)
+    : maxEntries(maxEntries_) {}
+
+std::optional<std::vector<TaggedString>> ShapingCache::get(const Key& key) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto it = index.find(key);
+    if (it == index.end()) {
+        stats.misses++;
+        return std::nullopt;
+    }
+
+    stats.hits++;
+    entries.splice(entries.begin(), entries, it->second);
+    return it->second->second;
+}
+
+void ShapingCache::put(Key key, std::vector<TaggedString> lines) {
+    if (!maxEntries) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (index.find(key) != index.end()) {
+        // Another thread shaped the same string in the meantime
+        return;
+    }
+
+    if (entries.size() == maxEntries) {
+        index.erase(entries.back().first);
+        entries.pop_back();
+        stats.evictions++;
+    }
+
+    entries.emplace_front(std::move(key), std::move(lines));
+    index.emplace(entries.front().first, entries.begin());
+}
+
+ShapingCache::Stats ShapingCache::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+std::size_t ShapingCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+void ShapingCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    index.clear();
+    entries.clear();
+    stats = {};
+}
+
+} // namespace mbgl
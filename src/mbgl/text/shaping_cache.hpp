@@ -0,0 +1,83 @@
+#pragma once
+
+#include <mbgl/text/tagged_string.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace mbgl {
+
+/**
+ * Bounded, thread-safe cache of the lines that a label is broken into and reordered
+ * to by the bidirectional algorithm, shared by the symbol layouts of the tiles that
+ * take their glyphs from the same GlyphManager.
+ *
+ * Besides the text, its sections and the shaping width and spacing, the line breaks
+ * depend on the advances of the glyphs, which the key doesn't hold. A cache must only
+ * be used with glyphs of one source, which is why the GlyphManager starts a new one
+ * whenever its glyph URL changes. Labels with images are not cached, as the line
+ * breaks depend on the size of the images.
+ */
+class ShapingCache {
+public:
+    struct Key {
+        struct Section {
+            FontStackHash fontStackHash;
+            double scale;
+            std::optional<Color> textColor;
+
+            bool operator==(const Section&) const;
+        };
+
+        /// Returns std::nullopt if the lines of the string can't be cached.
+        static std::optional<Key> create(const TaggedString&, float maxWidth, float spacing);
+
+        bool operator==(const Key&) const;
+
+        StyledText text;
+        std::vector<Section> sections;
+        float maxWidth;
+        float spacing;
+        std::size_t hash;
+    };
+
+    struct Stats {
+        std::size_t hits = 0;
+        std::size_t misses = 0;
+        std::size_t evictions = 0;
+
+        double hitRate() const;
+    };
+
+    explicit ShapingCache(std::size_t maxEntries);
+
+    std::optional<std::vector<TaggedString>> get(const Key&);
+    void put(Key, std::vector<TaggedString> lines);
+
+    Stats getStats() const;
+    std::size_t size() const;
+    void clear();
+
+    static constexpr std::size_t defaultMaxEntries = 8192;
+
+private:
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const { return key.hash; }
+    };
+
+    using Entries = std::list<std::pair<Key, std::vector<TaggedString>>>;
+
+    const std::size_t maxEntries;
+    mutable std::mutex mutex;
+    // Most recently used first
+    Entries entries;
+    std::unordered_map<std::reference_wrapper<const Key>, Entries::iterator, KeyHash, std::equal_to<Key>> index;
+    Stats stats;
+};
+
+} // namespace mbgl
@@ -23,7 +23,7 @@ CustomGeometryTile::CustomGeometryTile(const OverscaledTileID& overscaledTileID,
       necessity(TileNecessity::Optional),
       options(std::move(options_)),
       loader(std::move(loader_)),
-      mailbox(std::make_shared<Mailbox>(*Scheduler::GetCurrent())),
+      mailbox(std::make_shared<Mailbox>(Scheduler::GetCurrent()->withPriority(Scheduler::Priority::Low))),
       actorRef(*this, mailbox) {}
 
 CustomGeometryTile::~CustomGeometryTile() {
@@ -20,14 +20,20 @@ void GeoJSONTile::updateData(std::shared_ptr<style::GeoJSONData> data_, bool nee
     if (needsRelayout) reset();
     data->getTile(
         id.canonical,
-        [this, self = weakFactory.makeWeakPtr(), capturedData = data.get()](style::GeoJSONData::TileFeatures features) {
+        [this, self = weakFactory.makeWeakPtr(), capturedRequest = ++dataRequest](
+            style::GeoJSONData::TileFeatures features) {
             if (!self) return;
-            if (data.get() != capturedData) return;
+            if (dataRequest != capturedRequest) return;
             auto tileData = std::make_unique<GeoJSONTileData>(std::move(features));
             setData(std::move(tileData));
         });
 }
 
+void GeoJSONTile::retainData(std::shared_ptr<style::GeoJSONData> data_) {
+    assert(data_);
+    data = std::move(data_);
+}
+
 void GeoJSONTile::querySourceFeatures(std::vector<Feature>& result, const SourceQueryOptions& options) {
     // Ignore the sourceLayer, there is only one
     if (auto tileData = getData()) {
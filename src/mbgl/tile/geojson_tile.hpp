@@ -18,11 +18,14 @@ public:
                 std::shared_ptr<style::GeoJSONData>);
 
     void updateData(std::shared_ptr<style::GeoJSONData> data, bool needsRelayout = false);
+    /// Switches to data known to yield the same features for this tile, without reloading it.
+    void retainData(std::shared_ptr<style::GeoJSONData> data);
 
     void querySourceFeatures(std::vector<Feature>& result, const SourceQueryOptions&) override;
 
 private:
     std::shared_ptr<style::GeoJSONData> data;
+    std::uint64_t dataRequest = 0;
     mapbox::base::WeakPtrFactory<GeoJSONTile> weakFactory{this};
 };
 
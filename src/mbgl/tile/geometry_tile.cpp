@@ -159,7 +159,7 @@ GeometryTile::GeometryTile(const OverscaledTileID& id_, std::string sourceID_, c
     : Tile(Kind::Geometry, id_),
       ImageRequestor(parameters.imageManager),
       sourceID(std::move(sourceID_)),
-      mailbox(std::make_shared<Mailbox>(*Scheduler::GetCurrent())),
+      mailbox(std::make_shared<Mailbox>(Scheduler::GetCurrent()->withPriority(Scheduler::Priority::Low))),
       worker(Scheduler::GetBackground(),
              ActorRef<GeometryTile>(*this, mailbox),
              id_,
@@ -273,7 +273,7 @@ void GeometryTile::onError(std::exception_ptr err, const uint64_t resultCorrelat
 }
 
 void GeometryTile::onGlyphsAvailable(GlyphMap glyphs) {
-    worker.self().invoke(&GeometryTileWorker::onGlyphsAvailable, std::move(glyphs));
+    worker.self().invoke(&GeometryTileWorker::onGlyphsAvailable, std::move(glyphs), glyphManager.getShapingCache());
 }
 
 void GeometryTile::getGlyphs(GlyphDependencies glyphDependencies) {
@@ -275,7 +275,8 @@ void GeometryTileWorker::coalesce() {
     self.invoke(&GeometryTileWorker::coalesced);
 }
 
-void GeometryTileWorker::onGlyphsAvailable(GlyphMap newGlyphMap) {
+void GeometryTileWorker::onGlyphsAvailable(GlyphMap newGlyphMap, std::shared_ptr<ShapingCache> shapingCache_) {
+    shapingCache = std::move(shapingCache_);
     for (auto& newFontGlyphs : newGlyphMap) {
         FontStackHash fontStack = newFontGlyphs.first;
         Glyphs& newGlyphs = newFontGlyphs.second;
@@ -421,6 +422,7 @@ void GeometryTileWorker::parse() {
                 bucket->addFeature(*feature, geometries, {}, PatternLayerMap(), i, id.canonical);
                 featureIndex->insert(geometries, i, sourceLayerID, leaderImpl.id);
             }
+            bucket->finalize();
 
             if (!bucket->hasData()) {
                 continue;
@@ -473,7 +475,8 @@ void GeometryTileWorker::finalizeLayout() {
                 return;
             }
 
-            layout->prepareSymbols(glyphMap, glyphAtlas.positions, imageMap, iconAtlas.iconPositions);
+            layout->prepareSymbols(
+                glyphMap, glyphAtlas.positions, imageMap, iconAtlas.iconPositions, shapingCache.get());
 
             if (!layout->hasSymbolInstances()) {
                 continue;
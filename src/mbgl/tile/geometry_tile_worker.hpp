@@ -21,6 +21,7 @@ namespace mbgl {
 class GeometryTile;
 class GeometryTileData;
 class Layout;
+class ShapingCache;
 
 namespace style {
 class Layer;
@@ -47,7 +48,7 @@ public:
     void reset(uint64_t correlationID_);
     void setShowCollisionBoxes(bool showCollisionBoxes_, uint64_t correlationID_);
 
-    void onGlyphsAvailable(GlyphMap newGlyphMap);
+    void onGlyphsAvailable(GlyphMap newGlyphMap, std::shared_ptr<ShapingCache>);
     void onImagesAvailable(ImageMap newIconMap,
                            ImageMap newPatternMap,
                            ImageVersionMap versionMap,
@@ -101,6 +102,8 @@ private:
     GlyphDependencies pendingGlyphDependencies;
     ImageDependencies pendingImageDependencies;
     GlyphMap glyphMap;
+    // Lines shaped with the glyphs of the glyph manager the last glyphs came from
+    std::shared_ptr<ShapingCache> shapingCache;
     ImageMap imageMap;
     ImageMap patternMap;
     ImageVersionMap versionMap;
@@ -17,7 +17,7 @@ namespace mbgl {
 RasterDEMTile::RasterDEMTile(const OverscaledTileID& id_, const TileParameters& parameters, const Tileset& tileset)
     : Tile(Kind::RasterDEM, id_),
       loader(*this, id_, parameters, tileset),
-      mailbox(std::make_shared<Mailbox>(*Scheduler::GetCurrent())),
+      mailbox(std::make_shared<Mailbox>(Scheduler::GetCurrent()->withPriority(Scheduler::Priority::Low))),
       worker(Scheduler::GetBackground(), ActorRef<RasterDEMTile>(*this, mailbox)) {
     encoding = tileset.encoding;
     if (id.canonical.y == 0) {
@@ -121,6 +121,10 @@ void RasterDEMTile::setNecessity(TileNecessity necessity) {
     loader.setNecessity(necessity);
 }
 
+void RasterDEMTile::setPriority(Resource::Priority priority) {
+    loader.setPriority(priority);
+}
+
 void RasterDEMTile::setUpdateParameters(const TileUpdateParameters& params) {
     loader.setUpdateParameters(params);
 }
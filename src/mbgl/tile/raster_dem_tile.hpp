@@ -66,6 +66,7 @@ public:
 
     std::unique_ptr<TileRenderData> createRenderData() override;
     void setNecessity(TileNecessity) override;
+    void setPriority(Resource::Priority) override;
     void setUpdateParameters(const TileUpdateParameters&) override;
 
     void setError(std::exception_ptr);
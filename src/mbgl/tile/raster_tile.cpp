@@ -17,7 +17,7 @@ namespace mbgl {
 RasterTile::RasterTile(const OverscaledTileID& id_, const TileParameters& parameters, const Tileset& tileset)
     : Tile(Kind::Raster, id_),
       loader(*this, id_, parameters, tileset),
-      mailbox(std::make_shared<Mailbox>(*Scheduler::GetCurrent())),
+      mailbox(std::make_shared<Mailbox>(Scheduler::GetCurrent()->withPriority(Scheduler::Priority::Low))),
       worker(Scheduler::GetBackground(), ActorRef<RasterTile>(*this, mailbox)) {}
 
 RasterTile::~RasterTile() = default;
@@ -74,6 +74,10 @@ void RasterTile::setNecessity(TileNecessity necessity) {
     loader.setNecessity(necessity);
 }
 
+void RasterTile::setPriority(Resource::Priority priority) {
+    loader.setPriority(priority);
+}
+
 void RasterTile::setUpdateParameters(const TileUpdateParameters& params) {
     loader.setUpdateParameters(params);
 }
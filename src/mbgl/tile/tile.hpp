@@ -65,6 +65,9 @@ public:
 
     virtual void setNecessity(TileNecessity) {}
 
+    // Priority of the next network request for this tile's data.
+    virtual void setPriority(Resource::Priority) {}
+
     virtual void setUpdateParameters(const TileUpdateParameters&) {}
 
     // Mark this tile as no longer needed and cancel any pending work.
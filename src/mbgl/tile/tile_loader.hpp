@@ -20,6 +20,7 @@ public:
     ~TileLoader();
 
     void setNecessity(TileNecessity newNecessity);
+    void setPriority(Resource::Priority priority) { resource.setPriority(priority); }
     void setUpdateParameters(const TileUpdateParameters&);
 
 private:
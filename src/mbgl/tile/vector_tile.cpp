@@ -17,6 +17,10 @@ void VectorTile::setNecessity(TileNecessity necessity) {
     loader.setNecessity(necessity);
 }
 
+void VectorTile::setPriority(Resource::Priority priority) {
+    loader.setPriority(priority);
+}
+
 void VectorTile::setUpdateParameters(const TileUpdateParameters& params) {
     loader.setUpdateParameters(params);
 }
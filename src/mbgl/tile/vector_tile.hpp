@@ -13,6 +13,7 @@ public:
     VectorTile(const OverscaledTileID&, std::string sourceID, const TileParameters&, const Tileset&);
 
     void setNecessity(TileNecessity) final;
+    void setPriority(Resource::Priority) final;
     void setUpdateParameters(const TileUpdateParameters&) final;
     void setMetadata(std::optional<Timestamp> modified, std::optional<Timestamp> expires);
     void setData(const std::shared_ptr<const std::string>& data);
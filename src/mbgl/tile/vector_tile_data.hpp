@@ -16,6 +16,7 @@
 
 #include <unordered_map>
 #include <functional>
+#include <mutex>
 #include <utility>
 
 namespace mbgl {
@@ -60,7 +61,8 @@ public:
 
 private:
     std::shared_ptr<const std::string> data;
-    mutable bool parsed = false;
+    // Layers are parsed lazily; feature queries may do so from several threads at once.
+    mutable std::once_flag parsed;
     mutable std::map<std::string, const protozero::data_view> layers;
 };
 
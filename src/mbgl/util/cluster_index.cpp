@@ -0,0 +1,873 @@
+#include <mbgl/util/cluster_index.hpp>
+
+#include <mbgl/actor/scheduler.hpp>
+#include <mbgl/math/clamp.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/logging.hpp>
+#include <mbgl/util/parallel.hpp>
+#include <mbgl/util/projection.hpp>
+#include <mbgl/util/string.hpp>
+
+#include <kdbush.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace mbgl {
+
+namespace {
+
+using Tree = kdbush::KDBush<std::pair<double, double>, uint32_t>;
+
+// Points handled by one task when work on a level is spread over the thread pool.
+constexpr std::size_t chunkSize = 16384;
+
+// Cluster IDs keep the zoom level in their lowest five bits, the index of the
+// point that started the cluster on the previous level in the remaining bits.
+constexpr uint32_t maxClusterIndex = 0x7ffffff;
+
+uint32_t clusterID(uint32_t index, uint8_t zoom) {
+    return (index << 5) + (zoom + 1);
+}
+
+// Projects a point to Mercator coordinates in the unit square.
+Point<double> project(const mapbox::geometry::point<double>& p) {
+    return Projection::project(LatLng(util::clamp(p.y, -util::LATITUDE_MAX, util::LATITUDE_MAX), p.x), 0);
+}
+
+LatLng unproject(double x, double y) {
+    return Projection::unproject({x, y}, 1 / util::tileSize_D);
+}
+
+void extend(ClusterIndex::ChangedBounds* changed, uint8_t zoom, double x, double y) {
+    if (!changed) {
+        return;
+    }
+    auto it = changed->find(zoom);
+    if (it == changed->end()) {
+        changed->emplace(zoom, ClusterIndex::Box{{x, y}, {x, y}});
+        return;
+    }
+    auto& box = it->second;
+    box.min.x = std::min(box.min.x, x);
+    box.min.y = std::min(box.min.y, y);
+    box.max.x = std::max(box.max.x, x);
+    box.max.y = std::max(box.max.y, y);
+}
+
+} // namespace
+
+// The points of one zoom level: a slice of the shared point buffer, followed
+// by the points added through updates. The spatial index covers the positions
+// as of its last build; points moved or added since are tracked as stale and
+// tested one by one until the index is rebuilt.
+class ClusterIndex::Level {
+public:
+    Level(std::vector<Point>& points_, std::vector<PropertiesPtr>& properties_, bool hasProperties_)
+        : points(points_),
+          properties(properties_),
+          hasProperties(hasProperties_) {}
+
+    // Copies the level of another index into the point buffer of this one.
+    Level(const Level& other, std::vector<Point>& points_, std::vector<PropertiesPtr>& properties_)
+        : begin(other.begin),
+          size(other.size),
+          points(points_),
+          properties(properties_),
+          hasProperties(other.hasProperties),
+          added(other.added),
+          addedProperties(other.addedProperties),
+          tree(other.tree),
+          stale(other.stale),
+          isStale(other.isStale) {}
+
+    uint32_t count() const { return size + static_cast<uint32_t>(added.size()); }
+
+    Point& operator[](uint32_t i) { return i < size ? points[begin + i] : added[i - size]; }
+    const Point& operator[](uint32_t i) const { return i < size ? points[begin + i] : added[i - size]; }
+
+    PropertiesPtr getProperties(uint32_t i) const {
+        if (!hasProperties) {
+            return {};
+        }
+        return i < size ? properties[begin + i] : addedProperties[i - size];
+    }
+
+    void setProperties(uint32_t i, PropertiesPtr value) {
+        if (hasProperties) {
+            (i < size ? properties[begin + i] : addedProperties[i - size]) = std::move(value);
+        }
+    }
+
+    uint32_t add(const Point& point, PropertiesPtr value) {
+        added.push_back(point);
+        if (hasProperties) {
+            addedProperties.push_back(std::move(value));
+        }
+        const uint32_t index = count() - 1;
+        markStale(index);
+        return index;
+    }
+
+    void markStale(uint32_t i) {
+        if (isStale.size() < count()) {
+            isStale.resize(count(), false);
+        }
+        if (!isStale[i]) {
+            isStale[i] = true;
+            stale.push_back(i);
+        }
+        if (stale.size() > std::max<std::size_t>(64, count() / 16)) {
+            buildTree();
+        }
+    }
+
+    void buildTree() {
+        stale.clear();
+        isStale.clear();
+        if (count() == 0) {
+            tree.reset();
+            return;
+        }
+        std::vector<std::pair<double, double>> positions;
+        positions.reserve(count());
+        for (uint32_t i = 0; i < count(); ++i) {
+            const Point& point = (*this)[i];
+            positions.emplace_back(point.x, point.y);
+        }
+        tree = std::make_shared<Tree>(positions);
+    }
+
+    template <typename Fn>
+    void within(double x, double y, double r, Fn&& fn) const {
+        if (tree) {
+            tree->within(x, y, r, [&](uint32_t i) {
+                if (isStale.empty() || !isStale[i]) {
+                    fn(i);
+                }
+            });
+        }
+        for (const uint32_t i : stale) {
+            const Point& point = (*this)[i];
+            const double dx = point.x - x;
+            const double dy = point.y - y;
+            if (dx * dx + dy * dy <= r * r) {
+                fn(i);
+            }
+        }
+    }
+
+    template <typename Fn>
+    void range(double minX, double minY, double maxX, double maxY, Fn&& fn) const {
+        if (tree) {
+            tree->range(minX, minY, maxX, maxY, [&](uint32_t i) {
+                if (isStale.empty() || !isStale[i]) {
+                    fn(i);
+                }
+            });
+        }
+        for (const uint32_t i : stale) {
+            const Point& point = (*this)[i];
+            if (point.x >= minX && point.x <= maxX && point.y >= minY && point.y <= maxY) {
+                fn(i);
+            }
+        }
+    }
+
+    std::size_t begin = 0; // Offset of the level in the point buffer.
+    uint32_t size = 0;     // Number of points of the level in the point buffer.
+
+private:
+    std::vector<Point>& points;
+    std::vector<PropertiesPtr>& properties;
+    const bool hasProperties;
+
+    std::vector<Point> added;
+    std::vector<PropertiesPtr> addedProperties;
+
+    std::shared_ptr<Tree> tree; // Shared by copies, and never changed once built.
+    std::vector<uint32_t> stale;
+    std::vector<bool> isStale;
+};
+
+ClusterIndex::ClusterIndex(Features features_, Options options_)
+    : options(std::move(options_)),
+      features(std::make_shared<const Features>(std::move(features_))) {
+    assert(options.minZoom <= options.maxZoom + 1);
+    for (int z = options.minZoom; z <= options.maxZoom + 1; ++z) {
+        levels.push_back(std::make_unique<Level>(points, properties, bool(options.reduce)));
+    }
+
+    buildLeaves();
+    for (int z = options.maxZoom; z >= options.minZoom; z--) {
+        clusterLevel(static_cast<uint8_t>(z));
+    }
+}
+
+ClusterIndex::ClusterIndex(const ClusterIndex& other)
+    : options(other.options),
+      features(other.features),
+      featureIndices(other.featureIndices),
+      addedFeatures(other.addedFeatures),
+      addedFeatureIndices(other.addedFeatureIndices),
+      leaves(other.leaves),
+      pointCount(other.pointCount),
+      updateCount(other.updateCount),
+      points(other.points),
+      properties(other.properties) {
+    levels.reserve(other.levels.size());
+    for (const auto& otherLevel : other.levels) {
+        levels.push_back(std::make_unique<Level>(*otherLevel, points, properties));
+    }
+}
+
+ClusterIndex::~ClusterIndex() = default;
+
+void ClusterIndex::buildLeaves() {
+    std::vector<uint32_t> pointFeatures;
+    std::map<FeatureIdentifier, uint32_t> indices;
+    leaves.assign(features->size(), none);
+    for (std::size_t i = 0; i < features->size(); ++i) {
+        const auto& pointFeature = (*features)[i];
+        if (pointFeature.geometry.is<mapbox::geometry::point<double>>()) {
+            leaves[i] = static_cast<uint32_t>(pointFeatures.size());
+            pointFeatures.push_back(static_cast<uint32_t>(i));
+            if (!pointFeature.id.is<NullValue>()) {
+                indices[pointFeature.id] = static_cast<uint32_t>(i);
+            }
+        }
+    }
+    featureIndices = std::make_shared<const std::map<FeatureIdentifier, uint32_t>>(std::move(indices));
+    pointCount = pointFeatures.size();
+
+    // Levels hold no more points than the level above; lower levels usually
+    // hold far fewer, so this covers the first levels without reallocating.
+    points.reserve(pointCount * 2);
+    points.resize(pointCount);
+    if (options.reduce) {
+        properties.reserve(pointCount * 2);
+        properties.resize(pointCount);
+    }
+
+    Level& leafLevel = level(options.maxZoom + 1);
+    leafLevel.size = static_cast<uint32_t>(pointCount);
+
+    const std::size_t chunks = (pointCount + chunkSize - 1) / chunkSize;
+    util::parallelFor(*Scheduler::GetBackground(), chunks, [&](const std::size_t chunk) {
+        const std::size_t begin = chunk * chunkSize;
+        const std::size_t end = std::min(pointCount, (chunk + 1) * chunkSize);
+        std::vector<const PropertyMap*> chunkProperties;
+        for (std::size_t i = begin; i < end; ++i) {
+            const auto& pointFeature = (*features)[pointFeatures[i]];
+            const auto position = project(pointFeature.geometry.get<mapbox::geometry::point<double>>());
+            Point& point = points[i];
+            point.x = position.x;
+            point.y = position.y;
+            point.numPoints = 1;
+            point.id = pointFeatures[i];
+            if (options.reduce) {
+                chunkProperties.push_back(&pointFeature.properties);
+            }
+        }
+        if (options.reduce) {
+            auto mapped = mapProperties(chunkProperties);
+            std::move(mapped.begin(), mapped.end(), properties.begin() + begin);
+        }
+    });
+    leafLevel.buildTree();
+}
+
+void ClusterIndex::clusterLevel(const uint8_t zoom) {
+    Level& previous = level(zoom + 1);
+    Level& current = level(zoom);
+    const double r = radiusAt(zoom);
+
+    // Reserve up front, so references into the previous level stay valid.
+    if (points.capacity() < points.size() + previous.size) {
+        points.reserve(std::max(points.capacity() * 2, points.size() + previous.size));
+        if (options.reduce) {
+            properties.reserve(points.capacity());
+        }
+    }
+    current.begin = points.size();
+
+    std::vector<bool> visited(previous.size, false);
+    std::vector<uint32_t> members;
+    uint32_t unclustered = 0;
+    for (uint32_t i = 0; i < previous.size; ++i) {
+        if (visited[i]) continue;
+        visited[i] = true;
+
+        const Point& origin = previous[i];
+        const auto index = static_cast<uint32_t>(points.size() - current.begin);
+
+        // Collect the unprocessed neighbors, in the order of the spatial index.
+        // The origin is kept in that order too, as it defines the child order.
+        // Points past the indices that fit in a cluster ID can't start a cluster,
+        // but can still join the cluster of another point.
+        uint32_t numPoints = origin.numPoints;
+        members.clear();
+        if (i <= maxClusterIndex) {
+            previous.within(origin.x, origin.y, r, [&](uint32_t neighbor) {
+                if (neighbor == i) {
+                    members.push_back(neighbor);
+                } else if (!visited[neighbor]) {
+                    members.push_back(neighbor);
+                    numPoints += previous[neighbor].numPoints;
+                }
+            });
+        } else {
+            ++unclustered;
+        }
+
+        if (numPoints < 2 || i > maxClusterIndex) {
+            // Not enough points to form a cluster, carry the point over.
+            previous[i].next = index;
+            points.push_back({origin.x, origin.y, origin.numPoints, origin.id});
+            if (options.reduce) {
+                properties.push_back(previous.getProperties(i));
+            }
+            continue;
+        }
+
+        const uint32_t id = clusterID(i, zoom);
+        double weightX = origin.x * double(origin.numPoints);
+        double weightY = origin.y * double(origin.numPoints);
+        uint32_t firstChild = none;
+        uint32_t lastChild = none;
+        for (const uint32_t member : members) {
+            Point& child = previous[member];
+            if (member != i) {
+                visited[member] = true;
+                weightX += child.x * double(child.numPoints);
+                weightY += child.y * double(child.numPoints);
+            }
+            child.parentID = id;
+            child.next = index;
+            if (lastChild == none) {
+                firstChild = member;
+            } else {
+                previous[lastChild].nextSibling = member;
+            }
+            lastChild = member;
+        }
+
+        Point cluster{weightX / double(numPoints), weightY / double(numPoints), numPoints, id};
+        cluster.firstChild = firstChild;
+        points.push_back(cluster);
+        if (options.reduce) {
+            properties.emplace_back(); // Aggregated below.
+        }
+    }
+    current.size = static_cast<uint32_t>(points.size() - current.begin);
+    if (unclustered > 0) {
+        Log::Warning(Event::General,
+                     "Cluster index: " + util::toString(unclustered) + " of " + util::toString(previous.size) +
+                         " points on zoom " + util::toString(int(zoom) + 1) + " can't start a cluster");
+    }
+
+    // Aggregate cluster properties while the spatial index is built.
+    const std::size_t chunks = options.reduce ? (current.size + chunkSize - 1) / chunkSize : 0;
+    util::parallelFor(*Scheduler::GetBackground(), chunks + 1, [&](const std::size_t chunk) {
+        if (chunk == chunks) {
+            current.buildTree();
+            return;
+        }
+        // Merge the clusters of the chunk in one batch.
+        std::vector<uint32_t> clusters;
+        std::vector<PropertyMap> clusterProperties;
+        std::vector<Options::Member> members;
+        const uint32_t end = std::min<uint32_t>(current.size, static_cast<uint32_t>((chunk + 1) * chunkSize));
+        for (auto i = static_cast<uint32_t>(chunk * chunkSize); i < end; ++i) {
+            const Point& cluster = current[i];
+            if (cluster.firstChild == none) {
+                continue;
+            }
+            // Start from the properties of the origin, then merge the other members.
+            const uint32_t origin = cluster.id >> 5;
+            auto originProperties = previous.getProperties(origin);
+            clusters.push_back(i);
+            clusterProperties.push_back(originProperties ? *originProperties : PropertyMap{});
+            for (uint32_t child = cluster.firstChild; child != none; child = previous[child].nextSibling) {
+                if (child == origin) continue;
+                if (auto childProperties = previous.getProperties(child)) {
+                    members.emplace_back(clusters.size() - 1, childProperties.get());
+                }
+            }
+        }
+        if (!members.empty()) {
+            options.reduce(clusterProperties, members);
+        }
+        for (std::size_t k = 0; k < clusters.size(); ++k) {
+            current.setProperties(clusters[k], std::make_shared<const PropertyMap>(std::move(clusterProperties[k])));
+        }
+    });
+}
+
+uint8_t ClusterIndex::limitZoom(const uint8_t z) const {
+    if (z < options.minZoom) return options.minZoom;
+    if (z > options.maxZoom + 1) return options.maxZoom + 1;
+    return z;
+}
+
+double ClusterIndex::radiusAt(const uint8_t zoom) const {
+    return options.radius / (options.extent * std::pow(2, zoom));
+}
+
+ClusterIndex::TileFeatures ClusterIndex::getTile(const uint8_t z, const uint32_t x_, const uint32_t y) const {
+    TileFeatures result;
+    const Level& zoom = level(limitZoom(z));
+
+    const auto z2 = static_cast<uint32_t>(std::pow(2, z));
+    const double r = static_cast<double>(options.radius) / options.extent;
+    auto x = static_cast<int32_t>(x_);
+
+    const auto visitor = [&](uint32_t i) {
+        const Point& point = zoom[i];
+        if (point.numPoints == 0) {
+            return;
+        }
+        const mapbox::geometry::point<int16_t> position(
+            static_cast<int16_t>(::round(options.extent * (point.x * z2 - x))),
+            static_cast<int16_t>(::round(options.extent * (point.y * z2 - y))));
+        if (point.numPoints == 1) {
+            // Points keep their original properties and identifier.
+            const auto& pointFeature = feature(point.id);
+            result.emplace_back(position, pointFeature.properties, pointFeature.id);
+        } else {
+            result.emplace_back(position,
+                                clusterProperties(point, zoom.getProperties(i)),
+                                FeatureIdentifier(static_cast<uint64_t>(point.id)));
+        }
+    };
+
+    const double top = (y - r) / z2;
+    const double bottom = (y + 1 + r) / z2;
+
+    zoom.range((x - r) / z2, top, (x + 1 + r) / z2, bottom, visitor);
+
+    // Include points from the other side of the antimeridian.
+    if (x_ == 0) {
+        x = static_cast<int32_t>(z2);
+        zoom.range(1 - r / z2, top, 1, bottom, visitor);
+    }
+    if (x_ == z2 - 1) {
+        x = -1;
+        zoom.range(0, top, r / z2, bottom, visitor);
+    }
+
+    return result;
+}
+
+template <typename Fn>
+void ClusterIndex::eachChild(const uint32_t clusterID_, Fn&& fn) const {
+    const uint32_t originID = clusterID_ >> 5;
+    const uint32_t originZoom = clusterID_ % 32;
+    if (originZoom < options.minZoom || originZoom > options.maxZoom + 1u) {
+        throw std::runtime_error("No cluster with the specified id.");
+    }
+    const Level& origins = level(static_cast<uint8_t>(originZoom));
+    if (originID >= origins.count()) {
+        throw std::runtime_error("No cluster with the specified id.");
+    }
+
+    const Point& origin = origins[originID];
+    bool hasChildren = false;
+    if (originZoom > options.minZoom && origin.parentID == clusterID_) {
+        const Point& cluster = level(static_cast<uint8_t>(originZoom - 1))[origin.next];
+        for (uint32_t child = cluster.firstChild; child != none; child = origins[child].nextSibling) {
+            if (origins[child].numPoints != 0) {
+                fn(origins[child], origins.getProperties(child));
+                hasChildren = true;
+            }
+        }
+    }
+
+    if (!hasChildren) {
+        throw std::runtime_error("No children found");
+    }
+}
+
+template <typename Fn>
+void ClusterIndex::eachLeaf(
+    const uint32_t clusterID_, uint32_t& limit, const uint32_t offset, uint32_t& skipped, Fn&& fn) const {
+    eachChild(clusterID_, [&](const Point& child, const PropertiesPtr& childProperties) {
+        if (limit == 0) return;
+        if (child.numPoints > 1) {
+            if (skipped + child.numPoints <= offset) {
+                // Skip the whole cluster.
+                skipped += child.numPoints;
+            } else {
+                eachLeaf(child.id, limit, offset, skipped, fn);
+            }
+        } else if (skipped < offset) {
+            skipped++;
+        } else {
+            fn(child, childProperties);
+            limit--;
+        }
+    });
+}
+
+ClusterIndex::Features ClusterIndex::getChildren(const uint32_t clusterID_) const {
+    Features children;
+    eachChild(clusterID_, [&](const Point& child, const PropertiesPtr& childProperties) {
+        children.push_back(toGeoJSON(child, childProperties));
+    });
+    return children;
+}
+
+ClusterIndex::Features ClusterIndex::getLeaves(const uint32_t clusterID_,
+                                               const uint32_t limit,
+                                               const uint32_t offset) const {
+    Features leafFeatures;
+    uint32_t remaining = limit;
+    uint32_t skipped = 0;
+    eachLeaf(clusterID_, remaining, offset, skipped, [&](const Point& leaf, const PropertiesPtr& leafProperties) {
+        leafFeatures.push_back(toGeoJSON(leaf, leafProperties));
+    });
+    return leafFeatures;
+}
+
+uint8_t ClusterIndex::getClusterExpansionZoom(uint32_t clusterID_) const {
+    uint32_t clusterZoom = (clusterID_ % 32) - 1;
+    while (clusterZoom <= options.maxZoom) {
+        uint32_t numChildren = 0;
+        eachChild(clusterID_, [&](const Point& child, const PropertiesPtr&) {
+            numChildren++;
+            clusterID_ = child.id;
+        });
+        clusterZoom++;
+        if (numChildren != 1) break;
+    }
+    return static_cast<uint8_t>(clusterZoom);
+}
+
+GeoJSONFeature ClusterIndex::toGeoJSON(const Point& point, const PropertiesPtr& pointProperties) const {
+    if (point.numPoints == 1) {
+        return feature(point.id);
+    }
+    const LatLng position = unproject(point.x, point.y);
+    return {mapbox::geometry::point<double>{position.longitude(), position.latitude()},
+            clusterProperties(point, pointProperties),
+            FeatureIdentifier(static_cast<uint64_t>(point.id))};
+}
+
+std::vector<ClusterIndex::PropertiesPtr> ClusterIndex::mapProperties(
+    const std::vector<const PropertyMap*>& pointProperties) const {
+    std::vector<PropertiesPtr> result;
+    result.reserve(pointProperties.size());
+    if (options.map) {
+        auto mapped = options.map(pointProperties);
+        assert(mapped.size() == pointProperties.size());
+        for (auto& value : mapped) {
+            result.push_back(std::make_shared<const PropertyMap>(std::move(value)));
+        }
+    } else {
+        for (const auto* value : pointProperties) {
+            result.push_back(std::make_shared<const PropertyMap>(*value));
+        }
+    }
+    return result;
+}
+
+PropertyMap ClusterIndex::clusterProperties(const Point& point, const PropertiesPtr& pointProperties) const {
+    PropertyMap result{{"cluster", true},
+                       {"cluster_id", static_cast<uint64_t>(point.id)},
+                       {"point_count", static_cast<uint64_t>(point.numPoints)}};
+    std::stringstream ss;
+    if (point.numPoints >= 1000) {
+        ss << std::fixed;
+        if (point.numPoints < 10000) {
+            ss << std::setprecision(1);
+        } else {
+            ss << std::setprecision(0);
+        }
+        ss << double(point.numPoints) / 1000 << "k";
+    } else {
+        ss << point.numPoints;
+    }
+    result.emplace("point_count_abbreviated", ss.str());
+    if (pointProperties) {
+        for (const auto& property : *pointProperties) {
+            result.emplace(property);
+        }
+    }
+    return result;
+}
+
+ClusterIndex::Features ClusterIndex::getFeatures() const {
+    Features result;
+    result.reserve(pointCount);
+    for (std::size_t i = 0; i < leaves.size(); ++i) {
+        if (leaves[i] != none) {
+            result.push_back(feature(static_cast<uint32_t>(i)));
+        }
+    }
+    return result;
+}
+
+std::size_t ClusterIndex::size() const {
+    return pointCount;
+}
+
+std::size_t ClusterIndex::getUpdateCount() const {
+    return updateCount;
+}
+
+std::shared_ptr<ClusterIndex> ClusterIndex::update(const std::vector<FeatureIdentifier>& remove_,
+                                                   const Features& add,
+                                                   ChangedBounds* changed) const {
+    auto result = std::shared_ptr<ClusterIndex>(new ClusterIndex(*this));
+    for (const auto& id : remove_) {
+        result->remove(id, changed);
+    }
+    for (const auto& added : add) {
+        if (!added.id.is<NullValue>()) {
+            result->remove(added.id, changed);
+        }
+        result->insert(added, changed);
+    }
+    return result;
+}
+
+uint32_t ClusterIndex::findFeature(const FeatureIdentifier& id) const {
+    auto added = addedFeatureIndices.find(id);
+    if (added != addedFeatureIndices.end()) {
+        return added->second;
+    }
+    auto it = featureIndices->find(id);
+    return it == featureIndices->end() ? none : it->second;
+}
+
+void ClusterIndex::insert(const GeoJSONFeature& added, ChangedBounds* changed) {
+    if (!added.geometry.is<mapbox::geometry::point<double>>()) {
+        return;
+    }
+
+    const auto featureIndex = static_cast<uint32_t>(leaves.size());
+    addedFeatures.push_back(added);
+    if (!added.id.is<NullValue>()) {
+        addedFeatureIndices[added.id] = featureIndex;
+    }
+    ++pointCount;
+    ++updateCount;
+
+    PropertiesPtr pointProperties;
+    if (options.reduce) {
+        pointProperties = mapProperties({&added.properties}).front();
+    }
+
+    const auto position = project(added.geometry.get<mapbox::geometry::point<double>>());
+    auto zoom = static_cast<uint8_t>(options.maxZoom + 1);
+    uint32_t index = level(zoom).add({position.x, position.y, 1, featureIndex}, pointProperties);
+    leaves.push_back(index);
+    extend(changed, zoom, position.x, position.y);
+
+    // Walk down the zoom levels until the point joins a cluster.
+    while (zoom > options.minZoom) {
+        const auto target = static_cast<uint8_t>(zoom - 1);
+        Level& upper = level(zoom);
+        Level& lower = level(target);
+        const double r = radiusAt(target);
+
+        // Prefer joining a cluster whose origin is in range, so the point is
+        // found as its child; otherwise pair up with an unclustered point.
+        uint32_t origin = none;
+        uint32_t single = none;
+        double originDistance = std::numeric_limits<double>::infinity();
+        double singleDistance = std::numeric_limits<double>::infinity();
+        upper.within(position.x, position.y, r, [&](uint32_t i) {
+            const Point& other = upper[i];
+            if (i == index || other.numPoints == 0) {
+                return;
+            }
+            const double dx = other.x - position.x;
+            const double dy = other.y - position.y;
+            const double distance = dx * dx + dy * dy;
+            if (i <= maxClusterIndex && other.parentID == clusterID(i, target)) {
+                if (distance < originDistance) {
+                    origin = i;
+                    originDistance = distance;
+                }
+            } else if (other.parentID == 0 && distance < singleDistance) {
+                single = i;
+                singleDistance = distance;
+            }
+        });
+
+        Point& point = upper[index];
+        if (origin != none) {
+            const uint32_t cluster = upper[origin].next;
+            point.parentID = upper[origin].parentID;
+            point.next = cluster;
+            uint32_t last = lower[cluster].firstChild;
+            while (upper[last].nextSibling != none) {
+                last = upper[last].nextSibling;
+            }
+            upper[last].nextSibling = index;
+            recompute(target, cluster, changed);
+            propagate(target, cluster, changed);
+            return;
+        }
+
+        if (single != none && single <= maxClusterIndex) {
+            // The unclustered point and the new one form a new cluster, which
+            // takes the place of the copy of the unclustered point.
+            Point& other = upper[single];
+            const uint32_t cluster = other.next;
+            Point& copy = lower[cluster];
+            copy.id = clusterID(single, target);
+            copy.firstChild = single;
+            other.parentID = copy.id;
+            other.nextSibling = index;
+            point.parentID = copy.id;
+            point.next = cluster;
+            recompute(target, cluster, changed);
+            propagate(target, cluster, changed);
+            return;
+        }
+
+        // Not clustered on this level either: carry the point over.
+        const uint32_t copy = lower.add({position.x, position.y, 1, featureIndex}, pointProperties);
+        upper[index].next = copy;
+        extend(changed, target, position.x, position.y);
+        index = copy;
+        zoom = target;
+    }
+}
+
+void ClusterIndex::remove(const FeatureIdentifier& id, ChangedBounds* changed) {
+    // Removed features keep their identifier, but no longer have a leaf.
+    const uint32_t featureIndex = findFeature(id);
+    if (featureIndex == none) {
+        return;
+    }
+    const uint32_t leaf = leaves[featureIndex];
+    if (leaf == none) {
+        return;
+    }
+    leaves[featureIndex] = none;
+    --pointCount;
+    ++updateCount;
+
+    const auto zoom = static_cast<uint8_t>(options.maxZoom + 1);
+    Point& point = level(zoom)[leaf];
+    extend(changed, zoom, point.x, point.y);
+    point.numPoints = 0;
+    propagate(zoom, leaf, changed);
+}
+
+// Recomputes a cluster from its remaining members. A cluster left with a
+// single point becomes a copy of that point.
+void ClusterIndex::recompute(const uint8_t zoom, const uint32_t index, ChangedBounds* changed) {
+    Level& current = level(zoom);
+    Level& children = level(zoom + 1);
+    Point& cluster = current[index];
+    extend(changed, zoom, cluster.x, cluster.y);
+
+    uint32_t numPoints = 0;
+    double weightX = 0;
+    double weightY = 0;
+    uint32_t last = none;
+    for (uint32_t child = cluster.firstChild; child != none;) {
+        Point& point = children[child];
+        const uint32_t nextSibling = point.nextSibling;
+        if (point.numPoints == 0) {
+            // Unlink removed members.
+            if (last == none) {
+                cluster.firstChild = nextSibling;
+            } else {
+                children[last].nextSibling = nextSibling;
+            }
+            point.nextSibling = none;
+        } else {
+            numPoints += point.numPoints;
+            weightX += point.x * double(point.numPoints);
+            weightY += point.y * double(point.numPoints);
+            last = child;
+        }
+        child = nextSibling;
+    }
+
+    if (numPoints == 0) {
+        cluster.numPoints = 0;
+        return;
+    }
+
+    if (numPoints == 1) {
+        Point& point = children[last];
+        point.parentID = 0;
+        cluster.firstChild = none;
+        cluster.x = point.x;
+        cluster.y = point.y;
+        cluster.numPoints = 1;
+        cluster.id = point.id;
+        current.setProperties(index, children.getProperties(last));
+    } else {
+        cluster.x = weightX / double(numPoints);
+        cluster.y = weightY / double(numPoints);
+        cluster.numPoints = numPoints;
+        if (options.reduce) {
+            const uint32_t origin = cluster.id >> 5;
+            const bool hasOrigin = origin < children.count() && children[origin].numPoints != 0 &&
+                                   children[origin].parentID == cluster.id;
+            const uint32_t first = hasOrigin ? origin : cluster.firstChild;
+            auto firstProperties = children.getProperties(first);
+            std::vector<PropertyMap> clusterProperties{firstProperties ? *firstProperties : PropertyMap{}};
+            std::vector<Options::Member> members;
+            for (uint32_t child = cluster.firstChild; child != none; child = children[child].nextSibling) {
+                if (child == first) continue;
+                if (auto childProperties = children.getProperties(child)) {
+                    members.emplace_back(0, childProperties.get());
+                }
+            }
+            if (!members.empty()) {
+                options.reduce(clusterProperties, members);
+            }
+            current.setProperties(index, std::make_shared<const PropertyMap>(std::move(clusterProperties.front())));
+        }
+    }
+
+    current.markStale(index);
+    extend(changed, zoom, cluster.x, cluster.y);
+}
+
+// Carries a change of a point or cluster over to the lower zoom levels.
+void ClusterIndex::propagate(uint8_t zoom, uint32_t index, ChangedBounds* changed) {
+    while (zoom > options.minZoom) {
+        const auto target = static_cast<uint8_t>(zoom - 1);
+        Level& lower = level(target);
+        Point& point = level(zoom)[index];
+        const uint32_t next = point.next;
+
+        if (point.parentID != 0) {
+            recompute(target, next, changed);
+        } else if (point.numPoints == 0) {
+            Point& copy = lower[next];
+            extend(changed, target, copy.x, copy.y);
+            copy.numPoints = 0;
+        } else if (point.numPoints > 1 && index <= maxClusterIndex) {
+            // The point became a cluster, which starts a cluster on the lower level.
+            Point& copy = lower[next];
+            copy.id = clusterID(index, target);
+            copy.firstChild = index;
+            point.parentID = copy.id;
+            point.nextSibling = none;
+            recompute(target, next, changed);
+        } else {
+            // The copy on the lower level is unaffected.
+            return;
+        }
+
+        index = next;
+        zoom = target;
+    }
+}
+
+} // namespace mbgl
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <mbgl/util/feature.hpp>
+
+#include <mapbox/geometry/box.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace mbgl {
+
+/*
+ ClusterIndex groups points into clusters for every zoom level between
+ `minZoom` and `maxZoom`, using the same greedy algorithm as supercluster.hpp:
+ a fresh index produces the same clusters, cluster IDs and tile contents.
+ Cluster IDs hold the index of a point on its zoom level in 27 bits: points
+ past that index can't start a cluster, and are reported as a warning.
+
+ All zoom levels live in one flat point buffer. Clustering a zoom level needs
+ the level above it, so levels are clustered one after another; point
+ projection, `map` evaluation, cluster property aggregation and the spatial
+ index of each level are computed in parallel on the background thread pool.
+
+ Points can be inserted and removed after the index has been built. Updates
+ attach new points to a nearby cluster (or turn a nearby point into one) and
+ recompute the affected clusters on every level, without clustering the
+ levels again. Clusters therefore drift away from what a fresh build would
+ produce; `getUpdateCount()` lets owners decide when to rebuild. As long as
+ fewer than a quarter of the points have been updated, the number of points
+ and clusters on a zoom level stays within a quarter of a fresh build.
+
+ An index doesn't change once built: updates are applied to a copy, which
+ shares the features the index was built from. Indexes can therefore be read
+ from any thread, while an update is prepared.
+*/
+class ClusterIndex {
+public:
+    using Features = mapbox::feature::feature_collection<double>;
+    using TileFeatures = mapbox::feature::feature_collection<int16_t>;
+    using Box = mapbox::geometry::box<double>;
+
+    class Options {
+    public:
+        uint8_t minZoom = 0;  // min zoom to generate clusters on
+        uint8_t maxZoom = 16; // max zoom level to cluster the points on
+        uint16_t radius = 40; // cluster radius in pixels
+        uint16_t extent = 512;
+
+        // A cluster member to merge: the index of its cluster in the batch, and its properties.
+        using Member = std::pair<std::size_t, const PropertyMap*>;
+
+        // Map the properties of points to the properties aggregated into their
+        // clusters, one result per point, and merge the properties of cluster
+        // members into the properties of their clusters, in the given order.
+        // Both are called with batches of points and clusters, so that each
+        // expression can be evaluated over a whole batch. Cluster properties are
+        // only maintained if `reduce` is set. Both may be called concurrently.
+        std::function<std::vector<PropertyMap>(const std::vector<const PropertyMap*>&)> map;
+        std::function<void(std::vector<PropertyMap>&, const std::vector<Member>&)> reduce;
+    };
+
+    /// Projected bounds of the points and clusters changed by an update, per zoom level.
+    using ChangedBounds = std::map<uint8_t, Box>;
+
+    ClusterIndex(Features, Options);
+    ~ClusterIndex();
+
+    TileFeatures getTile(uint8_t z, uint32_t x, uint32_t y) const;
+    Features getChildren(uint32_t clusterID) const;
+    Features getLeaves(uint32_t clusterID, uint32_t limit = 10, uint32_t offset = 0) const;
+    uint8_t getClusterExpansionZoom(uint32_t clusterID) const;
+
+    /// Returns the indexed features that are still present, in insertion order.
+    Features getFeatures() const;
+
+    /// Number of indexed points.
+    std::size_t size() const;
+    /// Number of points inserted or removed since the index was built.
+    std::size_t getUpdateCount() const;
+
+    /// Returns a copy of the index with the features with the given
+    /// identifiers removed, then the given features added. Added features
+    /// replace indexed features with the same identifier. Features that are
+    /// not points are ignored.
+    std::shared_ptr<ClusterIndex> update(const std::vector<FeatureIdentifier>& remove,
+                                         const Features& add,
+                                         ChangedBounds* = nullptr) const;
+
+private:
+    ClusterIndex(const ClusterIndex&);
+
+    static constexpr uint32_t none = UINT32_MAX;
+
+    // A point or cluster on one zoom level. Points that are not clustered on
+    // a level are carried over to the next one as a copy with the same ID.
+    class Point {
+    public:
+        double x;
+        double y;
+        uint32_t numPoints; // 0 for removed points
+        uint32_t id;        // feature index for points, cluster ID for clusters
+        uint32_t parentID = 0;
+        uint32_t next = none;       // the cluster or copy representing this point on the next zoom level
+        uint32_t firstChild = none; // members of a cluster, on the previous zoom level
+        uint32_t nextSibling = none;
+    };
+
+    using PropertiesPtr = std::shared_ptr<const PropertyMap>;
+
+    class Level;
+
+    void buildLeaves();
+    void clusterLevel(uint8_t zoom);
+    uint8_t limitZoom(uint8_t z) const;
+    double radiusAt(uint8_t zoom) const;
+    Level& level(uint8_t zoom) { return *levels[zoom - options.minZoom]; }
+    const Level& level(uint8_t zoom) const { return *levels[zoom - options.minZoom]; }
+
+    template <typename Fn>
+    void eachChild(uint32_t clusterID, Fn&&) const;
+    template <typename Fn>
+    void eachLeaf(uint32_t clusterID, uint32_t& limit, uint32_t offset, uint32_t& skipped, Fn&&) const;
+    const GeoJSONFeature& feature(uint32_t index) const {
+        return index < features->size() ? (*features)[index] : addedFeatures[index - features->size()];
+    }
+    uint32_t findFeature(const FeatureIdentifier&) const;
+    GeoJSONFeature toGeoJSON(const Point&, const PropertiesPtr&) const;
+    std::vector<PropertiesPtr> mapProperties(const std::vector<const PropertyMap*>&) const;
+    PropertyMap clusterProperties(const Point&, const PropertiesPtr&) const;
+
+    // Incremental updates.
+    void insert(const GeoJSONFeature&, ChangedBounds*);
+    void remove(const FeatureIdentifier&, ChangedBounds*);
+    void recompute(uint8_t zoom, uint32_t index, ChangedBounds*);
+    void propagate(uint8_t zoom, uint32_t index, ChangedBounds*);
+
+    const Options options;
+    // The features the index was built from, and those added by updates since.
+    std::shared_ptr<const Features> features;
+    std::shared_ptr<const std::map<FeatureIdentifier, uint32_t>> featureIndices;
+    Features addedFeatures;
+    std::map<FeatureIdentifier, uint32_t> addedFeatureIndices;
+    std::vector<uint32_t> leaves; // Leaf point of each feature, `none` for removed features and other geometries.
+    std::size_t pointCount = 0;
+    std::size_t updateCount = 0;
+
+    std::vector<Point> points; // Points of all zoom levels, level after level.
+    std::vector<PropertiesPtr> properties;
+    std::vector<std::unique_ptr<Level>> levels;
+};
+
+} // namespace mbgl
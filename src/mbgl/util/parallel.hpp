@@ -0,0 +1,81 @@
+#pragma once
+
+#include <mbgl/actor/scheduler.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace mbgl {
+namespace util {
+
+/**
+ * @brief Runs `fn(i)` for every `i` in `[0, count)`, spreading the work over
+ * the given scheduler, and returns once all of the invocations have finished.
+ *
+ * The calling thread takes part in the work, so this is safe to call from a
+ * task that is itself running on `scheduler`: if no worker becomes available
+ * the caller simply processes every item on its own.
+ *
+ * `fn` must be safe to invoke concurrently for distinct indices.
+ */
+template <typename Fn>
+void parallelFor(Scheduler& scheduler, const std::size_t count, Fn&& fn, std::size_t maxWorkers = 4) {
+    if (count == 0) {
+        return;
+    }
+    if (count == 1 || maxWorkers == 0) {
+        for (std::size_t i = 0; i < count; ++i) {
+            fn(i);
+        }
+        return;
+    }
+
+    struct State {
+        std::function<void(std::size_t)> fn;
+        std::size_t count;
+        std::atomic<std::size_t> next{0};
+        std::size_t finished = 0;
+        std::mutex mutex;
+        std::condition_variable cv;
+
+        // Claims items until none are left; returns once this thread has no more work.
+        void drain() {
+            std::size_t done = 0;
+            for (std::size_t i = next++; i < count; i = next++) {
+                fn(i);
+                ++done;
+            }
+            if (done) {
+                std::lock_guard<std::mutex> lock(mutex);
+                finished += done;
+                if (finished == count) {
+                    cv.notify_all();
+                }
+            }
+        }
+    };
+
+    // Workers may only get to run after the caller has returned, so the state is
+    // shared. Such late workers find no items left and never touch `fn`.
+    auto state = std::make_shared<State>();
+    state->fn = std::forward<Fn>(fn);
+    state->count = count;
+
+    const std::size_t workers = std::min(count - 1, maxWorkers);
+    for (std::size_t i = 0; i < workers; ++i) {
+        scheduler.schedule([state] { state->drain(); });
+    }
+
+    state->drain();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->cv.wait(lock, [&] { return state->finished == state->count; });
+}
+
+} // namespace util
+} // namespace mbgl
@@ -5,8 +5,71 @@
 #include <mbgl/util/platform.hpp>
 #include <mbgl/util/string.hpp>
 
+#include <atomic>
+#include <ctime>
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
 namespace mbgl {
 
+namespace {
+
+std::atomic<bool> cpuTimeTracking{false};
+
+// CPU time counters of the live scheduler threads. Never destroyed, as threads
+// of static schedulers may still unregister during static destruction.
+struct ThreadCPUTimes {
+    std::mutex mutex;
+    uint64_t nextID = 0;
+    std::map<uint64_t, const std::atomic<Duration::rep>*> threads;
+};
+
+ThreadCPUTimes& threadCPUTimes() {
+    static auto* instance = new ThreadCPUTimes();
+    return *instance;
+}
+
+} // namespace
+
+void ThreadedSchedulerBase::setCPUTimeTracking(bool enabled) {
+    cpuTimeTracking = enabled;
+}
+
+std::map<uint64_t, Duration> ThreadedSchedulerBase::getThreadCPUTimes() {
+    auto& registry = threadCPUTimes();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    std::map<uint64_t, Duration> result;
+    for (const auto& thread : registry.threads) {
+        result.emplace(thread.first, Duration(thread.second->load()));
+    }
+    return result;
+}
+
+Duration ThreadedSchedulerBase::getCurrentThreadCPUTime() {
+#if defined(_WIN32)
+    FILETIME creation;
+    FILETIME exit;
+    FILETIME kernel;
+    FILETIME user;
+    if (GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user)) {
+        const auto ticks = [](const FILETIME& time) {
+            return (uint64_t(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+        };
+        // FILETIME counts in units of 100 ns.
+        return std::chrono::duration_cast<Duration>(std::chrono::nanoseconds(100 * (ticks(kernel) + ticks(user))));
+    }
+#elif defined(CLOCK_THREAD_CPUTIME_ID)
+    timespec time{};
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) == 0) {
+        return std::chrono::duration_cast<Duration>(std::chrono::seconds(time.tv_sec) +
+                                                    std::chrono::nanoseconds(time.tv_nsec));
+    }
+#endif
+    return Duration::zero();
+}
+
 ThreadedSchedulerBase::~ThreadedSchedulerBase() = default;
 
 void ThreadedSchedulerBase::terminate() {
@@ -28,12 +91,24 @@ std::thread ThreadedSchedulerBase::makeSchedulerThread(size_t index) {
         platform::setCurrentThreadName(std::string{"Worker "} + util::toString(index + 1));
         platform::attachThread();
 
+        std::atomic<Duration::rep> cpuTime{0};
+        uint64_t id = 0;
+        {
+            auto& registry = threadCPUTimes();
+            std::lock_guard<std::mutex> registryLock(registry.mutex);
+            id = registry.nextID++;
+            registry.threads.emplace(id, &cpuTime);
+        }
+
         while (true) {
             std::unique_lock<std::mutex> lock(mutex);
 
             cv.wait(lock, [this] { return !queue.empty() || terminated; });
 
             if (terminated) {
+                auto& registry = threadCPUTimes();
+                std::lock_guard<std::mutex> registryLock(registry.mutex);
+                registry.threads.erase(id);
                 platform::detachThread();
                 return;
             }
@@ -41,7 +116,14 @@ std::thread ThreadedSchedulerBase::makeSchedulerThread(size_t index) {
             auto function = std::move(queue.front());
             queue.pop();
             lock.unlock();
-            if (function) function();
+            if (!function) continue;
+            if (cpuTimeTracking) {
+                const auto start = getCurrentThreadCPUTime();
+                function();
+                cpuTime += (getCurrentThreadCPUTime() - start).count();
+            } else {
+                function();
+            }
         }
     });
 }
@@ -2,9 +2,12 @@
 
 #include <mbgl/actor/mailbox.hpp>
 #include <mbgl/actor/scheduler.hpp>
+#include <mbgl/util/chrono.hpp>
 
 #include <array>
 #include <condition_variable>
+#include <cstdint>
+#include <map>
 #include <mutex>
 #include <queue>
 #include <thread>
@@ -15,6 +18,16 @@ class ThreadedSchedulerBase : public Scheduler {
 public:
     void schedule(std::function<void()>) override;
 
+    /// Enables measuring the CPU time that the threads of all schedulers spend running tasks.
+    static void setCPUTimeTracking(bool);
+
+    /// CPU time spent running tasks by each live scheduler thread while tracking was enabled,
+    /// keyed by an ID unique to the thread.
+    static std::map<uint64_t, Duration> getThreadCPUTimes();
+
+    /// CPU time used by the calling thread so far, or zero where it can't be measured.
+    static Duration getCurrentThreadCPUTime();
+
 protected:
     ThreadedSchedulerBase() = default;
     ~ThreadedSchedulerBase() override;
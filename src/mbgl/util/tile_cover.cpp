@@ -278,6 +278,34 @@ std::vector<OverscaledTileID> tileCover(const TransformState& state,
     return ids;
 }
 
+const std::vector<OverscaledTileID>& TileCoverCache::get(const TransformState& state,
+                                                         uint8_t z,
+                                                         const std::optional<uint8_t>& overscaledZ) {
+    if (!matches(state)) {
+        invProjMatrix = state.getInvProjectionMatrix();
+        scale = state.getScale();
+        pitch = state.getPitch();
+        size = state.getSize();
+        viewportMode = state.getViewportMode();
+        valid = true;
+        covers.clear();
+    }
+
+    auto it = covers.find({z, overscaledZ.value_or(z)});
+    if (it != covers.end()) {
+        hits++;
+        return it->second;
+    }
+
+    misses++;
+    return covers.emplace(std::make_pair(z, overscaledZ.value_or(z)), tileCover(state, z, overscaledZ)).first->second;
+}
+
+bool TileCoverCache::matches(const TransformState& state) const {
+    return valid && scale == state.getScale() && pitch == state.getPitch() && size == state.getSize() &&
+           viewportMode == state.getViewportMode() && invProjMatrix == state.getInvProjectionMatrix();
+}
+
 std::vector<UnwrappedTileID> tileCover(const LatLngBounds& bounds_, uint8_t z) {
     if (bounds_.isEmpty() || bounds_.south() > util::LATITUDE_MAX || bounds_.north() < -util::LATITUDE_MAX) {
         return {};
@@ -1,12 +1,17 @@
 #pragma once
 
+#include <mbgl/map/mode.hpp>
 #include <mbgl/tile/tile_id.hpp>
 #include <mbgl/style/types.hpp>
 #include <mbgl/util/geometry.hpp>
+#include <mbgl/util/mat4.hpp>
+#include <mbgl/util/size.hpp>
 
+#include <map>
 #include <vector>
 #include <memory>
 #include <optional>
+#include <utility>
 
 namespace mbgl {
 
@@ -39,6 +44,34 @@ std::vector<OverscaledTileID> tileCover(const TransformState&,
 std::vector<UnwrappedTileID> tileCover(const LatLngBounds&, uint8_t z);
 std::vector<UnwrappedTileID> tileCover(const Geometry<double>&, uint8_t z);
 
+// Keeps the covers computed for the last transform state, so that sources sharing a zoom level
+// don't compute the same cover again within a frame, or while the camera doesn't move.
+class TileCoverCache {
+public:
+    // The returned cover is valid until the cache is asked for the cover of a different state.
+    const std::vector<OverscaledTileID>& get(const TransformState&,
+                                             uint8_t z,
+                                             const std::optional<uint8_t>& overscaledZ = std::nullopt);
+
+    std::size_t getHits() const { return hits; }
+    std::size_t getMisses() const { return misses; }
+
+private:
+    bool matches(const TransformState&) const;
+
+    // Everything the cover of a transform state depends on.
+    mat4 invProjMatrix;
+    double scale = 0.0;
+    double pitch = 0.0;
+    Size size;
+    ViewportMode viewportMode = ViewportMode::Default;
+    bool valid = false;
+
+    std::map<std::pair<uint8_t, uint8_t>, std::vector<OverscaledTileID>> covers;
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+};
+
 // Compute only the count of tiles needed for tileCover
 uint64_t tileCount(const LatLngBounds&, uint8_t z);
 uint64_t tileCount(const Geometry<double>&, uint8_t z);
@@ -3,64 +3,93 @@
 #include <mbgl/util/math.hpp>
 
 #include <algorithm>
+#include <cmath>
+#include <vector>
 
 namespace mbgl {
 namespace util {
 
 namespace tinysdf {
 
-static const double INF = 1e20;
+static const float INF = 1e20f;
+
+// Temporary arrays for the distance transform. They are kept per thread, so that
+// glyphs transformed one after the other don't allocate.
+struct Scratch {
+    std::vector<float> gridOuter;
+    std::vector<float> gridInner;
+    std::vector<float> f;
+    std::vector<float> d;
+    std::vector<float> z;
+    std::vector<uint16_t> v;
+
+    void resize(uint32_t size, uint32_t maxDimension) {
+        gridOuter.resize(size);
+        gridInner.resize(size);
+        f.resize(maxDimension);
+        d.resize(maxDimension);
+        z.resize(maxDimension + 1);
+        v.resize(maxDimension);
+    }
+};
+
+// 1D squared distance transform of `f` into `d`
+void edt1d(const float* f, float* d, uint16_t* v, float* z, uint32_t n) {
+    // Cells at infinity never become part of the lower envelope, so their parabolas
+    // are skipped rather than added and removed again.
+    uint32_t q = 0;
+    while (q < n && f[q] >= INF) q++;
+    if (q == n) {
+        std::fill(d, d + n, INF);
+        return;
+    }
 
-// 1D squared distance transform
-void edt1d(
-    std::vector<double>& f, std::vector<double>& d, std::vector<int16_t>& v, std::vector<double>& z, uint32_t n) {
-    v[0] = 0;
+    uint32_t k = 0;
+    v[0] = static_cast<uint16_t>(q);
     z[0] = -INF;
     z[1] = +INF;
 
-    for (uint32_t q = 1, k = 0; q < n; q++) {
-        double s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2 * q - 2 * v[k]);
-        while (s <= z[k]) {
+    for (q++; q < n; q++) {
+        if (f[q] >= INF) continue;
+        const float fq = f[q] + static_cast<float>(q * q);
+        float s;
+        while (true) {
+            const uint32_t r = v[k];
+            s = (fq - (f[r] + static_cast<float>(r * r))) / static_cast<float>(2 * (q - r));
+            if (s > z[k]) break;
             k--;
-            s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2 * q - 2 * v[k]);
         }
         k++;
-        v[k] = q;
+        v[k] = static_cast<uint16_t>(q);
         z[k] = s;
         z[k + 1] = +INF;
     }
 
-    for (uint32_t q = 0, k = 0; q < n; q++) {
-        while (z[k + 1] < q) k++;
-        d[q] = (static_cast<double>(q) - v[k]) * (static_cast<double>(q) - v[k]) + f[v[k]];
+    k = 0;
+    for (q = 0; q < n; q++) {
+        while (z[k + 1] < static_cast<float>(q)) k++;
+        const float dq = static_cast<float>(q) - static_cast<float>(v[k]);
+        d[q] = dq * dq + f[v[k]];
     }
 }
 
-// 2D Euclidean distance transform by Felzenszwalb & Huttenlocher https://cs.brown.edu/~pff/dt/
-void edt(std::vector<double>& data,
-         uint32_t width,
-         uint32_t height,
-         std::vector<double>& f,
-         std::vector<double>& d,
-         std::vector<int16_t>& v,
-         std::vector<double>& z) {
+// 2D squared Euclidean distance transform by Felzenszwalb & Huttenlocher https://cs.brown.edu/~pff/dt/
+void edt(float* data, uint32_t width, uint32_t height, Scratch& scratch) {
+    float* f = scratch.f.data();
+    float* d = scratch.d.data();
     for (uint32_t x = 0; x < width; x++) {
         for (uint32_t y = 0; y < height; y++) {
             f[y] = data[y * width + x];
         }
-        edt1d(f, d, v, z, height);
+        edt1d(f, d, scratch.v.data(), scratch.z.data(), height);
         for (uint32_t y = 0; y < height; y++) {
             data[y * width + x] = d[y];
         }
     }
     for (uint32_t y = 0; y < height; y++) {
-        for (uint32_t x = 0; x < width; x++) {
-            f[x] = data[y * width + x];
-        }
-        edt1d(f, d, v, z, width);
-        for (uint32_t x = 0; x < width; x++) {
-            data[y * width + x] = std::sqrt(d[x]);
-        }
+        float* row = data + y * width;
+        std::copy(row, row + width, f);
+        edt1d(f, row, scratch.v.data(), scratch.z.data(), width);
     }
 }
 
@@ -72,27 +101,28 @@ AlphaImage transformRasterToSDF(const AlphaImage& rasterInput, double radius, do
 
     AlphaImage sdf(rasterInput.size);
 
-    // temporary arrays for the distance transform
-    std::vector<double> gridOuter(size);
-    std::vector<double> gridInner(size);
-    std::vector<double> f(maxDimension);
-    std::vector<double> d(maxDimension);
-    std::vector<double> z(maxDimension + 1);
-    std::vector<int16_t> v(maxDimension);
+    thread_local tinysdf::Scratch scratch;
+    scratch.resize(size, maxDimension);
+    float* gridOuter = scratch.gridOuter.data();
+    float* gridInner = scratch.gridInner.data();
+    const uint8_t* alpha = rasterInput.data.get();
 
     for (uint32_t i = 0; i < size; i++) {
-        double a = static_cast<double>(rasterInput.data[i]) / 255; // alpha value
-        gridOuter[i] = a == 1.0 ? 0.0 : a == 0.0 ? tinysdf::INF : std::pow(std::max(0.0, 0.5 - a), 2.0);
-        gridInner[i] = a == 1.0 ? tinysdf::INF : a == 0.0 ? 0.0 : std::pow(std::max(0.0, a - 0.5), 2.0);
+        const float a = static_cast<float>(alpha[i]) / 255.0f;
+        const float outer = std::max(0.0f, 0.5f - a);
+        const float inner = std::max(0.0f, a - 0.5f);
+        gridOuter[i] = alpha[i] == 255 ? 0.0f : alpha[i] == 0 ? tinysdf::INF : outer * outer;
+        gridInner[i] = alpha[i] == 255 ? tinysdf::INF : alpha[i] == 0 ? 0.0f : inner * inner;
     }
 
-    tinysdf::edt(gridOuter, rasterInput.size.width, rasterInput.size.height, f, d, v, z);
-    tinysdf::edt(gridInner, rasterInput.size.width, rasterInput.size.height, f, d, v, z);
+    tinysdf::edt(gridOuter, rasterInput.size.width, rasterInput.size.height, scratch);
+    tinysdf::edt(gridInner, rasterInput.size.width, rasterInput.size.height, scratch);
 
+    const auto scale = static_cast<float>(255.0 / radius);
+    const auto offset = static_cast<float>(255.0 - 255.0 * cutoff);
     for (uint32_t i = 0; i < size; i++) {
-        double distance = gridOuter[i] - gridInner[i];
-        sdf.data[i] = static_cast<uint8_t>(
-            std::max(0l, std::min(255l, ::lround(255.0 - 255.0 * (distance / radius + cutoff)))));
+        const float distance = std::sqrt(gridOuter[i]) - std::sqrt(gridInner[i]);
+        sdf.data[i] = static_cast<uint8_t>(std::clamp(std::lround(offset - scale * distance), 0l, 255l));
     }
 
     return sdf;
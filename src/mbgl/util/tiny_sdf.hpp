@@ -14,6 +14,9 @@ namespace util {
 
     Takes an alpha channel raster input and transforms it into an alpha channel
     Signed Distance Field (SDF) output of the same dimensions.
+
+    Safe to call from several threads at once; each thread reuses its own
+    temporary buffers across calls.
 */
 AlphaImage transformRasterToSDF(const AlphaImage& rasterInput, double radius, double cutoff);
 
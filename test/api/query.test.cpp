@@ -132,6 +132,38 @@ TEST(Query, QueryRenderedFeaturesFilter) {
     EXPECT_EQ(features3.size(), 1u);
 }
 
+TEST(Query, QueryRenderedFeaturesAsync) {
+    QueryTest test;
+
+    auto zz = test.map.pixelForLatLng({0, 0});
+    const ScreenLineString point{zz};
+    auto expected = test.frontend.getRenderer()->queryRenderedFeatures(point, {});
+    ASSERT_EQ(expected.size(), 4u);
+
+    std::optional<std::vector<Feature>> features;
+    test.frontend.getRenderer()->queryRenderedFeaturesAsync(
+        point, {}, [&](const std::vector<Feature>& result) { features = result; });
+    while (!features) {
+        test.loop.runOnce();
+    }
+
+    ASSERT_EQ(features->size(), expected.size());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ((*features)[i].id, expected[i].id);
+        EXPECT_EQ((*features)[i].properties, expected[i].properties);
+    }
+
+    // The snapshot keeps its own copy of the render state.
+    std::optional<std::vector<Feature>> filtered;
+    test.frontend.getRenderer()->queryRenderedFeaturesAsync(
+        point, {{{"layer1"}}, {}}, [&](const std::vector<Feature>& result) { filtered = result; });
+    test.map.getStyle().removeLayer("layer1");
+    while (!filtered) {
+        test.loop.runOnce();
+    }
+    EXPECT_EQ(filtered->size(), 1u);
+}
+
 TEST(Query, QuerySourceFeatures) {
     QueryTest test;
 
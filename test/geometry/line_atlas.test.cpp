@@ -2,7 +2,9 @@
 
 #include <mbgl/geometry/line_atlas.hpp>
 
+#include <algorithm>
 #include <random>
+#include <vector>
 
 using namespace mbgl;
 
@@ -29,3 +31,98 @@ TEST(LineAtlas, Random) {
         }
     }
 }
+
+TEST(LineAtlas, SharedPatterns) {
+    LineAtlas atlas;
+    const auto& first = atlas.getDashPatternTexture({1, 2}, {3, 4}, LinePatternCap::Square);
+    const auto& second = atlas.getDashPatternTexture({3, 4}, {5, 6}, LinePatternCap::Square);
+
+    // Both textures are rows of the same atlas, and share the pattern they have in common.
+    EXPECT_EQ(Size(256, 16), atlas.getSize());
+    EXPECT_FLOAT_EQ(0.5f / 16, first.getFrom().y);
+    EXPECT_FLOAT_EQ(1.5f / 16, first.getTo().y);
+    EXPECT_FLOAT_EQ(1.5f / 16, second.getFrom().y);
+    EXPECT_FLOAT_EQ(2.5f / 16, second.getTo().y);
+    EXPECT_FLOAT_EQ(1.0f / 16, second.getTo().height);
+    EXPECT_FLOAT_EQ(11.0f, second.getTo().width);
+}
+
+TEST(LineAtlas, Grow) {
+    LineAtlas atlas(64);
+    const auto& first = atlas.getDashPatternTexture({1, 2}, {1, 2}, LinePatternCap::Round);
+    EXPECT_EQ(Size(256, 16), atlas.getSize());
+    EXPECT_FLOAT_EQ(7.5f / 16, first.getFrom().y);
+
+    // The atlas doubles in height, and the positions of existing patterns are updated.
+    const auto& second = atlas.getDashPatternTexture({3, 4}, {3, 4}, LinePatternCap::Round);
+    EXPECT_EQ(Size(256, 32), atlas.getSize());
+    EXPECT_FLOAT_EQ(7.5f / 32, first.getFrom().y);
+    EXPECT_FLOAT_EQ(15.0f / 32, first.getFrom().height);
+    EXPECT_FLOAT_EQ(22.5f / 32, second.getFrom().y);
+}
+
+TEST(LineAtlas, Full) {
+    LineAtlas atlas(16);
+    const auto& first = atlas.getDashPatternTexture({1, 2}, {1, 2}, LinePatternCap::Round);
+
+    // Patterns requested during the current frame aren't evicted.
+    const auto& second = atlas.getDashPatternTexture({3, 4}, {3, 4}, LinePatternCap::Round);
+    EXPECT_EQ(Size(256, 16), atlas.getSize());
+    EXPECT_FLOAT_EQ(7.5f / 16, first.getFrom().y);
+    EXPECT_FLOAT_EQ(0.0f, second.getFrom().height);
+}
+
+TEST(LineAtlas, EvictAcrossFrames) {
+    LineAtlas atlas(16);
+    const auto rowPixels = [&](uint32_t row) {
+        const auto& image = atlas.getAtlasImageForTests();
+        const auto* begin = image.data.get() + row * image.size.width;
+        return std::vector<uint8_t>(begin, begin + image.size.width);
+    };
+
+    // Rows 0 and 1, and rows 1 and 2, with the pattern on row 1 shared by both pairs.
+    atlas.getDashPatternTexture({1, 2}, {3, 4}, LinePatternCap::Square);
+    const auto& shared = atlas.getDashPatternTexture({3, 4}, {5, 6}, LinePatternCap::Square);
+    // Fill the remaining rows.
+    std::vector<std::vector<float>> fillers;
+    for (float i = 0; i < 13; ++i) {
+        fillers.push_back({10 + i, 1});
+        atlas.getDashPatternTexture(fillers.back(), fillers.back(), LinePatternCap::Square);
+    }
+    EXPECT_EQ(Size(256, 16), atlas.getSize());
+    const auto sharedRow = rowPixels(1);
+
+    // In the next frame, every pair but the first one is requested again, so that only
+    // the first one can be evicted to make room for a new pattern.
+    atlas.beginFrame();
+    atlas.getDashPatternTexture({3, 4}, {5, 6}, LinePatternCap::Square);
+    for (const auto& filler : fillers) {
+        atlas.getDashPatternTexture(filler, filler, LinePatternCap::Square);
+    }
+    const auto& added = atlas.getDashPatternTexture({7, 8}, {7, 8}, LinePatternCap::Square);
+
+    // The new pattern takes the row of the evicted pattern that no other pair uses...
+    EXPECT_EQ(Size(256, 16), atlas.getSize());
+    EXPECT_FLOAT_EQ(0.5f / 16, added.getFrom().y);
+    EXPECT_FLOAT_EQ(1.0f / 16, added.getFrom().height);
+    EXPECT_FLOAT_EQ(15.0f, added.getFrom().width);
+
+    // ...while the pattern the evicted pair shared stays where it is.
+    EXPECT_FLOAT_EQ(1.5f / 16, shared.getFrom().y);
+    EXPECT_FLOAT_EQ(2.5f / 16, shared.getTo().y);
+    EXPECT_EQ(sharedRow, rowPixels(1));
+
+    // Without another frame, all pairs are in use and nothing more fits.
+    const auto& full = atlas.getDashPatternTexture({9, 9}, {9, 9}, LinePatternCap::Square);
+    EXPECT_FLOAT_EQ(0.0f, full.getFrom().height);
+
+    // Once the shared pattern isn't referenced any more, its row is reused as well.
+    atlas.beginFrame();
+    for (const auto& filler : fillers) {
+        atlas.getDashPatternTexture(filler, filler, LinePatternCap::Square);
+    }
+    atlas.getDashPatternTexture({7, 8}, {7, 8}, LinePatternCap::Square);
+    const auto& reused = atlas.getDashPatternTexture({9, 9}, {9, 9}, LinePatternCap::Square);
+    EXPECT_FLOAT_EQ(1.5f / 16, reused.getFrom().y);
+    EXPECT_NE(sharedRow, rowPixels(1));
+}
@@ -0,0 +1,45 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/gfx/half_float.hpp>
+
+#include <cmath>
+#include <limits>
+
+using namespace mbgl;
+using namespace mbgl::gfx;
+
+TEST(HalfFloat, RoundTrip) {
+    // Every finite half converts to a float and back to the same bits
+    for (uint32_t i = 0; i < 0x10000; ++i) {
+        const auto bits = static_cast<uint16_t>(i);
+        if ((bits & 0x7c00) == 0x7c00) {
+            continue;
+        }
+        EXPECT_EQ(bits, HalfFloat(static_cast<float>(HalfFloat::fromBits(bits))).getBits()) << i;
+    }
+}
+
+TEST(HalfFloat, Rounding) {
+    EXPECT_EQ(0x3800, HalfFloat(0.5f).getBits());
+    EXPECT_EQ(0xc100, HalfFloat(-2.5f).getBits());
+    EXPECT_EQ(0x3c00, HalfFloat(1.0f).getBits());
+
+    // Ties round to even: 1 + 2^-11 lies halfway between 1 and the next half
+    EXPECT_EQ(0x3c00, HalfFloat(1.0f + std::ldexp(1.0f, -11)).getBits());
+    EXPECT_EQ(0x3c02, HalfFloat(1.0f + 3 * std::ldexp(1.0f, -11)).getBits());
+
+    // Opacities keep more precision than the 8 bits of a color channel
+    for (int i = 0; i <= 255; ++i) {
+        const float opacity = i / 255.0f;
+        EXPECT_NEAR(opacity, static_cast<float>(HalfFloat(opacity)), 0.5f / 255.0f);
+    }
+}
+
+TEST(HalfFloat, Limits) {
+    EXPECT_EQ(0x0001, HalfFloat(std::ldexp(1.0f, -24)).getBits());
+    EXPECT_EQ(0x0000, HalfFloat(std::ldexp(1.0f, -26)).getBits());
+    EXPECT_EQ(0x7bff, HalfFloat(65504.0f).getBits());
+    EXPECT_EQ(0x7c00, HalfFloat(65520.0f).getBits());
+    EXPECT_EQ(0xfc00, HalfFloat(-std::numeric_limits<float>::infinity()).getBits());
+    EXPECT_TRUE(std::isnan(static_cast<float>(HalfFloat(std::numeric_limits<float>::quiet_NaN()))));
+}
@@ -6,15 +6,30 @@
 #include <mbgl/gfx/backend_scope.hpp>
 #include <mbgl/renderer/buckets/circle_bucket.hpp>
 #include <mbgl/renderer/buckets/fill_bucket.hpp>
+#include <mbgl/renderer/buckets/heatmap_bucket.hpp>
 #include <mbgl/renderer/buckets/line_bucket.hpp>
 #include <mbgl/renderer/buckets/raster_bucket.hpp>
 #include <mbgl/renderer/buckets/symbol_bucket.hpp>
 #include <mbgl/renderer/bucket_parameters.hpp>
+#include <mbgl/renderer/property_evaluation_parameters.hpp>
+#include <mbgl/renderer/render_layer.hpp>
+#include <mbgl/renderer/transition_parameters.hpp>
+#include <mbgl/layermanager/layer_manager.hpp>
+#include <mbgl/style/layers/heatmap_layer.hpp>
+#include <mbgl/style/layers/heatmap_layer_properties.hpp>
 #include <mbgl/style/layers/symbol_layer_properties.hpp>
 #include <mbgl/gl/context.hpp>
 #include <mbgl/gl/headless_backend.hpp>
 
 #include <mbgl/map/mode.hpp>
+#include <mbgl/math/clamp.hpp>
+#include <mbgl/style/expression/dsl.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/math.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
 
 namespace mbgl {
 
@@ -383,4 +398,136 @@ TEST(Buckets, RasterBucketMaskComplex) {
     EXPECT_EQ(expectedSegments, bucket.segments);
 }
 
+#if MLN_LEGACY_RENDERER
+TEST(Buckets, HeatmapBucketBinning) {
+    style::HeatmapLayer layer("heatmap", "source");
+    layer.setHeatmapWeight(2.0f);
+    auto renderLayer = LayerManager::get()->createRenderLayer(layer.baseImpl);
+    renderLayer->transition(TransitionParameters{Clock::now(), style::TransitionOptions()});
+    renderLayer->evaluate(PropertyEvaluationParameters(10));
+    const BucketParameters parameters{OverscaledTileID(10, 0, 0), MapMode::Static, 1.0f, nullptr};
+
+    // Two clusters of points, each of which fits into a single cell.
+    const auto addPoints = [](HeatmapBucket& bucket, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto offset = static_cast<int16_t>(i % 4);
+            GeometryCollection point{{{static_cast<int16_t>((i % 2 ? 5000 : 1000) + offset), 1000}}};
+            bucket.addFeature(StubGeometryTileFeature{{}, FeatureType::Point, point, properties},
+                              point,
+                              {},
+                              PatternLayerMap(),
+                              i,
+                              CanonicalTileID(10, 0, 0));
+        }
+        bucket.finalize();
+    };
+
+    HeatmapBucket small{parameters, {renderLayer->evaluatedProperties}, 100};
+    addPoints(small, 100);
+    EXPECT_FALSE(small.isBinned());
+    EXPECT_EQ(400u, small.vertices.elements());
+
+    HeatmapBucket large{parameters, {renderLayer->evaluatedProperties}, 100};
+    addPoints(large, 400);
+    ASSERT_TRUE(large.isBinned());
+    ASSERT_EQ(8u, large.vertices.elements());
+    EXPECT_EQ(HeatmapProgram::vertex({1001, 1000}, -1, -1).a1, large.vertices.at(0).a1);
+    EXPECT_EQ(HeatmapProgram::vertex({5002, 1000}, -1, -1).a1, large.vertices.at(4).a1);
+
+    // The cells store their point counts, and the constant weight moves to the intensity.
+    EXPECT_EQ(8 * sizeof(float), large.paintPropertyBinders.at("heatmap").vertexBytes());
+    const auto evaluated = large.binnedProperties(
+        getEvaluated<style::HeatmapLayerProperties>(renderLayer->evaluatedProperties));
+    EXPECT_FLOAT_EQ(2.0f, evaluated.get<style::HeatmapIntensity>());
+    EXPECT_FALSE(evaluated.get<style::HeatmapWeight>().isConstant());
+}
+
+namespace {
+
+// Sums the Gaussian kernels of the points of a heatmap bucket at the given positions,
+// as the heatmap shader does, with the standard deviation in tile units.
+std::vector<double> heatmapDensity(const HeatmapBucket& bucket,
+                                   const std::string& layerID,
+                                   double sigma,
+                                   const std::vector<Point<double>>& samples) {
+    const auto& weights = bucket.paintPropertyBinders.at(layerID).get<style::HeatmapWeight>()->getSharedVertexVector();
+    EXPECT_TRUE(weights);
+    EXPECT_EQ(sizeof(float), weights->getRawSize());
+    EXPECT_EQ(bucket.vertices.elements(), weights->getRawCount());
+    const auto* weight = static_cast<const float*>(weights->getRawData());
+
+    std::vector<double> density(samples.size(), 0.0);
+    for (std::size_t v = 0; v < bucket.vertices.elements(); v += 4) {
+        // The first vertex of each quad has no extrusion.
+        const auto& position = bucket.vertices.at(v).a1;
+        const Point<double> point(position[0] / 2, position[1] / 2);
+        for (std::size_t i = 0; i < samples.size(); ++i) {
+            const double distance = util::dist<double>(point, samples[i]) / sigma;
+            density[i] += weight[v] * std::exp(-0.5 * distance * distance);
+        }
+    }
+    return density;
+}
+
+} // namespace
+
+TEST(Buckets, HeatmapBucketBinningDensity) {
+    style::HeatmapLayer layer("heatmap", "source");
+    layer.setHeatmapWeight(style::PropertyExpression<float>(
+        style::expression::dsl::number(style::expression::dsl::get("weight"))));
+    auto renderLayer = LayerManager::get()->createRenderLayer(layer.baseImpl);
+    renderLayer->transition(TransitionParameters{Clock::now(), style::TransitionOptions()});
+    renderLayer->evaluate(PropertyEvaluationParameters(10));
+    const BucketParameters parameters{OverscaledTileID(10, 0, 0), MapMode::Static, 1.0f, nullptr};
+
+    // A cluster of points with weights between 0.5 and 2.
+    std::mt19937 generator(42);
+    std::normal_distribution<double> spread(0.0, 300.0);
+    std::uniform_real_distribution<double> weights(0.5, 2.0);
+    std::vector<std::pair<GeometryCollection, PropertyMap>> features;
+    for (std::size_t i = 0; i < 2000; ++i) {
+        features.emplace_back(
+            GeometryCollection{{{static_cast<int16_t>(util::clamp(2048 + spread(generator), 0.0, 4095.0)),
+                                 static_cast<int16_t>(util::clamp(2048 + spread(generator), 0.0, 4095.0))}}},
+            PropertyMap{{"weight", weights(generator)}});
+    }
+    const auto addPoints = [&](HeatmapBucket& bucket) {
+        for (std::size_t i = 0; i < features.size(); ++i) {
+            const auto& [geometry, featureProperties] = features[i];
+            bucket.addFeature(StubGeometryTileFeature{{}, FeatureType::Point, geometry, featureProperties},
+                              geometry,
+                              {},
+                              PatternLayerMap(),
+                              i,
+                              CanonicalTileID(10, 0, 0));
+        }
+        bucket.finalize();
+    };
+
+    HeatmapBucket points{parameters, {renderLayer->evaluatedProperties}, std::numeric_limits<std::size_t>::max()};
+    addPoints(points);
+    ASSERT_FALSE(points.isBinned());
+    HeatmapBucket cells{parameters, {renderLayer->evaluatedProperties}, 100};
+    addPoints(cells);
+    ASSERT_TRUE(cells.isBinned());
+    EXPECT_LT(cells.vertices.elements(), points.vertices.elements() / 4);
+
+    // The default radius of 30 px at twice the size of the tile, where the error of the
+    // cells is largest. The kernel is cut off at three standard deviations.
+    const double sigma = 30.0 * util::EXTENT / util::tileSize_D / 2 / 3;
+    std::vector<Point<double>> samples;
+    for (double y = 1024; y <= 3072; y += 128) {
+        for (double x = 1024; x <= 3072; x += 128) {
+            samples.emplace_back(x, y);
+        }
+    }
+    const auto expected = heatmapDensity(points, "heatmap", sigma, samples);
+    const auto actual = heatmapDensity(cells, "heatmap", sigma, samples);
+    const double peak = *std::max_element(expected.begin(), expected.end());
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        EXPECT_NEAR(expected[i], actual[i], 0.02 * peak) << samples[i].x << "," << samples[i].y;
+    }
+}
+#endif // MLN_LEGACY_RENDERER
+
 #endif
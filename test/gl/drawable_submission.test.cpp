@@ -0,0 +1,92 @@
+#include <mbgl/test/util.hpp>
+
+#if MLN_DRAWABLE_RENDERER
+
+#include <mbgl/gl/drawable_gl.hpp>
+#include <mbgl/gl/drawable_submission.hpp>
+#include <mbgl/gl/uniform_block_gl.hpp>
+#include <mbgl/gl/vertex_attribute_gl.hpp>
+#include <mbgl/shaders/shader_program_base.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+class StubShader final : public gfx::ShaderProgramBase {
+public:
+    static constexpr std::string_view Name{"StubShader"};
+    const std::string_view typeName() const noexcept override { return Name; }
+
+    std::optional<uint32_t> getSamplerLocation(const StringIdentity) const override { return std::nullopt; }
+    const gfx::UniformBlockArray& getUniformBlocks() const override { return uniformBlocks; }
+    const gfx::VertexAttributeArray& getVertexAttributes() const override { return vertexAttributes; }
+
+protected:
+    gfx::UniformBlockArray& mutableUniformBlocks() override { return uniformBlocks; }
+
+private:
+    gl::UniformBlockArrayGL uniformBlocks;
+    gl::VertexAttributeArrayGL vertexAttributes;
+};
+
+class Drawables {
+public:
+    void add(const std::string& name, const std::shared_ptr<StubShader>& shader, const OverscaledTileID& tileID) {
+        auto drawable = std::make_unique<gl::DrawableGL>(name);
+        drawable->setShader(shader);
+        drawable->setTileID(tileID);
+        order.push_back(drawable.get());
+        drawables.push_back(std::move(drawable));
+    }
+
+    std::vector<std::string> sorted() {
+        gl::DrawableOrder().sort(order);
+        std::vector<std::string> names;
+        for (const auto* drawable : order) {
+            names.push_back(drawable->getName());
+        }
+        return names;
+    }
+
+private:
+    std::vector<gfx::UniqueDrawable> drawables;
+    std::vector<gfx::Drawable*> order;
+};
+
+} // namespace
+
+TEST(DrawableOrder, GroupsByShader) {
+    const auto fill = std::make_shared<StubShader>();
+    const auto outline = std::make_shared<StubShader>();
+
+    Drawables drawables;
+    drawables.add("fill-a", fill, {1, 0, 0});
+    drawables.add("outline-a", outline, {1, 0, 0});
+    drawables.add("fill-b", fill, {1, 1, 0});
+    drawables.add("outline-b", outline, {1, 1, 0});
+    drawables.add("fill-c", fill, {1, 0, 1});
+    drawables.add("outline-c", outline, {1, 0, 1});
+
+    EXPECT_EQ((std::vector<std::string>{"fill-a", "fill-b", "fill-c", "outline-a", "outline-b", "outline-c"}),
+              drawables.sorted());
+}
+
+TEST(DrawableOrder, KeepsTileOrder) {
+    const auto fill = std::make_shared<StubShader>();
+    const auto outline = std::make_shared<StubShader>();
+
+    // Grouping by shader would draw the outline of tile b before its fill.
+    Drawables drawables;
+    drawables.add("fill-a", fill, {1, 0, 0});
+    drawables.add("outline-a", outline, {1, 0, 0});
+    drawables.add("outline-b", outline, {1, 1, 0});
+    drawables.add("fill-b", fill, {1, 1, 0});
+
+    EXPECT_EQ((std::vector<std::string>{"fill-a", "outline-a", "outline-b", "fill-b"}), drawables.sorted());
+}
+
+#endif
@@ -0,0 +1,58 @@
+#if MLN_RENDER_BACKEND_OPENGL
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/gfx/headless_frontend.hpp>
+#include <mbgl/map/map.hpp>
+#include <mbgl/map/map_options.hpp>
+#include <mbgl/storage/resource_options.hpp>
+#include <mbgl/style/layers/background_layer.hpp>
+#include <mbgl/style/style.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <vector>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+TEST(FramebufferReadback, RenderAsync) {
+    if (gfx::Backend::GetType() != gfx::Backend::Type::OpenGL) {
+        return;
+    }
+
+    util::RunLoop loop;
+
+    HeadlessFrontend frontend{1};
+    Map map(frontend,
+            MapObserver::nullObserver(),
+            MapOptions().withMapMode(MapMode::Static).withSize(frontend.getSize()),
+            ResourceOptions().withCachePath(":memory:").withAssetPath("test/fixtures/api/assets"));
+    map.getStyle().loadJSON(util::read_file("test/fixtures/api/water.json"));
+    map.jumpTo(CameraOptions().withCenter(LatLng{37.8, -122.5}).withZoom(10.0));
+
+    const PremultipliedImage expected = frontend.render(map).image;
+
+    std::vector<PremultipliedImage> images;
+    auto collect = [&](HeadlessFrontend::RenderResult result) {
+        images.push_back(std::move(result.image));
+    };
+
+    frontend.renderAsync(map, collect);
+    auto background = static_cast<BackgroundLayer*>(map.getStyle().getLayer("background"));
+    background->setBackgroundColor({{1.0f, 0.0f, 0.0f, 1.0f}});
+    // Images are written into caller-provided buffers of the right size.
+    frontend.renderAsync(map, collect, PremultipliedImage(expected.size));
+    frontend.finishRenders();
+
+    ASSERT_EQ(2u, images.size());
+    // Rows are in the same order as those of synchronous reads.
+    EXPECT_EQ(expected, images[0]);
+    EXPECT_EQ(expected.size, images[1].size);
+    EXPECT_NE(expected, images[1]);
+
+    // Nothing is left to deliver.
+    frontend.finishRenders();
+    EXPECT_EQ(2u, images.size());
+}
+
+#endif
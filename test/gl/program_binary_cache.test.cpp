@@ -0,0 +1,108 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/gl/program_binary_cache.hpp>
+#include <mbgl/util/io.hpp>
+
+using namespace mbgl;
+using namespace mbgl::gl;
+
+namespace {
+
+const std::string directory = "test/fixtures/program_binary_cache";
+
+} // namespace
+
+TEST(ProgramBinaryCache, Key) {
+    EXPECT_EQ(ProgramBinaryCache::key({"a", "b"}), ProgramBinaryCache::key({"a", "b"}));
+    EXPECT_NE(ProgramBinaryCache::key({"a", "b"}), ProgramBinaryCache::key({"ab", ""}));
+    EXPECT_NE(ProgramBinaryCache::key({"a", "b"}), ProgramBinaryCache::key({"b", "a"}));
+}
+
+TEST(ProgramBinaryCache, Path) {
+    const ProgramBinaryCache cache(directory, "driver");
+    const std::string path = cache.path(1);
+    EXPECT_EQ(directory + "/", path.substr(0, directory.size() + 1));
+    EXPECT_EQ(directory.size() + 1 + 16 + 5, path.size());
+    EXPECT_EQ(".pbin", path.substr(path.size() - 5));
+
+    // Files are named after the program sources and the driver only.
+    EXPECT_EQ(path, ProgramBinaryCache(directory, "driver").path(1));
+    EXPECT_NE(path, cache.path(2));
+    EXPECT_NE(path, ProgramBinaryCache(directory, "other driver").path(1));
+}
+
+TEST(ProgramBinaryCache, TEST_REQUIRES_WRITE(StoreLoad)) {
+    const ProgramBinaryCache cache(directory, "vendor|renderer|1.0|");
+    cache.remove(1);
+    EXPECT_FALSE(cache.load(1));
+
+    ASSERT_TRUE(cache.store(1, {0x8741, std::string("binary\0data", 11)}));
+    auto entry = cache.load(1);
+    ASSERT_TRUE(entry);
+    EXPECT_EQ(0x8741u, entry->format);
+    EXPECT_EQ(std::string("binary\0data", 11), entry->binary);
+
+    // Entries built from other sources or by another driver are not used.
+    EXPECT_FALSE(cache.load(2));
+    EXPECT_FALSE(ProgramBinaryCache(directory, "vendor|renderer|2.0|").load(1));
+
+    // An entry found under the name of another one is rejected.
+    util::write_file(cache.path(2), util::read_file(cache.path(1)));
+    EXPECT_FALSE(cache.load(2));
+    cache.remove(2);
+
+    cache.remove(1);
+    EXPECT_FALSE(cache.load(1));
+}
+
+TEST(ProgramBinaryCache, TEST_REQUIRES_WRITE(Corrupt)) {
+    const ProgramBinaryCache cache(directory, "driver");
+    ASSERT_TRUE(cache.store(1, {1, "binary"}));
+    const std::string data = util::read_file(cache.path(1));
+
+    // Truncated at any point.
+    for (std::size_t length = 0; length < data.size(); ++length) {
+        util::write_file(cache.path(1), data.substr(0, length));
+        EXPECT_FALSE(cache.load(1)) << length;
+    }
+
+    // Trailing data.
+    util::write_file(cache.path(1), data + "x");
+    EXPECT_FALSE(cache.load(1));
+
+    // Modified binary, caught by the checksum.
+    std::string modified = data;
+    modified[modified.find("binary")] = 'B';
+    util::write_file(cache.path(1), modified);
+    EXPECT_FALSE(cache.load(1));
+
+    util::write_file(cache.path(1), data);
+    EXPECT_TRUE(cache.load(1));
+    cache.remove(1);
+}
+
+TEST(ProgramBinaryCache, TEST_REQUIRES_WRITE(Prune)) {
+    const std::string binary(1000, 'b');
+    const ProgramBinaryCache unbounded(directory, "driver");
+    ASSERT_TRUE(unbounded.store(1, {1, binary}));
+    const auto entrySize = util::read_file(unbounded.path(1)).size();
+    unbounded.remove(1);
+
+    // Room for two entries; storing a third removes one of the older ones.
+    const ProgramBinaryCache cache(directory, "driver", 2 * entrySize + entrySize / 2);
+    ASSERT_TRUE(cache.store(1, {1, binary}));
+    ASSERT_TRUE(cache.store(2, {1, binary}));
+    EXPECT_TRUE(cache.load(1));
+    EXPECT_TRUE(cache.load(2));
+    ASSERT_TRUE(cache.store(3, {1, binary}));
+    EXPECT_TRUE(cache.load(3));
+    EXPECT_EQ(1, int(bool(cache.load(1))) + int(bool(cache.load(2))));
+
+    // A smaller cache on the same directory removes entries down to its size.
+    ProgramBinaryCache(directory, "driver", entrySize).prune();
+    EXPECT_EQ(1, int(bool(cache.load(1))) + int(bool(cache.load(2))) + int(bool(cache.load(3))));
+
+    cache.remove(1);
+    cache.remove(2);
+    cache.remove(3);
+}
@@ -0,0 +1,154 @@
+#if MLN_RENDER_BACKEND_OPENGL && MLN_DRAWABLE_RENDERER
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/gfx/backend_scope.hpp>
+#include <mbgl/gl/context.hpp>
+#include <mbgl/gl/headless_backend.hpp>
+#include <mbgl/gl/uniform_buffer_allocator.hpp>
+#include <mbgl/gl/uniform_buffer_gl.hpp>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+using namespace mbgl;
+
+TEST(UniformBufferAllocator, SharesBufferObjects) {
+    gl::HeadlessBackend backend{{256, 256}};
+    gfx::BackendScope scope{backend};
+    gl::Context context{backend};
+
+    const std::array<float, 16> data{};
+    std::vector<gfx::UniformBufferPtr> buffers;
+    for (int i = 0; i < 100; ++i) {
+        buffers.push_back(context.createUniformBuffer(data.data(), sizeof(data), false));
+    }
+
+    const auto& stats = context.renderingStats();
+    EXPECT_EQ(100, stats.numUniformBuffers);
+    EXPECT_EQ(1, stats.numUniformBufferObjs);
+
+    // Updates are uploaded together
+    const std::array<float, 16> other{1.0f};
+    for (const auto& buffer : buffers) {
+        buffer->update(other.data(), sizeof(other));
+    }
+    const auto uploads = stats.uniformBufferObjUpdates;
+    context.getUniformBufferAllocator().flush();
+    EXPECT_EQ(uploads + 1, stats.uniformBufferObjUpdates);
+
+    // Unchanged contents are not written again
+    const auto writes = stats.numUniformUpdates;
+    buffers.front()->update(other.data(), sizeof(other));
+    EXPECT_EQ(writes, stats.numUniformUpdates);
+
+    buffers.clear();
+    EXPECT_EQ(0, stats.numUniformBuffers);
+    EXPECT_EQ(0, stats.memUniformBuffers);
+    context.reset();
+    EXPECT_EQ(0, stats.numUniformBufferObjs);
+}
+
+TEST(UniformBufferAllocator, ReusesReleasedRanges) {
+    gl::HeadlessBackend backend{{256, 256}};
+    gfx::BackendScope scope{backend};
+    gl::Context context{backend};
+    auto& allocator = context.getUniformBufferAllocator();
+
+    const auto first = allocator.allocate(64);
+    const auto second = allocator.allocate(64);
+    EXPECT_EQ(first.page, second.page);
+    EXPECT_NE(first.offset, second.offset);
+
+    allocator.release(first);
+    const auto third = allocator.allocate(60);
+    EXPECT_EQ(first.page, third.page);
+    EXPECT_EQ(first.offset, third.offset);
+    EXPECT_EQ(60u, third.size);
+
+    // Ranges larger than a page get a buffer object of their own
+    const auto large = allocator.allocate(gl::UniformBufferAllocator::pageSize + 1);
+    EXPECT_NE(first.page, large.page);
+    EXPECT_EQ(0u, large.offset);
+    EXPECT_EQ(2, context.renderingStats().numUniformBufferObjs);
+
+    allocator.release(second);
+    allocator.release(third);
+    allocator.release(large);
+    EXPECT_EQ(0u, allocator.getAllocatedCount());
+}
+
+TEST(UniformBufferAllocator, MergesReleasedRanges) {
+    gl::HeadlessBackend backend{{256, 256}};
+    gfx::BackendScope scope{backend};
+    gl::Context context{backend};
+    auto& allocator = context.getUniformBufferAllocator();
+
+    const auto first = allocator.allocate(64);
+    const auto second = allocator.allocate(64);
+    const auto third = allocator.allocate(64);
+    const auto last = allocator.allocate(64);
+    const auto stride = second.offset - first.offset;
+
+    // Adjacent released ranges make room for a larger one
+    allocator.release(second);
+    allocator.release(first);
+    allocator.release(third);
+    const auto merged = allocator.allocate(3 * stride);
+    EXPECT_EQ(first.page, merged.page);
+    EXPECT_EQ(first.offset, merged.offset);
+
+    // Space released at the end of the page is handed out again from there
+    allocator.release(last);
+    const auto next = allocator.allocate(64);
+    EXPECT_EQ(last.offset, next.offset);
+
+    allocator.release(merged);
+    allocator.release(next);
+    EXPECT_EQ(0u, allocator.getAllocatedCount());
+}
+
+TEST(UniformBufferAllocator, DeletesEmptyBufferObjects) {
+    gl::HeadlessBackend backend{{256, 256}};
+    gfx::BackendScope scope{backend};
+    gl::Context context{backend};
+    auto& allocator = context.getUniformBufferAllocator();
+    const auto& stats = context.renderingStats();
+
+    constexpr std::size_t size = 1024;
+    std::vector<gl::UniformBufferAllocator::Range> ranges;
+    for (std::size_t i = 0; i < 2 * gl::UniformBufferAllocator::pageSize / size; ++i) {
+        ranges.push_back(allocator.allocate(size));
+    }
+    EXPECT_EQ(2u, allocator.getPageCount());
+    EXPECT_EQ(2, stats.numUniformBufferObjs);
+
+    // Emptying the first page deletes its buffer object on the next flush
+    const auto firstPage = ranges.front().page;
+    for (auto it = ranges.begin(); it != ranges.end();) {
+        if (it->page == firstPage) {
+            allocator.release(*it);
+            it = ranges.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    allocator.flush();
+    EXPECT_EQ(1u, allocator.getPageCount());
+    EXPECT_EQ(1, stats.numUniformBufferObjs);
+
+    // Its slot is taken by the next buffer object, without disturbing the ranges of the other
+    const auto range = allocator.allocate(gl::UniformBufferAllocator::pageSize + 1);
+    EXPECT_EQ(firstPage, range.page);
+    EXPECT_EQ(2u, allocator.getPageCount());
+
+    allocator.release(range);
+    for (const auto& remaining : ranges) {
+        allocator.release(remaining);
+    }
+    allocator.flush();
+    EXPECT_EQ(0u, allocator.getPageCount());
+    EXPECT_EQ(0, stats.numUniformBufferObjs);
+}
+
+#endif
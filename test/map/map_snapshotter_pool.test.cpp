@@ -0,0 +1,100 @@
+#include <mbgl/map/camera.hpp>
+#include <mbgl/map/map_snapshotter_pool.hpp>
+#include <mbgl/storage/resource_options.hpp>
+#include <mbgl/test/util.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+std::string backgroundStyle(const std::string& color) {
+    return R"JSON({
+        "version": 8,
+        "layers": [{
+            "id": "background",
+            "type": "background",
+            "paint": {"background-color": ")JSON" +
+           color + R"JSON("}
+        }]
+    })JSON";
+}
+
+} // namespace
+
+TEST(MapSnapshotterPool, Queue) {
+    util::RunLoop runLoop;
+    MapSnapshotterPool pool(2, 1.0f, ResourceOptions());
+    EXPECT_EQ(2u, pool.size());
+
+    const std::vector<Size> sizes = {{32, 16}, {16, 32}, {8, 8}, {32, 16}, {24, 24}};
+    std::vector<Size> rendered;
+
+    for (std::size_t i = 0; i < sizes.size(); ++i) {
+        MapSnapshotterPool::Job job;
+        job.styleJSON = backgroundStyle(i % 2 ? "green" : "red");
+        job.size = sizes[i];
+        job.camera = CameraOptions().withCenter(LatLng{0, 0}).withZoom(double(i));
+        pool.snapshot(std::move(job),
+                      [&](std::exception_ptr error,
+                          PremultipliedImage image,
+                          MapSnapshotter::Attributions,
+                          MapSnapshotter::PointForFn,
+                          MapSnapshotter::LatLngForFn) {
+                          EXPECT_EQ(nullptr, error);
+                          rendered.push_back(image.size);
+                          if (rendered.size() == sizes.size()) {
+                              runLoop.stop();
+                          }
+                      });
+    }
+
+    // Two jobs are taken right away, the rest waits for a free snapshotter.
+    EXPECT_EQ(2u, pool.active());
+    EXPECT_EQ(3u, pool.pending());
+
+    runLoop.run();
+
+    EXPECT_EQ(0u, pool.pending());
+    std::vector<Size> expected = sizes;
+    auto bySize = [](const Size& a, const Size& b) {
+        return std::tie(a.width, a.height) < std::tie(b.width, b.height);
+    };
+    std::sort(expected.begin(), expected.end(), bySize);
+    std::sort(rendered.begin(), rendered.end(), bySize);
+    EXPECT_EQ(expected, rendered);
+}
+
+TEST(MapSnapshotterPool, CancelPending) {
+    util::RunLoop runLoop;
+    MapSnapshotterPool pool(1, 1.0f, ResourceOptions());
+
+    std::size_t callbacks = 0;
+    for (std::size_t i = 0; i < 3; ++i) {
+        MapSnapshotterPool::Job job;
+        job.styleJSON = backgroundStyle("green");
+        job.size = {16, 16};
+        pool.snapshot(std::move(job),
+                      [&](std::exception_ptr error,
+                          PremultipliedImage,
+                          MapSnapshotter::Attributions,
+                          MapSnapshotter::PointForFn,
+                          MapSnapshotter::LatLngForFn) {
+                          EXPECT_EQ(nullptr, error);
+                          callbacks++;
+                          runLoop.stop();
+                      });
+    }
+
+    EXPECT_EQ(2u, pool.pending());
+    pool.cancelPending();
+    EXPECT_EQ(0u, pool.pending());
+
+    runLoop.run();
+    EXPECT_EQ(1u, callbacks);
+    EXPECT_EQ(0u, pool.pending());
+}
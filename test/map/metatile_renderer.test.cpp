@@ -0,0 +1,212 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/gfx/headless_frontend.hpp>
+#include <mbgl/gfx/metatile_renderer.hpp>
+#include <mbgl/map/camera.hpp>
+#include <mbgl/map/map.hpp>
+#include <mbgl/map/map_options.hpp>
+#include <mbgl/storage/resource_options.hpp>
+#include <mbgl/style/image.hpp>
+#include <mbgl/style/style.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/projection.hpp>
+#include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/string.hpp>
+
+#include <mapbox/pixelmatch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+struct MetatileTest {
+    util::RunLoop loop;
+    HeadlessFrontend frontend{1};
+    Map map{frontend,
+            MapObserver::nullObserver(),
+            MapOptions()
+                .withMapMode(MapMode::Static)
+                .withConstrainMode(ConstrainMode::None)
+                .withSize(frontend.getSize()),
+            ResourceOptions().withCachePath(":memory:").withAssetPath("test/fixtures/api/assets")};
+};
+
+std::vector<std::tuple<uint32_t, uint32_t, uint32_t, uint32_t>> extents(
+    const std::vector<MetatileRenderer::Metatile>& metatiles) {
+    std::vector<std::tuple<uint32_t, uint32_t, uint32_t, uint32_t>> result;
+    for (const auto& metatile : metatiles) {
+        result.emplace_back(metatile.x, metatile.y, metatile.width, metatile.height);
+    }
+    return result;
+}
+
+// Lines of latitude and longitude on a background, with a polygon over the northern edge of
+// the world, so that tiles look different depending on where they are rendered.
+std::string graticuleStyle() {
+    std::string features;
+    const auto addLine = [&](double lng0, double lat0, double lng1, double lat1) {
+        features += std::string(features.empty() ? "" : ",") +
+                    R"({"type": "Feature", "properties": {}, "geometry": {"type": "LineString", "coordinates": [[)" +
+                    util::toString(lng0) + "," + util::toString(lat0) + "],[" + util::toString(lng1) + "," +
+                    util::toString(lat1) + "]]}}";
+    };
+    for (int lng = -170; lng <= 170; lng += 20) addLine(lng, -85, lng, 85);
+    for (const int lat : {-80, -75, -60, -40, -20, 0, 20, 40, 60, 75, 80}) addLine(-180, lat, 180, lat);
+
+    return R"JSON({
+        "version": 8,
+        "sources": {
+            "graticule": {"type": "geojson", "data": {"type": "FeatureCollection", "features": [)JSON" +
+           features + R"JSON(]}},
+            "cap": {"type": "geojson", "data": {"type": "Polygon", "coordinates":
+                [[[-120, 70], [100, 70], [100, 84], [-120, 84], [-120, 70]]]}}
+        },
+        "layers": [
+            {"id": "background", "type": "background", "paint": {"background-color": "#fe8"}},
+            {"id": "cap", "type": "fill", "source": "cap", "paint": {"fill-color": "#37a"}},
+            {"id": "graticule", "type": "line", "source": "graticule",
+                "paint": {"line-color": "#c31", "line-width": 3}}
+        ]
+    })JSON";
+}
+
+// Rows of overlapping icons across the prime meridian, so that icons collide along a seam
+// between metatiles.
+std::string iconRowsStyle() {
+    std::string features;
+    for (const int lat : {4, 12, 20}) {
+        for (int i = -40; i <= 40; ++i) {
+            features += std::string(features.empty() ? "" : ",") +
+                        R"({"type": "Feature", "properties": {}, "geometry": {"type": "Point", "coordinates": [)" +
+                        util::toString(i * 0.25) + "," + util::toString(lat) + "]}}";
+        }
+    }
+
+    return R"JSON({
+        "version": 8,
+        "sources": {
+            "points": {"type": "geojson", "data": {"type": "FeatureCollection", "features": [)JSON" +
+           features + R"JSON(]}}
+        },
+        "layers": [
+            {"id": "background", "type": "background", "paint": {"background-color": "#fff"}},
+            {"id": "icons", "type": "symbol", "source": "points", "layout": {"icon-image": "dot", "icon-padding": 0}}
+        ]
+    })JSON";
+}
+
+} // namespace
+
+TEST(MetatileRenderer, Metatiles) {
+    MetatileTest test;
+    MetatileRenderer renderer(test.frontend, test.map);
+
+    // Smaller zoom levels fit into a single metatile.
+    EXPECT_EQ((decltype(extents({})){{0, 0, 2, 2}}), extents(renderer.metatiles(1)));
+
+    // Consecutive metatiles are adjacent.
+    EXPECT_EQ((decltype(extents({})){{0, 0, 8, 8}, {0, 8, 8, 8}, {8, 8, 8, 8}, {8, 0, 8, 8}}),
+              extents(renderer.metatiles(4)));
+    const auto metatiles = renderer.metatiles(7);
+    ASSERT_EQ(256u, metatiles.size());
+    for (std::size_t i = 1; i < metatiles.size(); ++i) {
+        const auto dx = int64_t(metatiles[i].x) - int64_t(metatiles[i - 1].x);
+        const auto dy = int64_t(metatiles[i].y) - int64_t(metatiles[i - 1].y);
+        EXPECT_EQ(8, std::abs(dx) + std::abs(dy));
+    }
+
+    // Metatiles are clipped to the bounds, which cover tiles 654-655 x 1582-1584.
+    const LatLngBounds bounds = LatLngBounds::hull({37.7, -122.5}, {37.8, -122.4});
+    auto clipped = extents(renderer.metatiles(12, bounds));
+    std::sort(clipped.begin(), clipped.end());
+    EXPECT_EQ((decltype(extents({})){{654, 1582, 2, 2}, {654, 1584, 2, 1}}), clipped);
+}
+
+TEST(MetatileRenderer, Render) {
+    MetatileTest test;
+    test.map.getStyle().loadJSON(graticuleStyle());
+
+    MetatileRenderer::Options options;
+    options.tileSize = 256;
+    options.metatileSize = 2;
+    MetatileRenderer renderer(test.frontend, test.map, options);
+
+    std::map<std::tuple<uint8_t, uint32_t, uint32_t>, PremultipliedImage> tiles;
+    for (const uint8_t z : {1, 2}) {
+        renderer.render(z, [&](const CanonicalTileID& tileID, PremultipliedImage image) {
+            EXPECT_EQ(Size(256, 256), image.size);
+            tiles.emplace(std::make_tuple(tileID.z, tileID.x, tileID.y), std::move(image));
+        });
+    }
+    ASSERT_EQ(4u + 16u, tiles.size());
+
+    // Each tile, including the ones along the top and bottom of the world and the ones of
+    // the zoom levels that fit into a single metatile, matches the tile rendered on its own.
+    HeadlessFrontend frontend{{256, 256}, 1};
+    Map map{frontend,
+            MapObserver::nullObserver(),
+            MapOptions().withMapMode(MapMode::Static).withConstrainMode(ConstrainMode::None).withSize({256, 256}),
+            ResourceOptions().withCachePath(":memory:").withAssetPath("test/fixtures/api/assets")};
+    map.getStyle().loadJSON(graticuleStyle());
+    for (const auto& [id, image] : tiles) {
+        const auto [z, x, y] = id;
+        const double scale = std::pow(2.0, z);
+        map.jumpTo(CameraOptions()
+                       .withCenter(Projection::unproject({(x + 0.5) * util::tileSize_D, (y + 0.5) * util::tileSize_D},
+                                                         scale))
+                       .withZoom(z - 1.0));
+        auto expected = frontend.render(map).image;
+        ASSERT_EQ(expected.size, image.size);
+
+        PremultipliedImage diff{image.size};
+        const uint64_t pixels = mapbox::pixelmatch(
+            image.data.get(), expected.data.get(), image.size.width, image.size.height, diff.data.get(), 0.1);
+        EXPECT_LE(pixels, image.size.area() / 100) << "tile " << int(z) << "/" << x << "/" << y;
+    }
+}
+
+TEST(MetatileRenderer, LabelsAtSeams) {
+    MetatileTest test;
+    test.map.getStyle().loadJSON(iconRowsStyle());
+    PremultipliedImage dot({16, 16});
+    for (std::size_t i = 0; i < dot.bytes(); i += 4) {
+        dot.data[i] = 255;
+        dot.data[i + 3] = 255;
+    }
+    test.map.getStyle().addImage(std::make_unique<style::Image>("dot", std::move(dot), 1.0f));
+
+    // Every tile is a metatile of its own, and 2/1/1 and 2/2/1 meet at the prime meridian.
+    MetatileRenderer::Options options;
+    options.tileSize = 256;
+    options.metatileSize = 1;
+    MetatileRenderer renderer(test.frontend, test.map, options);
+
+    std::map<uint32_t, PremultipliedImage> tiles;
+    renderer.render(
+        2,
+        [&](const CanonicalTileID& tileID, PremultipliedImage image) { tiles.emplace(tileID.x, std::move(image)); },
+        LatLngBounds::hull({1, -20}, {30, 20}));
+    ASSERT_EQ(2u, tiles.size());
+    const PremultipliedImage& west = tiles.at(1);
+    const PremultipliedImage& east = tiles.at(2);
+    ASSERT_EQ(east.size, west.size);
+
+    // Icons across the seam are drawn on both sides of it.
+    std::size_t iconRows = 0;
+    for (uint32_t y = 0; y < west.size.height; ++y) {
+        const uint8_t* left = west.data.get() + (y * west.size.width + west.size.width - 1) * 4;
+        const uint8_t* right = east.data.get() + (y * east.size.width) * 4;
+        // Icons are red on white, so the green channel tells them apart.
+        EXPECT_LE(std::abs(int(left[1]) - int(right[1])), 64) << "row " << y;
+        iconRows += left[1] < 64 ? 1 : 0;
+    }
+    EXPECT_GT(iconRows, 0u);
+}
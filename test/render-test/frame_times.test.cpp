@@ -0,0 +1,50 @@
+#include <mbgl/test/util.hpp>
+
+#include "frame_times.hpp"
+
+using namespace mbgl;
+
+TEST(FrameTimes, Percentiles) {
+    // 1 to 100 ms, in reverse order.
+    std::vector<float> samples;
+    for (int i = 100; i > 0; --i) {
+        samples.push_back(static_cast<float>(i));
+    }
+
+    // Ranks are rounded to the nearest sample: 49.5, 94.05 and 98.01 of 0 to 99.
+    const auto summary = summarizeFrameTimes(samples);
+    EXPECT_FLOAT_EQ(51.0f, summary.median);
+    EXPECT_FLOAT_EQ(95.0f, summary.p95);
+    EXPECT_FLOAT_EQ(99.0f, summary.p99);
+
+    // The interval spans 0.98 * sqrt(100) = 9.8 ranks on either side of the median,
+    // from rank 40 to rank 59.
+    EXPECT_FLOAT_EQ((60.0f - 41.0f) / 2, summary.confidence);
+}
+
+TEST(FrameTimes, FewSamples) {
+    // The interval is clamped to the samples there are.
+    const auto summary = summarizeFrameTimes({5, 1, 4, 2, 3});
+    EXPECT_FLOAT_EQ(3.0f, summary.median);
+    EXPECT_FLOAT_EQ(5.0f, summary.p95);
+    EXPECT_FLOAT_EQ(5.0f, summary.p99);
+    EXPECT_FLOAT_EQ((5.0f - 1.0f) / 2, summary.confidence);
+
+    const auto single = summarizeFrameTimes({7});
+    EXPECT_FLOAT_EQ(7.0f, single.median);
+    EXPECT_FLOAT_EQ(7.0f, single.p99);
+    EXPECT_FLOAT_EQ(0.0f, single.confidence);
+}
+
+TEST(FrameTimes, ConfidenceNarrowsWithSamples) {
+    // Uniformly spread frame times: the interval shrinks with the square root of the sample count.
+    const auto uniform = [](int count) {
+        std::vector<float> samples;
+        for (int i = 0; i < count; ++i) {
+            samples.push_back(static_cast<float>(i) / count);
+        }
+        return summarizeFrameTimes(samples);
+    };
+    EXPECT_NEAR(0.098f, uniform(100).confidence, 0.01f);
+    EXPECT_NEAR(0.0098f * std::sqrt(10.0f), uniform(1000).confidence, 0.002f);
+}
@@ -0,0 +1,63 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/map/transform.hpp>
+#include <mbgl/math/angles.hpp>
+#include <mbgl/renderer/tile_load_order.hpp>
+
+#include <cmath>
+
+using namespace mbgl;
+
+namespace {
+
+// Centre of tile 3/4/3.
+const LatLng center{util::rad2deg(std::atan(std::sinh(M_PI / 8))), 22.5};
+
+} // namespace
+
+TEST(TileLoadOrder, DistanceFromCenter) {
+    Transform transform;
+    transform.resize({512, 512});
+    transform.jumpTo(CameraOptions().withCenter(center).withZoom(3.0));
+
+    std::vector<OverscaledTileID> tiles{{3, 0, 3, 6, 3}, {3, 0, 3, 4, 4}, {3, 0, 3, 4, 3}, {3, -1, 3, 7, 3}};
+    TileLoadOrder(transform.getState()).sort(tiles, [](const OverscaledTileID&) { return false; });
+    EXPECT_EQ((std::vector<OverscaledTileID>{{3, 0, 3, 4, 3}, {3, 0, 3, 4, 4}, {3, 0, 3, 6, 3}, {3, -1, 3, 7, 3}}),
+              tiles);
+
+    // Without pitch, tiles at the same distance in any direction are equal.
+    const TileLoadOrder order(transform.getState());
+    EXPECT_DOUBLE_EQ(order.distance({3, 0, 3, 4, 2}), order.distance({3, 0, 3, 4, 4}));
+
+    // Parent tiles are compared by the position of their centre.
+    EXPECT_LT(order.distance({2, 0, 2, 2, 1}), order.distance({3, 0, 3, 6, 3}));
+}
+
+TEST(TileLoadOrder, CoveredLast) {
+    Transform transform;
+    transform.resize({512, 512});
+    transform.jumpTo(CameraOptions().withCenter(center).withZoom(3.0));
+
+    std::vector<OverscaledTileID> tiles{{3, 0, 3, 4, 3}, {3, 0, 3, 5, 3}, {3, 0, 3, 3, 3}, {3, 0, 3, 6, 3}};
+    TileLoadOrder(transform.getState()).sort(tiles, [](const OverscaledTileID& id) {
+        return id.canonical.x == 4 || id.canonical.x == 5;
+    });
+    EXPECT_EQ((std::vector<OverscaledTileID>{{3, 0, 3, 3, 3}, {3, 0, 3, 6, 3}, {3, 0, 3, 4, 3}, {3, 0, 3, 5, 3}}),
+              tiles);
+}
+
+TEST(TileLoadOrder, NearTilesBeforeHorizon) {
+    Transform transform;
+    transform.resize({512, 512});
+    transform.jumpTo(CameraOptions().withCenter(center).withZoom(3.0).withPitch(60.0));
+
+    std::vector<OverscaledTileID> tiles{{3, 0, 3, 4, 2}, {3, 0, 3, 4, 4}, {3, 0, 3, 4, 3}};
+    TileLoadOrder(transform.getState()).sort(tiles, [](const OverscaledTileID&) { return false; });
+    EXPECT_EQ((std::vector<OverscaledTileID>{{3, 0, 3, 4, 3}, {3, 0, 3, 4, 4}, {3, 0, 3, 4, 2}}), tiles);
+
+    // The same holds when the map is rotated: the horizon is then to the south.
+    transform.jumpTo(CameraOptions().withBearing(180.0));
+    tiles = {{3, 0, 3, 4, 4}, {3, 0, 3, 4, 2}};
+    TileLoadOrder(transform.getState()).sort(tiles, [](const OverscaledTileID&) { return false; });
+    EXPECT_EQ((std::vector<OverscaledTileID>{{3, 0, 3, 4, 2}, {3, 0, 3, 4, 4}}), tiles);
+}
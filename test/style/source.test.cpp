@@ -45,7 +45,9 @@
 #include <mbgl/renderer/tile_render_data.hpp>
 #include <mbgl/text/glyph_manager.hpp>
 
+#include <algorithm>
 #include <cstdint>
+#include <map>
 #include <optional>
 #include <gmock/gmock.h>
 
@@ -764,6 +766,7 @@ public:
         renderable = true;
     }
     void setNecessity(TileNecessity necessity) override;
+    void setPriority(Resource::Priority) override;
     void setUpdateParameters(const TileUpdateParameters&) override;
     bool layerPropertiesUpdated(const Immutable<style::LayerProperties>&) override { return true; }
 
@@ -799,12 +802,20 @@ public:
     const std::optional<Tileset>& getTileset() const override {
         return static_cast<const style::VectorSource::Impl&>(*baseImpl).tileset;
     }
+
+    const std::vector<OverscaledTileID>& getLoadOrder() const { return tilePyramid.getLoadOrder(); }
+
+    std::map<OverscaledTileID, Resource::Priority> priorities;
 };
 
 void FakeTile::setNecessity(TileNecessity necessity) {
     source.tileSetNecessity(necessity);
 }
 
+void FakeTile::setPriority(Resource::Priority priority) {
+    source.priorities[id] = priority;
+}
+
 void FakeTile::setUpdateParameters(const TileUpdateParameters& params) {
     source.tileSetMinimumUpdateInterval(params.minimumUpdateInterval);
 }
@@ -834,6 +845,44 @@ TEST(Source, InvisibleSourcesTileNecessity) {
     renderSource->update(initialized.baseImpl, layers, true, false, test.tileParameters());
 }
 
+TEST(Source, CoveredTilesLowPriority) {
+    SourceTest test;
+    VectorSource initialized("source", Tileset{{"tiles"}});
+    initialized.loadDescription(*test.fileSource);
+
+    FakeTileSource renderTilesetSource{initialized.baseImpl};
+    RenderSource* renderSource = &renderTilesetSource;
+    LineLayer layer("id", "source");
+    Immutable<LayerProperties> layerProperties = makeMutable<LineLayerProperties>(
+        staticImmutableCast<LineLayer::Impl>(layer.baseImpl));
+    std::vector<Immutable<LayerProperties>> layers{layerProperties};
+
+    // Nothing is loaded yet, so the only tile leaves a hole.
+    renderSource->update(initialized.baseImpl, layers, true, true, test.tileParameters());
+    const OverscaledTileID root{0, 0, 0};
+    ASSERT_FALSE(renderTilesetSource.getLoadOrder().empty());
+    EXPECT_EQ(root, renderTilesetSource.getLoadOrder().front());
+    EXPECT_EQ(Resource::Priority::Regular, renderTilesetSource.priorities.at(root));
+
+    // The renderable parent covers all the children, so they are requested at low priority.
+    test.transform.jumpTo(CameraOptions().withZoom(1.0));
+    test.transformState = test.transform.getState();
+    renderSource->update(initialized.baseImpl, layers, true, false, test.tileParameters());
+    std::size_t children = 0;
+    for (const auto& tileID : renderTilesetSource.getLoadOrder()) {
+        EXPECT_EQ(1, tileID.overscaledZ);
+        if (tileID.wrap == 0) {
+            EXPECT_EQ(Resource::Priority::Low, renderTilesetSource.priorities.at(tileID)) << util::toString(tileID);
+            ++children;
+        }
+    }
+    EXPECT_EQ(4u, children);
+
+    // Invisible sources have nothing to load.
+    renderSource->update(initialized.baseImpl, layers, false, false, test.tileParameters());
+    EXPECT_TRUE(renderTilesetSource.getLoadOrder().empty());
+}
+
 TEST(Source, SourceMinimumUpdateInterval) {
     SourceTest test;
     VectorSource initialized("source", Tileset{{"tiles"}});
@@ -950,6 +999,90 @@ TEST(Source, GeoJSONSourceTilesAfterDataReset) {
     EXPECT_TRUE(renderSource.isLoaded()); // Tiles are reset in static mode.
 }
 
+TEST(Source, GeoJSONSourceUpdateData) {
+    SourceTest test;
+    GeoJSONSource source("source");
+
+    const auto point = [](uint64_t id, double lng, double lat) {
+        GeoJSONFeature feature{mapbox::geometry::point<double>{lng, lat}};
+        feature.id = id;
+        return feature;
+    };
+    const auto getTileIDs = [&](GeoJSONData& data, const CanonicalTileID& tileID) {
+        std::vector<uint64_t> ids;
+        data.getTile(tileID, [&](const GeoJSONData::TileFeatures& features) {
+            for (const auto& feature : features) {
+                ids.push_back(feature.id.get<uint64_t>());
+            }
+            test.end();
+        });
+        test.run();
+        return ids;
+    };
+
+    // Large enough to be indexed in several partitions, with two far apart
+    // clusters interleaved in the input: even IDs in tile 2/1/1, odd IDs in
+    // tile 2/2/2.
+    mapbox::feature::feature_collection<double> features;
+    std::vector<uint64_t> all;
+    std::vector<uint64_t> west;
+    for (uint64_t i = 0; i < 10000; ++i) {
+        const double sign = i % 2 ? 1.0 : -1.0;
+        features.push_back(point(i + 10, sign * (70.0 + (i % 200) * 0.005), -sign * (40.0 + (i / 200) * 0.02)));
+        all.push_back(i + 10);
+        if (i % 2 == 0) {
+            west.push_back(i + 10);
+        }
+    }
+    features.push_back(point(1, 50.0, 25.0));
+    features.push_back(point(2, 60.0, 30.0));
+    source.setGeoJSON(features);
+    auto before = source.impl().getData().lock();
+    ASSERT_TRUE(before);
+
+    // Features taken from several partitions keep their source order.
+    auto expected = all;
+    expected.push_back(1);
+    expected.push_back(2);
+    EXPECT_EQ(expected, getTileIDs(*before, {0, 0, 0}));
+
+    // Each cluster is served on its own.
+    EXPECT_EQ(west, getTileIDs(*before, {2, 1, 1}));
+    EXPECT_EQ(5000u, getTileIDs(*before, {2, 2, 2}).size());
+
+    // A replaced feature keeps its position, new ones are appended.
+    GeoJSONDataDiff diff;
+    diff.remove = {uint64_t{1}};
+    diff.add.push_back(point(2, 70.0, 35.0));
+    diff.add.push_back(point(3, 80.0, 40.0));
+    source.updateData(diff);
+    auto after = source.impl().getData().lock();
+    ASSERT_TRUE(after);
+    EXPECT_NE(before, after);
+
+    expected = all;
+    expected.push_back(2);
+    expected.push_back(3);
+    EXPECT_EQ(expected, getTileIDs(*after, {0, 0, 0}));
+    EXPECT_EQ((std::vector<uint64_t>{2u, 3u}), getTileIDs(*after, {2, 2, 1}));
+    EXPECT_EQ(west, getTileIDs(*after, {2, 1, 1}));
+
+    // Only tiles around the changed features need a reload.
+    EXPECT_TRUE(after->isTileChanged(*before, {0, 0, 0}));
+    EXPECT_TRUE(after->isTileChanged(*before, {2, 2, 1}));
+    EXPECT_FALSE(after->isTileChanged(*before, {2, 1, 1}));
+    EXPECT_FALSE(after->isTileChanged(*before, {2, 3, 3}));
+    EXPECT_TRUE(after->isTileChanged(*after, {2, 1, 1}));
+
+    diff = {};
+    diff.removeAll = true;
+    diff.add.push_back(point(4, 0.0, 0.0));
+    source.updateData(diff);
+    auto cleared = source.impl().getData().lock();
+    EXPECT_EQ(std::vector<uint64_t>{4u}, getTileIDs(*cleared, {0, 0, 0}));
+    EXPECT_TRUE(cleared->isTileChanged(*after, {2, 3, 3}));
+}
+
 TEST(Source, SetMaxParentOverscaleFactor) {
     SourceTest test;
     test.transform.jumpTo(CameraOptions().withCenter(LatLng()).withZoom(8.0));
@@ -0,0 +1,40 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/map/transform_state.hpp>
+#include <mbgl/text/collision_index.hpp>
+#include <mbgl/util/mat4.hpp>
+
+using namespace mbgl;
+
+TEST(CollisionIndex, CullsBoundsOutsideOfTheGrid) {
+    TransformState state;
+    state.setSize({512, 512});
+    const CollisionIndex collisionIndex(state, MapMode::Continuous);
+
+    // Maps clip coordinates to themselves, so that [-1, 1] covers the viewport
+    mat4 posMatrix;
+    matrix::identity(posMatrix);
+
+    CollisionBounds empty;
+    EXPECT_FALSE(collisionIndex.isCulled(empty, posMatrix, 1.0f));
+
+    CollisionBounds inView;
+    inView.add(Point<float>{-0.5f, -0.5f});
+    inView.add(Point<float>{0.5f, 0.5f});
+    EXPECT_FALSE(collisionIndex.isCulled(inView, posMatrix, 1.0f));
+
+    CollisionBounds outOfView;
+    outOfView.add(Point<float>{4.0f, 4.0f});
+    outOfView.add(Point<float>{5.0f, 5.0f});
+    EXPECT_TRUE(collisionIndex.isCulled(outOfView, posMatrix, 1.0f));
+
+    // Boxes large enough to reach into the grid
+    outOfView.extent = 10000.0f;
+    EXPECT_FALSE(collisionIndex.isCulled(outOfView, posMatrix, 1.0f));
+
+    // Bounds reaching behind the camera are never culled
+    CollisionBounds behind;
+    posMatrix[15] = -1;
+    behind.add(Point<float>{4.0f, 4.0f});
+    EXPECT_FALSE(collisionIndex.isCulled(behind, posMatrix, 1.0f));
+}
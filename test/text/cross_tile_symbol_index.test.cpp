@@ -44,7 +44,7 @@ SymbolInstance makeSymbolInstance(float x, float y, std::u16string key) {
                           subfeature,
                           0,
                           0,
-                          key,
+                          std::make_shared<const std::u16string>(std::move(key)),
                           0.0f,
                           0.0f,
                           0.0f,
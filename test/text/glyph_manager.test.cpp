@@ -2,6 +2,8 @@
 #include <mbgl/test/stub_file_source.hpp>
 
 #include <mbgl/text/glyph_manager.hpp>
+#include <mbgl/text/glyph_pack.hpp>
+#include <mbgl/text/shaping_cache.hpp>
 #include <mbgl/util/run_loop.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/i18n.hpp>
@@ -199,6 +201,81 @@ TEST(GlyphManager, LoadingSuccess) {
     test.run("test/fixtures/resources/glyphs.pbf", GlyphDependencies{{{{"Test Stack"}}, {u'a', u'å', u' '}}});
 }
 
+TEST(GlyphManager, LoadingFromGlyphPack) {
+    GlyphManagerTest test;
+
+    test.fileSource.glyphsResponse = [&](const Resource&) {
+        ADD_FAILURE() << "Ranges in the glyph pack should not be requested";
+        return std::optional<Response>();
+    };
+
+    test.observer.glyphsError = [&](const FontStack&, const GlyphRange&, std::exception_ptr) {
+        FAIL();
+        test.end();
+    };
+
+    test.requestor.glyphsAvailable = [&](GlyphMap glyphs) {
+        const auto& testPositions = glyphs.at(FontStackHasher()({{"Test Stack"}}));
+
+        ASSERT_EQ(testPositions.size(), 2u);
+        ASSERT_TRUE(bool(testPositions.at(u'a')));
+        ASSERT_TRUE(bool(testPositions.at(u'å')));
+
+        test.end();
+    };
+
+    test.run("file://test/fixtures/resources/glyphs.glyphpack", GlyphDependencies{{{{"Test Stack"}}, {u'a', u'å'}}});
+}
+
+TEST(GlyphManager, LoadingMissingRangeFromGlyphPackURL) {
+    GlyphManagerTest test;
+
+    // The pack only has the first range, and was made for a style with this glyph URL
+    test.fileSource.glyphsResponse = [&](const Resource& resource) {
+        EXPECT_EQ("https://example.com/fonts/Test%20Stack/256-511.pbf", resource.url);
+        Response response;
+        response.data = std::make_shared<std::string>(util::read_file("test/fixtures/resources/glyphs.pbf"));
+        return response;
+    };
+
+    test.observer.glyphsError = [&](const FontStack&, const GlyphRange&, std::exception_ptr) {
+        FAIL();
+        test.end();
+    };
+
+    test.requestor.glyphsAvailable = [&](GlyphMap glyphs) {
+        const auto& testPositions = glyphs.at(FontStackHasher()({{"Test Stack"}}));
+        ASSERT_TRUE(bool(testPositions.at(u'a')));
+        test.end();
+    };
+
+    test.run("file://test/fixtures/resources/glyphs.glyphpack",
+             GlyphDependencies{{{{"Test Stack"}}, {u'a', u'\u0100'}}});
+}
+
+TEST(GlyphManager, GlyphPackServesRangesBeforeURL) {
+    GlyphManagerTest test;
+    test.glyphManager.setURL("https://example.com/fonts/{fontstack}/{range}.pbf");
+    test.glyphManager.setGlyphPack(GlyphPack::fromData(GlyphPack::encode(
+        {{{{"Test Stack"}, GlyphRange(0, 255)}, util::read_file("test/fixtures/resources/glyphs.pbf")}})));
+
+    test.fileSource.glyphsResponse = [&](const Resource& resource) {
+        EXPECT_EQ("https://example.com/fonts/Test%20Stack/256-511.pbf", resource.url);
+        Response response;
+        response.data = std::make_shared<std::string>(util::read_file("test/fixtures/resources/glyphs.pbf"));
+        return response;
+    };
+
+    test.requestor.glyphsAvailable = [&](GlyphMap glyphs) {
+        const auto& testPositions = glyphs.at(FontStackHasher()({{"Test Stack"}}));
+        ASSERT_TRUE(bool(testPositions.at(u'a')));
+        test.end();
+    };
+
+    test.run("https://example.com/fonts/{fontstack}/{range}.pbf",
+             GlyphDependencies{{{{"Test Stack"}}, {u'a', u'\u0100'}}});
+}
+
 TEST(GlyphManager, LoadingFail) {
     GlyphManagerTest test;
 
@@ -438,3 +515,25 @@ TEST(GlyphManager, ImmediateFileSource) {
 
     test.run("test/fixtures/resources/glyphs.pbf", GlyphDependencies{{{{"Test Stack"}}, {u'a', u'å', u' '}}});
 }
+
+TEST(GlyphManager, ShapingCachePerURL) {
+    util::RunLoop loop;
+    GlyphManager glyphManager;
+    GlyphManager otherGlyphManager;
+    EXPECT_NE(glyphManager.getShapingCache(), otherGlyphManager.getShapingCache());
+
+    glyphManager.setURL("https://example.com/{fontstack}/{range}.pbf");
+    const auto cache = glyphManager.getShapingCache();
+    ASSERT_TRUE(cache);
+    const TaggedString string(u"Main Street", SectionOptions(1.0, {"Test Stack"}));
+    cache->put(*ShapingCache::Key::create(string, 10.0f, 0.0f), {string});
+
+    glyphManager.setURL("https://example.com/{fontstack}/{range}.pbf");
+    EXPECT_EQ(cache, glyphManager.getShapingCache());
+
+    // Lines shaped with the glyphs of another URL aren't reused
+    glyphManager.setURL("https://example.org/{fontstack}/{range}.pbf");
+    ASSERT_NE(cache, glyphManager.getShapingCache());
+    EXPECT_EQ(0u, glyphManager.getShapingCache()->size());
+    EXPECT_EQ(1u, cache->size());
+}
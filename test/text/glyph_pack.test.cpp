@@ -0,0 +1,51 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/text/glyph_pack.hpp>
+#include <mbgl/util/io.hpp>
+
+using namespace mbgl;
+
+TEST(GlyphPack, Ranges) {
+    const FontStack regular{"Open Sans Regular", "Arial Unicode MS Regular"};
+    const FontStack bold{"Open Sans Bold"};
+    const auto pack = GlyphPack::fromData(GlyphPack::encode(
+        {
+            {{regular, GlyphRange(0, 255)}, "regular 0-255"},
+            {{regular, GlyphRange(256, 511)}, "regular 256-511"},
+            {{bold, GlyphRange(0, 255)}, ""},
+        },
+        "https://example.com/{fontstack}/{range}.pbf"));
+    ASSERT_TRUE(pack);
+    EXPECT_EQ(3u, pack->rangeCount());
+    EXPECT_EQ("https://example.com/{fontstack}/{range}.pbf", pack->getGlyphURL());
+
+    EXPECT_EQ("regular 0-255", pack->getRange(regular, GlyphRange(0, 255)));
+    EXPECT_EQ("regular 256-511", pack->getRange(regular, GlyphRange(256, 511)));
+    EXPECT_EQ("", pack->getRange(bold, GlyphRange(0, 255)));
+    EXPECT_FALSE(pack->getRange(bold, GlyphRange(256, 511)));
+    EXPECT_FALSE(pack->getRange({"Open Sans Regular"}, GlyphRange(0, 255)));
+}
+
+TEST(GlyphPack, Invalid) {
+    EXPECT_FALSE(GlyphPack::fromData(""));
+    EXPECT_FALSE(GlyphPack::fromData("CORRUPTED"));
+
+    // Truncated data
+    auto data = GlyphPack::encode({{{{"Test Stack"}, GlyphRange(0, 255)}, "glyphs"}});
+    data.pop_back();
+    EXPECT_FALSE(GlyphPack::fromData(data));
+
+    EXPECT_FALSE(GlyphPack::open("test/fixtures/resources/missing.glyphpack"));
+}
+
+TEST(GlyphPack, Open) {
+    // Made with scripts/pack-glyphs.py --url 'https://example.com/fonts/{fontstack}/{range}.pbf'
+    //     --range 'Test Stack' 0 test/fixtures/resources/glyphs.pbf test/fixtures/resources/glyphs.glyphpack
+    const auto pack = GlyphPack::open("test/fixtures/resources/glyphs.glyphpack");
+    ASSERT_TRUE(pack);
+    EXPECT_EQ(1u, pack->rangeCount());
+    EXPECT_EQ("https://example.com/fonts/{fontstack}/{range}.pbf", pack->getGlyphURL());
+    const auto range = pack->getRange({"Test Stack"}, GlyphRange(0, 255));
+    ASSERT_TRUE(range);
+    EXPECT_EQ(util::read_file("test/fixtures/resources/glyphs.pbf"), *range);
+}
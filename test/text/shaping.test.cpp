@@ -4,6 +4,7 @@
 #include <mbgl/text/bidi.hpp>
 #include <mbgl/text/tagged_string.hpp>
 #include <mbgl/text/shaping.hpp>
+#include <mbgl/text/shaping_cache.hpp>
 #include <mbgl/util/constants.hpp>
 
 using namespace mbgl;
@@ -103,3 +104,64 @@ TEST(Shaping, ZWSP) {
         ASSERT_EQ(shaping.writingMode, WritingModeType::Horizontal);
     }
 }
+
+TEST(Shaping, Cache) {
+    GlyphPosition glyphPosition;
+    glyphPosition.metrics.width = 18;
+    glyphPosition.metrics.height = 18;
+    glyphPosition.metrics.advance = 21;
+
+    Glyph glyph;
+    glyph.id = u'中';
+    glyph.metrics = glyphPosition.metrics;
+
+    BiDi bidi;
+    const std::vector<std::string> fontStack{{"font-stack"}};
+    const SectionOptions sectionOptions(1.0f, fontStack);
+    GlyphMap glyphs = {{FontStackHasher()(fontStack), {{u'中', Immutable<Glyph>(makeMutable<Glyph>(glyph))}}}};
+    GlyphPositions glyphPositions = {{FontStackHasher()(fontStack), {{u'中', glyphPosition}}}};
+    ImagePositions imagePositions;
+    ShapingCache cache(2);
+
+    const auto testGetShaping = [&](const TaggedString& string, unsigned maxWidthInChars) {
+        return getShaping(string,
+                          maxWidthInChars * ONE_EM,
+                          ONE_EM, // lineHeight
+                          style::SymbolAnchorType::Center,
+                          style::TextJustifyType::Center,
+                          0,              // spacing
+                          {{0.0f, 0.0f}}, // translate
+                          WritingModeType::Horizontal,
+                          bidi,
+                          glyphs,
+                          glyphPositions,
+                          imagePositions,
+                          16.0f,
+                          16.0f,
+                          /*allowVerticalPlacement*/ false,
+                          &cache);
+    };
+
+    const TaggedString string(u"中中\u200b中", sectionOptions);
+    const auto shaping = testGetShaping(string, 1);
+    EXPECT_EQ(0u, cache.getStats().hits);
+    EXPECT_EQ(1u, cache.getStats().misses);
+
+    const auto cached = testGetShaping(string, 1);
+    EXPECT_EQ(1u, cache.getStats().hits);
+    ASSERT_EQ(shaping.positionedLines.size(), cached.positionedLines.size());
+    EXPECT_EQ(shaping.top, cached.top);
+    EXPECT_EQ(shaping.bottom, cached.bottom);
+    EXPECT_EQ(shaping.left, cached.left);
+    EXPECT_EQ(shaping.right, cached.right);
+
+    // The width is part of the key
+    EXPECT_EQ(1u, testGetShaping(string, 5).positionedLines.size());
+    EXPECT_EQ(2u, cache.getStats().misses);
+
+    // Least recently used strings are evicted
+    testGetShaping(TaggedString(u"中", sectionOptions), 1);
+    EXPECT_EQ(1u, cache.getStats().evictions);
+    EXPECT_EQ(2u, cache.size());
+    EXPECT_DOUBLE_EQ(0.25, cache.getStats().hitRate());
+}
@@ -0,0 +1,167 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/layout/symbol_layout.hpp>
+#include <mbgl/layout/symbol_projection.hpp>
+#include <mbgl/map/transform_state.hpp>
+#include <mbgl/renderer/buckets/symbol_bucket.hpp>
+#include <mbgl/renderer/render_tile.hpp>
+#include <mbgl/tile/tile.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/mat4.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+using namespace mbgl;
+
+TEST(SymbolProjection, ProjectPointsMatchesProject) {
+    mat4 matrix;
+    matrix::perspective(matrix, 0.6435, 1.5, 1, 10000);
+    matrix::translate(matrix, matrix, -256, 128, -600);
+    matrix::rotate_x(matrix, matrix, 0.8);
+    matrix::rotate_z(matrix, matrix, 0.3);
+
+    std::vector<float> xs;
+    std::vector<float> ys;
+    for (int i = 0; i < 37; ++i) {
+        xs.push_back(static_cast<float>(i * 113 % 8192));
+        ys.push_back(static_cast<float>(i * 71 % 8192) - 512.0f);
+    }
+
+    std::vector<double> x(xs.size());
+    std::vector<double> y(xs.size());
+    std::vector<double> w(xs.size());
+    projectPoints(xs.data(), ys.data(), xs.size(), matrix, x.data(), y.data(), w.data());
+
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        const auto expected = project({xs[i], ys[i]}, matrix);
+        EXPECT_FLOAT_EQ(expected.first.x, static_cast<float>(x[i] / w[i]));
+        EXPECT_FLOAT_EQ(expected.first.y, static_cast<float>(y[i] / w[i]));
+        EXPECT_FLOAT_EQ(expected.second, static_cast<float>(w[i]));
+    }
+}
+
+namespace {
+
+class StubTile final : public Tile {
+public:
+    explicit StubTile(const OverscaledTileID& tileID)
+        : Tile(Tile::Kind::Geometry, tileID) {}
+    std::unique_ptr<TileRenderData> createRenderData() override { return nullptr; }
+    void setNecessity(TileNecessity) override {}
+    void setUpdateParameters(const TileUpdateParameters&) override {}
+    bool layerPropertiesUpdated(const Immutable<style::LayerProperties>&) override { return true; }
+};
+
+PlacedSymbol makeLineLabel(const std::size_t index, const WritingModeType writingModes) {
+    // Lines point in every direction, so that labels are flipped or switch to
+    // their vertical variant, and bend once after the anchor
+    const double angle = static_cast<double>(index) * 0.37;
+    const Point<double> direction{std::cos(angle), std::sin(angle)};
+    const Point<double> anchor{512.0 + static_cast<double>(index * 619 % 7168),
+                               512.0 + static_cast<double>(index * 317 % 7168)};
+    const double length = 2000.0;
+    const auto toTile = [](const Point<double>& point) {
+        return GeometryCoordinate{static_cast<int16_t>(std::lround(point.x)),
+                                  static_cast<int16_t>(std::lround(point.y))};
+    };
+    const Point<double> bend = anchor + direction * (length / 2);
+    GeometryCoordinates line{toTile(anchor - direction * length),
+                             toTile(bend),
+                             toTile(bend + Point<double>{-direction.y, direction.x} * length)};
+
+    const Anchor tileAnchor(static_cast<float>(anchor.x), static_cast<float>(anchor.y), static_cast<float>(angle), 0);
+    auto tileDistances = SymbolLayout::calculateTileDistances(line, tileAnchor);
+    PlacedSymbol symbol(
+        tileAnchor.point, 0, 16.0f, 16.0f, {{0.0f, 0.0f}}, writingModes, std::move(line), std::move(tileDistances));
+    if (index % 5 == 0) {
+        symbol.glyphOffsets = {0.0f};
+    } else {
+        symbol.glyphOffsets = {-36.0f, -18.0f, 0.0f, 18.0f, 36.0f};
+    }
+    return symbol;
+}
+
+} // namespace
+
+TEST(SymbolProjection, ReprojectLineLabelsInParallel) {
+    TransformState state;
+    state.setSize({512, 512});
+    state.setLatLngZoom({0, 0}, 0);
+    state.setPitch(0.5);
+
+    const UnwrappedTileID tileID{0, 0, 0};
+    StubTile stubTile(OverscaledTileID{0, 0, 0});
+    const RenderTile tile(tileID, stubTile);
+
+    mat4 projMatrix;
+    state.getProjMatrix(projMatrix);
+    mat4 posMatrix;
+    state.matrixFor(posMatrix, tileID);
+    matrix::multiply(posMatrix, projMatrix, posMatrix);
+
+    const auto sizeBinder = SymbolSizeBinder::create(0.0f, style::PropertyValue<float>(16.0f), 16.0f);
+
+    // Every fourth label has a vertical variant, which follows it; some of
+    // both kinds are hidden
+    std::vector<PlacedSymbol> symbols;
+    for (std::size_t i = 0; i < 600; ++i) {
+        const bool hasVertical = i % 4 == 0;
+        symbols.push_back(
+            makeLineLabel(i, hasVertical ? WritingModeType::Horizontal | WritingModeType::Vertical
+                                         : WritingModeType::Horizontal));
+        symbols.back().hidden = i % 9 == 0;
+        if (hasVertical) {
+            symbols.push_back(makeLineLabel(i, WritingModeType::Vertical));
+            symbols.back().hidden = i % 8 == 0;
+        }
+    }
+
+    using DynamicVertices = gfx::VertexVector<gfx::Vertex<SymbolDynamicLayoutAttributes>>;
+    const auto reproject = [&](DynamicVertices& vertices, const std::vector<PlacedSymbol>& placed) {
+        reprojectLineLabels(vertices, placed, posMatrix, false, true, true, tile, *sizeBinder, state);
+    };
+
+    DynamicVertices parallel;
+    reproject(parallel, symbols);
+
+    // The reference is projected on the calling thread in short runs. Each run
+    // starts at a shown horizontal symbol, which doesn't depend on the symbols
+    // before it, so the runs put together are the same as a single pass.
+    DynamicVertices serial;
+    std::vector<PlacedSymbol> run;
+    const auto flush = [&] {
+        DynamicVertices vertices;
+        reproject(vertices, run);
+        for (std::size_t i = 0; i < vertices.elements(); ++i) {
+            serial.emplace_back(vertices.at(i));
+        }
+        run.clear();
+    };
+    for (const auto& symbol : symbols) {
+        if (run.size() >= 100 && !symbol.hidden && symbol.writingModes != WritingModeType::Vertical) {
+            flush();
+        }
+        run.push_back(symbol);
+    }
+    flush();
+
+    ASSERT_EQ(serial.elements(), parallel.elements());
+    EXPECT_EQ(0, std::memcmp(serial.getRawData(), parallel.getRawData(), serial.getRawSize()));
+
+    // The vertical variants of some labels and both orientations of others are placed
+    std::size_t offset = 0;
+    std::size_t placedHorizontal = 0;
+    std::size_t placedVertical = 0;
+    for (const auto& symbol : symbols) {
+        const auto& vertex = parallel.at(offset);
+        if (vertex.a1[0] != -INFINITY) {
+            EXPECT_FALSE(symbol.hidden);
+            (symbol.writingModes == WritingModeType::Vertical ? placedVertical : placedHorizontal)++;
+        }
+        offset += symbol.glyphOffsets.size() * 4;
+    }
+    EXPECT_GT(placedHorizontal, 0u);
+    EXPECT_GT(placedVertical, 0u);
+}
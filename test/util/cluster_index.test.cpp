@@ -0,0 +1,188 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/cluster_index.hpp>
+
+#include <supercluster.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+using namespace mbgl;
+
+namespace {
+
+GeoJSONFeature makePoint(double lng, double lat, uint64_t id) {
+    return {mapbox::geometry::point<double>{lng, lat}, PropertyMap{{"value", uint64_t(1)}}, FeatureIdentifier(id)};
+}
+
+// Two groups of three points, far enough apart not to be clustered together
+// above zoom 2, but close enough that the points within a group cluster up to zoom 10.
+ClusterIndex::Features makeGroups() {
+    ClusterIndex::Features features;
+    uint64_t id = 0;
+    for (const double lng : {-40.0, 40.0}) {
+        for (const double offset : {0.0, 0.001, 0.002}) {
+            features.push_back(makePoint(lng + offset, 10.0, id++));
+        }
+    }
+    return features;
+}
+
+ClusterIndex::Options makeOptions() {
+    ClusterIndex::Options options;
+    options.maxZoom = 10;
+    options.reduce = [](std::vector<PropertyMap>& clusters, const std::vector<ClusterIndex::Options::Member>& members) {
+        for (const auto& [cluster, point] : members) {
+            auto& value = clusters[cluster]["value"];
+            value = value.get<uint64_t>() + point->at("value").get<uint64_t>();
+        }
+    };
+    return options;
+}
+
+uint64_t pointCount(const ClusterIndex::TileFeatures& features) {
+    uint64_t count = 0;
+    for (const auto& feature : features) {
+        auto it = feature.properties.find("point_count");
+        count += it == feature.properties.end() ? 1 : it->second.get<uint64_t>();
+    }
+    return count;
+}
+
+class LevelCount {
+public:
+    std::size_t features = 0;
+    uint64_t points = 0;
+};
+
+// Points and clusters on a zoom level, counting each one only in the tile it
+// is in and not in the buffers of the tiles around it.
+template <typename Index>
+LevelCount countLevel(Index& index, uint8_t z, int16_t extent) {
+    LevelCount count;
+    const uint32_t tiles = 1u << z;
+    for (uint32_t x = 0; x < tiles; ++x) {
+        for (uint32_t y = 0; y < tiles; ++y) {
+            const auto tile = index.getTile(z, x, y);
+            for (const auto& feature : tile) {
+                const auto& point = feature.geometry.template get<mapbox::geometry::point<int16_t>>();
+                if (point.x >= 0 && point.x < extent && point.y >= 0 && point.y < extent) {
+                    auto it = feature.properties.find("point_count");
+                    ++count.features;
+                    count.points += it == feature.properties.end() ? 1 : it->second.get<uint64_t>();
+                }
+            }
+        }
+    }
+    return count;
+}
+
+} // namespace
+
+TEST(ClusterIndex, Clusters) {
+    ClusterIndex index(makeGroups(), makeOptions());
+    EXPECT_EQ(6u, index.size());
+
+    const auto tile = index.getTile(5, 12, 15);
+    ASSERT_EQ(1u, tile.size());
+    const auto& cluster = tile.front();
+    EXPECT_EQ(true, cluster.properties.at("cluster").get<bool>());
+    EXPECT_EQ(3u, cluster.properties.at("point_count").get<uint64_t>());
+    EXPECT_EQ("3", cluster.properties.at("point_count_abbreviated").get<std::string>());
+    EXPECT_EQ(3u, cluster.properties.at("value").get<uint64_t>());
+
+    const auto clusterID = static_cast<uint32_t>(cluster.id.get<uint64_t>());
+    EXPECT_EQ(3u, index.getLeaves(clusterID).size());
+    EXPECT_EQ(1u, index.getLeaves(clusterID, 1, 2).size());
+    EXPECT_FALSE(index.getChildren(clusterID).empty());
+    EXPECT_GT(index.getClusterExpansionZoom(clusterID), 5u);
+    EXPECT_THROW(index.getChildren(0xffffffe), std::runtime_error);
+
+    // Points are not clustered above the maximum zoom level.
+    EXPECT_EQ(3u, index.getTile(11, 796, 966).size());
+}
+
+TEST(ClusterIndex, Update) {
+    ClusterIndex original(makeGroups(), makeOptions());
+
+    ClusterIndex::ChangedBounds changed;
+    ClusterIndex::Features add{makePoint(40.003, 10.0, 6), makePoint(120.0, 10.0, 7)};
+    auto updated = original.update({FeatureIdentifier(uint64_t(0)), FeatureIdentifier(uint64_t(1))}, add, &changed);
+    ASSERT_TRUE(updated);
+    const ClusterIndex& index = *updated;
+    EXPECT_EQ(6u, index.size());
+    EXPECT_EQ(4u, index.getUpdateCount());
+    EXPECT_EQ(6u, index.getFeatures().size());
+
+    // The lowest zoom level still accounts for every point.
+    EXPECT_EQ(6u, pointCount(index.getTile(0, 0, 0)));
+
+    // The remaining point of the first group is no longer clustered.
+    const auto west = index.getTile(5, 12, 15);
+    ASSERT_EQ(1u, west.size());
+    EXPECT_EQ(FeatureIdentifier(uint64_t(2)), west.front().id);
+    EXPECT_EQ(0u, west.front().properties.count("cluster"));
+
+    // The added point joined the cluster of the second group.
+    const auto east = index.getTile(5, 19, 15);
+    ASSERT_EQ(1u, east.size());
+    EXPECT_EQ(4u, east.front().properties.at("point_count").get<uint64_t>());
+    EXPECT_EQ(4u, east.front().properties.at("value").get<uint64_t>());
+    EXPECT_EQ(4u, index.getLeaves(static_cast<uint32_t>(east.front().id.get<uint64_t>())).size());
+
+    EXPECT_EQ(1u, changed.count(5));
+    EXPECT_EQ(1u, changed.count(11));
+
+    // The index the update was applied to is unchanged.
+    EXPECT_EQ(0u, original.getUpdateCount());
+    const auto before = original.getTile(5, 12, 15);
+    ASSERT_EQ(1u, before.size());
+    EXPECT_EQ(3u, before.front().properties.at("point_count").get<uint64_t>());
+    EXPECT_EQ(3u, original.getTile(5, 19, 15).front().properties.at("point_count").get<uint64_t>());
+    EXPECT_EQ(6u, original.getFeatures().size());
+}
+
+TEST(ClusterIndex, UpdateDrift) {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> coordinate(-20, 20);
+    ClusterIndex::Features features;
+    for (uint64_t i = 0; i < 2000; ++i) {
+        features.push_back(makePoint(coordinate(generator), coordinate(generator), i));
+    }
+
+    ClusterIndex::Options options;
+    options.maxZoom = 6;
+    std::shared_ptr<const ClusterIndex> index = std::make_shared<ClusterIndex>(features, options);
+
+    // Move points until just below a quarter of the points have been updated,
+    // where clustered sources rebuild their index.
+    std::uniform_int_distribution<uint64_t> id(0, features.size() - 1);
+    for (int update = 0; update < 2; ++update) {
+        ClusterIndex::Features moved;
+        for (int i = 0; i < 100; ++i) {
+            moved.push_back(makePoint(coordinate(generator), coordinate(generator), id(generator)));
+        }
+        index = index->update({}, moved);
+    }
+    ASSERT_EQ(features.size(), index->size());
+    ASSERT_LE(index->getUpdateCount() * 4, index->size());
+
+    mapbox::supercluster::Options freshOptions;
+    freshOptions.maxZoom = options.maxZoom;
+    freshOptions.radius = options.radius;
+    freshOptions.extent = options.extent;
+    mapbox::supercluster::Supercluster fresh(index->getFeatures(), freshOptions);
+
+    const auto extent = static_cast<int16_t>(options.extent);
+    for (uint8_t z = 0; z <= options.maxZoom + 1; ++z) {
+        const auto count = countLevel(*index, z, extent);
+        const auto freshCount = countLevel(fresh, z, extent);
+
+        // Every point is still accounted for, and clusters stay within the documented bound.
+        EXPECT_EQ(features.size(), count.points) << "zoom " << int(z);
+        EXPECT_EQ(features.size(), freshCount.points) << "zoom " << int(z);
+        const auto difference = std::abs(static_cast<double>(count.features) - freshCount.features);
+        EXPECT_LE(difference, std::max(4.0, freshCount.features / 4.0)) << "zoom " << int(z);
+    }
+}
@@ -1,3 +1,5 @@
+#include <mbgl/actor/actor_ref.hpp>
+#include <mbgl/actor/mailbox.hpp>
 #include <mbgl/util/run_loop.hpp>
 #include <mbgl/util/timer.hpp>
 
@@ -65,6 +67,109 @@ TEST(RunLoop, Priorities) {
     EXPECT_EQ((std::vector<int>{2, 4, 1, 3}), order);
 }
 
+TEST(RunLoop, AllPriorities) {
+    std::vector<int> order;
+
+    RunLoop loop(RunLoop::Type::New);
+    loop.invoke(RunLoop::Priority::Low, [&] { order.push_back(1); });
+    loop.invoke([&] { order.push_back(2); });
+    loop.invoke(RunLoop::Priority::Critical, [&] { order.push_back(3); });
+    loop.invoke(RunLoop::Priority::High, [&] { order.push_back(4); });
+    loop.invoke(RunLoop::Priority::Low, [&] { loop.stop(); });
+    loop.run();
+
+    EXPECT_EQ((std::vector<int>{3, 4, 2, 1}), order);
+}
+
+TEST(RunLoop, PrioritySchedulers) {
+    class Receiver {
+    public:
+        void receive(int i) { order.push_back(i); }
+        std::vector<int> order;
+    };
+
+    RunLoop loop(RunLoop::Type::New);
+    mbgl::Scheduler& low = loop.withPriority(mbgl::Scheduler::Priority::Low);
+    mbgl::Scheduler& critical = loop.withPriority(mbgl::Scheduler::Priority::Critical);
+    EXPECT_EQ(&loop, &loop.withPriority(mbgl::Scheduler::Priority::Default));
+    EXPECT_EQ(&critical, &low.withPriority(mbgl::Scheduler::Priority::Critical));
+
+    // Replies to background work, such as parsed tiles sent to the mailbox of
+    // their tile, queue up with low priority; frame-critical work overtakes them.
+    Receiver receiver;
+    auto mailbox = std::make_shared<mbgl::Mailbox>(low);
+    mbgl::ActorRef<Receiver> tile(receiver, mailbox);
+    tile.invoke(&Receiver::receive, 1);
+    tile.invoke(&Receiver::receive, 2);
+    loop.schedule([&] { receiver.order.push_back(3); });
+    critical.schedule([&] { receiver.order.push_back(4); });
+    low.schedule([&] { loop.stop(); });
+    loop.run();
+
+    EXPECT_EQ((std::vector<int>{4, 3, 1, 2}), receiver.order);
+}
+
+TEST(RunLoop, TimeBudget) {
+    std::vector<int> order;
+
+    RunLoop loop(RunLoop::Type::New);
+    loop.setTimeBudget(std::chrono::milliseconds(1));
+
+    const auto work = [&](int i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        order.push_back(i);
+    };
+    loop.invoke([&] {
+        work(1);
+        // Critical tasks are not deferred by the budget.
+        loop.invoke(RunLoop::Priority::Critical, [&] { order.push_back(4); });
+    });
+    loop.invoke([&] { work(2); });
+    loop.invoke([&] { work(3); });
+    loop.invoke(RunLoop::Priority::Low, [&] { loop.stop(); });
+    loop.run();
+
+    EXPECT_EQ((std::vector<int>{1, 4, 2, 3}), order);
+    EXPECT_GE(loop.getStats().yields, 3u);
+}
+
+TEST(RunLoop, Stats) {
+    RunLoop loop(RunLoop::Type::New);
+    loop.setStatsEnabled(true);
+
+    loop.invoke([] { std::this_thread::sleep_for(std::chrono::milliseconds(2)); });
+    loop.invoke(RunLoop::Priority::High, [] {});
+    loop.invoke([&] { loop.stop(); });
+    loop.run();
+
+    auto stats = loop.getStats();
+    const auto& defaultTasks = stats.tasks[static_cast<std::size_t>(RunLoop::Priority::Default)];
+    // Includes the task posted by stop().
+    EXPECT_EQ(3u, defaultTasks.execution.count);
+    EXPECT_EQ(3u, defaultTasks.wait.count);
+    EXPECT_GE(defaultTasks.execution.max, std::chrono::milliseconds(2));
+    EXPECT_GE(defaultTasks.execution.percentile(1.0), std::chrono::milliseconds(2));
+    EXPECT_EQ(1u, stats.tasks[static_cast<std::size_t>(RunLoop::Priority::High)].execution.count);
+    EXPECT_EQ(0u, stats.tasks[static_cast<std::size_t>(RunLoop::Priority::Low)].execution.count);
+
+    loop.resetStats();
+    EXPECT_EQ(0u, loop.getStats().tasks[static_cast<std::size_t>(RunLoop::Priority::Default)].execution.count);
+}
+
+TEST(RunLoop, LatencyHistogram) {
+    LatencyHistogram histogram;
+    for (int i = 0; i < 99; ++i) {
+        histogram.record(std::chrono::microseconds(3));
+    }
+    histogram.record(std::chrono::milliseconds(5));
+
+    EXPECT_EQ(100u, histogram.count);
+    EXPECT_EQ(std::chrono::microseconds(4), histogram.percentile(0.5));
+    EXPECT_EQ(std::chrono::microseconds(4), histogram.percentile(0.95));
+    EXPECT_EQ(std::chrono::milliseconds(5), histogram.percentile(1.0));
+    EXPECT_EQ(std::chrono::milliseconds(5), histogram.max);
+}
+
 TEST(RunLoop, PlatformIntegration) {
     std::atomic<int> count1(0);
 
@@ -118,6 +118,32 @@ TEST(TileCover, PitchWithLargerResultSet) {
               (std::vector<OverscaledTileID>{cover.begin(), cover.begin() + 16}));
 }
 
+TEST(TileCover, Cache) {
+    Transform transform;
+    transform.resize({512, 512});
+    transform.jumpTo(CameraOptions().withCenter(LatLng{0.1, -0.1}).withZoom(8.0).withBearing(5.0).withPitch(40.0));
+
+    util::TileCoverCache cache;
+    const auto& cover = cache.get(transform.getState(), 8);
+    EXPECT_EQ(util::tileCover(transform.getState(), 8), cover);
+    EXPECT_EQ(0u, cache.getHits());
+    EXPECT_EQ(1u, cache.getMisses());
+
+    // Other sources asking for the same cover share the result.
+    EXPECT_EQ(&cover, &cache.get(transform.getState(), 8));
+    EXPECT_EQ(1u, cache.getHits());
+
+    EXPECT_EQ(util::tileCover(transform.getState(), 6), cache.get(transform.getState(), 6));
+    EXPECT_EQ(util::tileCover(transform.getState(), 8, 10), cache.get(transform.getState(), 8, 10));
+    EXPECT_EQ(3u, cache.getMisses());
+
+    // Moving the camera invalidates all covers.
+    transform.jumpTo(CameraOptions().withCenter(LatLng{10.0, 20.0}));
+    EXPECT_EQ(util::tileCover(transform.getState(), 8), cache.get(transform.getState(), 8));
+    EXPECT_EQ(1u, cache.getHits());
+    EXPECT_EQ(4u, cache.getMisses());
+}
+
 TEST(TileCover, WorldZ1) {
     EXPECT_EQ((std::vector<UnwrappedTileID>{
                   {1, 0, 0},